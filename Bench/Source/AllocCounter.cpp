@@ -0,0 +1,74 @@
+#include "AllocCounter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<uint64_t> allocatedBytes { 0 };
+    std::atomic<uint64_t> allocationCount { 0 };
+    std::atomic<int64_t>  liveBytes { 0 };
+
+    // Each block carries its size in front so delete can take it off the
+    // live count; the header keeps the block's fundamental alignment.
+    constexpr std::size_t kHeader = alignof (std::max_align_t);
+
+    void* countedAlloc (std::size_t size) noexcept
+    {
+        allocatedBytes.fetch_add (size, std::memory_order_relaxed);
+        allocationCount.fetch_add (1, std::memory_order_relaxed);
+        liveBytes.fetch_add ((int64_t) size, std::memory_order_relaxed);
+
+        auto* block = static_cast<unsigned char*> (std::malloc (kHeader + (size == 0 ? 1 : size)));
+        if (block == nullptr)
+            return nullptr;
+
+        *reinterpret_cast<std::size_t*> (block) = size;
+        return block + kHeader;
+    }
+
+    void countedFree (void* p) noexcept
+    {
+        if (p == nullptr)
+            return;
+
+        auto* block = static_cast<unsigned char*> (p) - kHeader;
+        liveBytes.fetch_sub ((int64_t) *reinterpret_cast<std::size_t*> (block), std::memory_order_relaxed);
+        std::free (block);
+    }
+}
+
+AllocCounter::Snapshot AllocCounter::snapshot() noexcept
+{
+    return { allocatedBytes.load (std::memory_order_relaxed),
+             allocationCount.load (std::memory_order_relaxed),
+             liveBytes.load (std::memory_order_relaxed) };
+}
+
+// Aligned overloads are left to the runtime: they never route through these,
+// and nothing on the paint path uses over-aligned types.
+void* operator new (std::size_t size)
+{
+    if (auto* p = countedAlloc (size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    if (auto* p = countedAlloc (size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new   (std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc (size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc (size); }
+
+void operator delete   (void* p) noexcept                              { countedFree (p); }
+void operator delete[] (void* p) noexcept                              { countedFree (p); }
+void operator delete   (void* p, std::size_t) noexcept                 { countedFree (p); }
+void operator delete[] (void* p, std::size_t) noexcept                 { countedFree (p); }
+void operator delete   (void* p, const std::nothrow_t&) noexcept       { countedFree (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept       { countedFree (p); }
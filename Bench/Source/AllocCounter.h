@@ -0,0 +1,29 @@
+#pragma once
+
+// ============================================================================
+// AllocCounter.h — process-wide heap allocation counters for the bench
+//
+// AllocCounter.cpp replaces the global (non-aligned) operator new/delete set,
+// so every allocation made by JUCE or the plugin code is counted. Take a
+// snapshot before and after the region of interest and subtract.
+// ============================================================================
+
+#include <cstdint>
+
+namespace AllocCounter
+{
+    struct Snapshot
+    {
+        uint64_t bytes = 0;     // allocated, cumulative
+        uint64_t count = 0;
+        int64_t  live  = 0;     // allocated and not yet freed
+    };
+
+    Snapshot snapshot() noexcept;
+
+    inline Snapshot since (const Snapshot& start) noexcept
+    {
+        const auto now = snapshot();
+        return { now.bytes - start.bytes, now.count - start.count, now.live - start.live };
+    }
+}
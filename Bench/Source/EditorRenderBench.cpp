@@ -0,0 +1,147 @@
+#include "EditorRenderBench.h"
+#include "AllocCounter.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/PluginEditor.h"
+
+#include <algorithm>
+#include <vector>
+
+#if ! DISPTR_PERF_TRACE
+ #error "EditorRenderBench needs DISPTR_PERF_TRACE=1 for per-zone timings"
+#endif
+
+namespace
+{
+    // Spans the processor's stored UI size range; several of these are outside
+    // the interactive resize limits, which is the point (worst-case layouts).
+    constexpr std::pair<int, int> kSizes[] {
+        { 360, 360 }, { 480, 360 }, { 640, 480 }, { 800, 600 },
+        { 800, 760 }, { 1024, 768 }, { 1280, 960 }, { 1600, 1200 }
+    };
+
+    constexpr float kFrameDt = 1.0f / 60.0f;
+
+    struct Stats
+    {
+        double mean = 0.0, p95 = 0.0, max = 0.0;
+    };
+
+    Stats summarise (std::vector<double>& v)
+    {
+        Stats s;
+        if (v.empty())
+            return s;
+
+        std::sort (v.begin(), v.end());
+        double sum = 0.0;
+        for (auto x : v)
+            sum += x;
+
+        s.mean = sum / (double) v.size();
+        s.p95  = v[(size_t) juce::jlimit (0, (int) v.size() - 1, (int) std::ceil (0.95 * (double) v.size()) - 1)];
+        s.max  = v.back();
+        return s;
+    }
+}
+
+juce::String EditorRenderBench::getCsvHeader()
+{
+    return "width,height,crt,palette,io,frames,"
+           "frame_us_mean,frame_us_p95,frame_us_max,"
+           "paint_us_mean,paint_us_max,crt_us_mean,crt_us_max,"
+           "alloc_bytes_per_frame,allocs_per_frame\n";
+}
+
+bool EditorRenderBench::run (juce::OutputStream& csv)
+{
+    csv << getCsvHeader();
+
+    for (const auto& size : kSizes)
+        for (int crt = 0; crt < 2; ++crt)
+            for (int pal = 0; pal < 2; ++pal)
+                for (int io = 0; io < 2; ++io)
+                    if (! runConfig ({ size.first, size.second, crt != 0, pal != 0, io != 0 }, csv))
+                        return false;
+
+    csv.flush();
+    return true;
+}
+
+bool EditorRenderBench::runConfig (const Config& c, juce::OutputStream& csv)
+{
+    DisperserAudioProcessor processor;
+    processor.setUiFxTailEnabled (c.crtEnabled);
+    processor.setUiUseCustomPalette (c.customPalette);
+    processor.setUiIoExpanded (c.ioExpanded);
+
+    std::unique_ptr<DisperserAudioProcessorEditor> editor (
+        dynamic_cast<DisperserAudioProcessorEditor*> (processor.createEditor()));
+    if (editor == nullptr)
+        return false;
+
+    // Without a peer the async startup apply never runs; do it inline, then
+    // bypass the resize limits so every size in the grid is laid out.
+    editor->applyPersistedUiStateFromProcessor (false, true);
+    editor->setSize (c.width, c.height);
+
+    juce::Image frame (juce::Image::ARGB, c.width, c.height, true, juce::SoftwareImageType());
+    auto& trace = processor.perfTrace;
+
+    std::vector<double> frameUs, paintUs, crtUs;
+    frameUs.reserve ((size_t) options.measuredFrames);
+    paintUs.reserve ((size_t) options.measuredFrames);
+    crtUs.reserve ((size_t) options.measuredFrames);
+
+    uint64_t totalBytes = 0, totalAllocs = 0;
+    float crtTime = 0.0f;
+
+    for (int i = 0; i < options.warmupFrames + options.measuredFrames; ++i)
+    {
+        // Advance the CRT clock as the editor timer would, so the effect does
+        // full work instead of hitting its unchanged-frame early-out.
+        crtTime += kFrameDt;
+        editor->crtEffect.setTime (crtTime);
+        editor->repaint();
+        trace.endFrame();
+
+        const auto allocStart = AllocCounter::snapshot();
+        const auto t0 = juce::Time::getHighResolutionTicks();
+        {
+            juce::Graphics g (frame);
+            editor->paintEntireComponent (g, false);
+        }
+        const auto t1 = juce::Time::getHighResolutionTicks();
+        const auto allocs = AllocCounter::since (allocStart);
+        trace.endFrame();
+
+        if (i < options.warmupFrames)
+            continue;
+
+        frameUs.push_back (juce::Time::highResolutionTicksToSeconds (t1 - t0) * 1000000.0);
+        paintUs.push_back (trace.getHistoryUs (PerfTrace::EditorPaint, 0));
+        crtUs.push_back (trace.getHistoryUs (PerfTrace::CrtApply, 0));
+        totalBytes  += allocs.bytes;
+        totalAllocs += allocs.count;
+    }
+
+    const auto frameS = summarise (frameUs);
+    const auto paintS = summarise (paintUs);
+    const auto crtS   = summarise (crtUs);
+    const double n    = (double) juce::jmax (1, options.measuredFrames);
+
+    juce::String row;
+    row << c.width << "," << c.height << ","
+        << (c.crtEnabled ? 1 : 0) << ","
+        << (c.customPalette ? "custom" : "default") << ","
+        << (c.ioExpanded ? "expanded" : "collapsed") << ","
+        << options.measuredFrames << ","
+        << juce::String (frameS.mean, 1) << "," << juce::String (frameS.p95, 1) << "," << juce::String (frameS.max, 1) << ","
+        << juce::String (paintS.mean, 1) << "," << juce::String (paintS.max, 1) << ","
+        << juce::String (crtS.mean, 1) << "," << juce::String (crtS.max, 1) << ","
+        << juce::String ((double) totalBytes / n, 1) << ","
+        << juce::String ((double) totalAllocs / n, 2) << "\n";
+    csv << row;
+
+    editor.reset();
+    return true;
+}
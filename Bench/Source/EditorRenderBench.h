@@ -0,0 +1,45 @@
+#pragma once
+
+// ============================================================================
+// EditorRenderBench.h — headless editor rendering benchmark
+//
+// Builds a DisperserAudioProcessorEditor without a peer and renders it into a
+// software image, frame by frame, over a grid of sizes × CRT × palette × IO
+// section state. Per-frame paint and CRT time come from the PerfTrace zones
+// (the bench is built with DISPTR_PERF_TRACE=1); heap traffic comes from
+// AllocCounter. One CSV row is written per configuration.
+// ============================================================================
+
+#include <JuceHeader.h>
+
+class EditorRenderBench
+{
+public:
+    struct Options
+    {
+        int warmupFrames   = 10;
+        int measuredFrames = 120;
+    };
+
+    explicit EditorRenderBench (Options o) : options (o) {}
+
+    // Writes the CSV header plus one row per configuration. Returns false if
+    // the editor could not be created.
+    bool run (juce::OutputStream& csv);
+
+    static juce::String getCsvHeader();
+
+private:
+    struct Config
+    {
+        int  width;
+        int  height;
+        bool crtEnabled;
+        bool customPalette;
+        bool ioExpanded;
+    };
+
+    bool runConfig (const Config& c, juce::OutputStream& csv);
+
+    Options options;
+};
@@ -0,0 +1,175 @@
+#include "InstantiationBench.h"
+#include "AllocCounter.h"
+#include "../../Source/PluginProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr int kSteadyBlocks = 16;
+
+    struct Stats
+    {
+        double mean = 0.0, p95 = 0.0, max = 0.0;
+    };
+
+    Stats summarise (std::vector<double>& v)
+    {
+        Stats s;
+        if (v.empty())
+            return s;
+
+        std::sort (v.begin(), v.end());
+        double sum = 0.0;
+        for (auto x : v)
+            sum += x;
+
+        s.mean = sum / (double) v.size();
+        s.p95  = v[(size_t) juce::jlimit (0, (int) v.size() - 1, (int) std::ceil (0.95 * (double) v.size()) - 1)];
+        s.max  = v.back();
+        return s;
+    }
+
+    double elapsedUs (juce::int64 t0) noexcept
+    {
+        return juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - t0) * 1000000.0;
+    }
+
+    // A saved session rather than a default one: a handful of parameters off
+    // their defaults, so setStateInformation does real work.
+    juce::MemoryBlock makeSessionState()
+    {
+        DisperserAudioProcessor source;
+        for (auto* p : source.getParameters())
+        {
+            auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p);
+            if (ranged == nullptr)
+                continue;
+
+            const auto& id = ranged->paramID;
+            if (id == DisperserAudioProcessor::kParamAmount)      ranged->setValueNotifyingHost (0.6f);
+            else if (id == DisperserAudioProcessor::kParamSeries) ranged->setValueNotifyingHost (0.3f);
+            else if (id == DisperserAudioProcessor::kParamFreq)   ranged->setValueNotifyingHost (0.4f);
+            else if (id == DisperserAudioProcessor::kParamMix)    ranged->setValueNotifyingHost (0.8f);
+        }
+
+        juce::MemoryBlock state;
+        source.getStateInformation (state);
+        return state;
+    }
+}
+
+juce::String InstantiationBench::getCsvHeader()
+{
+    return "phase,instances,us_mean,us_p95,us_max,"
+           "alloc_bytes_per_instance,allocs_per_instance,heap_live_bytes_per_instance\n";
+}
+
+bool InstantiationBench::run (juce::OutputStream& csv)
+{
+    csv << getCsvHeader();
+
+    const int n = juce::jmax (1, options.numInstances);
+    const auto state = makeSessionState();
+    const auto heapStart = AllocCounter::snapshot();
+
+    std::vector<std::unique_ptr<DisperserAudioProcessor>> processors;
+    processors.reserve ((size_t) n);
+
+    std::vector<double> times;
+    times.reserve ((size_t) n);
+
+    // Times `step` once per instance, then writes the phase row. Heap columns
+    // are per instance: traffic during the phase, and what all instances hold
+    // afterwards relative to the start of the run.
+    auto runPhase = [&] (const char* phase, auto&& step)
+    {
+        times.clear();
+        const auto allocStart = AllocCounter::snapshot();
+
+        for (int i = 0; i < n; ++i)
+        {
+            const auto t0 = juce::Time::getHighResolutionTicks();
+            step (i);
+            times.push_back (elapsedUs (t0));
+        }
+
+        const auto allocs = AllocCounter::since (allocStart);
+        const auto s = summarise (times);
+
+        juce::String row;
+        row << phase << "," << n << ","
+            << juce::String (s.mean, 1) << "," << juce::String (s.p95, 1) << "," << juce::String (s.max, 1) << ","
+            << juce::String ((double) allocs.bytes / n, 0) << ","
+            << juce::String ((double) allocs.count / n, 1) << ","
+            << juce::String ((double) AllocCounter::since (heapStart).live / n, 0) << "\n";
+        csv << row;
+    };
+
+    // What a scanner does: construct, query, destroy. Nothing stays alive.
+    runPhase ("scan", [] (int)
+    {
+        auto p = std::make_unique<DisperserAudioProcessor>();
+        juce::ignoreUnused (p->getName(), p->getTailLengthSeconds(), p->getParameters().size());
+        for (int prog = 0; prog < p->getNumPrograms(); ++prog)
+            juce::ignoreUnused (p->getProgramName (prog));
+    });
+
+    runPhase ("construct", [&] (int)
+    {
+        processors.push_back (std::make_unique<DisperserAudioProcessor>());
+    });
+
+    runPhase ("set_state", [&] (int i)
+    {
+        processors[(size_t) i]->setStateInformation (state.getData(), (int) state.getSize());
+    });
+
+    runPhase ("prepare", [&] (int i)
+    {
+        auto& p = *processors[(size_t) i];
+        p.setRateAndBufferSizeDetails (options.sampleRate, options.blockSize);
+        p.prepareToPlay (options.sampleRate, options.blockSize);
+    });
+
+    juce::AudioBuffer<float> buffer (2, options.blockSize);
+    juce::MidiBuffer midi;
+    juce::Random rng (1);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        for (int s = 0; s < buffer.getNumSamples(); ++s)
+            buffer.setSample (ch, s, rng.nextFloat() * 0.5f - 0.25f);
+
+    // One buffer goes through every instance in turn; the cascade's cost does
+    // not depend on what is in it.
+    runPhase ("first_block", [&] (int i)
+    {
+        processors[(size_t) i]->processBlock (buffer, midi);
+    });
+
+    // For comparison with first_block: one block once every instance has
+    // settled (parameter smoothing done, any deferred allocation handed over).
+    for (auto& p : processors)
+        for (int b = 0; b < kSteadyBlocks; ++b)
+            p->processBlock (buffer, midi);
+
+    runPhase ("steady_block", [&] (int i)
+    {
+        processors[(size_t) i]->processBlock (buffer, midi);
+    });
+
+    runPhase ("release", [&] (int i)
+    {
+        processors[(size_t) i]->releaseResources();
+    });
+
+    runPhase ("destroy", [&] (int i)
+    {
+        processors[(size_t) i].reset();
+    });
+
+    csv.flush();
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// ============================================================================
+// InstantiationBench.h — what a session load and a plugin scan cost
+//
+// A host loading a session constructs every instance, hands it its state,
+// prepares it and runs a first block; a scanner constructs, queries and
+// destroys. This times each of those steps per instance over a batch (mean,
+// p95, max) and records the heap each step allocates and leaves live, so
+// constructor work and memory that only processing needs stand out. One CSV
+// row per phase.
+// ============================================================================
+
+#include <JuceHeader.h>
+
+class InstantiationBench
+{
+public:
+    struct Options
+    {
+        int    numInstances = 150;
+        double sampleRate   = 48000.0;
+        int    blockSize    = 512;
+    };
+
+    explicit InstantiationBench (Options o) : options (o) {}
+
+    // Writes the CSV header plus one row per phase.
+    bool run (juce::OutputStream& csv);
+
+    static juce::String getCsvHeader();
+
+private:
+    Options options;
+};
@@ -0,0 +1,159 @@
+// ============================================================================
+// DISP-TR bench — headless performance measurements
+//
+//   DISP-TR-Bench --ui [--frames N] [--warmup N] [--out file.csv]
+//   DISP-TR-Bench --memory [--instances N] [--block N] [--no-editor] [--out file.csv]
+//   DISP-TR-Bench --instantiate [--instances N] [--block N] [--out file.csv]
+//   DISP-TR-Bench --calibrate [--out file.csv]
+//
+// --calibrate times the cascade kernels on this machine and saves the profile
+// the plugin reads in prepareToPlay (see KernelTuning.h); the CSV lists the
+// fitted costs per ISA level. Other modes never measure a profile themselves.
+//
+// Results are CSV on stdout (or --out) so UI cost, instance memory and session
+// load time can be tracked over time the same way DSP cost is.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "EditorRenderBench.h"
+#include "MemoryBench.h"
+#include "InstantiationBench.h"
+#include "../../Source/KernelTuning.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "usage: DISP-TR-Bench --ui [--frames N] [--warmup N] [--out file.csv]\n"
+                     "       DISP-TR-Bench --memory [--instances N] [--block N] [--no-editor] [--out file.csv]\n"
+                     "       DISP-TR-Bench --instantiate [--instances N] [--block N] [--out file.csv]\n"
+                     "       DISP-TR-Bench --calibrate [--out file.csv]\n";
+    }
+
+    // "--name value" lookup; returns an empty string when absent.
+    juce::String getOptionValue (const juce::StringArray& args, const juce::String& name)
+    {
+        const int idx = args.indexOf (name);
+        return (idx >= 0 && idx + 1 < args.size()) ? args[idx + 1] : juce::String();
+    }
+
+    int getIntOption (const juce::StringArray& args, const juce::String& name, int def)
+    {
+        const auto v = getOptionValue (args, name);
+        return v.isNotEmpty() ? juce::jmax (1, v.getIntValue()) : def;
+    }
+
+    bool writeResult (const juce::StringArray& args, const juce::MemoryOutputStream& csv)
+    {
+        const auto path = getOptionValue (args, "--out");
+        if (path.isEmpty())
+        {
+            std::cout << csv.toString();
+            return true;
+        }
+
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile (path);
+        if (! file.replaceWithText (csv.toString()))
+        {
+            std::cerr << "could not write " << file.getFullPathName() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    bool runCalibration (juce::MemoryOutputStream& csv)
+    {
+        cost::Profile p;
+        juce::String error;
+        if (! KernelTuning::get().calibrate (p, error))
+        {
+            std::cerr << "calibration failed: " << error << "\n";
+            return false;
+        }
+
+        csv << "isa,kernel,ns_per_sample,ns_per_chunk\n";
+        const int host = (int) simd::detectHostIsa();
+        for (int i = 0; i <= host; ++i)
+        {
+            const juce::String isa (simd::getIsaName ((simd::Isa) i));
+            csv << isa << ",wavefront," << p.wavefrontNs[i] << "," << p.wavefrontChunkNs[i] << "\n"
+                << isa << ",scan,"      << p.scanNs[i]      << "," << p.scanChunkNs[i]      << "\n";
+        }
+
+        std::cerr << "saved " << KernelTuning::getProfileFile().getFullPathName()
+                  << " (" << KernelTuning::getMachineId() << ")\n";
+        return true;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add (juce::String::fromUTF8 (argv[i]));
+
+    const bool ui = args.contains ("--ui");
+    const bool memory = args.contains ("--memory");
+    const bool instantiate = args.contains ("--instantiate");
+    const bool calibrate = args.contains ("--calibrate");
+    if ((int) ui + (int) memory + (int) instantiate + (int) calibrate != 1)
+    {
+        printUsage();
+        return 1;
+    }
+
+    // Editors need the message manager, fonts and look-and-feel set up.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::MemoryOutputStream csv;
+
+    if (calibrate)
+        return runCalibration (csv) && writeResult (args, csv) ? 0 : 1;
+
+    // A profile measured in the background would compete with what is timed.
+    KernelTuning::get().setBackgroundMeasuring (false);
+
+    if (memory)
+    {
+        MemoryBench::Options opts;
+        opts.numInstances = getIntOption (args, "--instances", opts.numInstances);
+        opts.blockSize    = getIntOption (args, "--block", opts.blockSize);
+        opts.withEditor   = ! args.contains ("--no-editor");
+
+        if (! MemoryBench (opts).run (csv))
+        {
+            std::cerr << "memory bench failed\n";
+            return 1;
+        }
+
+        return writeResult (args, csv) ? 0 : 1;
+    }
+
+    if (instantiate)
+    {
+        InstantiationBench::Options opts;
+        opts.numInstances = getIntOption (args, "--instances", opts.numInstances);
+        opts.blockSize    = getIntOption (args, "--block", opts.blockSize);
+
+        if (! InstantiationBench (opts).run (csv))
+        {
+            std::cerr << "instantiation bench failed\n";
+            return 1;
+        }
+
+        return writeResult (args, csv) ? 0 : 1;
+    }
+
+    EditorRenderBench::Options opts;
+    opts.warmupFrames   = getIntOption (args, "--warmup", opts.warmupFrames);
+    opts.measuredFrames = getIntOption (args, "--frames", opts.measuredFrames);
+
+    if (! EditorRenderBench (opts).run (csv))
+    {
+        std::cerr << "editor render bench failed\n";
+        return 1;
+    }
+
+    return writeResult (args, csv) ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#include "MemoryBench.h"
+#include "AllocCounter.h"
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/PluginEditor.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr int kProcessBlocks = 16;
+
+    // Image pixels and MemoryBlocks come from juce::HeapBlock (malloc), which
+    // AllocCounter never sees; leave them out of the heap comparison.
+    size_t getOperatorNewBytes (const MemoryReport& r) noexcept
+    {
+        return r.getTotal() - r.get (MemoryReport::EditorImages) - r.get (MemoryReport::StateCache);
+    }
+}
+
+juce::String MemoryBench::getCsvHeader()
+{
+    juce::String h ("phase,instances");
+    for (int i = 0; i < MemoryReport::kNumSubsystems; ++i)
+        h << "," << juce::String (MemoryReport::getSubsystemName (i)).replaceCharacter (' ', '_');
+    h << ",tracked_bytes,heap_live_bytes,untracked_bytes\n";
+    return h;
+}
+
+bool MemoryBench::run (juce::OutputStream& csv)
+{
+    csv << getCsvHeader();
+
+    const int n = juce::jmax (1, options.numInstances);
+    const auto heapStart = AllocCounter::snapshot();
+
+    std::vector<std::unique_ptr<DisperserAudioProcessor>> processors;
+    std::vector<std::unique_ptr<juce::AudioProcessorEditor>> editors;
+
+    auto writePhase = [&] (const char* phase)
+    {
+        MemoryReport sum;
+        for (const auto& p : processors)
+        {
+            const auto r = p->getMemoryReport();
+            for (int i = 0; i < MemoryReport::kNumSubsystems; ++i)
+                sum.add ((MemoryReport::Subsystem) i, r.get (i));
+        }
+
+        const double heapLive = (double) AllocCounter::since (heapStart).live / n;
+        const double tracked  = (double) sum.getTotal() / n;
+
+        juce::String row;
+        row << phase << "," << n;
+        for (int i = 0; i < MemoryReport::kNumSubsystems; ++i)
+            row << "," << juce::String ((double) sum.get (i) / n, 0);
+        row << "," << juce::String (tracked, 0)
+            << "," << juce::String (heapLive, 0)
+            << "," << juce::String (heapLive - (double) getOperatorNewBytes (sum) / n, 0) << "\n";
+        csv << row;
+    };
+
+    for (int i = 0; i < n; ++i)
+        processors.push_back (std::make_unique<DisperserAudioProcessor>());
+    writePhase ("constructed");
+
+    for (auto& p : processors)
+        p->prepareToPlay (options.sampleRate, options.blockSize);
+    writePhase ("prepared");
+
+    juce::AudioBuffer<float> buffer (2, options.blockSize);
+    juce::MidiBuffer midi;
+    juce::Random rng (1);
+    for (auto& p : processors)
+    {
+        for (int b = 0; b < kProcessBlocks; ++b)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int s = 0; s < buffer.getNumSamples(); ++s)
+                    buffer.setSample (ch, s, rng.nextFloat() * 0.5f - 0.25f);
+            p->processBlock (buffer, midi);
+        }
+    }
+    writePhase ("processing");
+
+    if (options.withEditor)
+    {
+        for (auto& p : processors)
+        {
+            auto* editor = dynamic_cast<DisperserAudioProcessorEditor*> (p->createEditorAndMakeActive());
+            if (editor == nullptr)
+                return false;
+
+            // One software frame, so the buffered image and CRT buffers exist.
+            editor->applyPersistedUiStateFromProcessor (false, true);
+            juce::Image frame (juce::Image::ARGB, editor->getWidth(), editor->getHeight(), true, juce::SoftwareImageType());
+            juce::Graphics g (frame);
+            editor->paintEntireComponent (g, false);
+            editors.emplace_back (editor);
+        }
+        writePhase ("editor");
+        editors.clear();
+    }
+
+    csv.flush();
+    return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// ============================================================================
+// MemoryBench.h — per-instance memory, by subsystem and in total
+//
+// Creates a batch of processors and walks them through the life of a plugin
+// in a session: constructed, prepared, processing, editor open. After each
+// phase it averages the instances' MemoryReports and, from AllocCounter, the
+// live heap each one added, so the gap between what the report itemises and
+// what the heap actually holds is visible. One CSV row per phase.
+// ============================================================================
+
+#include <JuceHeader.h>
+
+class MemoryBench
+{
+public:
+    struct Options
+    {
+        int    numInstances = 16;
+        double sampleRate   = 48000.0;
+        int    blockSize    = 512;
+        bool   withEditor   = true;
+    };
+
+    explicit MemoryBench (Options o) : options (o) {}
+
+    // Writes the CSV header plus one row per phase.
+    bool run (juce::OutputStream& csv);
+
+    static juce::String getCsvHeader();
+
+private:
+    Options options;
+};
@@ -0,0 +1,57 @@
+// ============================================================================
+// DISP-TR CLAP entry — plugin factory for the single DISP-TR effect
+//
+// The shared library exports `clap_entry`; hosts look for it in ~/.clap
+// (Linux), %COMMONPROGRAMFILES%\CLAP (Windows) or ~/Library/Audio/Plug-Ins/CLAP
+// (macOS). JUCE is initialised once per load for the headless processor.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <clap/clap.h>
+#include <cstring>
+#include "ClapPlugin.h"
+
+namespace
+{
+    bool entryInit (const char*)
+    {
+        juce::initialiseJuce_GUI();
+        return true;
+    }
+
+    void entryDeinit()
+    {
+        juce::shutdownJuce_GUI();
+    }
+
+    const clap_plugin_factory factory
+    {
+        [] (const clap_plugin_factory*) -> uint32_t { return 1; },
+        [] (const clap_plugin_factory*, uint32_t index) -> const clap_plugin_descriptor*
+        {
+            return index == 0 ? &ClapPlugin::descriptor : nullptr;
+        },
+        [] (const clap_plugin_factory*, const clap_host* host, const char* pluginId) -> const clap_plugin*
+        {
+            if (! clap_version_is_compatible (host->clap_version)
+                || std::strcmp (pluginId, ClapPlugin::descriptor.id) != 0)
+                return nullptr;
+
+            // Owned by the host from here; clap_plugin::destroy deletes it.
+            return (new ClapPlugin (host))->getClapPlugin();
+        }
+    };
+
+    const void* getFactory (const char* factoryId)
+    {
+        return std::strcmp (factoryId, CLAP_PLUGIN_FACTORY_ID) == 0 ? &factory : nullptr;
+    }
+}
+
+extern "C" CLAP_EXPORT const clap_plugin_entry clap_entry
+{
+    CLAP_VERSION_INIT,
+    entryInit,
+    entryDeinit,
+    getFactory
+};
@@ -0,0 +1,526 @@
+#include "ClapPlugin.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr const char* kFeatures[] { CLAP_PLUGIN_FEATURE_AUDIO_EFFECT, CLAP_PLUGIN_FEATURE_FILTER,
+                                        CLAP_PLUGIN_FEATURE_PHASER, CLAP_PLUGIN_FEATURE_STEREO, nullptr };
+}
+
+const clap_plugin_descriptor ClapPlugin::descriptor
+{
+    CLAP_VERSION_INIT,
+    "com.nmstr.disp-tr",
+    JucePlugin_Name,
+    "NMSTR",
+    "", "", "",
+    "1.4.0",
+    "All-pass cascade disperser",
+    kFeatures
+};
+
+//==============================================================================
+// Extension tables: plain function pointers back into the instance.
+
+const clap_plugin_audio_ports ClapPlugin::audioPortsExtension
+{
+    [] (const clap_plugin*, bool) -> uint32_t { return 1; },
+    [] (const clap_plugin*, uint32_t index, bool isInput, clap_audio_port_info* info) -> bool
+    {
+        if (index != 0)
+            return false;
+        info->id = 0;
+        std::snprintf (info->name, sizeof (info->name), "%s", isInput ? "Input" : "Output");
+        info->flags = CLAP_AUDIO_PORT_IS_MAIN;
+        info->channel_count = 2;
+        info->port_type = CLAP_PORT_STEREO;
+        info->in_place_pair = 0;
+        return true;
+    }
+};
+
+const clap_plugin_note_ports ClapPlugin::notePortsExtension
+{
+    [] (const clap_plugin*, bool isInput) -> uint32_t { return isInput ? 1 : 0; },
+    [] (const clap_plugin*, uint32_t index, bool isInput, clap_note_port_info* info) -> bool
+    {
+        if (index != 0 || ! isInput)
+            return false;
+        info->id = 0;
+        info->supported_dialects = CLAP_NOTE_DIALECT_CLAP | CLAP_NOTE_DIALECT_MIDI;
+        info->preferred_dialect = CLAP_NOTE_DIALECT_CLAP;
+        std::snprintf (info->name, sizeof (info->name), "MIDI In");
+        return true;
+    }
+};
+
+const clap_plugin_params ClapPlugin::paramsExtension
+{
+    [] (const clap_plugin* p) -> uint32_t { return (uint32_t) from (p).params.size(); },
+    [] (const clap_plugin* p, uint32_t index, clap_param_info* info) -> bool { return from (p).getParamInfo (index, *info); },
+    [] (const clap_plugin* p, clap_id id, double* value) -> bool
+    {
+        auto* param = from (p).findParam (id);
+        if (param == nullptr)
+            return false;
+        *value = toClapValue (*param, param->getValue());
+        return true;
+    },
+    [] (const clap_plugin* p, clap_id id, double value, char* display, uint32_t size) -> bool
+    {
+        auto* param = from (p).findParam (id);
+        if (param == nullptr || size == 0)
+            return false;
+        auto text = param->getText (fromClapValue (*param, value), (int) size - 1);
+        if (param->getLabel().isNotEmpty())
+            text << " " << param->getLabel();
+        text.copyToUTF8 (display, size);
+        return true;
+    },
+    [] (const clap_plugin* p, clap_id id, const char* display, double* value) -> bool
+    {
+        auto* param = from (p).findParam (id);
+        if (param == nullptr)
+            return false;
+        *value = toClapValue (*param, param->getValueForText (juce::String::fromUTF8 (display)));
+        return true;
+    },
+    [] (const clap_plugin* p, const clap_input_events* in, const clap_output_events* out)
+    {
+        // Only parameter changes matter outside process(); notes are dropped.
+        auto& self = from (p);
+        for (uint32_t i = 0, n = in->size (in); i < n; ++i)
+        {
+            const auto* ev = in->get (in, i);
+            if (ev->space_id == CLAP_CORE_EVENT_SPACE_ID && ev->type == CLAP_EVENT_PARAM_VALUE)
+                self.applyEvent (*ev, 0);
+        }
+        self.reportParamChanges (out, 0);
+    }
+};
+
+const clap_plugin_state ClapPlugin::stateExtension
+{
+    [] (const clap_plugin* p, const clap_ostream* stream) -> bool { return from (p).saveState (*stream); },
+    [] (const clap_plugin* p, const clap_istream* stream) -> bool { return from (p).loadState (*stream); }
+};
+
+const clap_plugin_thread_pool ClapPlugin::threadPoolExtension
+{
+    [] (const clap_plugin* p, uint32_t taskIndex) { from (p).processor.runDspTask ((int) taskIndex); }
+};
+
+//==============================================================================
+ClapPlugin::ClapPlugin (const clap_host* h)
+    : host (h)
+{
+    plugin.desc = &descriptor;
+    plugin.plugin_data = this;
+    plugin.init = [] (const clap_plugin* p) { return from (p).init(); };
+    plugin.destroy = [] (const clap_plugin* p) { delete &from (p); };
+    plugin.activate = [] (const clap_plugin* p, double sampleRate, uint32_t, uint32_t maxFrames)
+    {
+        return from (p).activate (sampleRate, maxFrames);
+    };
+    plugin.deactivate = [] (const clap_plugin* p) { from (p).processor.releaseResources(); };
+    plugin.start_processing = [] (const clap_plugin*) { return true; };
+    plugin.stop_processing = [] (const clap_plugin*) {};
+    plugin.reset = [] (const clap_plugin* p) { from (p).processor.reset(); };
+    plugin.process = [] (const clap_plugin* p, const clap_process* process) { return from (p).process (*process); };
+    plugin.get_extension = [] (const clap_plugin* p, const char* id) { return from (p).getExtension (id); };
+    plugin.on_main_thread = [] (const clap_plugin* p) { from (p).processor.buildRequestedDelayArena(); };
+}
+
+clap_id ClapPlugin::getParamId (const juce::RangedAudioParameter& param) noexcept
+{
+    // Stable across builds and sessions as long as the string ID is.
+    return (clap_id) (param.getParameterID().hashCode() & 0x7fffffff);
+}
+
+bool ClapPlugin::init()
+{
+    for (auto* p : processor.getParameters())
+    {
+        if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p))
+        {
+            // Hosts store these IDs in sessions, so two parameters must never
+            // share one. A collision fails to load in every build, and a
+            // renamed parameter fixes it before it ships.
+            const auto id = getParamId (*ranged);
+            if (! paramIndexById.emplace (id, (uint32_t) params.size()).second)
+            {
+                jassertfalse;
+                return false;
+            }
+            params.push_back (ranged);
+        }
+    }
+    reportedValues.resize (params.size());
+    markParamsReported();
+
+    if (host->get_extension != nullptr)
+    {
+        hostThreadPool = static_cast<const clap_host_thread_pool*> (host->get_extension (host, CLAP_EXT_THREAD_POOL));
+        hostParams = static_cast<const clap_host_params*> (host->get_extension (host, CLAP_EXT_PARAMS));
+    }
+
+    processor.setPlayHead (&playHead);
+
+    return true;
+}
+
+bool ClapPlugin::activate (double sampleRate, uint32_t maxFrames)
+{
+    playHead.sampleRate = sampleRate;
+    transportRunning = false;
+    processor.setRateAndBufferSizeDetails (sampleRate, (int) maxFrames);
+    processor.prepareToPlay (sampleRate, (int) maxFrames);
+    midi.ensureSize (4096);
+    paramChanges.reserve (kMaxParamChanges);
+
+    if (hostThreadPool != nullptr && hostThreadPool->request_exec != nullptr)
+        processor.setDspTaskExecutor (&ClapPlugin::requestTasks, this);
+
+    return true;
+}
+
+bool ClapPlugin::requestTasks (void* context, int numTasks) noexcept
+{
+    auto& self = *static_cast<ClapPlugin*> (context);
+    return self.hostThreadPool->request_exec (self.host, (uint32_t) numTasks);
+}
+
+const void* ClapPlugin::getExtension (const char* id) const noexcept
+{
+    if (std::strcmp (id, CLAP_EXT_AUDIO_PORTS) == 0) return &audioPortsExtension;
+    if (std::strcmp (id, CLAP_EXT_NOTE_PORTS) == 0)  return &notePortsExtension;
+    if (std::strcmp (id, CLAP_EXT_PARAMS) == 0)      return &paramsExtension;
+    if (std::strcmp (id, CLAP_EXT_STATE) == 0)       return &stateExtension;
+    if (std::strcmp (id, CLAP_EXT_THREAD_POOL) == 0) return &threadPoolExtension;
+    return nullptr;
+}
+
+//==============================================================================
+clap_process_status ClapPlugin::process (const clap_process& p) noexcept
+{
+    juce::ScopedNoDenormals noDenormals;
+
+    if (p.audio_outputs_count < 1 || p.audio_outputs[0].data32 == nullptr)
+        return CLAP_PROCESS_ERROR;
+
+    const auto& out = p.audio_outputs[0];
+    const uint32_t frames = p.frames_count;
+    const int numChannels = (int) juce::jmin (out.channel_count, 2u);
+
+    // The processor works in place, so the input is copied onto the output
+    // unless the host already shares the buffers. A mono input feeds both sides.
+    const bool hasInput = p.audio_inputs_count > 0 && p.audio_inputs[0].channel_count > 0
+                       && p.audio_inputs[0].data32 != nullptr;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* dest = out.data32[ch];
+        if (! hasInput)
+        {
+            std::fill (dest, dest + frames, 0.0f);
+            continue;
+        }
+
+        const auto& in = p.audio_inputs[0];
+        const float* src = in.data32[juce::jmin ((uint32_t) ch, in.channel_count - 1)];
+        if (src != dest)
+            std::copy (src, src + frames, dest);
+    }
+
+    updatePlayHead (p.transport, frames);
+
+    // One processBlock per call: parameter changes go in as timed changes and
+    // notes through the MIDI buffer, and the processor splits the engine run
+    // at both, so each lands on its own sample.
+    const auto* events = p.in_events;
+    midi.clear();
+    paramChanges.clear();
+
+    for (uint32_t i = 0, n = events->size (events); i < n; ++i)
+    {
+        const auto* ev = events->get (events, i);
+        if (ev->space_id != CLAP_CORE_EVENT_SPACE_ID)
+            continue;
+
+        const int t = (int) juce::jmin (ev->time, frames);
+        if (ev->type == CLAP_EVENT_PARAM_VALUE && paramChanges.size() < paramChanges.capacity())
+            queueParamChange (reinterpret_cast<const clap_event_param_value&> (*ev), t);
+        else
+            applyEvent (*ev, t);   // a flood past the reserve lands at the block start
+    }
+
+    // Refers to the host's memory; no allocation.
+    float* channels[2] {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        channels[ch] = out.data32[ch];
+    juce::AudioBuffer<float> buffer (channels, numChannels, (int) frames);
+    processor.processBlockWithParamChanges (buffer, midi, paramChanges.data(), (int) paramChanges.size());
+
+    // Values the processor set itself (a recalled preset lands at the start
+    // of the block), reported at its end.
+    if (frames > 0)
+        reportParamChanges (p.out_events, frames - 1);
+
+    // No JUCE message loop runs here, so DELAY rings are built in on_main_thread.
+    if (processor.isDelayArenaRequested() && host->request_callback != nullptr)
+        host->request_callback (host);
+
+    return CLAP_PROCESS_CONTINUE;
+}
+
+void ClapPlugin::queueParamChange (const clap_event_param_value& pv, int sampleOffset) noexcept
+{
+    const int index = findParamIndex (pv.param_id);
+    if (index < 0)
+        return;
+
+    auto* param = params[(size_t) index];
+    const float v = fromClapValue (*param, pv.value);
+    paramChanges.push_back ({ sampleOffset, param->getParameterIndex(), v });
+    reportedValues[(size_t) index] = v;   // the host's own change, not echoed
+}
+
+void ClapPlugin::applyEvent (const clap_event_header& ev, int sampleOffset) noexcept
+{
+    switch (ev.type)
+    {
+        case CLAP_EVENT_PARAM_VALUE:
+        {
+            const auto& pv = reinterpret_cast<const clap_event_param_value&> (ev);
+            const int index = findParamIndex (pv.param_id);
+            if (index < 0)
+                break;
+
+            // Same as JUCE's own wrappers: set, then tell the APVTS.
+            auto* param = params[(size_t) index];
+            const float v = fromClapValue (*param, pv.value);
+            if (param->getValue() != v)
+            {
+                param->setValue (v);
+                param->sendValueChangedMessageToListeners (v);
+            }
+            reportedValues[(size_t) index] = v;   // the host's own change, not echoed
+            break;
+        }
+
+        case CLAP_EVENT_NOTE_ON:
+        case CLAP_EVENT_NOTE_OFF:
+        {
+            const auto& note = reinterpret_cast<const clap_event_note&> (ev);
+            if (note.key < 0 || note.key > 127)
+                break;
+            const int channel = juce::jlimit (1, 16, note.channel + 1);   // −1 (any) → 1
+            const auto velocity = (float) juce::jlimit (0.0, 1.0, note.velocity);
+            midi.addEvent (ev.type == CLAP_EVENT_NOTE_ON ? juce::MidiMessage::noteOn (channel, note.key, velocity)
+                                                         : juce::MidiMessage::noteOff (channel, note.key, velocity),
+                           sampleOffset);
+            break;
+        }
+
+        case CLAP_EVENT_MIDI:
+        {
+            const auto& m = reinterpret_cast<const clap_event_midi&> (ev);
+            if (m.data[0] >= 0x80)
+                midi.addEvent (juce::MidiMessage (m.data[0], m.data[1], m.data[2]), sampleOffset);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+int ClapPlugin::findParamIndex (clap_id id) const noexcept
+{
+    const auto it = paramIndexById.find (id);
+    return it != paramIndexById.end() ? (int) it->second : -1;
+}
+
+juce::RangedAudioParameter* ClapPlugin::findParam (clap_id id) const noexcept
+{
+    const int index = findParamIndex (id);
+    return index >= 0 ? params[(size_t) index] : nullptr;
+}
+
+bool ClapPlugin::getParamInfo (uint32_t index, clap_param_info& info) const
+{
+    if (index >= params.size())
+        return false;
+
+    const auto* param = params[index];
+    info = {};
+    info.id = getParamId (*param);
+    info.flags = CLAP_PARAM_IS_AUTOMATABLE | (isStepped (*param) ? CLAP_PARAM_IS_STEPPED : 0u);
+    info.cookie = nullptr;
+    param->getName (CLAP_NAME_SIZE - 1).copyToUTF8 (info.name, CLAP_NAME_SIZE);
+    info.min_value = toClapValue (*param, 0.0f);
+    info.max_value = toClapValue (*param, 1.0f);
+    info.default_value = toClapValue (*param, param->getDefaultValue());
+    return true;
+}
+
+bool ClapPlugin::isStepped (const juce::RangedAudioParameter& param) noexcept
+{
+    return dynamic_cast<const juce::AudioParameterInt*> (&param) != nullptr
+        || dynamic_cast<const juce::AudioParameterChoice*> (&param) != nullptr
+        || dynamic_cast<const juce::AudioParameterBool*> (&param) != nullptr;
+}
+
+double ClapPlugin::toClapValue (const juce::RangedAudioParameter& param, float normalised) noexcept
+{
+    if (! isStepped (param))
+        return normalised;
+    return std::round (param.convertFrom0to1 (juce::jlimit (0.0f, 1.0f, normalised)));
+}
+
+float ClapPlugin::fromClapValue (const juce::RangedAudioParameter& param, double value) noexcept
+{
+    if (! isStepped (param))
+        return (float) juce::jlimit (0.0, 1.0, value);
+    return param.convertTo0to1 ((float) value);
+}
+
+//==============================================================================
+void ClapPlugin::reportParamChanges (const clap_output_events* out, uint32_t time) noexcept
+{
+    if (out == nullptr)
+        return;
+
+    for (size_t i = 0; i < params.size(); ++i)
+    {
+        const float v = params[i]->getValue();
+        if (v == reportedValues[i])
+            continue;
+
+        clap_event_param_value ev {};
+        ev.header.size = sizeof (ev);
+        ev.header.time = time;
+        ev.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
+        ev.header.type = CLAP_EVENT_PARAM_VALUE;
+        ev.header.flags = 0;
+        ev.param_id = getParamId (*params[i]);
+        ev.cookie = nullptr;
+        ev.note_id = -1;
+        ev.port_index = -1;
+        ev.channel = -1;
+        ev.key = -1;
+        ev.value = toClapValue (*params[i], v);
+
+        // A full queue retries at the next block.
+        if (out->try_push (out, &ev.header))
+            reportedValues[i] = v;
+    }
+}
+
+void ClapPlugin::markParamsReported() noexcept
+{
+    for (size_t i = 0; i < params.size(); ++i)
+        reportedValues[i] = params[i]->getValue();
+}
+
+//==============================================================================
+void ClapPlugin::updatePlayHead (const clap_event_transport* transport, uint32_t frames) noexcept
+{
+    playHead.transport = transport;
+
+    const bool hasSeconds = transport != nullptr && (transport->flags & CLAP_TRANSPORT_HAS_SECONDS_TIMELINE) != 0;
+    const bool playing = hasSeconds && (transport->flags & CLAP_TRANSPORT_IS_PLAYING) != 0;
+    if (! hasSeconds)
+    {
+        transportRunning = false;
+        return;
+    }
+
+    // CLAP has no sample position, only fixed-point seconds. Keep a running
+    // transport exact, so the processor's loop detection sees no false jumps.
+    const auto seconds = (double) transport->song_pos_seconds / (double) CLAP_SECTIME_FACTOR;
+    const auto computed = (juce::int64) std::llround (seconds * playHead.sampleRate);
+    playHead.blockStartSample = transportRunning && playing && std::abs (computed - nextBlockSample) <= 1
+                              ? nextBlockSample : computed;
+    nextBlockSample = playHead.blockStartSample + frames;
+    transportRunning = playing;
+}
+
+juce::Optional<juce::AudioPlayHead::PositionInfo> ClapPlugin::PlayHead::getPosition() const
+{
+    if (transport == nullptr)
+        return {};
+
+    const auto& t = *transport;
+    const auto beats = [] (clap_beattime b) { return (double) b / (double) CLAP_BEATTIME_FACTOR; };
+
+    PositionInfo info;
+    info.setIsPlaying ((t.flags & CLAP_TRANSPORT_IS_PLAYING) != 0);
+    info.setIsRecording ((t.flags & CLAP_TRANSPORT_IS_RECORDING) != 0);
+    info.setIsLooping ((t.flags & CLAP_TRANSPORT_IS_LOOP_ACTIVE) != 0);
+
+    if ((t.flags & CLAP_TRANSPORT_HAS_TEMPO) != 0)
+        info.setBpm (t.tempo);
+    if ((t.flags & CLAP_TRANSPORT_HAS_TIME_SIGNATURE) != 0)
+        info.setTimeSignature (juce::AudioPlayHead::TimeSignature { t.tsig_num, t.tsig_denom });
+
+    if ((t.flags & CLAP_TRANSPORT_HAS_SECONDS_TIMELINE) != 0)
+    {
+        info.setTimeInSeconds ((double) t.song_pos_seconds / (double) CLAP_SECTIME_FACTOR);
+        info.setTimeInSamples (blockStartSample);
+    }
+
+    if ((t.flags & CLAP_TRANSPORT_HAS_BEATS_TIMELINE) != 0)
+    {
+        info.setPpqPosition (beats (t.song_pos_beats));
+        info.setPpqPositionOfLastBarStart (beats (t.bar_start));
+        info.setBarCount (t.bar_number);
+        info.setLoopPoints (juce::AudioPlayHead::LoopPoints { beats (t.loop_start_beats), beats (t.loop_end_beats) });
+    }
+
+    return info;
+}
+
+//==============================================================================
+bool ClapPlugin::saveState (const clap_ostream& stream)
+{
+    juce::MemoryBlock data;
+    processor.getStateInformation (data);
+
+    const auto* bytes = static_cast<const char*> (data.getData());
+    for (size_t written = 0; written < data.getSize();)
+    {
+        const int64_t n = stream.write (&stream, bytes + written, data.getSize() - written);
+        if (n <= 0)
+            return false;
+        written += (size_t) n;
+    }
+    return true;
+}
+
+bool ClapPlugin::loadState (const clap_istream& stream)
+{
+    juce::MemoryOutputStream data;
+    char chunk[4096];
+    for (;;)
+    {
+        const int64_t n = stream.read (&stream, chunk, sizeof (chunk));
+        if (n < 0)
+            return false;
+        if (n == 0)
+            break;
+        data.write (chunk, (size_t) n);
+    }
+
+    processor.setStateInformation (data.getData(), (int) data.getDataSize());
+
+    // The host re-reads every value after a state load.
+    markParamsReported();
+    if (hostParams != nullptr)
+        hostParams->rescan (host, CLAP_PARAM_RESCAN_VALUES);
+    return true;
+}
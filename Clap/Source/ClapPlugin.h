@@ -0,0 +1,109 @@
+#pragma once
+
+// ============================================================================
+// ClapPlugin.h — DISP-TR as a CLAP plugin
+//
+// JUCE 8 has no CLAP wrapper, so this talks to the CLAP ABI directly and runs
+// the regular DisperserAudioProcessor headless inside it (hosts show their
+// generic parameter UI). Parameters are the processor's, by hashed string ID
+// and normalised 0..1 value, and state is the processor's own blob, so
+// sessions and presets move freely between the CLAP and VST3 builds.
+//
+// Int, choice and bool parameters are stepped and use their plain integer
+// range instead, since CLAP truncates stepped values to integers. Changes the
+// processor makes itself (preset recall) go back to the host as parameter
+// out-events. The host transport reaches the processor as its AudioPlayHead.
+//
+// Extensions: audio-ports, note-ports, params, state and thread-pool. With a
+// host thread pool, the engine's per-channel cascade work in one process call
+// goes to the host's workers (see DisperserEngine::setTaskExecutor). No JUCE
+// message loop is assumed: work the processor defers to the main thread (the
+// lazy DELAY rings) runs in on_main_thread, via host->request_callback.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <clap/clap.h>
+#include <unordered_map>
+#include <vector>
+#include "../../Source/PluginProcessor.h"
+
+class ClapPlugin
+{
+public:
+    static const clap_plugin_descriptor descriptor;
+
+    explicit ClapPlugin (const clap_host* host);
+
+    const clap_plugin* getClapPlugin() const noexcept { return &plugin; }
+
+private:
+    static ClapPlugin& from (const clap_plugin* p) noexcept { return *static_cast<ClapPlugin*> (p->plugin_data); }
+    static clap_id getParamId (const juce::RangedAudioParameter& param) noexcept;
+
+    bool init();
+    bool activate (double sampleRate, uint32_t maxFrames);
+    clap_process_status process (const clap_process& p) noexcept;
+    const void* getExtension (const char* id) const noexcept;
+
+    // Parameter values and notes; notes go into `midi` at `sampleOffset`.
+    void applyEvent (const clap_event_header& ev, int sampleOffset) noexcept;
+    // A parameter value for the processor to apply at `sampleOffset` of this block.
+    void queueParamChange (const clap_event_param_value& pv, int sampleOffset) noexcept;
+
+    int findParamIndex (clap_id id) const noexcept;
+    juce::RangedAudioParameter* findParam (clap_id id) const noexcept;
+    bool getParamInfo (uint32_t index, clap_param_info& info) const;
+
+    // CLAP values: normalised 0..1, or the plain integer for stepped params.
+    static bool isStepped (const juce::RangedAudioParameter& param) noexcept;
+    static double toClapValue (const juce::RangedAudioParameter& param, float normalised) noexcept;
+    static float fromClapValue (const juce::RangedAudioParameter& param, double value) noexcept;
+
+    // Sends CLAP_EVENT_PARAM_VALUE for every value the host has not seen.
+    void reportParamChanges (const clap_output_events* out, uint32_t time) noexcept;
+    void markParamsReported() noexcept;
+
+    void updatePlayHead (const clap_event_transport* transport, uint32_t frames) noexcept;
+
+    bool saveState (const clap_ostream& stream);
+    bool loadState (const clap_istream& stream);
+
+    // DisperserEngine::TaskExecutor → clap_host_thread_pool::request_exec.
+    static bool requestTasks (void* context, int numTasks) noexcept;
+
+    static const clap_plugin_audio_ports audioPortsExtension;
+    static const clap_plugin_note_ports  notePortsExtension;
+    static const clap_plugin_params      paramsExtension;
+    static const clap_plugin_state       stateExtension;
+    static const clap_plugin_thread_pool threadPoolExtension;
+
+    // clap_process::transport for the processor.
+    struct PlayHead : public juce::AudioPlayHead
+    {
+        juce::Optional<PositionInfo> getPosition() const override;
+
+        const clap_event_transport* transport = nullptr;   // null: free running
+        double sampleRate = 44100.0;
+        juce::int64 blockStartSample = 0;
+    };
+
+    clap_plugin plugin {};
+    const clap_host* host = nullptr;
+    const clap_host_thread_pool* hostThreadPool = nullptr;
+    const clap_host_params* hostParams = nullptr;
+
+    PlayHead playHead;
+    bool transportRunning = false;
+    juce::int64 nextBlockSample = 0;
+
+    DisperserAudioProcessor processor;
+    std::vector<juce::RangedAudioParameter*> params;
+    std::vector<float> reportedValues;   // normalised, per params index; audio thread once active
+    std::unordered_map<clap_id, uint32_t> paramIndexById;
+    juce::MidiBuffer midi;
+
+    static constexpr size_t kMaxParamChanges = 4096;   // per process call, reserved in activate
+    std::vector<DisperserAudioProcessor::ParamChange> paramChanges;
+
+    JUCE_DECLARE_NON_COPYABLE (ClapPlugin)
+};
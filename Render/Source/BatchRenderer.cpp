@@ -0,0 +1,714 @@
+#include "BatchRenderer.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <vector>
+
+namespace
+{
+    double sumOfSquares (const juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+    {
+        double sum = 0.0;
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            const float* data = buffer.getReadPointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                sum += (double) data[i] * (double) data[i];
+        }
+        return sum;
+    }
+
+    juce::int64 roundUp (juce::int64 v, juce::int64 multiple) noexcept
+    {
+        return (v + multiple - 1) / multiple * multiple;
+    }
+}
+
+//==============================================================================
+// Per split file: part files and measurements filled in by whichever workers
+// render the segments; the worker that finishes the last one joins them.
+struct BatchRenderer::SplitState
+{
+    std::vector<std::unique_ptr<juce::TemporaryFile>> parts;
+    std::vector<double>       inEnergy, outEnergy;
+    std::vector<juce::String> errors;
+    std::vector<double>       startMs;
+    std::atomic<int>          remaining { 0 };
+};
+
+struct BatchRenderer::RunState
+{
+    juce::Array<Job>     jobs;
+    std::vector<Segment> segments;
+    std::vector<Result>  results;
+    std::vector<std::unique_ptr<SplitState>> splits;   // null for whole-file jobs
+    std::atomic<int>     next { 0 };
+    std::ostream&        log;
+    juce::CriticalSection logLock;
+
+    explicit RunState (std::ostream& l) : log (l) {}
+};
+
+//==============================================================================
+class BatchRenderer::Worker : public juce::ThreadPoolJob
+{
+public:
+    Worker (const BatchRenderer& o, RunState& s)
+        : juce::ThreadPoolJob ("render worker"), owner (o), state (s)
+    {
+        formats.registerBasicFormats();
+        engine.setCostProfile (owner.options.costProfile);
+    }
+
+    JobStatus runJob() override
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        for (int i = state.next.fetch_add (1); i < (int) state.segments.size() && ! shouldExit();
+             i = state.next.fetch_add (1))
+        {
+            const auto& seg = state.segments[(size_t) i];
+            const auto& job = state.jobs.getReference (seg.job);
+            auto& result = state.results[(size_t) seg.job];
+
+            if (seg.numSegments == 1)
+            {
+                result = owner.renderFile (engine, formats, job);
+            }
+            else
+            {
+                auto& split = *state.splits[(size_t) seg.job];
+                owner.renderSegment (engine, formats, job, seg, split);
+                if (split.remaining.fetch_sub (1) != 1)
+                    continue;
+
+                result = owner.joinSegments (engine, formats, job, split);
+            }
+
+            report (job, result);
+        }
+
+        return jobHasFinished;
+    }
+
+private:
+    void report (const Job& job, const Result& result)
+    {
+        const juce::ScopedLock sl (state.logLock);
+        auto& log = state.log;
+        if (result.ok)
+        {
+            log << "ok    " << job.input.getFileName() << "  "
+                << juce::String (result.seconds, 2) << " s";
+            if (result.segments > 1)
+                log << "  " << result.segments << " segments";
+            if (owner.options.gainMatch)
+                log << "  gain " << juce::String (result.gainDb, 2) << " dB";
+            if (result.segments > 1 && owner.options.verify)
+                log << "  null " << juce::String (result.nullDb, 1) << " dBFS";
+            log << "\n";
+        }
+        else
+        {
+            log << "FAIL  " << job.input.getFileName() << ": " << result.error << "\n";
+        }
+    }
+
+    const BatchRenderer& owner;
+    RunState& state;
+
+    juce::AudioFormatManager formats;
+    DisperserEngine engine;
+};
+
+//==============================================================================
+BatchRenderer::BatchRenderer (const DisperserEngine::Params& p, Options o)
+    : params (p), options (std::move (o))
+{
+    options.numWorkers = juce::jmax (1, options.numWorkers);
+    options.chunkSize  = juce::jmax (256, options.chunkSize);
+}
+
+juce::File BatchRenderer::getOutputFile (const juce::File& input) const
+{
+    return options.outputDir.getChildFile (input.getFileName());
+}
+
+juce::Array<BatchRenderer::Job> BatchRenderer::scanInputs (const juce::Array<juce::File>& inputs, std::ostream& log) const
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    juce::Array<Job> jobs;
+    for (const auto& file : inputs)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+        if (reader == nullptr)
+        {
+            log << "skip  " << file.getFileName() << ": not a readable audio file\n";
+            continue;
+        }
+
+        if ((int) reader->numChannels > DisperserEngine::kMaxChannels)
+        {
+            log << "skip  " << file.getFileName() << ": " << (int) reader->numChannels
+                << " channels (mono and stereo only)\n";
+            continue;
+        }
+
+        const auto out = getOutputFile (file);
+        if (out == file)
+        {
+            log << "skip  " << file.getFileName() << ": output would replace the input\n";
+            continue;
+        }
+
+        if (out.exists() && ! options.overwrite)
+        {
+            log << "skip  " << file.getFileName() << ": " << out.getFullPathName()
+                << " exists (use --overwrite)\n";
+            continue;
+        }
+
+        jobs.add ({ file, reader->lengthInSamples, reader->sampleRate, (int) reader->numChannels });
+    }
+
+    // Longest first: the last job to start is a short one, so workers finish together.
+    std::stable_sort (jobs.begin(), jobs.end(), [] (const Job& a, const Job& b)
+    {
+        return a.lengthInSamples > b.lengthInSamples;
+    });
+
+    return jobs;
+}
+
+std::vector<BatchRenderer::Segment> BatchRenderer::planSegments (const juce::Array<Job>& jobs, std::ostream& log) const
+{
+    // Segment starts sit on the chunk grid (so the tilt ramp steps line up)
+    // and on the coefficient update grid (so modulated coefficients do).
+    const juce::int64 align = std::lcm ((juce::int64) options.chunkSize,
+                                        (juce::int64) DisperserEngine::kCoeffUpdateInterval);
+    const bool split = options.segmentSeconds > 0.0
+                    || (options.segmentSeconds == 0.0 && jobs.size() < options.numWorkers);
+    const int share = juce::jmax (1, options.numWorkers / juce::jmax (1, jobs.size()));
+
+    std::vector<Segment> segments;
+    for (int j = 0; j < jobs.size(); ++j)
+    {
+        const auto& job = jobs.getReference (j);
+        const double sr = job.sampleRate;
+
+        juce::int64 segLen = job.lengthInSamples, preRoll = 0;
+        int numSegments = 1;
+        const double tail = split ? DisperserEngine::estimateTailSeconds (params, sr) : 0.0;
+
+        // At the cap the state never settles (feedback at or near ±1), so no
+        // pre-roll would make the joins match a serial render.
+        if (split && tail >= DisperserEngine::kMaxTailSeconds)
+            log << "whole " << job.input.getFileName() << ": the tail does not decay, so it is not split\n";
+        else if (split)
+        {
+            preRoll = roundUp ((juce::int64) std::ceil (tail * sr), align);
+
+            if (options.segmentSeconds > 0.0)
+                segLen = (juce::int64) (options.segmentSeconds * sr);
+            else    // auto: one segment per spare worker, but long enough that pre-roll stays a small overhead
+                segLen = juce::jmax (job.lengthInSamples / share,
+                                     (juce::int64) (kMinSegmentSeconds * sr), 4 * preRoll);
+
+            segLen = roundUp (juce::jmax ((juce::int64) 1, segLen), align);
+            numSegments = (int) juce::jmax ((juce::int64) 1, (job.lengthInSamples + segLen - 1) / segLen);
+        }
+
+        if (numSegments == 1)
+        {
+            segments.push_back ({ j, 0, 1, 0, job.lengthInSamples, 0 });
+            continue;
+        }
+
+        for (int k = 0; k < numSegments; ++k)
+        {
+            const juce::int64 start = k * segLen;
+            segments.push_back ({ j, k, numSegments, start,
+                                  juce::jmin (job.lengthInSamples, start + segLen),
+                                  juce::jmin (start, preRoll) });
+        }
+    }
+
+    std::stable_sort (segments.begin(), segments.end(), [] (const Segment& a, const Segment& b)
+    {
+        return a.end - a.start + a.preRoll > b.end - b.start + b.preRoll;
+    });
+
+    return segments;
+}
+
+//==============================================================================
+bool BatchRenderer::renderPass (DisperserEngine& engine, juce::AudioFormatReader& reader,
+                                juce::int64 start, juce::int64 end, juce::int64 preRoll,
+                                juce::AudioFormatWriter* writer, float gain,
+                                double& inEnergy, double& outEnergy, juce::String& error) const
+{
+    const int numChannels = (int) reader.numChannels;
+    juce::AudioBuffer<float> buffer (numChannels, options.chunkSize);
+
+    engine.prepare (reader.sampleRate, options.chunkSize, params);
+    engine.skipAhead (start - preRoll, params);
+
+    // start and preRoll are multiples of the chunk size, so no chunk straddles
+    // the end of the pre-roll.
+    for (juce::int64 pos = start - preRoll; pos < end; pos += options.chunkSize)
+    {
+        const int n = (int) juce::jmin ((juce::int64) options.chunkSize, end - pos);
+
+        if (! reader.read (&buffer, 0, n, pos, true, true))
+        {
+            error = "read failed at sample " + juce::String (pos);
+            return false;
+        }
+
+        const bool keep = pos >= start;
+        if (keep)
+            inEnergy += sumOfSquares (buffer, n);
+        engine.process (buffer.getArrayOfWritePointers(), numChannels, n, params);
+        if (! keep)
+            continue;
+        outEnergy += sumOfSquares (buffer, n);
+
+        if (writer != nullptr)
+        {
+            if (gain != 1.0f)
+                buffer.applyGain (0, n, gain);
+
+            if (! writer->writeFromAudioSampleBuffer (buffer, 0, n))
+            {
+                error = "write failed";
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<juce::AudioFormatWriter> BatchRenderer::createOutputWriter (juce::AudioFormatManager& formats,
+                                                                            const juce::AudioFormatReader& source,
+                                                                            const juce::File& outFile,
+                                                                            juce::TemporaryFile& temp,
+                                                                            juce::String& error) const
+{
+    auto* format = formats.findFormatForFileExtension (outFile.getFileExtension());
+    if (format == nullptr)
+    {
+        error = "no writer for " + outFile.getFileExtension();
+        return {};
+    }
+
+    // Same bit depth as the source where the format allows it.
+    int bits = (int) source.bitsPerSample;
+    const auto depths = format->getPossibleBitDepths();
+    if (! depths.contains (bits))
+        bits = depths.contains (24) ? 24 : depths.getLast();
+
+    auto stream = temp.getFile().createOutputStream();
+    if (stream == nullptr)
+    {
+        error = "could not create " + temp.getFile().getFullPathName();
+        return {};
+    }
+
+    std::unique_ptr<juce::AudioFormatWriter> writer (format->createWriterFor (stream.get(), source.sampleRate,
+                                                                              source.numChannels, bits,
+                                                                              source.metadataValues, 0));
+    if (writer == nullptr)
+    {
+        error = "could not create a " + format->getFormatName() + " writer";
+        return {};
+    }
+    stream.release();   // owned by the writer now
+    return writer;
+}
+
+BatchRenderer::Result BatchRenderer::renderFile (DisperserEngine& engine, juce::AudioFormatManager& formats,
+                                                 const Job& job) const
+{
+    Result r;
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (job.input));
+    if (reader == nullptr)
+    {
+        r.error = "could not open";
+        return r;
+    }
+
+    const auto outFile = getOutputFile (job.input);
+    const juce::int64 length = reader->lengthInSamples;
+    double inEnergy = 0.0, outEnergy = 0.0;
+    float gain = 1.0f;
+
+    if (options.gainMatch)
+    {
+        if (! renderPass (engine, *reader, 0, length, 0, nullptr, 1.0f, inEnergy, outEnergy, r.error))
+            return r;
+
+        if (inEnergy > 0.0 && outEnergy > 0.0)
+            r.gainDb = juce::jlimit (-options.maxGainDb, options.maxGainDb,
+                                     (float) (10.0 * std::log10 (inEnergy / outEnergy)));
+        gain = juce::Decibels::decibelsToGain (r.gainDb);
+    }
+
+    // Written next to the target and moved into place, so a failed render
+    // never leaves a truncated file under the final name.
+    juce::TemporaryFile temp (outFile);
+    {
+        auto writer = createOutputWriter (formats, *reader, outFile, temp, r.error);
+        if (writer == nullptr)
+            return r;
+
+        inEnergy = outEnergy = 0.0;
+        if (! renderPass (engine, *reader, 0, length, 0, writer.get(), gain, inEnergy, outEnergy, r.error))
+            return r;
+    }
+
+    if (! temp.overwriteTargetFileWithTemporary())
+    {
+        r.error = "could not write " + outFile.getFullPathName();
+        return r;
+    }
+
+    r.ok = true;
+    r.seconds = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+    return r;
+}
+
+//==============================================================================
+void BatchRenderer::renderSegment (DisperserEngine& engine, juce::AudioFormatManager& formats,
+                                   const Job& job, const Segment& seg, SplitState& split) const
+{
+    const auto k = (size_t) seg.index;
+    split.startMs[k] = juce::Time::getMillisecondCounterHiRes();
+    auto& error = split.errors[k];
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (job.input));
+    if (reader == nullptr)
+    {
+        error = "could not open";
+        return;
+    }
+
+    // Parts are float WAV whatever the output format, so the join only
+    // rounds once.
+    split.parts[k] = std::make_unique<juce::TemporaryFile> (getOutputFile (job.input).withFileExtension ("part.wav"));
+    auto stream = split.parts[k]->getFile().createOutputStream();
+    if (stream == nullptr)
+    {
+        error = "could not create " + split.parts[k]->getFile().getFullPathName();
+        return;
+    }
+
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wav.createWriterFor (stream.get(), reader->sampleRate,
+                                                                          reader->numChannels, 32, {}, 0));
+    if (writer == nullptr)
+    {
+        error = "could not create a part writer";
+        return;
+    }
+    stream.release();
+
+    renderPass (engine, *reader, seg.start, seg.end, seg.preRoll, writer.get(), 1.0f,
+                split.inEnergy[k], split.outEnergy[k], error);
+}
+
+BatchRenderer::Result BatchRenderer::joinSegments (DisperserEngine& engine, juce::AudioFormatManager& formats,
+                                                   const Job& job, SplitState& split) const
+{
+    Result r;
+    r.segments = (int) split.parts.size();
+
+    for (size_t k = 0; k < split.parts.size(); ++k)
+    {
+        if (split.errors[k].isNotEmpty())
+        {
+            r.error = "segment " + juce::String ((int) k + 1) + ": " + split.errors[k];
+            return r;
+        }
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> source (formats.createReaderFor (job.input));
+    if (source == nullptr)
+    {
+        r.error = "could not open";
+        return r;
+    }
+
+    const double inEnergy  = std::accumulate (split.inEnergy.begin(), split.inEnergy.end(), 0.0);
+    const double outEnergy = std::accumulate (split.outEnergy.begin(), split.outEnergy.end(), 0.0);
+    if (options.gainMatch && inEnergy > 0.0 && outEnergy > 0.0)
+        r.gainDb = juce::jlimit (-options.maxGainDb, options.maxGainDb,
+                                 (float) (10.0 * std::log10 (inEnergy / outEnergy)));
+    const float gain = juce::Decibels::decibelsToGain (r.gainDb);
+
+    const auto outFile = getOutputFile (job.input);
+    juce::TemporaryFile temp (outFile);
+    {
+        auto writer = createOutputWriter (formats, *source, outFile, temp, r.error);
+        if (writer == nullptr)
+            return r;
+
+        const int numChannels = job.numChannels;
+        juce::AudioBuffer<float> buffer (numChannels, options.chunkSize), serial (numChannels, options.chunkSize);
+        if (options.verify)
+            engine.prepare (job.sampleRate, options.chunkSize, params);
+
+        juce::WavAudioFormat wav;
+        float maxDiff = 0.0f;
+        juce::int64 pos = 0;
+
+        for (auto& part : split.parts)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader (wav.createReaderFor (part->getFile().createInputStream().release(), true));
+            if (reader == nullptr)
+            {
+                r.error = "could not reopen " + part->getFile().getFullPathName();
+                return r;
+            }
+
+            for (juce::int64 partPos = 0; partPos < reader->lengthInSamples; partPos += options.chunkSize)
+            {
+                const int n = (int) juce::jmin ((juce::int64) options.chunkSize, reader->lengthInSamples - partPos);
+                if (! reader->read (&buffer, 0, n, partPos, true, true))
+                {
+                    r.error = "part read failed";
+                    return r;
+                }
+
+                // Same chunk grid as the segments, so this is the render a
+                // single worker would have produced.
+                if (options.verify)
+                {
+                    if (! source->read (&serial, 0, n, pos, true, true))
+                    {
+                        r.error = "read failed at sample " + juce::String (pos);
+                        return r;
+                    }
+                    engine.process (serial.getArrayOfWritePointers(), numChannels, n, params);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        const float* a = buffer.getReadPointer (ch);
+                        const float* b = serial.getReadPointer (ch);
+                        for (int i = 0; i < n; ++i)
+                            maxDiff = juce::jmax (maxDiff, std::abs (a[i] - b[i]));
+                    }
+                }
+
+                if (gain != 1.0f)
+                    buffer.applyGain (0, n, gain);
+                if (! writer->writeFromAudioSampleBuffer (buffer, 0, n))
+                {
+                    r.error = "write failed";
+                    return r;
+                }
+                pos += n;
+            }
+
+            part.reset();   // deletes the part file
+        }
+
+        if (options.verify)
+        {
+            r.nullDb = juce::Decibels::gainToDecibels ((double) maxDiff, -1000.0);
+            if (r.nullDb > options.nullToleranceDb)
+            {
+                r.error = "segment joins differ from a serial render by " + juce::String (r.nullDb, 1)
+                        + " dBFS (tolerance " + juce::String (options.nullToleranceDb, 1) + ")";
+                return r;
+            }
+        }
+    }
+
+    if (! temp.overwriteTargetFileWithTemporary())
+    {
+        r.error = "could not write " + outFile.getFullPathName();
+        return r;
+    }
+
+    r.ok = true;
+    r.seconds = (juce::Time::getMillisecondCounterHiRes()
+                 - *std::min_element (split.startMs.begin(), split.startMs.end())) * 0.001;
+    return r;
+}
+
+//==============================================================================
+int BatchRenderer::run (const juce::Array<juce::File>& inputs, std::ostream& log)
+{
+    if (! options.outputDir.createDirectory())
+    {
+        log << "could not create " << options.outputDir.getFullPathName() << "\n";
+        return inputs.size();
+    }
+
+    RunState state (log);
+    state.jobs = scanInputs (inputs, log);
+    if (state.jobs.isEmpty())
+        return inputs.size();
+
+    state.segments = planSegments (state.jobs, log);
+    state.results.resize ((size_t) state.jobs.size());
+    state.splits.resize ((size_t) state.jobs.size());
+    for (const auto& seg : state.segments)
+    {
+        if (seg.numSegments == 1 || state.splits[(size_t) seg.job] != nullptr)
+            continue;
+
+        auto split = std::make_unique<SplitState>();
+        const auto n = (size_t) seg.numSegments;
+        split->parts.resize (n);
+        split->inEnergy.assign (n, 0.0);
+        split->outEnergy.assign (n, 0.0);
+        split->errors.resize (n);
+        split->startMs.assign (n, 0.0);
+        split->remaining = seg.numSegments;
+        state.splits[(size_t) seg.job] = std::move (split);
+    }
+
+    const int numWorkers = juce::jmin (options.numWorkers, (int) state.segments.size());
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        juce::ThreadPool pool (numWorkers);
+        std::vector<std::unique_ptr<Worker>> workers;
+        for (int i = 0; i < numWorkers; ++i)
+        {
+            workers.push_back (std::make_unique<Worker> (*this, state));
+            pool.addJob (workers.back().get(), false);
+        }
+
+        for (auto& w : workers)
+            pool.waitForJobToFinish (w.get(), -1);
+    }
+
+    const double wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+
+    int rendered = 0;
+    double audioSeconds = 0.0;
+    for (int i = 0; i < state.jobs.size(); ++i)
+    {
+        if (state.results[(size_t) i].ok)
+        {
+            ++rendered;
+            audioSeconds += (double) state.jobs[i].lengthInSamples / state.jobs[i].sampleRate;
+        }
+    }
+
+    log << "rendered " << rendered << "/" << inputs.size()
+        << " files, " << juce::String (audioSeconds, 1) << " s of audio in "
+        << juce::String (wallSeconds, 2) << " s on " << numWorkers << " worker(s)";
+    if (wallSeconds > 0.0)
+        log << " (" << juce::String (audioSeconds / wallSeconds, 1) << "x realtime)";
+    log << "\n";
+
+    return inputs.size() - rendered;
+}
+
+//==============================================================================
+double BatchRenderer::measureThroughput (double sampleRate) const
+{
+    const int n = options.chunkSize;
+    juce::AudioBuffer<float> noise (2, n), work (2, n);
+    juce::Random rng (0x44495350);
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < n; ++i)
+            noise.setSample (ch, i, rng.nextFloat() * 0.5f - 0.25f);
+
+    DisperserEngine engine;
+    engine.setCostProfile (options.costProfile);
+    engine.prepare (sampleRate, n, params);
+
+    juce::ScopedNoDenormals noDenormals;
+    work.makeCopyOf (noise, true);
+    engine.process (work.getArrayOfWritePointers(), 2, n, params);   // warm-up
+
+    // At least ~0.25 s of work and a second of audio, so short chunks still
+    // average over the smoothers settling.
+    juce::int64 frames = 0;
+    const double startMs = juce::Time::getMillisecondCounterHiRes();
+    double elapsedMs = 0.0;
+    while (elapsedMs < 250.0 || frames < (juce::int64) sampleRate)
+    {
+        work.makeCopyOf (noise, true);
+        engine.process (work.getArrayOfWritePointers(), 2, n, params);
+        frames += n;
+        elapsedMs = juce::Time::getMillisecondCounterHiRes() - startMs;
+    }
+
+    return (double) frames / (elapsedMs * 0.001);
+}
+
+void BatchRenderer::printEstimate (const juce::Array<juce::File>& inputs, std::ostream& log)
+{
+    const auto jobs = scanInputs (inputs, log);
+    if (jobs.isEmpty())
+        return;
+
+    const auto segments = planSegments (jobs, log);
+    std::map<double, double> throughputByRate;
+    const int numWorkers = juce::jmin (options.numWorkers, (int) segments.size());
+    std::vector<double> workerLoad ((size_t) numWorkers, 0.0);
+    std::vector<double> jobCost ((size_t) jobs.size(), 0.0);
+    std::vector<int> jobSegments ((size_t) jobs.size(), 1);
+
+    auto throughputFor = [&] (double sampleRate)
+    {
+        auto it = throughputByRate.find (sampleRate);
+        if (it == throughputByRate.end())
+            it = throughputByRate.emplace (sampleRate, measureThroughput (sampleRate)).first;
+        return it->second;
+    };
+
+    double audioSeconds = 0.0, cpuSeconds = 0.0;
+
+    // Same longest-first order the workers use; each segment goes to the
+    // worker that frees up first. Whole files pay two passes for gain match,
+    // split files none (it is applied at the join), but a verified split
+    // file adds a serial render at the end.
+    for (const auto& seg : segments)
+    {
+        const auto& job = jobs.getReference (seg.job);
+        const int passes = (options.gainMatch && seg.numSegments == 1) ? 2 : 1;
+        double cost = (double) (seg.end - seg.start + seg.preRoll) * passes / throughputFor (job.sampleRate);
+        if (options.verify && seg.numSegments > 1 && seg.index == seg.numSegments - 1)
+            cost += (double) job.lengthInSamples / throughputFor (job.sampleRate);
+
+        *std::min_element (workerLoad.begin(), workerLoad.end()) += cost;
+        jobCost[(size_t) seg.job] += cost;
+        jobSegments[(size_t) seg.job] = seg.numSegments;
+        cpuSeconds += cost;
+    }
+
+    log << std::left << std::setw (40) << "file" << std::right << std::setw (12) << "audio s"
+        << std::setw (10) << "segments" << std::setw (12) << "est cpu s" << "\n";
+
+    for (int j = 0; j < jobs.size(); ++j)
+    {
+        const auto& job = jobs.getReference (j);
+        const double duration = (double) job.lengthInSamples / job.sampleRate;
+        audioSeconds += duration;
+
+        log << std::left << std::setw (40) << job.input.getFileName().toStdString()
+            << std::right << std::setw (12) << juce::String (duration, 1).toStdString()
+            << std::setw (10) << jobSegments[(size_t) j]
+            << std::setw (12) << juce::String (jobCost[(size_t) j], 2).toStdString() << "\n";
+    }
+
+    const double wall = *std::max_element (workerLoad.begin(), workerLoad.end());
+    log << jobs.size() << " file(s), " << juce::String (audioSeconds, 1) << " s of audio, "
+        << juce::String (cpuSeconds, 2) << " s DSP, ~" << juce::String (wall, 2) << " s wall on "
+        << numWorkers << " worker(s)"
+        << (options.gainMatch ? " (gain match: 2 passes for unsplit files)" : "")
+        << "\nestimates are DSP time at stereo cost; decoding and disk I/O are not included\n";
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// ============================================================================
+// BatchRenderer.h — offline file rendering through DisperserEngine
+//
+// Files are streamed in large chunks (no whole-file buffers) and spread over a
+// pool of workers, each owning one engine. Longest files are scheduled first
+// so the pool drains evenly. Parameters are fixed for the whole render; the
+// engine's chaos generators are seeded per prepare, so a render is repeatable.
+//
+// Gain matching renders each file twice: the first pass only measures input
+// and output RMS, the second applies the correction while writing.
+//
+// Long files can also be split into segments rendered on different workers.
+// Each segment starts on a fresh engine: skipAhead() brings the chaos
+// generators and tilt ramp to the segment's start, then a pre-roll of input
+// (from DisperserEngine::estimateTailSeconds) is run and discarded so the
+// cascade, feedback, filters and limiter settle before anything is kept.
+// Segments go to float WAV part files that are joined in order, which is
+// also where a split file's gain match is applied (no second pass). With
+// `verify`, the join runs a serial render alongside and fails the file if
+// the two differ by more than the tolerance.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../../Source/Engine/DisperserEngine.h"
+
+class BatchRenderer
+{
+public:
+    struct Options
+    {
+        juce::File outputDir;
+        int   numWorkers   = 1;
+        int   chunkSize    = 65536;
+        bool  gainMatch    = false;
+        float maxGainDb    = 24.0f;     // gain-match correction limit (±)
+        bool  overwrite    = false;
+
+        double segmentSeconds = 0.0;    // 0 = split only when files < workers, < 0 = never
+        bool   verify         = false;  // null split files against a serial render
+        float  nullToleranceDb = -90.0f; // max allowed difference, dBFS
+
+        const cost::Profile* costProfile = nullptr;   // kernel timings for the cascade split; nullptr = defaults
+    };
+
+    BatchRenderer (const DisperserEngine::Params& params, Options options);
+
+    // Renders every input into outputDir (same name and format). Progress and
+    // errors go to `log`; returns the number of files that failed.
+    int run (const juce::Array<juce::File>& inputs, std::ostream& log);
+
+    // Reads only the file headers and a short calibration render, then prints
+    // per-file and total estimated render time for the worker count.
+    void printEstimate (const juce::Array<juce::File>& inputs, std::ostream& log);
+
+    // Engine throughput with these parameters, in stereo frames per second on
+    // one core.
+    double measureThroughput (double sampleRate) const;
+
+private:
+    struct Job
+    {
+        juce::File  input;
+        juce::int64 lengthInSamples = 0;
+        double      sampleRate = 0.0;
+        int         numChannels = 0;
+    };
+
+    // A sample range of one job. Whole files are a single segment with no
+    // pre-roll; split files have `numSegments` of them.
+    struct Segment
+    {
+        int         job = 0;
+        int         index = 0;
+        int         numSegments = 1;
+        juce::int64 start = 0, end = 0;
+        juce::int64 preRoll = 0;          // samples rendered and discarded before `start`
+    };
+
+    struct Result
+    {
+        bool         ok = false;
+        juce::String error;
+        double       seconds = 0.0;
+        float        gainDb = 0.0f;
+        int          segments = 1;
+        double       nullDb = -1000.0;    // split + verify only
+    };
+
+    class Worker;
+    struct SplitState;
+    struct RunState;
+
+    static constexpr double kMinSegmentSeconds = 30.0;   // auto mode
+
+    juce::Array<Job> scanInputs (const juce::Array<juce::File>& inputs, std::ostream& log) const;
+    juce::File getOutputFile (const juce::File& input) const;
+
+    // Chooses segment boundaries and pre-rolls per job, longest work first.
+    // Jobs whose tail never decays stay whole; each is noted in `log`.
+    std::vector<Segment> planSegments (const juce::Array<Job>& jobs, std::ostream& log) const;
+
+    // Streams [start, end) of a file through `engine`, after fast-forwarding
+    // to start − preRoll and rendering the pre-roll. With `writer == nullptr`
+    // only the RMS accumulators are filled.
+    bool renderPass (DisperserEngine& engine, juce::AudioFormatReader& reader,
+                     juce::int64 start, juce::int64 end, juce::int64 preRoll,
+                     juce::AudioFormatWriter* writer, float gain,
+                     double& inEnergy, double& outEnergy, juce::String& error) const;
+
+    // Writer into `temp` with the output format and the source's bit depth.
+    std::unique_ptr<juce::AudioFormatWriter> createOutputWriter (juce::AudioFormatManager& formats,
+                                                                 const juce::AudioFormatReader& source,
+                                                                 const juce::File& outFile,
+                                                                 juce::TemporaryFile& temp,
+                                                                 juce::String& error) const;
+
+    Result renderFile (DisperserEngine& engine, juce::AudioFormatManager& formats, const Job& job) const;
+    void   renderSegment (DisperserEngine& engine, juce::AudioFormatManager& formats,
+                          const Job& job, const Segment& seg, SplitState& split) const;
+    Result joinSegments (DisperserEngine& engine, juce::AudioFormatManager& formats,
+                         const Job& job, SplitState& split) const;
+
+    DisperserEngine::Params params;
+    Options options;
+};
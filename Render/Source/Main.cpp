@@ -0,0 +1,180 @@
+// ============================================================================
+// DISP-TR render — headless batch processing of audio files
+//
+//   DISP-TR-Render [--state file] [--set id=value ...] --out dir
+//                  [--jobs N] [--chunk N] [--gain-match] [--overwrite]
+//                  [--segment auto|off|seconds] [--verify] [--null-db dB]
+//                  [--dry-run] input...
+//
+// Inputs are WAV/AIFF/FLAC files or directories (searched recursively).
+// --state takes a plugin state blob as saved by a host; --set overrides single
+// parameters by ID with plain values (e.g. --set freq=440 --set amount=64) and
+// is applied after --state. Output files keep the input's name and format.
+//
+// --segment splits long files across workers (auto: only when there are fewer
+// files than workers); --verify also renders split files serially and fails
+// any whose joins differ by more than --null-db (default -90 dBFS).
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "BatchRenderer.h"
+#include "../../Source/PluginProcessor.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "usage: DISP-TR-Render [--state file] [--set id=value ...] --out dir\n"
+                     "                      [--jobs N] [--chunk N] [--gain-match] [--overwrite]\n"
+                     "                      [--segment auto|off|seconds] [--verify] [--null-db dB]\n"
+                     "                      [--dry-run] input...\n";
+    }
+
+    const juce::StringArray kValueOptions { "--state", "--set", "--out", "--jobs", "--chunk", "--segment", "--null-db" };
+    const juce::StringArray kFlagOptions  { "--gain-match", "--overwrite", "--verify", "--dry-run" };
+
+    // "--name value" lookup; returns an empty string when absent.
+    juce::String getOptionValue (const juce::StringArray& args, const juce::String& name)
+    {
+        const int idx = args.indexOf (name);
+        return (idx >= 0 && idx + 1 < args.size()) ? args[idx + 1] : juce::String();
+    }
+
+    int getIntOption (const juce::StringArray& args, const juce::String& name, int def)
+    {
+        const auto v = getOptionValue (args, name);
+        return v.isNotEmpty() ? juce::jmax (1, v.getIntValue()) : def;
+    }
+
+    // "auto" → 0, "off" → −1, otherwise segment length in seconds.
+    double getSegmentOption (const juce::StringArray& args)
+    {
+        const auto v = getOptionValue (args, "--segment");
+        if (v.isEmpty() || v == "auto")
+            return 0.0;
+        if (v == "off")
+            return -1.0;
+        return juce::jmax (1.0, v.getDoubleValue());
+    }
+
+    juce::File resolvePath (const juce::String& path)
+    {
+        return juce::File::getCurrentWorkingDirectory().getChildFile (path);
+    }
+
+    bool applyState (DisperserAudioProcessor& processor, const juce::StringArray& args)
+    {
+        const auto statePath = getOptionValue (args, "--state");
+        if (statePath.isNotEmpty())
+        {
+            juce::MemoryBlock data;
+            if (! resolvePath (statePath).loadFileAsData (data))
+            {
+                std::cerr << "could not read " << statePath << "\n";
+                return false;
+            }
+            processor.setStateInformation (data.getData(), (int) data.getSize());
+        }
+
+        for (int i = 0; i + 1 < args.size(); ++i)
+        {
+            if (args[i] != "--set")
+                continue;
+
+            const auto id = args[i + 1].upToFirstOccurrenceOf ("=", false, false).trim();
+            const auto value = args[i + 1].fromFirstOccurrenceOf ("=", false, false).trim();
+            auto* param = processor.apvts.getParameter (id);
+            if (param == nullptr || value.isEmpty())
+            {
+                std::cerr << "bad --set " << args[i + 1] << " (expected id=value with a known parameter ID)\n";
+                return false;
+            }
+            param->setValueNotifyingHost (param->convertTo0to1 (value.getFloatValue()));
+        }
+
+        return true;
+    }
+
+    juce::Array<juce::File> collectInputs (const juce::StringArray& args)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        const auto wildcard = formats.getWildcardForAllFormats();
+
+        juce::Array<juce::File> inputs;
+        for (int i = 0; i < args.size(); ++i)
+        {
+            if (kValueOptions.contains (args[i]))
+            {
+                ++i;
+                continue;
+            }
+            if (kFlagOptions.contains (args[i]))
+                continue;
+
+            const auto f = resolvePath (args[i]);
+            if (f.isDirectory())
+            {
+                for (const auto& entry : juce::RangedDirectoryIterator (f, true, wildcard, juce::File::findFiles))
+                    inputs.add (entry.getFile());
+            }
+            else
+            {
+                inputs.add (f);
+            }
+        }
+        return inputs;
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::StringArray args;
+    for (int i = 1; i < argc; ++i)
+        args.add (juce::String::fromUTF8 (argv[i]));
+
+    const auto outPath = getOptionValue (args, "--out");
+    const auto inputs = collectInputs (args);
+    if (outPath.isEmpty() || inputs.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    // The processor is only used to decode state exactly as the plugin would;
+    // rendering runs on bare engines.
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    // A saved kernel profile is used, but never measured here: the renderer
+    // keeps every core busy, which is no time to take timings.
+    auto& tuning = KernelTuning::get();
+    tuning.setBackgroundMeasuring (false);
+    tuning.prepare();
+
+    DisperserAudioProcessor processor;
+    if (! applyState (processor, args))
+        return 1;
+
+    BatchRenderer::Options opts;
+    opts.outputDir  = resolvePath (outPath);
+    opts.numWorkers = getIntOption (args, "--jobs", juce::SystemStats::getNumCpus());
+    opts.chunkSize  = getIntOption (args, "--chunk", opts.chunkSize);
+    opts.gainMatch  = args.contains ("--gain-match");
+    opts.overwrite  = args.contains ("--overwrite");
+    opts.segmentSeconds = getSegmentOption (args);
+    opts.verify     = args.contains ("--verify");
+    opts.costProfile = &tuning.getProfile();
+    if (args.contains ("--null-db"))
+        opts.nullToleranceDb = getOptionValue (args, "--null-db").getFloatValue();
+
+    BatchRenderer renderer (processor.makeEngineParams(), opts);
+
+    if (args.contains ("--dry-run"))
+    {
+        renderer.printEstimate (inputs, std::cout);
+        return 0;
+    }
+
+    return renderer.run (inputs, std::cout) == 0 ? 0 : 1;
+}
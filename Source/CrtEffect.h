@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include "MemoryReport.h"
+#include "PerfTrace.h"
 
 //======================================================================
 //  CrtEffect — full-screen CRT post-process via juce::ImageEffectFilter
@@ -30,10 +32,26 @@ public:
     void setEnabled    (bool  e)          noexcept { effectEnabled = e; }
     void setResolution (float w, float h) noexcept { resW = w; resH = h; }
 
+    // While deferred, a size change draws the source unprocessed instead of
+    // reallocating outputBuf/prevSrc — used during live corner drags so the
+    // buffers are rebuilt once, at the final size.
+    void setDeferReallocation (bool d)    noexcept { deferRealloc = d; }
+
+    // Optional zone tracer (only records when DISPTR_PERF_TRACE is on).
+    void setTracer (PerfTrace* t)         noexcept { tracer = t; }
+
+    // Pixel storage of outputBuf and prevSrc, for MemoryReport.
+    size_t getBufferBytes() const noexcept
+    {
+        return MemoryReport::getImageBytes (outputBuf) + MemoryReport::getImageBytes (prevSrc);
+    }
+
     //-- ImageEffectFilter override ------------------------------------
     void applyEffect (juce::Image& src, juce::Graphics& destCtx,
                       float /*scaleFactor*/, float alpha) override
     {
+        PERF_TRACE_ZONE (tracer, CrtApply);
+
         const int w = src.getWidth();
         const int h = src.getHeight();
 
@@ -46,6 +64,13 @@ public:
 
         // Reuse output buffer to avoid per-frame allocation.
         const bool sizeChanged = (outputBuf.getWidth() != w || outputBuf.getHeight() != h);
+        if (sizeChanged && deferRealloc)
+        {
+            destCtx.setOpacity (alpha);
+            destCtx.drawImageAt (src, 0, 0);
+            return;
+        }
+
         if (sizeChanged)
         {
             outputBuf = juce::Image (juce::Image::ARGB, w, h, false);
@@ -248,6 +273,8 @@ private:
     //-- state ---------------------------------------------------------
     float crtTime       = 0.0f;
     bool  effectEnabled = true;
+    bool  deferRealloc  = false;
+    PerfTrace* tracer   = nullptr;
     float resW          = 800.0f;
     float resH          = 600.0f;
     juce::Image outputBuf;
@@ -0,0 +1,537 @@
+#include "BatchEngine.h"
+
+namespace
+{
+    template <typename T>
+    inline T limit (T lo, T hi, T v) noexcept
+    {
+        return v < lo ? lo : (hi < v ? hi : v);
+    }
+
+    constexpr int kFilterSections = 4;   // hp0, hp1, lp0, lp1
+}
+
+//==============================================================================
+bool BatchEngine::supports (const Params& p) noexcept
+{
+    if (p.stageType != 0 || p.midiFreqHz > 0.0f || p.chaosFilter || p.chaosDelay
+        || p.limMode != 0 || p.sumBus != 0)
+        return false;
+
+    for (const auto& r : p.modMatrix.routes)
+        if (r.source > ModMatrix::SourceNone && r.source < ModMatrix::kNumSources
+            && r.target >= 0 && r.target < ModMatrix::kNumTargets && r.depth != 0.0f)
+            return false;
+
+    return true;
+}
+
+void BatchEngine::prepare (double sr, int maxBlockSize, int streams, int channels, const Params& p)
+{
+    params       = p;
+    sampleRate   = std::max (1.0, sr);
+    maxChunkSize = std::max (1, maxBlockSize);
+    numStreams   = std::max (1, streams);
+    numChannels  = limit (1, Engine::kMaxChannels, channels);
+    groupSize    = (numStreams + simd::kLaneAlign - 1) / simd::kLaneAlign * simd::kLaneAlign;
+    numLanes     = groupSize * numChannels;
+
+    setIsa (simd::resolveIsa());
+
+    const size_t laneRows = (size_t) maxChunkSize * (size_t) numLanes;
+    wet.assign (laneRows, 0.0f);
+    dry.assign (laneRows, 0.0f);
+
+    // ── Cascade: the engine's prepare() and first-chunk state ──
+    const int style = limit (0, 3, p.style);
+    const bool hasStereo = numChannels > 1;
+    stages   = limit (0, Engine::kMaxStages, p.stages);
+    series   = limit (1, Engine::kMaxSeries, p.series);
+    shape    = limit (0.0f, 1.0f, p.shape);
+    processR = style >= 1 && hasStereo;
+    crossFbk = style == 2;
+    negateR  = style == 2;
+    dualR    = style == 3;
+
+    targetFreq    = p.freqHz * Engine::modFreqMultiplier (p.mod);
+    smoothedFreq  = p.freqHz;
+    freqEmaCoeff  = std::exp (-1.0f / ((float) sampleRate * Engine::kFreqTauDefault));
+    lastCoeffFreq = lastCoeffFreqR = -1.0f;
+    lastCoeffStages = -1;
+    coeffUpdateCountdown = 0;
+
+    stageCoeff.assign ((size_t) Engine::kMaxStages, 0.0f);
+    stageCoeffR.assign ((size_t) Engine::kMaxStages, 0.0f);
+    laneCoeffs.assign ((size_t) (series * std::max (1, stages) * numChannels), 0.0f);
+    laneState.assign ((size_t) (series * std::max (1, stages)) * (size_t) numLanes, 0.0f);
+
+    feedbackSmoothed.reset (sampleRate, Engine::kFeedbackSmoothingSeconds);
+    feedbackSmoothed.setCurrentAndTargetValue (limit (-1.0f, 1.0f, p.feedback));
+    feedbackSmoothed.setTargetValue (Engine::mapFeedback (p.feedback));
+    feedbackRamp.assign ((size_t) maxChunkSize, 0.0f);
+    feedbackLast.assign ((size_t) numLanes, 0.0f);
+
+    // ── Wet filter ──
+    const float fsr = (float) sampleRate;
+    const float maxFreq = std::min (Engine::kFilterFreqMax, 0.49f * fsr);
+    smoothedHpFreq = p.hpFreq;
+    smoothedLpFreq = p.lpFreq;
+    lastCalcHpFreq = limit (Engine::kFilterFreqMin, maxFreq, smoothedHpFreq);
+    lastCalcLpFreq = limit (Engine::kFilterFreqMin, maxFreq, smoothedLpFreq);
+    Engine::calcWetFilterCoeffs (true,  lastCalcHpFreq, limit (0, 2, p.hpSlope), fsr, hpCoeffs);
+    Engine::calcWetFilterCoeffs (false, lastCalcLpFreq, limit (0, 2, p.lpSlope), fsr, lpCoeffs);
+    filterCoeffCountdown = 0;
+    filterState.assign ((size_t) (kFilterSections * 2) * (size_t) numLanes, 0.0f);
+
+    // ── Tilt ──
+    tiltB0 = tiltTargetB0 = 1.0f;
+    tiltB1 = tiltTargetB1 = 0.0f;
+    tiltA1 = tiltTargetA1 = 0.0f;
+    lastTiltDb = 0.0f;
+    tiltSmoothSc = 1.0f - std::exp (-1.0f / (fsr * 0.03f));
+    tiltState.assign ((size_t) numLanes, 0.0f);
+
+    // ── Gains and pan ──
+    smoothedInputGain = smoothedOutputGain = smoothedMix = 1.0f;
+    inRamp.assign ((size_t) maxChunkSize, 0.0f);
+    outRamp.assign ((size_t) maxChunkSize, 0.0f);
+    mixRamp.assign ((size_t) maxChunkSize, 0.0f);
+
+    const float angle = p.pan * 1.5707963f; // π/2
+    panLeft  = std::cos (angle);
+    panRight = std::sin (angle);
+}
+
+void BatchEngine::release()
+{
+    maxChunkSize = 0;
+    for (auto* v : { &wet, &dry, &laneCoeffs, &laneState, &feedbackRamp, &feedbackLast,
+                     &filterState, &tiltState, &inRamp, &outRamp, &mixRamp })
+        v->clear();
+}
+
+//==============================================================================
+void BatchEngine::process (float* const* const* streams, int numSamples) noexcept
+{
+    if (maxChunkSize <= 0 || numSamples <= 0)
+        return;
+
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+        processChunk (streams, start, std::min (maxChunkSize, numSamples - start));
+}
+
+void BatchEngine::processChunk (float* const* const* streams, int offset, int numSamples) noexcept
+{
+    const auto& p = params;
+    const int G = groupSize;
+    const bool hasStereo = numChannels > 1;
+
+    // ── Streams → lanes ──
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int s = 0; s < numStreams; ++s)
+        {
+            const float* src = streams[s][ch] + offset;
+            float* dst = wet.data() + ch * G + s;
+            for (int n = 0; n < numSamples; ++n)
+                dst[(size_t) n * (size_t) numLanes] = src[n];
+        }
+    }
+
+    const float mixValue = limit (0.0f, 1.0f, p.mix);
+    const bool needsDryBlend = (mixValue < 0.999f) || (p.mixMode == 1);
+    if (needsDryBlend)
+        std::copy (wet.begin(), wet.begin() + (std::ptrdiff_t) numSamples * numLanes, dry.begin());
+
+    // ── Mode In ──
+    const int modeIn = limit (0, 2, p.modeIn);
+    if (modeIn > 0 && hasStereo)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* r = row (n);
+            for (int l = 0; l < G; ++l)
+            {
+                const float L = r[l];
+                const float R = r[G + l];
+                const float v = modeIn == 1 ? (L + R) * Engine::kSqrt2Over2 : (L - R) * Engine::kSqrt2Over2;
+                r[l] = v;
+                r[G + l] = v;
+            }
+        }
+    }
+
+    const int fltPos = p.filterPos;
+    const bool filterPre = (fltPos == 1 || fltPos == 2);
+    const bool tiltPre   = (fltPos == 1 || fltPos == 3);
+
+    if (filterPre) runFilters (numSamples);
+    if (tiltPre)   runTilt (numSamples);
+
+    runCascade (numSamples);
+
+    if (! filterPre) runFilters (numSamples);
+    if (! tiltPre)   runTilt (numSamples);
+
+    // ── Mode Out ──
+    const int modeOut = limit (0, 2, p.modeOut);
+    if (modeOut > 0 && hasStereo)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* r = row (n);
+            for (int l = 0; l < G; ++l)
+            {
+                const float L = r[l];
+                const float R = r[G + l];
+                const float v = modeOut == 1 ? (L + R) * Engine::kSqrt2Over2 : (L - R) * Engine::kSqrt2Over2;
+                r[l] = v;
+                r[G + l] = v;
+            }
+        }
+    }
+
+    const size_t total = (size_t) numSamples * (size_t) numLanes;
+    auto invert = [&] (int position)
+    {
+        if (p.invPol == position)
+            for (size_t i = 0; i < total; ++i)
+                wet[i] *= -1.0f;
+
+        if (p.invStr == position && hasStereo)
+            for (int n = 0; n < numSamples; ++n)
+                std::swap_ranges (row (n), row (n) + G, row (n) + G);
+    };
+
+    invert (1);
+    blend (numSamples);
+
+    // ── Pan ──
+    if (hasStereo && std::abs (p.pan - 0.5f) > 0.001f)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* r = row (n);
+            for (int l = 0; l < G; ++l)
+            {
+                r[l]     *= panLeft;
+                r[G + l] *= panRight;
+            }
+        }
+    }
+
+    invert (2);
+
+    // ── Safety limiter (+48 dBFS) and lanes → streams ──
+    for (size_t i = 0; i < total; ++i)
+        wet[i] = limit (-251.19f, 251.19f, wet[i]);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int s = 0; s < numStreams; ++s)
+        {
+            float* dst = streams[s][ch] + offset;
+            const float* src = wet.data() + ch * G + s;
+            for (int n = 0; n < numSamples; ++n)
+                dst[n] = src[(size_t) n * (size_t) numLanes];
+        }
+    }
+}
+
+//==============================================================================
+void BatchEngine::updateStageCoeffs (bool updateL, float freqL, bool updateR, float freqR) noexcept
+{
+    const float sr = (float) sampleRate;
+    if (updateL)
+        Engine::computeStageCoeffs (freqL, shape, stages, sr, stageCoeff.data());
+    if (updateR)
+        Engine::computeStageCoeffs (freqR, shape, stages, sr, stageCoeffR.data());
+
+    // Series are more stages of the same chain, as in the engine's stage-major path.
+    for (int s = 0; s < series; ++s)
+    {
+        for (int st = 0; st < stages; ++st)
+        {
+            const bool flip = params.alt && (st & 1);
+            const float a = flip ? -stageCoeff[(size_t) st] : stageCoeff[(size_t) st];
+            float* dest = laneCoeffs.data() + (size_t) ((s * stages + st) * numChannels);
+            dest[0] = a;
+            if (numChannels > 1)
+                dest[1] = ! processR ? a
+                        : negateR    ? -a
+                        : dualR      ? (flip ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st])
+                                     : a;
+        }
+    }
+}
+
+void BatchEngine::cascadeRows (int from, int to, bool withFeedback) noexcept
+{
+    if (to <= from || stages <= 0)
+        return;
+
+    float* data = row (from);
+    const int rows = to - from;
+    const int total = series * stages;
+
+    if (withFeedback)
+    {
+        kernels->allpassLanesFeedback (data, rows, numLanes, groupSize, laneCoeffs.data(), laneState.data(),
+                                       total, feedbackRamp.data() + from, feedbackLast.data(),
+                                       crossFbk ? groupSize : 0);
+    }
+    else
+    {
+        kernels->allpassLanes (data, rows, numLanes, groupSize, laneCoeffs.data(), laneState.data(), total);
+        std::copy (row (to - 1), row (to - 1) + numLanes, feedbackLast.begin());
+    }
+
+    // MONO on stereo streams: R takes L's cascade.
+    if (numChannels > 1 && ! processR)
+        for (int n = from; n < to; ++n)
+            std::copy (row (n), row (n) + groupSize, row (n) + groupSize);
+}
+
+void BatchEngine::runCascade (int numSamples) noexcept
+{
+    // A WIDE mono stream's cross feedback reads an R channel that never
+    // sounds, so its loop stays silent, as in the engine.
+    const bool feedbackPath = ! (crossFbk && numChannels == 1);
+    const bool freqConverged = std::abs (smoothedFreq - targetFreq) < 0.01f;
+
+    // ── Fast path: the engine's settled branch ──
+    if (freqConverged && ! feedbackSmoothed.isSmoothing())
+    {
+        smoothedFreq = targetFreq;
+        if (stages <= 0)
+            return;
+
+        const bool stagesChanged = lastCoeffStages != stages;
+        const float freqR = targetFreq * 0.5f;
+        const bool updateR = dualR && std::abs (freqR - lastCoeffFreqR) > 0.001f;
+        if (stagesChanged || updateR)
+        {
+            updateStageCoeffs (stagesChanged, targetFreq, updateR, freqR);
+            if (stagesChanged)
+            {
+                lastCoeffStages = stages;
+                lastCoeffFreq = targetFreq;
+            }
+            if (updateR)
+                lastCoeffFreqR = freqR;
+        }
+
+        const float fb = feedbackSmoothed.getCurrentValue();
+        if (fb != 0.0f && feedbackPath)
+            std::fill (feedbackRamp.begin(), feedbackRamp.begin() + numSamples, fb);
+        cascadeRows (0, numSamples, fb != 0.0f && feedbackPath);
+        return;
+    }
+
+    // ── Slow path: per-sample glide and feedback ramp; the lanes run between
+    // coefficient updates ──
+    const bool withFeedback = feedbackPath && ! (feedbackSmoothed.getCurrentValue() == 0.0f
+                                                 && ! feedbackSmoothed.isSmoothing());
+    int runStart = 0;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        smoothedFreq += (targetFreq - smoothedFreq) * (1.0f - freqEmaCoeff);
+        const float fb = feedbackSmoothed.getNextValue();
+        feedbackRamp[(size_t) n] = feedbackPath ? fb : 0.0f;
+        if (stages <= 0)
+            continue;
+
+        bool updateL = false;
+        --coeffUpdateCountdown;
+        if (coeffUpdateCountdown <= 0 || lastCoeffStages != stages)
+        {
+            coeffUpdateCountdown = Engine::kCoeffUpdateInterval;
+            updateL = lastCoeffStages != stages || std::abs (smoothedFreq - lastCoeffFreq) > 0.001f;
+        }
+
+        const float freqR = smoothedFreq * 0.5f;
+        const bool updateR = dualR && std::abs (freqR - lastCoeffFreqR) > 0.001f;
+
+        if (updateL || updateR)
+        {
+            cascadeRows (runStart, n, withFeedback);
+            runStart = n;
+            updateStageCoeffs (updateL, smoothedFreq, updateR, freqR);
+            if (updateL)
+            {
+                lastCoeffStages = stages;
+                lastCoeffFreq = smoothedFreq;
+            }
+            if (updateR)
+                lastCoeffFreqR = freqR;
+        }
+    }
+
+    cascadeRows (runStart, numSamples, withFeedback);
+}
+
+//==============================================================================
+void BatchEngine::runFilters (int numSamples) noexcept
+{
+    const auto& p = params;
+    if (! p.hpOn && ! p.lpOn)
+        return;
+
+    const float k = Engine::kGainSmoothCoeff;
+    const float targetHp = limit (Engine::kFilterFreqMin, Engine::kFilterFreqMax, p.hpFreq);
+    const float targetLp = limit (Engine::kFilterFreqMin, Engine::kFilterFreqMax, p.lpFreq);
+    const float fsr = (float) sampleRate;
+    const float maxFreq = std::min (Engine::kFilterFreqMax, 0.49f * fsr);
+
+    int runStart = 0;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        smoothedHpFreq = smoothedHpFreq * k + targetHp * (1.0f - k);
+        smoothedLpFreq = smoothedLpFreq * k + targetLp * (1.0f - k);
+
+        if (--filterCoeffCountdown > 0)
+            continue;
+
+        filterCoeffCountdown = Engine::kFilterCoeffUpdateInterval;
+        const float hpFreq = limit (Engine::kFilterFreqMin, maxFreq, smoothedHpFreq);
+        const float lpFreq = limit (Engine::kFilterFreqMin, maxFreq, smoothedLpFreq);
+        const bool updateHp = std::abs (hpFreq - lastCalcHpFreq) > 0.01f;
+        const bool updateLp = std::abs (lpFreq - lastCalcLpFreq) > 0.01f;
+        if (! updateHp && ! updateLp)
+            continue;
+
+        filterRows (runStart, n);
+        runStart = n;
+        if (updateHp)
+        {
+            lastCalcHpFreq = hpFreq;
+            Engine::calcWetFilterCoeffs (true, hpFreq, limit (0, 2, p.hpSlope), fsr, hpCoeffs);
+        }
+        if (updateLp)
+        {
+            lastCalcLpFreq = lpFreq;
+            Engine::calcWetFilterCoeffs (false, lpFreq, limit (0, 2, p.lpSlope), fsr, lpCoeffs);
+        }
+    }
+
+    filterRows (runStart, numSamples);
+}
+
+void BatchEngine::filterRows (int from, int to) noexcept
+{
+    if (to <= from)
+        return;
+
+    const auto& p = params;
+    float* data = row (from);
+    const int rows = to - from;
+
+    auto run = [&] (const Engine::BiquadCoeffs& c, int section)
+    {
+        const float coeffs[5] { c.b0, c.b1, c.b2, c.a1, c.a2 };
+        float* z1 = filterState.data() + (size_t) (section * 2) * (size_t) numLanes;
+        kernels->biquadLanes (data, rows, numLanes, coeffs, z1, z1 + numLanes);
+    };
+
+    if (p.hpOn)
+        for (int s = 0; s < (limit (0, 2, p.hpSlope) == 2 ? 2 : 1); ++s)
+            run (hpCoeffs[s], s);
+
+    if (p.lpOn)
+        for (int s = 0; s < (limit (0, 2, p.lpSlope) == 2 ? 2 : 1); ++s)
+            run (lpCoeffs[s], 2 + s);
+}
+
+void BatchEngine::runTilt (int numSamples) noexcept
+{
+    const float tiltDb = params.tiltDb;
+    if (std::abs (tiltDb) <= 0.05f)
+        return;
+
+    // One smoothing step per chunk, like the engine's.
+    if (std::abs (tiltDb - lastTiltDb) > 0.02f)
+    {
+        lastTiltDb = tiltDb;
+        Engine::calcTiltCoeffs (tiltDb, sampleRate, tiltTargetB0, tiltTargetB1, tiltTargetA1);
+    }
+    tiltB0 += (tiltTargetB0 - tiltB0) * tiltSmoothSc;
+    tiltB1 += (tiltTargetB1 - tiltB1) * tiltSmoothSc;
+    tiltA1 += (tiltTargetA1 - tiltA1) * tiltSmoothSc;
+
+    const float b0 = tiltB0, b1 = tiltB1, a1 = tiltA1;
+    float* state = tiltState.data();
+    for (int n = 0; n < numSamples; ++n)
+    {
+        float* r = row (n);
+        for (int l = 0; l < numLanes; ++l)
+        {
+            const float x = r[l];
+            const float y = b0 * x + state[l];
+            state[l] = b1 * x - a1 * y;
+            r[l] = y;
+        }
+    }
+}
+
+void BatchEngine::blend (int numSamples) noexcept
+{
+    const auto& p = params;
+    const float k = Engine::kGainSmoothCoeff;
+    const float mixValue   = limit (0.0f, 1.0f, p.mix);
+    const int   mixMode    = p.mixMode;
+    const float dryLevel   = mixMode == 1 ? p.dryLevel : 0.0f;
+    const float wetLevel   = mixMode == 1 ? p.wetLevel : 0.0f;
+    const float inputGain  = Engine::fastDecibelsToGain (limit (Engine::kGainMinDb, Engine::kInputMaxDb, p.inputDb));
+    const float outputGain = Engine::fastDecibelsToGain (limit (Engine::kGainMinDb, Engine::kOutputMaxDb, p.outputDb));
+    const bool needsDryBlend = (mixValue < 0.999f) || (mixMode == 1);
+    const size_t total = (size_t) numSamples * (size_t) numLanes;
+
+    if (needsDryBlend && smoothedInputGain == inputGain && smoothedOutputGain == outputGain && smoothedMix == mixValue)
+    {
+        // Settled: every lane is one long run for the blend kernels.
+        if (mixMode == 0)
+            kernels->mixInsert (dry.data(), wet.data(), wet.data(), (int) total, inputGain * outputGain, mixValue);
+        else
+            kernels->mixSend (dry.data(), wet.data(), wet.data(), (int) total, inputGain * outputGain, dryLevel, wetLevel);
+        return;
+    }
+
+    // Ramping: the engine advances the smoothers through one channel's
+    // samples, then on through the next channel's, so each channel group
+    // gets its own stretch of the ramp.
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            smoothedInputGain  = smoothedInputGain  * k + inputGain  * (1.0f - k);
+            smoothedOutputGain = smoothedOutputGain * k + outputGain * (1.0f - k);
+            if (needsDryBlend)
+                smoothedMix    = smoothedMix        * k + mixValue   * (1.0f - k);
+            inRamp[(size_t) n]  = smoothedInputGain;
+            outRamp[(size_t) n] = smoothedOutputGain;
+            mixRamp[(size_t) n] = smoothedMix;
+        }
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* w = row (n) + ch * groupSize;
+            const float* d = dry.data() + (size_t) n * (size_t) numLanes + ch * groupSize;
+            const float gIn = inRamp[(size_t) n], gOut = outRamp[(size_t) n], m = mixRamp[(size_t) n];
+
+            if (! needsDryBlend)
+                for (int l = 0; l < groupSize; ++l)
+                    w[l] = w[l] * gIn * gOut;
+            else if (mixMode == 0)
+                for (int l = 0; l < groupSize; ++l)
+                    w[l] = d[l] + m * (w[l] * gIn * gOut - d[l]);
+            else
+                for (int l = 0; l < groupSize; ++l)
+                    w[l] = d[l] * dryLevel + (w[l] * gIn * gOut) * wetLevel;
+        }
+    }
+
+    constexpr float kSnapEpsilon = 1e-5f;
+    if (std::abs (smoothedInputGain  - inputGain)  < kSnapEpsilon) smoothedInputGain  = inputGain;
+    if (std::abs (smoothedOutputGain - outputGain) < kSnapEpsilon) smoothedOutputGain = outputGain;
+    if (std::abs (smoothedMix - mixValue) < kSnapEpsilon) smoothedMix = mixValue;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+// ============================================================================
+// BatchEngine.h — one DISP-TR preset over many streams in lock step
+//
+// Batch pipelines run thousands of stems through the same preset. With one
+// DisperserEngine per stem every cascade runs a channel at a time; here the
+// streams share one set of parameters, smoothers and coefficients, and the
+// audio is transposed into lanes so the cascade, wet filters and blend run
+// across streams — 4, 8 or 16 per instruction with the dispatched kernels.
+//
+//   BatchEngine batch;
+//   if (BatchEngine::supports (params))
+//   {
+//       batch.prepare (sampleRate, blockSize, numStreams, numChannels, params);
+//       batch.process (streams, numSamples);   // streams[s][ch], in place
+//   }
+//
+// Row n of the lane buffer holds sample n of every stream: channel c of
+// stream s sits at lane c·G + s, with G the stream count rounded up to
+// simd::kLaneAlign (the spare lanes carry silence).
+//
+// Each stream comes out as a DisperserEngine prepared with the same Params and
+// fed the same blocks renders it: the control path (glides, coefficient
+// updates, gain ramps, the per-chunk tilt step) is the engine's, run once, and
+// every lane does the engine's per-sample arithmetic. The one difference is
+// the block scan the engine's cost model may pick for feedback-free chunks,
+// which rounds differently (~−90 dB); an engine set to setMaxErrorDb() below
+// cost::kScanErrorDb never takes it. Parameters are fixed from prepare() on,
+// and whatever modulates the cascade per sample or follows a stream's own
+// level stays with DisperserEngine: CHS F/D, mod matrix routes, MIDI, the
+// limiter, SUM BUS and DELAY stages. supports() rejects those presets, and
+// the caller runs them one engine per stream.
+// ============================================================================
+
+#include <vector>
+#include "DisperserEngine.h"
+
+class BatchEngine
+{
+public:
+    using Params = DisperserEngine::Params;
+
+    // True when every feature `p` uses runs batched.
+    static bool supports (const Params& p) noexcept;
+
+    // numStreams streams of numChannels (1 or 2) each, all rendered with `p`.
+    // Allocates the lane buffers for maxBlockSize samples and resets all state.
+    void prepare (double sampleRate, int maxBlockSize, int numStreams, int numChannels, const Params& p);
+    void release();
+
+    // In place, streams[s][ch] for every prepared stream. Longer calls than
+    // maxBlockSize run in pieces, as in DisperserEngine::process().
+    void process (float* const* const* streams, int numSamples) noexcept;
+
+    void setIsa (simd::Isa isa) noexcept { dspIsa = isa; kernels = &simd::getKernels (isa); }
+    simd::Isa getIsa() const noexcept    { return dspIsa; }
+
+    int getNumStreams() const noexcept   { return numStreams; }
+    int getNumLanes() const noexcept     { return numLanes; }
+
+private:
+    using Engine = DisperserEngine;
+
+    void processChunk (float* const* const* streams, int offset, int numSamples) noexcept;
+
+    void runCascade (int numSamples) noexcept;
+    void cascadeRows (int from, int to, bool withFeedback) noexcept;
+    // Recomputes L and/or DUAL's R stage coefficients and rebuilds the lane table.
+    void updateStageCoeffs (bool updateL, float freqL, bool updateR, float freqR) noexcept;
+
+    void runFilters (int numSamples) noexcept;
+    void filterRows (int from, int to) noexcept;
+    void runTilt (int numSamples) noexcept;
+    void blend (int numSamples) noexcept;
+
+    float* row (int n) noexcept    { return wet.data() + (size_t) n * (size_t) numLanes; }
+
+    Params params;
+    double sampleRate = 44100.0;
+    int    maxChunkSize = 0;
+    int    numStreams = 0;
+    int    numChannels = 0;
+    int    groupSize = 0;      // lanes per channel
+    int    numLanes = 0;
+
+    // ── SIMD dispatch ──
+    const simd::Kernels* kernels = &simd::getKernels (simd::Isa::Scalar);
+    simd::Isa dspIsa = simd::Isa::Scalar;
+
+    // Lane buffers, maxChunkSize rows of numLanes.
+    std::vector<float> wet, dry;
+
+    // ── All-pass cascade ──
+    int   stages = 0, series = 1;
+    float shape = 0.0f;
+    bool  processR = false, crossFbk = false, negateR = false, dualR = false;
+    float targetFreq = 1000.0f;
+    float smoothedFreq = 1000.0f;
+    float freqEmaCoeff = 0.0f;
+    float lastCoeffFreq = -1.0f, lastCoeffFreqR = -1.0f;
+    int   lastCoeffStages = -1;
+    int   coeffUpdateCountdown = 0;
+    std::vector<float> stageCoeff, stageCoeffR;   // per stage, as in the engine
+    std::vector<float> laneCoeffs;                // [series × stage][channel]
+    std::vector<float> laneState;                 // [series × stage][lane]
+
+    // ── Feedback ──
+    Engine::LinearSmoother feedbackSmoothed;
+    std::vector<float> feedbackRamp;              // per sample of the chunk
+    std::vector<float> feedbackLast;              // per lane
+
+    // ── Wet filter (HP + LP), coefficients shared by every lane ──
+    Engine::BiquadCoeffs hpCoeffs[2], lpCoeffs[2];
+    float smoothedHpFreq = 250.0f, smoothedLpFreq = 2000.0f;
+    float lastCalcHpFreq = -1.0f, lastCalcLpFreq = -1.0f;
+    int   filterCoeffCountdown = 0;
+    std::vector<float> filterState;               // [hp0, hp1, lp0, lp1][z1, z2][lane]
+
+    // ── Tilt ──
+    float tiltB0 = 1.0f, tiltB1 = 0.0f, tiltA1 = 0.0f;
+    float tiltTargetB0 = 1.0f, tiltTargetB1 = 0.0f, tiltTargetA1 = 0.0f;
+    float lastTiltDb = 0.0f;
+    float tiltSmoothSc = 0.0f;
+    std::vector<float> tiltState;                 // per lane
+
+    // ── Input / Output / Mix ──
+    float smoothedInputGain = 1.0f, smoothedOutputGain = 1.0f, smoothedMix = 1.0f;
+    std::vector<float> inRamp, outRamp, mixRamp;  // per sample of the chunk
+    float panLeft = 1.0f, panRight = 1.0f;
+};
@@ -0,0 +1,303 @@
+#include "CostModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <locale>
+#include <sstream>
+#include <vector>
+
+namespace cost
+{
+namespace
+{
+    // As in SimdDispatch.cpp: the wavefront kernels only start on chunks of
+    // four vector widths, and the scan solves whole blocks of 8 samples.
+    constexpr int kWavefrontWidths[kNumIsas] = { 1, 4, 8, 16 };
+    constexpr int kWavefrontMinWidths = 4;
+    constexpr int kScanBlock = 8;
+
+    int isaIndex (simd::Isa isa) noexcept
+    {
+        return std::clamp ((int) isa, 0, kNumIsas - 1);
+    }
+
+    // ── Calibration ──
+    // Stage counts are whole vector groups at every level, and the shortest
+    // chunk is where the widest wavefront engages, so each point times one
+    // kernel and nothing else.
+    constexpr int kGridStages[]  = { 16, 64, 256 };
+    constexpr int kGridSamples[] = { 64, 128, 256, 512, 1024 };
+    constexpr int kTimedRuns     = 7;
+    constexpr int kMinRunWork    = 1 << 16;   // stage-samples per run, far above timer resolution
+
+    using CascadeKernel = void (*) (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept;
+
+    // Fastest of kTimedRuns, in ns per call; a first, untimed run warms the caches.
+    double timeKernel (CascadeKernel kernel, float* data, int numSamples, const float* coeffs, float* state, int numStages)
+    {
+        using Clock = std::chrono::steady_clock;
+        const int calls = std::max (1, kMinRunWork / (numSamples * numStages));
+
+        double best = 0.0;
+        for (int run = 0; run <= kTimedRuns; ++run)
+        {
+            const auto start = Clock::now();
+            for (int c = 0; c < calls; ++c)
+                kernel (data, numSamples, coeffs, state, numStages);
+            const double ns = std::chrono::duration<double, std::nano> (Clock::now() - start).count() / calls;
+
+            if (run == 1 || (run > 1 && ns < best))
+                best = ns;
+        }
+        return best;
+    }
+
+    // Least-squares line through ns per stage against chunk length.
+    struct LineFit
+    {
+        double n = 0.0, sx = 0.0, sy = 0.0, sxx = 0.0, sxy = 0.0;
+
+        void add (double x, double y) noexcept { n += 1.0; sx += x; sy += y; sxx += x * x; sxy += x * y; }
+
+        void solve (float& perSample, float& perChunk) const noexcept
+        {
+            const double den   = n * sxx - sx * sx;
+            const double slope = den > 0.0 ? (n * sxy - sx * sy) / den : 0.0;
+            perSample = (float) std::max (0.01, slope);
+            perChunk  = (float) std::max (0.0, (sy - slope * sx) / std::max (1.0, n));
+        }
+    };
+
+    // ── Profile text ──
+    constexpr const char* kProfileHeader = "DISP-TR kernel profile 1";
+
+    std::string oneLine (std::string s)
+    {
+        std::replace (s.begin(), s.end(), '\n', ' ');
+        std::replace (s.begin(), s.end(), '\r', ' ');
+        return s;
+    }
+
+    // getline that also drops a '\r' left by an editor that saved CRLF.
+    bool readLine (std::istream& in, std::string& line)
+    {
+        if (! std::getline (in, line))
+            return false;
+        if (! line.empty() && line.back() == '\r')
+            line.pop_back();
+        return true;
+    }
+
+    bool readValues (std::istringstream& line, float* dest, int count, float minValue)
+    {
+        float v[kNumIsas] {};
+        for (int i = 0; i < count; ++i)
+            if (! (line >> v[i]) || ! std::isfinite (v[i]) || v[i] < minValue)
+                return false;
+
+        std::copy (v, v + count, dest);
+        return true;
+    }
+}
+
+const char* getPathName (int path) noexcept
+{
+    switch (path)
+    {
+        case PathWavefront:     return "wavefront";
+        case PathWavefrontScan: return "wavefront+scan";
+        case PathScan:          return "scan";
+        case PathSampleMajor:   return "sample-major";
+        case PathSmoothed:      return "smoothed";
+        case PathDelay:         return "delay";
+        default:                return "none";
+    }
+}
+
+const Profile& getDefaultProfile() noexcept
+{
+    static const Profile profile;
+    return profile;
+}
+
+bool measureKernels (Profile& dest, simd::Isa maxIsa, StopCheck shouldStop, void* context)
+{
+    constexpr int maxStages  = kGridStages[std::size (kGridStages) - 1];
+    constexpr int maxSamples = kGridSamples[std::size (kGridSamples) - 1];
+
+    // Half-scale noise through spread coefficients: stays well clear of
+    // denormals however many times the cascade runs over it.
+    std::vector<float> input ((size_t) maxSamples), data ((size_t) maxSamples);
+    std::vector<float> coeffs ((size_t) maxStages), state ((size_t) maxStages);
+    uint32_t seed = 0x2545f491u;
+    for (auto& x : input)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        x = (float) (int32_t) seed * (0.5f / 2147483648.0f);
+    }
+    for (int i = 0; i < maxStages; ++i)
+        coeffs[(size_t) i] = -0.8f + 1.6f * (float) (i % 17) / 16.0f;
+
+    Profile measured = dest;
+    const int top = std::min (isaIndex (maxIsa), isaIndex (simd::detectHostIsa()));
+
+    for (int i = 0; i <= top; ++i)
+    {
+        const auto& kernels = simd::getKernels ((simd::Isa) i);
+        const CascadeKernel kinds[] = { kernels.allpassCascade, kernels.allpassCascadeScan };
+
+        for (int kind = 0; kind < 2; ++kind)
+        {
+            LineFit fit;
+            for (const int stages : kGridStages)
+            {
+                for (const int samples : kGridSamples)
+                {
+                    if (shouldStop != nullptr && shouldStop (context))
+                        return false;
+
+                    std::copy (input.begin(), input.begin() + samples, data.begin());
+                    std::fill (state.begin(), state.end(), 0.0f);
+                    fit.add (samples, timeKernel (kinds[kind], data.data(), samples, coeffs.data(), state.data(), stages) / stages);
+                }
+            }
+
+            if (kind == 0)
+                fit.solve (measured.wavefrontNs[i], measured.wavefrontChunkNs[i]);
+            else
+                fit.solve (measured.scanNs[i], measured.scanChunkNs[i]);
+        }
+    }
+
+    // The wavefront kernels run leftover stages with the scalar loop.
+    measured.tailNs = measured.wavefrontNs[0];
+
+    dest = measured;
+    return true;
+}
+
+std::string formatProfile (const Profile& p, const std::string& machine)
+{
+    // Always '.' decimals, whatever locale the host has set.
+    std::ostringstream out;
+    out.imbue (std::locale::classic());
+
+    auto row = [&out] (const char* key, const float* v, int count)
+    {
+        out << key;
+        for (int i = 0; i < count; ++i)
+            out << ' ' << v[i];
+        out << '\n';
+    };
+
+    out << kProfileHeader << '\n'
+        << "machine " << oneLine (machine) << '\n';
+    row ("wavefront_ns",       p.wavefrontNs,      kNumIsas);
+    row ("wavefront_chunk_ns", p.wavefrontChunkNs, kNumIsas);
+    row ("scan_ns",            p.scanNs,           kNumIsas);
+    row ("scan_chunk_ns",      p.scanChunkNs,      kNumIsas);
+    row ("tail_ns",            &p.tailNs,          1);
+    return out.str();
+}
+
+bool parseProfile (const std::string& text, const std::string& machine, Profile& dest)
+{
+    std::istringstream in (text);
+    std::string line;
+    if (! readLine (in, line) || line != kProfileHeader)
+        return false;
+    if (! readLine (in, line) || line != "machine " + oneLine (machine))
+        return false;
+
+    Profile parsed = dest;
+    struct Row { const char* key; float* values; int count; float minValue; };
+    const Row rows[] = {
+        { "wavefront_ns",       parsed.wavefrontNs,      kNumIsas, 0.001f },
+        { "wavefront_chunk_ns", parsed.wavefrontChunkNs, kNumIsas, 0.0f },
+        { "scan_ns",            parsed.scanNs,           kNumIsas, 0.001f },
+        { "scan_chunk_ns",      parsed.scanChunkNs,      kNumIsas, 0.0f },
+        { "tail_ns",            &parsed.tailNs,          1,        0.001f },
+    };
+
+    // Unknown keys (from a newer build) are skipped; every known one must be there.
+    unsigned found = 0;
+    while (readLine (in, line))
+    {
+        std::istringstream fields (line);
+        fields.imbue (std::locale::classic());
+
+        std::string key;
+        fields >> key;
+
+        for (int r = 0; r < (int) std::size (rows); ++r)
+        {
+            if (key != rows[r].key)
+                continue;
+            if (! readValues (fields, rows[r].values, rows[r].count, rows[r].minValue))
+                return false;
+            found |= 1u << r;
+        }
+    }
+
+    if (found != (1u << std::size (rows)) - 1u)
+        return false;
+
+    dest = parsed;
+    return true;
+}
+
+int getWavefrontWidth (simd::Isa isa) noexcept
+{
+    return kWavefrontWidths[isaIndex (isa)];
+}
+
+double getCascadeChunkNs (int numStages, int wavefrontStages, int numSamples,
+                          simd::Isa isa, const Profile& prof) noexcept
+{
+    if (numStages <= 0 || numSamples <= 0)
+        return 0.0;
+
+    const int i = isaIndex (isa);
+    const int w = kWavefrontWidths[i];
+    const double n = (double) numSamples;
+
+    wavefrontStages = std::clamp (wavefrontStages, 0, numStages);
+    const int vectorStages = (w > 1 && numSamples >= kWavefrontMinWidths * w) ? wavefrontStages - wavefrontStages % w : 0;
+    const int tailStages   = wavefrontStages - vectorStages;
+    const int scanStages   = numStages - wavefrontStages;
+
+    const int scanSamples = numSamples - numSamples % kScanBlock;
+    const double scanStageNs = scanSamples * (double) prof.scanNs[i] + (numSamples - scanSamples) * (double) prof.tailNs
+                             + prof.scanChunkNs[i];
+
+    return vectorStages * (n * prof.wavefrontNs[i] + prof.wavefrontChunkNs[i])
+         + tailStages * n * prof.tailNs
+         + scanStages * scanStageNs;
+}
+
+int chooseWavefrontStages (int numStages, int numSamples, simd::Isa isa,
+                           float maxErrorDb, const Profile& prof) noexcept
+{
+    if (numStages <= 0 || maxErrorDb < kScanErrorDb)
+        return numStages;
+
+    const int w = getWavefrontWidth (isa);
+    const int candidates[] = { numStages - numStages % w, 0 };
+
+    int best = numStages;
+    double bestNs = getCascadeChunkNs (numStages, numStages, numSamples, isa, prof);
+    for (int wavefront : candidates)
+    {
+        const double ns = getCascadeChunkNs (numStages, wavefront, numSamples, isa, prof);
+        if (ns < bestNs)
+        {
+            best = wavefront;
+            bestNs = ns;
+        }
+    }
+    return best;
+}
+}
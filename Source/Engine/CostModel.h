@@ -0,0 +1,121 @@
+#pragma once
+
+// ============================================================================
+// CostModel.h — predicted processing time of a DISP-TR setting, per cascade path
+//
+// A cascade of up to kMaxStages × kMaxSeries stages costs what the path that
+// runs it costs, and the paths differ by an order of magnitude: the SIMD
+// wavefront (whole vector groups of stages), the block scan, the per-sample
+// tail both fall back to, and the sample-major loops that feedback, glides,
+// CHS D and the DELAY sections need. A Profile holds each path's time per
+// stage and sample for every ISA level, plus its fixed cost per chunk; the
+// defaults were measured with the engine on a desktop x86-64 core.
+//
+// measureKernels() replaces the vector kernels' entries with timings taken on
+// the running machine; formatProfile()/parseProfile() keep them in a small
+// text file so that happens once per machine (KernelTuning does both).
+//
+// DisperserEngine asks chooseWavefrontStages() how to split each
+// feedback-free chunk, and DisperserEngine::estimateCost() prices a whole
+// setting for the editor before it is committed. All paths keep the same z1
+// per stage, so the engine can change path from one chunk to the next with
+// no crossfade.
+// ============================================================================
+
+#include "SimdDispatch.h"
+#include <string>
+
+namespace cost
+{
+    enum Path : int
+    {
+        PathNone = 0,        // no stages
+        PathWavefront,       // wavefront, leftover stages per sample
+        PathWavefrontScan,   // wavefront, leftover stages as a block scan
+        PathScan,            // block scan for every stage
+        PathSampleMajor,     // settled, with feedback
+        PathSmoothed,        // per-sample smoothing: glides, CHS D, mod routes
+        PathDelay,           // DELAY sections
+        kNumPaths
+    };
+
+    const char* getPathName (int path) noexcept;
+
+    // Deviation of the block scan from the per-sample arithmetic, relative to
+    // full scale; every other path is that arithmetic. A target below this
+    // keeps the scan out, which also keeps output identical across ISAs.
+    constexpr float kScanErrorDb       = -90.0f;
+    constexpr float kDefaultMaxErrorDb = kScanErrorDb;
+
+    constexpr int kNumIsas = (int) simd::Isa::kNumIsas;
+
+    struct Profile
+    {
+        // Vector kernels, per stage and channel: ns per sample, and ns per
+        // chunk (wavefront fill and drain, scan setup).
+        float wavefrontNs[kNumIsas]      { 4.4f, 1.2f, 0.85f, 0.42f };
+        float wavefrontChunkNs[kNumIsas] { 0.0f, 8.0f, 12.0f, 30.0f };
+        float scanNs[kNumIsas]           { 6.5f, 1.44f, 1.15f, 1.15f };
+        float scanChunkNs[kNumIsas]      { 60.0f, 22.0f, 18.0f, 17.0f };
+        float tailNs = 4.4f;             // per-sample stage-major loop
+
+        // Sample-major loops, per stage and sample frame (the left and right
+        // chains overlap, so a stereo frame costs about what a mono one does).
+        float sampleMajorNs  = 3.9f;
+        float smoothedNs     = 4.2f;
+        float coeffNs        = 1.5f;     // per stage of one chain: its coefficient every 32 samples
+        float dualCoeffNs    = 2.2f;     // DUAL's right-channel coefficients, every sample while gliding
+        float delaySectionNs = 7.8f;     // per section and channel
+        float delayFrameNs   = 19.0f;
+
+        // Everything around the cascade, per sample frame.
+        float frameNs       = 16.0f;
+        float biquadNs      = 3.7f;      // per wet filter section and channel
+        float tiltNs        = 15.0f;
+        float limiterNs     = 18.0f;
+        float chaosDelayNs  = 125.0f;
+        float chaosFilterNs = 32.0f;
+    };
+
+    const Profile& getDefaultProfile() noexcept;
+
+    // ── Per-machine calibration ──
+    // Times allpassCascade and allpassCascadeScan at every level up to maxIsa
+    // over a grid of stage counts and chunk lengths, and fits each kernel's
+    // per-sample and per-chunk cost into `dest` (wavefront, scan and tail
+    // entries; the rest keep their values). Takes about a second; each point
+    // is the fastest of several runs, so a busy machine reads slow rather than
+    // noisy. Returns false, leaving `dest` untouched, if `shouldStop` asks.
+    using StopCheck = bool (*) (void* context) noexcept;
+    bool measureKernels (Profile& dest, simd::Isa maxIsa,
+                         StopCheck shouldStop = nullptr, void* context = nullptr);
+
+    // Text form of the measured entries, tagged with `machine` (any string
+    // that changes when the CPU does). parseProfile() fills `dest` only from
+    // a well-formed text of the current format written for the same machine.
+    std::string formatProfile (const Profile& profile, const std::string& machine);
+    bool parseProfile (const std::string& text, const std::string& machine, Profile& dest);
+
+    // Stages per wavefront vector at `isa` (1 = no wavefront).
+    int getWavefrontWidth (simd::Isa isa) noexcept;
+
+    // Predicted ns for one channel of a feedback-free chunk whose first
+    // `wavefrontStages` stages go to the wavefront kernel and the rest to the
+    // block scan, as DisperserEngine::runCascade runs them.
+    double getCascadeChunkNs (int numStages, int wavefrontStages, int numSamples,
+                              simd::Isa isa, const Profile& profile) noexcept;
+
+    // Cheapest such split whose rounding stays within `maxErrorDb`: all
+    // wavefront, the leftovers past the last whole vector group as a scan,
+    // or all scan.
+    int chooseWavefrontStages (int numStages, int numSamples, simd::Isa isa,
+                               float maxErrorDb, const Profile& profile) noexcept;
+
+    inline Path getSplitPath (int numStages, int wavefrontStages) noexcept
+    {
+        return numStages <= 0                 ? PathNone
+             : wavefrontStages >= numStages   ? PathWavefront
+             : wavefrontStages > 0            ? PathWavefrontScan
+                                              : PathScan;
+    }
+}
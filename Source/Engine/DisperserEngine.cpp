@@ -0,0 +1,2234 @@
+#include "DisperserEngine.h"
+
+#include <type_traits>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define DISPTR_X86 1
+ #include <xmmintrin.h>
+#else
+ #define DISPTR_X86 0
+#endif
+
+namespace
+{
+    template <typename T>
+    inline T limit (T lo, T hi, T v) noexcept
+    {
+        return v < lo ? lo : (hi < v ? hi : v);
+    }
+
+    inline float map (float t, float lo, float hi) noexcept
+    {
+        return lo + t * (hi - lo);
+    }
+
+    inline void multiply (float* data, float k, int n) noexcept
+    {
+        for (int i = 0; i < n; ++i)
+            data[i] *= k;
+    }
+
+    // splitmix64 — derives independent, well-mixed generator seeds from one value.
+    inline uint64_t mixSeed (uint64_t seed, uint64_t stream) noexcept
+    {
+        uint64_t z = seed + (stream + 1) * 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+
+    constexpr float kTwoPiF = 6.283185307f;
+
+    // ── Biquad coefficient calculators for wet HP/LP filters ──
+    using BQC = DisperserEngine::BiquadCoeffs;
+
+    inline BQC calcOnePoleLP (float freq, float sr)
+    {
+        const float w = kTwoPiF * freq / sr;
+        const float alpha = w / (1.0f + w);
+        return { alpha, 0.0f, 0.0f, -(1.0f - alpha), 0.0f };
+    }
+
+    inline BQC calcOnePoleHP (float freq, float sr)
+    {
+        const float w = kTwoPiF * freq / sr;
+        const float a = 1.0f / (1.0f + w);
+        return { a, -a, 0.0f, -(1.0f - a), 0.0f };
+    }
+
+    inline BQC calcBiquadLP (float freq, float sr, float Q)
+    {
+        const float w0 = kTwoPiF * freq / sr;
+        const float cs = std::cos (w0);
+        const float sn = std::sin (w0);
+        const float alpha = sn / (2.0f * Q);
+        const float a0 = 1.0f + alpha;
+        return { ((1.0f - cs) * 0.5f) / a0,
+                 (1.0f - cs) / a0,
+                 ((1.0f - cs) * 0.5f) / a0,
+                 (-2.0f * cs) / a0,
+                 (1.0f - alpha) / a0 };
+    }
+
+    inline BQC calcBiquadHP (float freq, float sr, float Q)
+    {
+        const float w0 = kTwoPiF * freq / sr;
+        const float cs = std::cos (w0);
+        const float sn = std::sin (w0);
+        const float alpha = sn / (2.0f * Q);
+        const float a0 = 1.0f + alpha;
+        return { ((1.0f + cs) * 0.5f) / a0,
+                 -(1.0f + cs) / a0,
+                 ((1.0f + cs) * 0.5f) / a0,
+                 (-2.0f * cs) / a0,
+                 (1.0f - alpha) / a0 };
+    }
+
+    // 4th-order Butterworth Q values
+    constexpr float kBW4_Q1 = 0.54119610f;   // 1 / (2 cos(3π/8))
+    constexpr float kBW4_Q2 = 1.30656296f;   // 1 / (2 cos(π/8))
+
+    inline float processBiquad (const BQC& c, DisperserEngine::BiquadState& s, float x) noexcept
+    {
+        const float y = c.b0 * x + s.z1;
+        s.z1 = c.b1 * x - c.a1 * y + s.z2;
+        s.z2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+}
+
+//==============================================================================
+void DisperserEngine::prepare (double sampleRate, int maxBlockSize, const Params& initial)
+{
+    currentSampleRate = std::max (1.0, sampleRate);
+    maxChunkSize = std::max (1, maxBlockSize);
+
+    const int stages = limit (0, kMaxStages, initial.stages);
+    const int series = limit (1, kMaxSeries, initial.series);
+    const float shape = limit (0.0f, 1.0f, initial.shape);
+
+    setIsa (simd::resolveIsa());
+
+    // All state is sized for the maxima up front so parameter changes never allocate.
+    stageCoeff.assign ((size_t) kMaxStages, 0.0f);
+    stageCoeffR.assign ((size_t) kMaxStages, 0.0f);
+    for (int i = 0; i < kMaxSeries; ++i)
+    {
+        chainL[(size_t) i].assign ((size_t) kMaxStages, {});
+        chainR[(size_t) i].assign ((size_t) kMaxStages, {});
+        xfadeChainL[(size_t) i].assign ((size_t) kMaxStages, {});
+        xfadeChainR[(size_t) i].assign ((size_t) kMaxStages, {});
+    }
+    for (auto* v : { &cascadeCoeffL, &cascadeCoeffR, &cascadeStateL, &cascadeStateR })
+        v->assign ((size_t) (kMaxSeries * kMaxStages), 0.0f);
+    for (auto& w : wetBuffer)
+        w.assign ((size_t) maxChunkSize, 0.0f);
+
+    // DELAY rings: a power of two past the longest section delay (+2 for the
+    // interpolation tap), so wrapping is a mask.
+    delayRingSize = 1;
+    while (delayRingSize < (int) std::ceil (currentSampleRate / kDelayMinFreq) + 2)
+        delayRingSize <<= 1;
+    delayRingMask = delayRingSize - 1;
+    if (initial.stageType == 1 || delayArena.size() == getDelayArenaSize())
+        delayArena.assign (getDelayArenaSize(), 0.0f);
+    else
+        std::vector<float>().swap (delayArena);
+    delayRingsWanted = false;
+    delayWritePos = 0;
+    activeDelaySections = 0;
+    delayMode = false;
+    delaySnap = true;
+
+    activeStages = stages;
+    activeSeries = series;
+    coeffUpdateCountdown = 0;
+    seriesXfadeSamplesRemaining = 0;
+    seriesXfadeTotalSamples = 0;
+    previousSeries = series;
+
+    stagesSmoothed.reset (currentSampleRate, kStageSmoothingSeconds);
+    stagesSmoothed.setCurrentAndTargetValue ((float) stages);
+    smoothedFreqValue = initial.freqHz;
+    freqEmaCoeffDefault_ = std::exp (-1.0f / ((float) currentSampleRate * kFreqTauDefault));
+    freqEmaCoeff = freqEmaCoeffDefault_;
+    shapeSmoothed.reset (currentSampleRate, kShapeSmoothingSeconds);
+    shapeSmoothed.setCurrentAndTargetValue (shape);
+    feedbackSmoothed.reset (currentSampleRate, kFeedbackSmoothingSeconds);
+    feedbackSmoothed.setCurrentAndTargetValue (limit (-1.0f, 1.0f, initial.feedback));
+    feedbackLastL = 0.0f;
+    feedbackLastR = 0.0f;
+
+    smoothedInputGain = 1.0f;
+    smoothedOutputGain = 1.0f;
+    smoothedMix = 1.0f;
+
+    // Reset tilt state
+    tiltDb_ = 0.0f;
+    tiltB0_ = 1.0f; tiltB1_ = 0.0f; tiltA1_ = 0.0f;
+    tiltTargetB0_ = 1.0f; tiltTargetB1_ = 0.0f; tiltTargetA1_ = 0.0f;
+    tiltState_[0] = tiltState_[1] = 0.0f;
+    lastTiltDb_ = 0.0f;
+    tiltSmoothSc_ = 1.0f - std::exp (-1.0f / (static_cast<float> (currentSampleRate) * 0.03f));
+    tiltSegmentSc_ = 1.0f - std::exp (-(float) ModMatrix::kSegmentSize / (static_cast<float> (currentSampleRate) * 0.005f));
+
+    lastCoeffFreq = -1.0f;
+    lastCoeffShape = -1.0f;
+    lastCoeffStages = -1;
+
+    // Reset wet filter state
+    wetFilterState_[0].reset();
+    wetFilterState_[1].reset();
+    smoothedFilterHpFreq_ = initial.hpFreq;
+    smoothedFilterLpFreq_ = initial.lpFreq;
+    filterHpSlope_ = limit (kFilterSlopeMin, kFilterSlopeMax, initial.hpSlope);
+    filterLpSlope_ = limit (kFilterSlopeMin, kFilterSlopeMax, initial.lpSlope);
+    lastCalcHpFreq_ = -1.0f;
+    lastCalcLpFreq_ = -1.0f;
+    lastCalcHpSlope_ = -1;
+    lastCalcLpSlope_ = -1;
+    filterCoeffCountdown_ = 0;
+    updateFilterCoeffs (true, true);
+
+    // Reset chaos state
+    chaosFilterEnabled_ = false;
+    chaosDelayEnabled_  = false;
+    chaosStereo_ = false;
+    chaosAmtD_ = 0.0f; chaosAmtNormD_ = 0.0f; chaosAmtF_ = 0.0f;
+    for (int c = 0; c < 2; ++c)
+    {
+        chaosDPrev_[c] = chaosDCurr_[c] = chaosDNext_[c] = 0.0f;
+        chaosDPhase_[c] = 0.0f; chaosDDriftPhase_[c] = 0.0f; chaosDDriftFreqHz_[c] = 0.0f; chaosDOut_[c] = 0.0f;
+        chaosGPrev_[c] = chaosGCurr_[c] = chaosGNext_[c] = 0.0f;
+        chaosGPhase_[c] = 0.0f; chaosGDriftPhase_[c] = 0.0f; chaosGDriftFreqHz_[c] = 0.0f; chaosGOut_[c] = 0.0f;
+        chaosDRng_[c].setSeed (mixSeed (rngSeed, (uint64_t) c));
+        chaosGRng_[c].setSeed (mixSeed (rngSeed, (uint64_t) c + 2));
+    }
+    chaosFPrev_ = chaosFCurr_ = chaosFNext_ = 0.0f;
+    chaosFPhase_ = 0.0f; chaosFDriftPhase_ = 0.0f; chaosFDriftFreqHz_ = 0.0f;
+    chaosFOut_[0] = chaosFOut_[1] = 0.0f;
+    chaosFRng_.setSeed (mixSeed (rngSeed, 4));
+    smoothedChaosFreqMaxOct_ = 0.0f;
+    smoothedChaosGainMaxDb_ = 0.0f;
+    smoothedChaosFilterMaxOct_ = 0.0f;
+    chaosShPeriodD_ = smoothedChaosShPeriodD_ = 8820.0f;   // as constructed, so a reused
+    chaosShPeriodF_ = smoothedChaosShPeriodF_ = 8820.0f;   // engine renders like a fresh one
+    chaosParamSmoothCoeff_ = 0.999f;
+
+    // Precompute chaos smooth coefficients (sampleRate-dependent but constant between prepare calls)
+    cachedChaosParamSmoothCoeff_ = std::exp (-1.0f / ((float) currentSampleRate * 0.010f));
+
+    // Reset limiter state and precompute coefficients
+    limEnv1_[0] = limEnv1_[1] = kLimFloor;
+    limEnv2_[0] = limEnv2_[1] = kLimFloor;
+    {
+        const float sr = (float) currentSampleRate;
+        limAtt1_ = std::exp (-1.0f / (sr * 0.002f));
+        limRel1_ = std::exp (-1.0f / (sr * 0.010f));
+        limRel2_ = std::exp (-1.0f / (sr * 0.100f));
+    }
+
+    modMatrix.prepare (currentSampleRate, maxChunkSize, mixSeed (rngSeed, 5));
+
+    lastPan_ = -1.0f;
+}
+
+void DisperserEngine::release()
+{
+    // Swap with empties: clear() would keep the capacity.
+    auto free = [] (auto& v) { std::decay_t<decltype (v)>().swap (v); };
+
+    maxChunkSize = 0;
+    for (auto& c : chainL) free (c);
+    for (auto& c : chainR) free (c);
+    for (auto& c : xfadeChainL) free (c);
+    for (auto& c : xfadeChainR) free (c);
+    for (auto& w : wetBuffer) free (w);
+    for (auto* v : { &cascadeCoeffL, &cascadeCoeffR, &cascadeStateL, &cascadeStateR })
+        free (*v);
+    free (delayArena);
+    free (stageCoeff);
+    free (stageCoeffR);
+    delayRingsWanted = false;
+}
+
+size_t DisperserEngine::getDelayArenaSize() const noexcept
+{
+    return (size_t) (kMaxSeries * kMaxDelaySections * kMaxChannels) * (size_t) delayRingSize;
+}
+
+void DisperserEngine::reserveDelayRings()
+{
+    if (delayArena.size() == getDelayArenaSize())
+        return;
+
+    std::vector<float> arena (getDelayArenaSize(), 0.0f);
+    swapDelayArena (arena);
+}
+
+void DisperserEngine::swapDelayArena (std::vector<float>& arena) noexcept
+{
+    if (arena.size() != getDelayArenaSize() || arena.empty())
+        return;
+
+    // Sections clear their rings as they come in, so the new arena starts
+    // from whatever it holds; the delay targets jump to the current setting.
+    delayArena.swap (arena);
+    delayRingsWanted = false;
+    delayWritePos = 0;
+    activeDelaySections = 0;
+    delaySnap = true;
+}
+
+DisperserEngine::MemoryUsage DisperserEngine::getMemoryUsage() const noexcept
+{
+    // Capacity, not size: that is what the allocator handed out.
+    auto bytes = [] (const auto& v) { return v.capacity() * sizeof (v[0]); };
+
+    MemoryUsage m;
+    for (int s = 0; s < kMaxSeries; ++s)
+    {
+        m.cascade   += bytes (chainL[(size_t) s]) + bytes (chainR[(size_t) s]);
+        m.crossfade += bytes (xfadeChainL[(size_t) s]) + bytes (xfadeChainR[(size_t) s]);
+    }
+    for (const auto* v : { &stageCoeff, &stageCoeffR, &cascadeCoeffL, &cascadeCoeffR, &cascadeStateL, &cascadeStateR })
+        m.cascade += bytes (*v);
+
+    m.delay = bytes (delayArena);
+
+    for (const auto& w : wetBuffer)
+        m.buffers += bytes (w);
+    m.buffers += modMatrix.getMemoryBytes();
+    return m;
+}
+
+//==============================================================================
+void DisperserEngine::captureState (StateSnapshot& d) const noexcept
+{
+    for (int s = 0; s < kMaxSeries; ++s)
+    {
+        const auto& cl = chainL[(size_t) s];
+        const auto& cr = chainR[(size_t) s];
+        for (int i = 0; i < kMaxStages; ++i)
+        {
+            d.z1L[s][i] = i < (int) cl.size() ? cl[(size_t) i].z1 : 0.0f;
+            d.z1R[s][i] = i < (int) cr.size() ? cr[(size_t) i].z1 : 0.0f;
+        }
+    }
+
+    d.activeStages    = activeStages;
+    d.activeSeries    = activeSeries;
+    d.feedbackLastL   = feedbackLastL;
+    d.feedbackLastR   = feedbackLastR;
+    d.stagesCurrent   = stagesSmoothed.getCurrentValue();
+    d.shapeCurrent    = shapeSmoothed.getCurrentValue();
+    d.feedbackCurrent = feedbackSmoothed.getCurrentValue();
+    d.smoothedFreq    = smoothedFreqValue;
+
+    d.smoothedInputGain  = smoothedInputGain;
+    d.smoothedOutputGain = smoothedOutputGain;
+    d.smoothedMix        = smoothedMix;
+
+    d.tiltB0 = tiltB0_; d.tiltB1 = tiltB1_; d.tiltA1 = tiltA1_;
+    d.tiltState[0] = tiltState_[0]; d.tiltState[1] = tiltState_[1];
+    d.lastTiltDb = lastTiltDb_;
+
+    d.wetFilter[0] = wetFilterState_[0];
+    d.wetFilter[1] = wetFilterState_[1];
+    d.smoothedFilterHpFreq = smoothedFilterHpFreq_;
+    d.smoothedFilterLpFreq = smoothedFilterLpFreq_;
+
+    for (int c = 0; c < 2; ++c)
+    {
+        const float dVals[7] { chaosDPrev_[c], chaosDCurr_[c], chaosDNext_[c], chaosDPhase_[c],
+                               chaosDDriftPhase_[c], chaosDDriftFreqHz_[c], chaosDOut_[c] };
+        const float gVals[7] { chaosGPrev_[c], chaosGCurr_[c], chaosGNext_[c], chaosGPhase_[c],
+                               chaosGDriftPhase_[c], chaosGDriftFreqHz_[c], chaosGOut_[c] };
+        std::copy (dVals, dVals + 7, d.chaosD[c]);
+        std::copy (gVals, gVals + 7, d.chaosG[c]);
+        d.chaosDRng[c] = chaosDRng_[c];
+        d.chaosGRng[c] = chaosGRng_[c];
+    }
+
+    const float fVals[6] { chaosFPrev_, chaosFCurr_, chaosFNext_, chaosFPhase_, chaosFDriftPhase_, chaosFDriftFreqHz_ };
+    std::copy (fVals, fVals + 6, d.chaosF);
+    d.chaosFOut[0] = chaosFOut_[0];
+    d.chaosFOut[1] = chaosFOut_[1];
+    d.chaosFRng    = chaosFRng_;
+
+    d.smoothedChaosShPeriodD    = smoothedChaosShPeriodD_;
+    d.smoothedChaosFreqMaxOct   = smoothedChaosFreqMaxOct_;
+    d.smoothedChaosGainMaxDb    = smoothedChaosGainMaxDb_;
+    d.smoothedChaosShPeriodF    = smoothedChaosShPeriodF_;
+    d.smoothedChaosFilterMaxOct = smoothedChaosFilterMaxOct_;
+
+    for (int c = 0; c < 2; ++c)
+    {
+        d.limEnv1[c] = limEnv1_[c];
+        d.limEnv2[c] = limEnv2_[c];
+    }
+
+    modMatrix.captureState (d.modMatrix);
+}
+
+void DisperserEngine::restoreState (const StateSnapshot& d) noexcept
+{
+    for (int s = 0; s < kMaxSeries; ++s)
+    {
+        auto& cl = chainL[(size_t) s];
+        auto& cr = chainR[(size_t) s];
+        const int n = std::min ({ (int) cl.size(), (int) cr.size(), kMaxStages });
+        for (int i = 0; i < n; ++i)
+        {
+            cl[(size_t) i].z1 = d.z1L[s][i];
+            cr[(size_t) i].z1 = d.z1R[s][i];
+        }
+    }
+
+    // A running series crossfade belongs to the state being replaced.
+    activeStages = d.activeStages;
+    activeSeries = d.activeSeries;
+    previousSeries = d.activeSeries;
+    seriesXfadeSamplesRemaining = 0;
+
+    feedbackLastL = d.feedbackLastL;
+    feedbackLastR = d.feedbackLastR;
+    stagesSmoothed.setCurrentAndTargetValue (d.stagesCurrent);
+    shapeSmoothed.setCurrentAndTargetValue (d.shapeCurrent);
+    feedbackSmoothed.setCurrentAndTargetValue (d.feedbackCurrent);
+    smoothedFreqValue = d.smoothedFreq;
+
+    smoothedInputGain  = d.smoothedInputGain;
+    smoothedOutputGain = d.smoothedOutputGain;
+    smoothedMix        = d.smoothedMix;
+
+    tiltB0_ = d.tiltB0; tiltB1_ = d.tiltB1; tiltA1_ = d.tiltA1;
+    tiltState_[0] = d.tiltState[0]; tiltState_[1] = d.tiltState[1];
+    lastTiltDb_ = d.lastTiltDb;
+
+    wetFilterState_[0] = d.wetFilter[0];
+    wetFilterState_[1] = d.wetFilter[1];
+    smoothedFilterHpFreq_ = d.smoothedFilterHpFreq;
+    smoothedFilterLpFreq_ = d.smoothedFilterLpFreq;
+
+    for (int c = 0; c < 2; ++c)
+    {
+        chaosDPrev_[c] = d.chaosD[c][0]; chaosDCurr_[c] = d.chaosD[c][1]; chaosDNext_[c] = d.chaosD[c][2];
+        chaosDPhase_[c] = d.chaosD[c][3]; chaosDDriftPhase_[c] = d.chaosD[c][4];
+        chaosDDriftFreqHz_[c] = d.chaosD[c][5]; chaosDOut_[c] = d.chaosD[c][6];
+        chaosGPrev_[c] = d.chaosG[c][0]; chaosGCurr_[c] = d.chaosG[c][1]; chaosGNext_[c] = d.chaosG[c][2];
+        chaosGPhase_[c] = d.chaosG[c][3]; chaosGDriftPhase_[c] = d.chaosG[c][4];
+        chaosGDriftFreqHz_[c] = d.chaosG[c][5]; chaosGOut_[c] = d.chaosG[c][6];
+        chaosDRng_[c] = d.chaosDRng[c];
+        chaosGRng_[c] = d.chaosGRng[c];
+    }
+
+    chaosFPrev_ = d.chaosF[0]; chaosFCurr_ = d.chaosF[1]; chaosFNext_ = d.chaosF[2];
+    chaosFPhase_ = d.chaosF[3]; chaosFDriftPhase_ = d.chaosF[4]; chaosFDriftFreqHz_ = d.chaosF[5];
+    chaosFOut_[0] = d.chaosFOut[0];
+    chaosFOut_[1] = d.chaosFOut[1];
+    chaosFRng_ = d.chaosFRng;
+
+    smoothedChaosShPeriodD_    = d.smoothedChaosShPeriodD;
+    smoothedChaosFreqMaxOct_   = d.smoothedChaosFreqMaxOct;
+    smoothedChaosGainMaxDb_    = d.smoothedChaosGainMaxDb;
+    smoothedChaosShPeriodF_    = d.smoothedChaosShPeriodF;
+    smoothedChaosFilterMaxOct_ = d.smoothedChaosFilterMaxOct;
+
+    for (int c = 0; c < 2; ++c)
+    {
+        limEnv1_[c] = d.limEnv1[c];
+        limEnv2_[c] = d.limEnv2[c];
+    }
+
+    modMatrix.restoreState (d.modMatrix);
+
+    // DELAY rings aren't captured; the sections restart from silence.
+    activeDelaySections = 0;
+    delaySnap = true;
+
+    // Coefficients are derived from the restored smoothers; force a recompute.
+    lastCoeffFreq = -1.0f;
+    lastCoeffShape = -1.0f;
+    lastCoeffStages = -1;
+    coeffUpdateCountdown = 0;
+    lastCalcHpFreq_ = -1.0f;
+    lastCalcLpFreq_ = -1.0f;
+    filterCoeffCountdown_ = 0;
+}
+
+void DisperserEngine::skipAhead (int64_t numSamples, const Params& p) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    // processChunk reloads these every chunk; with fixed params only the first
+    // load changes anything.
+    loadChaosParams (p);
+    tiltDb_ = p.tiltDb;
+
+    for (int64_t start = 0; start < numSamples; start += maxChunkSize)
+    {
+        const int len = (int) std::min<int64_t> (maxChunkSize, numSamples - start);
+        modMatrix.render (nullptr, 0, len, p.modMatrix, (double) start);
+        if (const float* tiltMod = modMatrix.getTarget (ModMatrix::TargetTilt))
+            stepTiltSegments (tiltMod, nullptr, 0, len);
+        else
+            stepTiltCoeffs();
+    }
+
+    for (int64_t n = 0; n < numSamples; ++n)
+    {
+        if (chaosDelayEnabled_) advanceChaosD();
+        if (chaosFilterEnabled_) advanceChaosF();
+    }
+}
+
+double DisperserEngine::estimateTailSeconds (const Params& p, double sampleRate, float floorDb) noexcept
+{
+    const double sr = std::max (1.0, sampleRate);
+    const double logFloor = (double) std::min (-1.0f, floorDb) / 20.0 * std::log (10.0);
+
+    // Samples for something that shrinks by `r` per sample to reach the floor.
+    auto decaySamples = [logFloor] (double r)
+    {
+        return r > 0.0 ? logFloor / std::log (std::min (r, 1.0 - 1.0e-9)) : 0.0;
+    };
+
+    // ── Cascade: total peak group delay plus the slowest pole's decay ──
+    // Lowest centre the cascade reaches: MOD, DUAL's half-rate right channel and
+    // the widest CHS D swing (drift + S&H peak, about 1.3 × the octave range).
+    float freq = (p.midiFreqHz > 0.0f ? p.midiFreqHz : p.freqHz) * modFreqMultiplier (p.mod);
+    if (limit (0, 3, p.style) == 3)
+        freq *= 0.5f;
+    if (p.chaosDelay)
+        freq *= std::exp2 (-1.3f * limit (0.0f, 100.0f, p.chaosAmtD) * 0.02f);
+    freq *= std::exp2 (-ModMatrix::getMaxDepth (p.modMatrix, ModMatrix::TargetFreq) * ModMatrix::kTargetRange[ModMatrix::TargetFreq]);
+
+    const int stages = limit (0, kMaxStages, p.stages);
+    const int series = limit (1, kMaxSeries, p.series);
+    double groupDelay = 0.0, slowestPole = 0.0, ringDecay = 0.0;
+    if (stages > 0 && p.stageType == 1)
+    {
+        // DELAY: a section's group delay peaks at M (1 + g) / (1 − g) samples
+        // and its ring loses a factor g every M samples.
+        const int sections = std::min (kMaxDelaySections, (stages + kStagesPerDelaySection - 1) / kStagesPerDelaySection);
+        float freqs[kMaxDelaySections];
+        computeStageFreqs (freq, p.shape, sections, (float) sr, freqs);
+        const double g = kDelayAllPassGain;
+        double longest = 0.0;
+        for (int i = 0; i < sections; ++i)
+        {
+            const double m = sr / std::max (freqs[i], kDelayMinFreq);
+            groupDelay += m * (1.0 + g) / (1.0 - g);
+            longest = std::max (longest, m);
+        }
+        groupDelay *= series;
+        ringDecay = longest * decaySamples (g);
+    }
+    else if (stages > 0)
+    {
+        float coeffs[kMaxStages];
+        computeStageCoeffs (freq, p.shape, stages, (float) sr, coeffs);
+        for (int i = 0; i < stages; ++i)
+        {
+            // First-order all-pass: group delay peaks at (1 + |a|) / (1 − |a|) samples.
+            const double a = std::min ((double) std::abs (coeffs[i]), 1.0 - 1.0e-6);
+            groupDelay += (1.0 + a) / (1.0 - a);
+            slowestPole = std::max (slowestPole, a);
+        }
+        groupDelay *= series;
+    }
+
+    double tail = groupDelay + decaySamples (slowestPole) + ringDecay;
+
+    // ── Feedback: each trip round the loop costs ~the cascade delay and scales by |fb| ──
+    const double af = std::min (1.0f, std::abs (p.feedback));
+    const double fb = std::min (1.0, af * af * (3.0 - 2.0 * af)
+                                     + ModMatrix::getMaxDepth (p.modMatrix, ModMatrix::TargetFeedback));
+    if (fb > 0.0)
+        tail += decaySamples (fb) * (groupDelay + 1.0);
+
+    // ── Wet filters: slowest section decays at σ = π f / Q (2π f for one pole) ──
+    const float filterShift = p.chaosFilter ? std::exp2 (-1.3f * limit (0.0f, 100.0f, p.chaosAmtF) * 0.02f) : 1.0f;
+    auto filterSamples = [&] (float cutoff, int slope, int modTarget)
+    {
+        const float modShift = std::exp2 (-ModMatrix::getMaxDepth (p.modMatrix, modTarget) * ModMatrix::kTargetRange[modTarget]);
+        const double f = limit (kFilterFreqMin, kFilterFreqMax, cutoff * filterShift * modShift);
+        const double q = slope == 0 ? 0.5 : (slope == 1 ? (double) kSqrt2Over2 : (double) kBW4_Q2);
+        return decaySamples (std::exp (-kPiD * f / (q * sr)));
+    };
+    if (p.hpOn) tail += filterSamples (p.hpFreq, p.hpSlope, ModMatrix::TargetHp);
+    if (p.lpOn) tail += filterSamples (p.lpFreq, p.lpSlope, ModMatrix::TargetLp);
+
+    // ── Limiter: the 100 ms release remembers past peaks ──
+    if (p.limMode != 0)
+        tail += decaySamples (std::exp (-1.0 / (sr * 0.100)));
+
+    // ── Smoothers start from prepare()'s values; the frequency glide is the slowest ──
+    const double glideTau = p.midiFreqHz > 0.0f ? kMidiGlideTauMax : kFreqTauDefault;
+    tail += decaySamples (std::exp (-1.0 / (sr * glideTau)));
+
+    // ── Envelope follower: its release falls through the 60 dB it maps ──
+    if (ModMatrix::usesSource (p.modMatrix, ModMatrix::SourceEnv))
+        tail += std::max (0.0f, p.modMatrix.envReleaseMs) * 0.001 * sr * std::log (1000.0);
+
+    return std::min (tail / sr, kMaxTailSeconds);
+}
+
+bool DisperserEngine::computeResponse (const Params& p, double sampleRate, const float* freqsHz, int numFreqs,
+                                       std::complex<double>* dest) noexcept
+{
+    using Complex = std::complex<double>;
+    const double sr = std::max (1.0, sampleRate);
+    const float srF = (float) sr;
+
+    // Settled values, exactly as processChunk derives them.
+    const float freq   = (p.midiFreqHz > 0.0f ? p.midiFreqHz : p.freqHz) * modFreqMultiplier (p.mod);
+    const float shape  = limit (0.0f, 1.0f, p.shape);
+    const int   stages = limit (0, kMaxStages, p.stages);
+    const int   series = limit (1, kMaxSeries, p.series);
+    const double fb    = mapFeedback (p.feedback);
+
+    // First-order all-pass (−a + z⁻¹) / (1 − a z⁻¹); a DELAY section is the
+    // same with z⁻ᴹ and gain g.
+    const bool delayStages = p.stageType == 1;
+    const int numSections  = delayStages ? std::min (kMaxDelaySections, (stages + kStagesPerDelaySection - 1) / kStagesPerDelaySection) : stages;
+    float coeffs[kMaxStages];
+    if (delayStages && numSections > 0)
+    {
+        computeStageFreqs (freq, shape, numSections, srF, coeffs);
+        for (int i = 0; i < numSections; ++i)
+            coeffs[i] = std::max (1.0f, srF / std::max (coeffs[i], kDelayMinFreq));   // section delay M
+    }
+    else if (numSections > 0)
+    {
+        computeStageCoeffs (freq, shape, numSections, srF, coeffs);
+    }
+
+    auto biquad = [] (const BiquadCoeffs& c, Complex z1)
+    {
+        const Complex z2 = z1 * z1;
+        return ((double) c.b0 + (double) c.b1 * z1 + (double) c.b2 * z2) / (1.0 + (double) c.a1 * z1 + (double) c.a2 * z2);
+    };
+
+    const float filterMax = std::min (kFilterFreqMax, 0.49f * srF);
+    BiquadCoeffs hp[2], lp[2];
+    if (p.hpOn)
+        calcWetFilterCoeffs (true, limit (kFilterFreqMin, filterMax, p.hpFreq), limit (kFilterSlopeMin, kFilterSlopeMax, p.hpSlope), srF, hp);
+    if (p.lpOn)
+        calcWetFilterCoeffs (false, limit (kFilterFreqMin, filterMax, p.lpFreq), limit (kFilterSlopeMin, kFilterSlopeMax, p.lpSlope), srF, lp);
+
+    const bool tiltOn = std::abs (p.tiltDb) > 0.05f;
+    float tiltB0 = 1.0f, tiltB1 = 0.0f, tiltA1 = 0.0f;
+    if (tiltOn)
+        calcTiltCoeffs (p.tiltDb, sr, tiltB0, tiltB1, tiltA1);
+
+    // ── Blend: the wet path carries input × output gain, the dry path neither ──
+    const double mix = limit (0.0f, 1.0f, p.mix);
+    const double wetGain = (double) fastDecibelsToGain (limit (kGainMinDb, kInputMaxDb, p.inputDb))
+                         * (double) fastDecibelsToGain (limit (kGainMinDb, kOutputMaxDb, p.outputDb))
+                         * (p.invPol == 1 ? -1.0 : 1.0);
+    double dryMix = 0.0, wetMix = 1.0;
+    if (p.mixMode == 1)           { dryMix = p.dryLevel;  wetMix = p.wetLevel; }
+    else if (mix < 0.999)         { dryMix = 1.0 - mix;   wetMix = mix; }
+
+    double outGain = p.invPol == 2 ? -1.0 : 1.0;
+    if (std::abs (p.pan - 0.5f) > 0.001f)
+        outGain *= std::cos (p.pan * 1.5707963f);
+
+    for (int k = 0; k < numFreqs; ++k)
+    {
+        const double w = 2.0 * kPiD * limit (0.0, 0.5 * sr, (double) freqsHz[k]) / sr;
+        const Complex z1 = std::polar (1.0, -w);
+
+        Complex chain (1.0, 0.0);
+        for (int i = 0; i < numSections; ++i)
+        {
+            const double sign = (p.alt && (i & 1)) ? -1.0 : 1.0;
+            if (delayStages)
+            {
+                const double g = sign * kDelayAllPassGain;
+                const Complex zm = std::polar (1.0, -w * coeffs[i]);
+                chain *= (zm - g) / (1.0 - g * zm);
+            }
+            else
+            {
+                const double a = sign * coeffs[i];
+                chain *= (z1 - a) / (1.0 - a * z1);
+            }
+        }
+
+        Complex cascade = chain;
+        for (int s = 1; s < series; ++s)
+            cascade *= chain;
+
+        Complex wet = fb != 0.0 ? cascade / (1.0 - fb * z1 * cascade) : cascade;
+        if (p.hpOn) wet *= biquad (hp[0], z1) * biquad (hp[1], z1);
+        if (p.lpOn) wet *= biquad (lp[0], z1) * biquad (lp[1], z1);
+        if (tiltOn) wet *= ((double) tiltB0 + (double) tiltB1 * z1) / (1.0 + (double) tiltA1 * z1);
+
+        dest[k] = outGain * (dryMix + wetMix * wetGain * wet);
+    }
+
+    bool modulated = false;
+    for (int t = 0; t < ModMatrix::kNumTargets; ++t)
+        modulated = modulated || ModMatrix::getMaxDepth (p.modMatrix, t) > 0.0f;
+
+    return p.modeIn == 0 && p.modeOut == 0 && p.sumBus == 0 && p.invStr == 0 && p.limMode == 0
+        && ! (p.style == 2 && fb != 0.0) && ! p.chaosDelay && ! p.chaosFilter && ! modulated;
+}
+
+DisperserEngine::CostEstimate DisperserEngine::estimateCost (const Params& p, int blockSize, int numChannels, simd::Isa isa,
+                                                             float maxErrorDb, const cost::Profile& prof) noexcept
+{
+    CostEstimate est;
+
+    const int chunk    = std::max (1, blockSize);
+    const int channels = limit (1, kMaxChannels, numChannels);
+    const int style    = limit (0, 3, p.style);
+    const int stages   = limit (0, kMaxStages, p.stages);
+    const int series   = limit (1, kMaxSeries, p.series);
+    const int total    = stages * series;
+    const int chains   = (style >= 1 && channels > 1) ? 2 : 1;
+
+    // ── Around the cascade ──
+    auto sections = [] (bool on, int slope) { return on ? (limit (kFilterSlopeMin, kFilterSlopeMax, slope) == 2 ? 2 : 1) : 0; };
+    double frameNs = prof.frameNs
+                   + prof.biquadNs * channels * (sections (p.hpOn, p.hpSlope) + sections (p.lpOn, p.lpSlope));
+    if (p.tiltDb != 0.0f)  frameNs += prof.tiltNs;
+    if (p.limMode != 0)    frameNs += prof.limiterNs;
+    if (p.chaosDelay)      frameNs += prof.chaosDelayNs;
+    if (p.chaosFilter)     frameNs += prof.chaosFilterNs;
+
+    // ── Cascade ──
+    // Series share one set of coefficients, so the per-sample path pays for
+    // their updates once per stage.
+    const bool cascadeModulated = p.chaosDelay
+                               || ModMatrix::getMaxDepth (p.modMatrix, ModMatrix::TargetFreq) > 0.0f
+                               || ModMatrix::getMaxDepth (p.modMatrix, ModMatrix::TargetShape) > 0.0f
+                               || ModMatrix::getMaxDepth (p.modMatrix, ModMatrix::TargetFeedback) > 0.0f;
+    const double smoothedNs = total * (double) prof.smoothedNs
+                            + stages * (double) (prof.coeffNs + (style == 3 ? prof.dualCoeffNs : 0.0f));
+
+    double settledNs = 0.0, glidingNs = 0.0;
+    if (p.stageType == 1)
+    {
+        const int numSections = std::min (kMaxDelaySections, (stages + kStagesPerDelaySection - 1) / kStagesPerDelaySection);
+        est.path  = cost::PathDelay;
+        settledNs = glidingNs = prof.delayFrameNs + (double) numSections * series * chains * prof.delaySectionNs;
+    }
+    else if (cascadeModulated)
+    {
+        est.path  = cost::PathSmoothed;
+        settledNs = glidingNs = smoothedNs;
+    }
+    else if (total == 0)
+    {
+        est.path = cost::PathNone;
+    }
+    else if (mapFeedback (p.feedback) != 0.0f)
+    {
+        est.path  = cost::PathSampleMajor;
+        settledNs = total * (double) prof.sampleMajorNs;
+        glidingNs = smoothedNs;
+    }
+    else
+    {
+        const int wavefront = cost::chooseWavefrontStages (total, chunk, isa, maxErrorDb, prof);
+        est.path  = cost::getSplitPath (total, wavefront);
+        settledNs = chains * cost::getCascadeChunkNs (total, wavefront, chunk, isa, prof) / chunk;
+        glidingNs = smoothedNs;
+    }
+
+    est.settledNs = frameNs + settledNs;
+    est.glidingNs = frameNs + glidingNs;
+    return est;
+}
+
+//==============================================================================
+void DisperserEngine::calcWetFilterCoeffs (bool highPass, float freq, int slope, float sr, BiquadCoeffs dest[2]) noexcept
+{
+    constexpr float kBW2_Q = 0.70710678f;  // 1/sqrt(2)
+
+    if (slope == 0)      // 6 dB/oct — single 1-pole
+    {
+        dest[0] = highPass ? calcOnePoleHP (freq, sr) : calcOnePoleLP (freq, sr);
+        dest[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };  // pass-through
+    }
+    else if (slope == 1) // 12 dB/oct — single Butterworth biquad
+    {
+        dest[0] = highPass ? calcBiquadHP (freq, sr, kBW2_Q) : calcBiquadLP (freq, sr, kBW2_Q);
+        dest[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    }
+    else                 // 24 dB/oct — two cascaded Butterworth biquads
+    {
+        dest[0] = highPass ? calcBiquadHP (freq, sr, kBW4_Q1) : calcBiquadLP (freq, sr, kBW4_Q1);
+        dest[1] = highPass ? calcBiquadHP (freq, sr, kBW4_Q2) : calcBiquadLP (freq, sr, kBW4_Q2);
+    }
+}
+
+void DisperserEngine::updateFilterCoeffs (bool forceHp, bool forceLp)
+{
+    const float sr = (float) currentSampleRate;
+    const int hpSlope = filterHpSlope_;
+    const int lpSlope = filterLpSlope_;
+
+    const float hpFreq = limit (kFilterFreqMin, std::min (kFilterFreqMax, 0.49f * sr), smoothedFilterHpFreq_);
+    const float lpFreq = limit (kFilterFreqMin, std::min (kFilterFreqMax, 0.49f * sr), smoothedFilterLpFreq_);
+
+    if (forceHp || hpSlope != lastCalcHpSlope_ || std::abs (hpFreq - lastCalcHpFreq_) > 0.01f)
+    {
+        lastCalcHpFreq_  = hpFreq;
+        lastCalcHpSlope_ = hpSlope;
+        calcWetFilterCoeffs (true, hpFreq, hpSlope, sr, hpCoeffs_);
+    }
+
+    if (forceLp || lpSlope != lastCalcLpSlope_ || std::abs (lpFreq - lastCalcLpFreq_) > 0.01f)
+    {
+        lastCalcLpFreq_  = lpFreq;
+        lastCalcLpSlope_ = lpSlope;
+        calcWetFilterCoeffs (false, lpFreq, lpSlope, sr, lpCoeffs_);
+    }
+}
+
+void DisperserEngine::updateWetFilterCoeffs (bool hpOn, bool lpOn, float hpModOct, float lpModOct)
+{
+    const bool chaosF = chaosFilterEnabled_ && chaosAmtF_ > 0.01f;
+    if (! chaosF && hpModOct == 0.0f && lpModOct == 0.0f)
+    {
+        updateFilterCoeffs (false, false);
+        hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
+        lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
+        return;
+    }
+
+    const float sHp = smoothedFilterHpFreq_;
+    const float sLp = smoothedFilterLpFreq_;
+    const float hpBase = hpOn ? sHp : kFilterFreqMin;
+    const float lpBase = lpOn ? sLp : kFilterFreqMax;
+
+    // L channel coefficients
+    const float octL = chaosF ? chaosFOut_[0] * smoothedChaosFilterMaxOct_ : 0.0f;
+    smoothedFilterHpFreq_ = limit (kFilterFreqMin, kFilterFreqMax, hpBase * std::exp2 (octL + hpModOct));
+    smoothedFilterLpFreq_ = limit (kFilterFreqMin, kFilterFreqMax, lpBase * std::exp2 (octL + lpModOct));
+    updateFilterCoeffs (true, true);
+
+    if (chaosF && chaosStereo_)
+    {
+        auto hpL0 = hpCoeffs_[0]; auto hpL1 = hpCoeffs_[1];
+        auto lpL0 = lpCoeffs_[0]; auto lpL1 = lpCoeffs_[1];
+
+        const float octR = chaosFOut_[1] * smoothedChaosFilterMaxOct_;
+        smoothedFilterHpFreq_ = limit (kFilterFreqMin, kFilterFreqMax, hpBase * std::exp2 (octR + hpModOct));
+        smoothedFilterLpFreq_ = limit (kFilterFreqMin, kFilterFreqMax, lpBase * std::exp2 (octR + lpModOct));
+        updateFilterCoeffs (true, true);
+
+        hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
+        lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
+        hpCoeffs_[0] = hpL0; hpCoeffs_[1] = hpL1;
+        lpCoeffs_[0] = lpL0; lpCoeffs_[1] = lpL1;
+    }
+    else
+    {
+        hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
+        lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
+    }
+
+    smoothedFilterHpFreq_ = sHp;
+    smoothedFilterLpFreq_ = sLp;
+}
+
+float DisperserEngine::calcAllPassCoeff (float frequency, float sampleRate) noexcept
+{
+    const float f = limit (20.0f, 0.49f * sampleRate, frequency);
+    const float t = std::tan (kPi * f / sampleRate);
+    if (! std::isfinite (t))
+        return 0.0f;
+    return (1.0f - t) / (1.0f + t);
+}
+
+void DisperserEngine::clearStageRange (int fromStageInclusive, int toStageExclusive, int seriesCount) noexcept
+{
+    const int fromStage = limit (0, kMaxStages, fromStageInclusive);
+    const int toStage = limit (0, kMaxStages, toStageExclusive);
+    const int nSeries = limit (1, kMaxSeries, seriesCount);
+
+    if (toStage <= fromStage)
+        return;
+
+    for (int s = 0; s < nSeries; ++s)
+    {
+        auto* left = chainL[(size_t) s].data();
+        auto* right = chainR[(size_t) s].data();
+        for (int st = fromStage; st < toStage; ++st)
+        {
+            left[st].z1 = 0.0f;
+            right[st].z1 = 0.0f;
+        }
+    }
+}
+
+void DisperserEngine::updateCoefficientsInto (float freqHz, float shapeNorm, int stages, std::vector<float>& dest)
+{
+    if ((int) dest.size() < std::max (1, stages))
+        dest.assign ((size_t) kMaxStages, 0.0f);
+
+    computeStageCoeffs (freqHz, shapeNorm, stages, (float) currentSampleRate, dest.data());
+}
+
+void DisperserEngine::computeStageCoeffs (float freqHz, float shapeNorm, int stages, float sr, float* dest) noexcept
+{
+    const int nStages = std::max (1, stages);
+    computeStageFreqs (freqHz, shapeNorm, nStages, sr, dest);
+    for (int i = 0; i < nStages; ++i)
+        dest[i] = calcAllPassCoeff (dest[i], sr);
+}
+
+void DisperserEngine::computeStageFreqs (float freqHz, float shapeNorm, int stages, float sr, float* dest) noexcept
+{
+    const int nStages = std::max (1, stages);
+    const float minFreq = 20.0f;
+    const float maxFreq = 0.49f * sr;
+    const float center = limit (minFreq, maxFreq, freqHz);
+    const float shape = limit (0.0f, 1.0f, shapeNorm);
+
+    const float logPos = std::log2 (center / minFreq) / std::log2 (maxFreq / minFreq);
+    const float lowComp = std::pow (limit (0.0f, 1.0f, 1.0f - logPos), 1.15f);
+    const float shapeStrength = 1.0f + (0.95f * lowComp);
+    const float shapeComp = limit (0.0f, 1.0f, 0.5f + ((shape - 0.5f) * shapeStrength));
+
+    const float spreadMax = 4.0f + (1.1f * lowComp);
+    const float spreadMin = 0.12f;
+    const float spreadOct = map (shapeComp, spreadMax, spreadMin);
+    const float warpGamma = map (shapeComp, 0.45f, 3.0f + (0.8f * lowComp));
+
+    if (nStages == 1)
+    {
+        dest[0] = center;
+        return;
+    }
+
+    const float denom = (float) std::max (1, nStages - 1);
+    for (int i = 0; i < nStages; ++i)
+    {
+        const float u = (2.0f * ((float) i / denom)) - 1.0f;
+        const float absWarped = std::pow (std::abs (u), warpGamma);
+        const float warped = std::copysign (absWarped, u);
+        const float oct = 0.5f * spreadOct * warped;
+        dest[i] = limit (minFreq, maxFreq, center * std::pow (2.0f, oct));
+    }
+}
+
+void DisperserEngine::updateCoefficients (float freqHz, float shapeNorm, int stages)
+{
+    updateCoefficientsInto (freqHz, shapeNorm, stages, stageCoeff);
+}
+
+void DisperserEngine::processCascadeNoFeedback (float* ch0, float* ch1, int numSamples, int stages,
+    bool altEnabled, bool processR, bool negateCoeffR, bool dualCoeffR) noexcept
+{
+    // Gather: series are just more stages in the chain, so flatten to one run.
+    const int total = activeSeries * stages;
+    for (int s = 0; s < activeSeries; ++s)
+    {
+        for (int st = 0; st < stages; ++st)
+        {
+            const size_t i = (size_t) (s * stages + st);
+            const bool flip = altEnabled && (st & 1);
+            const float a = flip ? -stageCoeff[(size_t) st] : stageCoeff[(size_t) st];
+            cascadeCoeffL[i] = a;
+            cascadeStateL[i] = chainL[(size_t) s][(size_t) st].z1;
+
+            if (processR)
+            {
+                cascadeCoeffR[i] = negateCoeffR ? -a
+                                 : (dualCoeffR ? (flip ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                cascadeStateR[i] = chainR[(size_t) s][(size_t) st].z1;
+            }
+        }
+    }
+
+    // Wavefront / scan split for this chunk length, from the cost model.
+    const int wavefront = cost::chooseWavefrontStages (total, numSamples, dspIsa, maxErrorDb, *costProfile);
+    cascadePath = cost::getSplitPath (total, wavefront);
+
+    if (processR && taskExecutor != nullptr && total * numSamples >= kMinTaskWork)
+    {
+        // L and R share nothing here, so each can run on another thread.
+        pendingTasks[0] = { ch0, numSamples, cascadeCoeffL.data(), cascadeStateL.data(), total, wavefront };
+        pendingTasks[1] = { ch1, numSamples, cascadeCoeffR.data(), cascadeStateR.data(), total, wavefront };
+        if (! taskExecutor (taskContext, 2))
+        {
+            runTask (0);
+            runTask (1);
+        }
+    }
+    else
+    {
+        runCascade (ch0, numSamples, cascadeCoeffL.data(), cascadeStateL.data(), total, wavefront);
+        if (processR)
+            runCascade (ch1, numSamples, cascadeCoeffR.data(), cascadeStateR.data(), total, wavefront);
+        else if (ch1 != nullptr)
+            std::copy (ch0, ch0 + numSamples, ch1);
+    }
+
+    // Scatter the advanced states back.
+    for (int s = 0; s < activeSeries; ++s)
+    {
+        for (int st = 0; st < stages; ++st)
+        {
+            const size_t i = (size_t) (s * stages + st);
+            chainL[(size_t) s][(size_t) st].z1 = cascadeStateL[i];
+            if (processR)
+                chainR[(size_t) s][(size_t) st].z1 = cascadeStateR[i];
+        }
+    }
+
+    feedbackLastL = ch0[numSamples - 1];
+    if (ch1 != nullptr)
+        feedbackLastR = ch1[numSamples - 1];
+}
+
+void DisperserEngine::runCascade (float* data, int numSamples, const float* coeffs, float* state,
+                                  int numStages, int wavefrontStages) const noexcept
+{
+    // The first wavefrontStages stages run in the wavefront kernel (which takes
+    // whole vector groups and runs the rest per sample), the others as a block
+    // scan; both keep the same z1, so the split can move between chunks.
+    if (wavefrontStages > 0)
+        kernels->allpassCascade (data, numSamples, coeffs, state, wavefrontStages);
+    if (wavefrontStages < numStages)
+        kernels->allpassCascadeScan (data, numSamples, coeffs + wavefrontStages, state + wavefrontStages,
+                                     numStages - wavefrontStages);
+}
+
+void DisperserEngine::runTask (int index) noexcept
+{
+    if (index < 0 || index >= kMaxChannels)
+        return;
+
+    // Host worker threads don't necessarily flush denormals; the audio thread
+    // does, and tasks must produce the same samples wherever they run.
+   #if DISPTR_X86
+    const unsigned int csr = _mm_getcsr();
+    _mm_setcsr (csr | 0x8040);   // FTZ | DAZ
+   #endif
+
+    const auto& t = pendingTasks[(size_t) index];
+    runCascade (t.data, t.numSamples, t.coeffs, t.state, t.numStages, t.wavefrontStages);
+
+   #if DISPTR_X86
+    _mm_setcsr (csr);
+   #endif
+}
+
+void DisperserEngine::applyChaosGain (float* ch0, float* ch1, int n) noexcept
+{
+    if (! chaosDelayEnabled_ || chaosAmtD_ <= 0.01f)
+        return;
+
+    {
+        const float gainDb  = chaosGOut_[0] * smoothedChaosGainMaxDb_;
+        const float ex = gainDb * 0.16609640474f;
+        const float exln2 = ex * 0.6931472f;
+        const float gainLin = 1.0f + exln2 * (1.0f + exln2 * 0.5f);
+        ch0[n] *= gainLin;
+    }
+    if (ch1 != nullptr)
+    {
+        const float gainDb  = chaosGOut_[1] * smoothedChaosGainMaxDb_;
+        const float ex = gainDb * 0.16609640474f;
+        const float exln2 = ex * 0.6931472f;
+        const float gainLin = 1.0f + exln2 * (1.0f + exln2 * 0.5f);
+        ch1[n] *= gainLin;
+    }
+}
+
+//==============================================================================
+void DisperserEngine::clearDelaySections (int fromSection, int toSection, int fromSeries, int toSeries) noexcept
+{
+    if (delayArena.empty())
+        return;
+
+    fromSection = limit (0, kMaxDelaySections, fromSection);
+    toSection   = limit (0, kMaxDelaySections, toSection);
+    fromSeries  = limit (0, kMaxSeries, fromSeries);
+    toSeries    = limit (0, kMaxSeries, toSeries);
+
+    for (int s = fromSeries; s < toSeries; ++s)
+        for (int i = fromSection; i < toSection; ++i)
+            for (int ch = 0; ch < kMaxChannels; ++ch)
+                std::fill_n (delayRing (s, i, ch), delayRingSize, 0.0f);
+}
+
+void DisperserEngine::updateDelayTargets (float freqHz, float shapeNorm, int sections, bool dualR, int rampFrom) noexcept
+{
+    const float sr = (float) currentSampleRate;
+    const float maxDelay = (float) (delayRingSize - 2);
+    const float step = 1.0f / (float) kCoeffUpdateInterval;
+    float freqs[kMaxDelaySections];
+
+    auto update = [&] (float centre, float* current, float* delta)
+    {
+        computeStageFreqs (centre, shapeNorm, sections, sr, freqs);
+        for (int i = 0; i < sections; ++i)
+        {
+            const float target = limit (1.0f, maxDelay, sr / std::max (freqs[i], kDelayMinFreq));
+            if (i < rampFrom)
+            {
+                delta[i] = (target - current[i]) * step;
+            }
+            else
+            {
+                current[i] = target;
+                delta[i] = 0.0f;
+            }
+        }
+    };
+
+    update (freqHz, delayCurrent.data(), delayStep.data());
+    if (dualR)
+        update (freqHz * 0.5f, delayCurrentR.data(), delayStepR.data());
+}
+
+void DisperserEngine::processDelayCascade (float* ch0, float* ch1, int numSamples, float targetFreq,
+    bool altEnabled, bool processR, bool crossFbk, bool negateR, bool dualR,
+    const float* modFreq, const float* modShape, const float* modFeedback) noexcept
+{
+    const bool hasStereo = (ch1 != nullptr);
+    const int mask = delayRingMask;
+    const float stagesPerSection = 1.0f / (float) kStagesPerDelaySection;
+    float modFreqMul = 1.0f;
+
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float smoothedStages = limit (0.0f, (float) kMaxStages, stagesSmoothed.getNextValue());
+        smoothedFreqValue += (targetFreq - smoothedFreqValue) * (1.0f - freqEmaCoeff);
+        float smoothedFreq = smoothedFreqValue;
+        float smoothedShape = shapeSmoothed.getNextValue();
+        float fb = feedbackSmoothed.getNextValue();
+
+        if (chaosDelayEnabled_)
+        {
+            advanceChaosD();
+            if (chaosAmtD_ > 0.01f)
+                smoothedFreq = limit (20.0f, 20000.0f, smoothedFreq * std::exp2 (chaosDOut_[0] * smoothedChaosFreqMaxOct_));
+        }
+
+        const int seg = n / ModMatrix::kSegmentSize;
+        if (modFreq != nullptr)
+        {
+            if (n % ModMatrix::kSegmentSize == 0)
+                modFreqMul = std::exp2 (modFreq[seg]);
+            smoothedFreq = limit (20.0f, 20000.0f, smoothedFreq * modFreqMul);
+        }
+        if (modShape != nullptr)
+            smoothedShape = limit (0.0f, 1.0f, smoothedShape + modShape[seg]);
+        if (modFeedback != nullptr)
+            fb = limit (-1.0f, 1.0f, fb + modFeedback[seg]);
+
+        // The last section fades in as STAGES crosses into it.
+        const float sectionPos = smoothedStages * stagesPerSection;
+        const int sections = limit (0, kMaxDelaySections, (int) std::ceil (sectionPos - 1.0e-4f));
+        const float lastFrac = limit (0.0f, 1.0f, sectionPos - (float) (sections - 1));
+
+        const bool grew = sections > activeDelaySections;
+        if (grew)
+            clearDelaySections (activeDelaySections, sections, 0, activeSeries);
+
+        --coeffUpdateCountdown;
+        if (coeffUpdateCountdown <= 0 || grew)
+        {
+            coeffUpdateCountdown = kCoeffUpdateInterval;
+            updateDelayTargets (smoothedFreq, smoothedShape, sections, dualR,
+                                delaySnap ? 0 : std::min (activeDelaySections, sections));
+            delaySnap = false;
+        }
+        activeDelaySections = sections;
+
+        if (sections > 0)
+        {
+            float xL = ch0[n] + fb * (crossFbk ? feedbackLastR : feedbackLastL);
+            float xR = processR ? (ch1[n] + fb * (crossFbk ? feedbackLastL : feedbackLastR)) : xL;
+            const int w = delayWritePos;
+
+            for (int s = 0; s < activeSeries; ++s)
+            {
+                for (int i = 0; i < sections; ++i)
+                {
+                    const float g = (altEnabled && (i & 1)) ? -kDelayAllPassGain : kDelayAllPassGain;
+                    const float frac = (i == sections - 1) ? lastFrac : 1.0f;
+
+                    {
+                        float* ring = delayRing (s, i, 0);
+                        const float d = delayCurrent[(size_t) i];
+                        const int di = (int) d;
+                        const float a0 = ring[(w - di) & mask];
+                        const float vd = a0 + (d - (float) di) * (ring[(w - di - 1) & mask] - a0);
+                        const float v = xL + g * vd;
+                        ring[w] = v;
+                        xL += frac * ((vd - g * v) - xL);
+                    }
+
+                    if (processR)
+                    {
+                        // WIDE: −g (complementary phase), DUAL: half-rate delays
+                        const float gR = negateR ? -g : g;
+                        float* ring = delayRing (s, i, 1);
+                        const float d = dualR ? delayCurrentR[(size_t) i] : delayCurrent[(size_t) i];
+                        const int di = (int) d;
+                        const float a0 = ring[(w - di) & mask];
+                        const float vd = a0 + (d - (float) di) * (ring[(w - di - 1) & mask] - a0);
+                        const float v = xR + gR * vd;
+                        ring[w] = v;
+                        xR += frac * ((vd - gR * v) - xR);
+                    }
+                }
+            }
+
+            ch0[n] = xL;
+            feedbackLastL = xL;
+            if (hasStereo)
+            {
+                ch1[n] = processR ? xR : xL;
+                feedbackLastR = processR ? xR : xL;
+            }
+        }
+
+        for (int i = 0; i < sections; ++i)
+            delayCurrent[(size_t) i] += delayStep[(size_t) i];
+        if (dualR)
+            for (int i = 0; i < sections; ++i)
+                delayCurrentR[(size_t) i] += delayStepR[(size_t) i];
+        delayWritePos = (delayWritePos + 1) & mask;
+
+        applyChaosGain (ch0, ch1, n);
+    }
+}
+
+//==============================================================================
+void DisperserEngine::process (float* const* channels, int numChannels, int numSamples, const Params& p) noexcept
+{
+    numChannels = std::min (numChannels, kMaxChannels);
+    if (maxChunkSize <= 0 || numChannels <= 0 || numSamples <= 0)
+        return;
+
+    // The dry copy is sized for maxChunkSize, so longer calls run in pieces.
+    for (int start = 0; start < numSamples; start += maxChunkSize)
+    {
+        float* chunk[kMaxChannels] {};
+        for (int ch = 0; ch < numChannels; ++ch)
+            chunk[ch] = channels[ch] + start;
+
+        processChunk (chunk, numChannels, std::min (maxChunkSize, numSamples - start), p, start);
+    }
+}
+
+void DisperserEngine::loadChaosParams (const Params& p) noexcept
+{
+    chaosFilterEnabled_ = p.chaosFilter;
+    chaosDelayEnabled_  = p.chaosDelay;
+    const bool anyChaos = chaosFilterEnabled_ || chaosDelayEnabled_;
+    if (anyChaos)
+    {
+        if (chaosDelayEnabled_)
+        {
+            const float rawAmtD = p.chaosAmtD;
+            const float rawSpdD = limit (kChaosSpdMin, kChaosSpdMax, p.chaosSpdD);
+            chaosAmtD_       = rawAmtD;
+            chaosAmtNormD_   = rawAmtD * 0.01f;
+            chaosShPeriodD_  = (float) currentSampleRate / rawSpdD;
+            chaosFreqMaxOct_ = chaosAmtNormD_ * 2.0f;   // ±2 oct at 100%
+            chaosGainMaxDb_  = chaosAmtNormD_ * 1.0f;    // ±1 dB at 100%
+        }
+        else
+        {
+            chaosFreqMaxOct_ = 0.0f;
+            chaosGainMaxDb_ = 0.0f;
+        }
+
+        if (chaosFilterEnabled_)
+        {
+            const float rawAmtF = p.chaosAmtF;
+            const float rawSpdF = limit (kChaosSpdMin, kChaosSpdMax, p.chaosSpdF);
+            chaosAmtF_       = rawAmtF;
+            chaosShPeriodF_  = (float) currentSampleRate / rawSpdF;
+            const float amtNormF = rawAmtF * 0.01f;
+            chaosFilterMaxOct_ = amtNormF * 2.0f;  // ±2 oct at 100%
+        }
+        else
+        {
+            chaosFilterMaxOct_ = 0.0f;
+        }
+
+        chaosParamSmoothCoeff_ = cachedChaosParamSmoothCoeff_;
+    }
+    else
+    {
+        chaosAmtD_ = 0.0f; chaosAmtF_ = 0.0f;
+        chaosFreqMaxOct_ = 0.0f;
+        chaosGainMaxDb_ = 0.0f;
+        chaosFilterMaxOct_ = 0.0f;
+    }
+
+    chaosStereo_ = (limit (0, 3, p.style) >= 1);
+}
+
+void DisperserEngine::calcTiltCoeffs (float tiltDb, double sampleRate, float& b0, float& b1, float& a1) noexcept
+{
+    const double pivot = 1000.0;
+    const double octToNy = std::log2 ((sampleRate * 0.5) / pivot);
+    const double gainNyDb = static_cast<double> (tiltDb) * octToNy;
+    const double gNy = std::pow (10.0, gainNyDb / 20.0);
+    const double wc = 2.0 * sampleRate
+                    * std::tan (kPiD * pivot / sampleRate);
+    const double K = wc / (2.0 * sampleRate);
+    const double g = std::sqrt (gNy);
+    const double norm = 1.0 / (1.0 + K * g);
+    b0 = static_cast<float> ((g + K) * norm);
+    b1 = static_cast<float> ((K - g) * norm);
+    a1 = static_cast<float> ((K * g - 1.0) * norm);
+}
+
+void DisperserEngine::setTiltTarget (float tiltDb) noexcept
+{
+    lastTiltDb_ = tiltDb;
+    calcTiltCoeffs (tiltDb, currentSampleRate, tiltTargetB0_, tiltTargetB1_, tiltTargetA1_);
+}
+
+bool DisperserEngine::stepTiltCoeffs() noexcept
+{
+    if (std::abs (tiltDb_) > 0.05f)
+    {
+        if (std::abs (tiltDb_ - lastTiltDb_) > 0.02f)
+            setTiltTarget (tiltDb_);
+
+        // One smoothing step per chunk.
+        const float sc = tiltSmoothSc_;
+        tiltB0_ += (tiltTargetB0_ - tiltB0_) * sc;
+        tiltB1_ += (tiltTargetB1_ - tiltB1_) * sc;
+        tiltA1_ += (tiltTargetA1_ - tiltA1_) * sc;
+        return true;
+    }
+
+    if (std::abs (lastTiltDb_) > 0.05f)
+    {
+        lastTiltDb_ = 0.0f;
+        tiltB0_ = 1.0f; tiltB1_ = 0.0f; tiltA1_ = 0.0f;
+        tiltTargetB0_ = 1.0f; tiltTargetB1_ = 0.0f; tiltTargetA1_ = 0.0f;
+        tiltState_[0] = tiltState_[1] = 0.0f;
+    }
+    return false;
+}
+
+void DisperserEngine::stepTiltSegments (const float* tiltMod, float* const* channels, int numChannels, int numSamples) noexcept
+{
+    const float sc = tiltSegmentSc_;
+    for (int start = 0, k = 0; start < numSamples; start += ModMatrix::kSegmentSize, ++k)
+    {
+        const float dB = tiltDb_ + tiltMod[k];
+        if (std::abs (dB - lastTiltDb_) > 0.02f)
+            setTiltTarget (dB);
+
+        tiltB0_ += (tiltTargetB0_ - tiltB0_) * sc;
+        tiltB1_ += (tiltTargetB1_ - tiltB1_) * sc;
+        tiltA1_ += (tiltTargetA1_ - tiltA1_) * sc;
+
+        if (channels == nullptr)
+            continue;
+
+        const int len = std::min (ModMatrix::kSegmentSize, numSamples - start);
+        for (int ch = 0; ch < std::min (numChannels, 2); ++ch)
+        {
+            float* data = channels[ch] + start;
+            for (int n = 0; n < len; ++n)
+            {
+                const float x = data[n];
+                const float y = tiltB0_ * x + tiltState_[ch];
+                tiltState_[ch] = tiltB1_ * x - tiltA1_ * y;
+                data[n] = y;
+            }
+        }
+    }
+}
+
+void DisperserEngine::processInputStage (const float* const* in, float* const* wet, int numChannels, int numSamples,
+                                         const Params& p, int modeIn, const float* modHp, const float* modLp,
+                                         bool applyTilt) noexcept
+{
+    const bool encode = modeIn > 0 && numChannels > 1;
+    const bool hpOn = filterPre_ && p.hpOn;
+    const bool lpOn = filterPre_ && p.lpOn;
+    const bool filter = hpOn || lpOn;
+
+    // Filters off but chaos F enabled: advance S&H to keep phase continuous
+    if (filterPre_ && ! filter && chaosFilterEnabled_)
+        for (int n = 0; n < numSamples; ++n)
+            advanceChaosF();
+
+    if (! encode && ! filter && ! applyTilt)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            if (wet[ch] != in[ch])
+                std::copy (in[ch], in[ch] + numSamples, wet[ch]);
+        return;
+    }
+
+    const float targetHpFreq = limit (kFilterFreqMin, kFilterFreqMax, p.hpFreq);
+    const float targetLpFreq = limit (kFilterFreqMin, kFilterFreqMax, p.lpFreq);
+    const int numSections_hp = (limit (kFilterSlopeMin, kFilterSlopeMax, p.hpSlope) == 2) ? 2 : 1;
+    const int numSections_lp = (limit (kFilterSlopeMin, kFilterSlopeMax, p.lpSlope) == 2) ? 2 : 1;
+
+    // Channel-major, so channel 1 sees the coefficients channel 0 ended the
+    // chunk with, as the separate passes did. Mode In gives both channels the
+    // same signal: the channel 0 pass stores it raw for channel 1 to continue
+    // from, which also keeps the encode safe when `wet` aliases `in`.
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const bool encodeHere = encode && ch == 0;
+        const float* src = (encode && ch == 1) ? wet[1] : in[ch];
+        float* out = wet[ch];
+        auto& fs = wetFilterState_[ch < 2 ? ch : 0];
+        const auto& hpC = (ch == 0) ? hpCoeffs_ : hpCoeffsR_;
+        const auto& lpC = (ch == 0) ? lpCoeffs_ : lpCoeffsR_;
+        const bool tilt = applyTilt && ch < 2;
+        float tiltZ = tilt ? tiltState_[ch] : 0.0f;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float x;
+            if (encodeHere)
+            {
+                const float L = in[0][n];
+                const float R = in[1][n];
+                x = (modeIn == 1 ? (L + R) : (L - R)) * kSqrt2Over2;
+                wet[1][n] = x;
+            }
+            else
+            {
+                x = src[n];
+            }
+
+            if (filter)
+            {
+                if (ch == 0)
+                {
+                    smoothedFilterHpFreq_ = smoothedFilterHpFreq_ * kGainSmoothCoeff
+                        + targetHpFreq * (1.0f - kGainSmoothCoeff);
+                    smoothedFilterLpFreq_ = smoothedFilterLpFreq_ * kGainSmoothCoeff
+                        + targetLpFreq * (1.0f - kGainSmoothCoeff);
+
+                    if (chaosFilterEnabled_) advanceChaosF();
+
+                    --filterCoeffCountdown_;
+                    if (filterCoeffCountdown_ <= 0)
+                    {
+                        filterCoeffCountdown_ = kFilterCoeffUpdateInterval;
+                        const int seg = n / ModMatrix::kSegmentSize;
+                        updateWetFilterCoeffs (hpOn, lpOn, modHp != nullptr ? modHp[seg] : 0.0f,
+                                                           modLp != nullptr ? modLp[seg] : 0.0f);
+                    }
+                }
+
+                if (hpOn)
+                    for (int s = 0; s < numSections_hp; ++s)
+                        x = processBiquad (hpC[s], fs.hp[s], x);
+
+                if (lpOn)
+                    for (int s = 0; s < numSections_lp; ++s)
+                        x = processBiquad (lpC[s], fs.lp[s], x);
+            }
+
+            if (tilt)
+            {
+                const float y = tiltB0_ * x + tiltZ;
+                tiltZ = tiltB1_ * x - tiltA1_ * y;
+                x = y;
+            }
+
+            out[n] = x;
+        }
+
+        if (tilt)
+            tiltState_[ch] = tiltZ;
+    }
+}
+
+void DisperserEngine::processChunk (float* const* channels, int numChannels, int numSamples, const Params& p,
+                                    int offsetInCall) noexcept
+{
+    // ── Mod matrix: one value per control segment for each routed target ──
+    modMatrix.render (channels, numChannels, numSamples, p.modMatrix, (double) offsetInCall);
+    const float* modFreq     = modMatrix.getTarget (ModMatrix::TargetFreq);
+    const float* modShape    = modMatrix.getTarget (ModMatrix::TargetShape);
+    const float* modFeedback = modMatrix.getTarget (ModMatrix::TargetFeedback);
+    const float* modTilt     = modMatrix.getTarget (ModMatrix::TargetTilt);
+    const float* modHp       = modMatrix.getTarget (ModMatrix::TargetHp);
+    const float* modLp       = modMatrix.getTarget (ModMatrix::TargetLp);
+
+    filterHpSlope_ = limit (kFilterSlopeMin, kFilterSlopeMax, p.hpSlope);
+    filterLpSlope_ = limit (kFilterSlopeMin, kFilterSlopeMax, p.lpSlope);
+
+    const int targetStages = limit (0, kMaxStages, p.stages);
+    const int targetSeries = limit (1, kMaxSeries, p.series);
+    float targetFreq = p.freqHz;
+    const float targetShape = limit (0.0f, 1.0f, p.shape);
+    const bool altEnabled = p.alt;
+
+    // MIDI frequency override (priority: MIDI > manual slider)
+    const bool midiNoteActive = p.midiFreqHz > 0.0f;
+    if (midiNoteActive)
+        targetFreq = p.midiFreqHz;
+
+    targetFreq *= modFreqMultiplier (p.mod);
+
+    // ── Smoothstep feedback mapping (sign-preserving bipolar) ─
+    const float targetFeedback = mapFeedback (p.feedback);
+
+    stagesSmoothed.setTargetValue ((float) targetStages);
+    shapeSmoothed.setTargetValue (targetShape);
+    feedbackSmoothed.setTargetValue (targetFeedback);
+
+    // ── MIX (dry/wet) ───────────────────────────────────────
+    const float mixValue = limit (0.0f, 1.0f, p.mix);
+    const int   mixMode  = p.mixMode;
+    const float dryLevel = (mixMode == 1) ? p.dryLevel : 0.0f;
+    const float wetLevel = (mixMode == 1) ? p.wetLevel : 0.0f;
+    const float* modMix  = (mixMode == 0) ? modMatrix.getTarget (ModMatrix::TargetMix) : nullptr;
+
+    // Filter / Tilt position
+    {
+        const int fltPos = p.filterPos;
+        // 0=F▼T▼  1=F▲T▲  2=F▲T▼  3=F▼T▲
+        filterPre_ = (fltPos == 1 || fltPos == 2);
+        tiltPre_   = (fltPos == 1 || fltPos == 3);
+    }
+
+    // ── TILT EQ parameter load ──
+    tiltDb_ = p.tiltDb;
+
+    // ── INPUT / OUTPUT gain (dB → linear, same as ECHO-TR) ───
+    const float inputGainDb  = limit (kGainMinDb, kInputMaxDb, p.inputDb);
+    const float outputGainDb = limit (kGainMinDb, kOutputMaxDb, p.outputDb);
+    const float inputGain    = fastDecibelsToGain (inputGainDb);
+    const float outputGain   = fastDecibelsToGain (outputGainDb);
+
+    // ── STYLE: 0=MONO, 1=STEREO, 2=WIDE, 3=DUAL ────────────
+    const int style = limit (0, 3, p.style);
+
+    // ── Sum Bus (needed early for needsDryBlend) ────────────
+    const int sumBusVal  = limit (0, 2, p.sumBus);
+
+    // Blended chunks build the wet path in wetBuffer and keep `channels` as the
+    // dry signal; full-wet chunks run in place. process() chunks at
+    // maxBlockSize, so the scratch always fits.
+    const bool needsDryBlend = (mixValue < 0.999f) || (sumBusVal != 0) || (mixMode == 1) || (modMix != nullptr);
+    std::array<float*, kMaxChannels> wetChannels {};
+    for (int ch = 0; ch < numChannels; ++ch)
+        wetChannels[(size_t) ch] = needsDryBlend ? wetBuffer[(size_t) ch].data() : channels[ch];
+    float* const* wet = wetChannels.data();
+
+    // ── MIDI glide: velocity-dependent EMA coefficient ──────
+    if (midiNoteActive)
+    {
+        const float vel  = (float) p.midiVelocity;
+        const float tLin = limit (0.0f, 1.0f, (vel - 1.0f) / 126.0f);
+        const float t    = std::pow (tLin, 0.05f);
+        const float tau  = kMidiGlideTauMax - t * (kMidiGlideTauMax - kMidiGlideTauMin);
+        freqEmaCoeff = std::exp (-1.0f / ((float) currentSampleRate * tau));
+    }
+    else
+    {
+        freqEmaCoeff = freqEmaCoeffDefault_;
+    }
+
+    // ── Direct mode (per-sample all-pass) ────────────────────
+
+    // Detect series change → start crossfade
+    if (targetSeries != activeSeries)
+    {
+        for (int s = 0; s < kMaxSeries; ++s)
+        {
+            xfadeChainL[(size_t) s] = chainL[(size_t) s];
+            xfadeChainR[(size_t) s] = chainR[(size_t) s];
+        }
+        previousSeries = activeSeries;
+        seriesXfadeTotalSamples = (int) std::round (currentSampleRate * kSeriesCrossfadeMs / 1000.0);
+        seriesXfadeSamplesRemaining = seriesXfadeTotalSamples;
+
+        if (targetSeries > activeSeries)
+        {
+            clearStageRange (0, kMaxStages, targetSeries);
+            clearDelaySections (0, activeDelaySections, activeSeries, targetSeries);
+        }
+        activeSeries = targetSeries;
+    }
+
+    const int modeInVal  = limit (0, 2, p.modeIn);
+    const int modeOutVal = limit (0, 2, p.modeOut);
+
+    const bool processR     = (style >= 1 && numChannels > 1);
+    const bool crossFbk     = (style == 2);  // WIDE
+    const bool negateCoeffR = (style == 2);  // WIDE: complementary phase
+    const bool dualCoeffR   = (style == 3);  // DUAL: separate R coefficients
+    const bool crossfading = (seriesXfadeSamplesRemaining > 0);
+
+    // ── Chaos per-block parameter read ──
+    loadChaosParams (p);
+
+    // ── TILT filter lambda (1-pole shelving, pivot 1 kHz) ──
+    auto applyTilt = [&]()
+    {
+        if (modTilt != nullptr)
+        {
+            stepTiltSegments (modTilt, wet, numChannels, numSamples);
+            return;
+        }
+
+        if (! stepTiltCoeffs())
+            return;
+
+        for (int ch = 0; ch < std::min (numChannels, 2); ++ch)
+        {
+            float* data = wet[ch];
+            for (int n = 0; n < numSamples; ++n)
+            {
+                const float x = data[n];
+                const float y = tiltB0_ * x + tiltState_[ch];
+                tiltState_[ch] = tiltB1_ * x - tiltA1_ * y;
+                data[n] = y;
+            }
+        }
+    };
+
+    // ── Input stage: Mode In, PRE filter and PRE tilt, into the wet path ──
+    // Modulated tilt steps its coefficients per control segment, so it keeps
+    // its own pass.
+    const bool fuseTilt = tiltPre_ && modTilt == nullptr && stepTiltCoeffs();
+    processInputStage (channels, wet, numChannels, numSamples, p, modeInVal, modHp, modLp, fuseTilt);
+    if (tiltPre_ && modTilt != nullptr)
+        applyTilt();
+
+    auto* ch0 = wet[0];
+    float* ch1 = (numChannels > 1) ? wet[1] : nullptr;
+    const bool hasStereo = (ch1 != nullptr);
+
+    const bool freqConverged = std::abs (smoothedFreqValue - targetFreq) < 0.01f;
+
+    // Fast path: parameters converged + no crossfade → tight inner loop
+    // without per-sample smoothing, coefficient checks, or fractional stages.
+    // Chaos D and mod matrix routes to FREQ/SHAPE/FEEDBACK force the slow path
+    // because they need per-sample coefficient modulation.
+    const bool cascadeModulated = modFreq != nullptr || modShape != nullptr || modFeedback != nullptr;
+
+    // Switching stage type: the chains being entered restart from silence.
+    const bool delayStages = (p.stageType == 1);
+    if (delayStages != delayMode)
+    {
+        delayMode = delayStages;
+        activeDelaySections = 0;
+        delaySnap = true;
+        clearStageRange (0, kMaxStages, kMaxSeries);
+        lastCoeffStages = -1;
+    }
+
+    if (delayMode)
+    {
+        // Series changes switch without the crossfade.
+        seriesXfadeSamplesRemaining = 0;
+        cascadePath = cost::PathDelay;
+        if (delayArena.empty())
+            delayRingsWanted = true;   // passes through until the rings arrive
+        else
+            processDelayCascade (ch0, ch1, numSamples, targetFreq, altEnabled, processR, crossFbk,
+                                 negateCoeffR, dualCoeffR, modFreq, modShape, modFeedback);
+    }
+    else if (!crossfading
+        && !stagesSmoothed.isSmoothing()
+        && freqConverged
+        && !shapeSmoothed.isSmoothing()
+        && !feedbackSmoothed.isSmoothing()
+        && !chaosDelayEnabled_
+        && !cascadeModulated)
+    {
+        smoothedFreqValue = targetFreq;   // snap EMA to avoid drift
+        const int stgs = activeStages;
+        const float fb = feedbackSmoothed.getCurrentValue();
+        cascadePath = stgs > 0 ? cost::PathSampleMajor : cost::PathNone;   // the no-feedback split sets its own
+
+        // After prepare(), a restore or a stage type switch nothing has
+        // computed coefficients for this topology yet.
+        if (stgs > 0 && lastCoeffStages != stgs)
+        {
+            updateCoefficients (targetFreq, targetShape, stgs);
+            lastCoeffStages = stgs;
+            lastCoeffFreq = targetFreq;
+            lastCoeffShape = targetShape;
+        }
+
+        // DUAL: update R coefficients for fast path
+        if (dualCoeffR && stgs > 0)
+        {
+            const float freqR = targetFreq * 0.5f;
+            if (std::abs (freqR - lastCoeffFreqR) > 0.001f || lastCoeffStages != stgs)
+            {
+                updateCoefficientsInto (freqR, targetShape, stgs, stageCoeffR);
+                lastCoeffFreqR = freqR;
+            }
+        }
+
+        if (stgs > 0 && fb == 0.0f)
+        {
+            // No feedback: nothing couples samples outside the stages themselves,
+            // so the whole cascade runs stage-major in the dispatched kernel.
+            processCascadeNoFeedback (ch0, ch1, numSamples, stgs, altEnabled, processR, negateCoeffR, dualCoeffR);
+        }
+        else if (stgs > 0)
+        {
+            for (int n = 0; n < numSamples; ++n)
+            {
+                // Feedback routing: cross for WIDE, independent otherwise
+                float xL = ch0[n] + fb * (crossFbk ? feedbackLastR : feedbackLastL);
+                float xR = processR ? (ch1[n] + fb * (crossFbk ? feedbackLastL : feedbackLastR)) : xL;
+
+                for (int s = 0; s < activeSeries; ++s)
+                {
+                    auto* lS = chainL[(size_t) s].data();
+                    auto* rS = chainR[(size_t) s].data();
+
+                    for (int st = 0; st < stgs; ++st)
+                    {
+                        const float aRaw = stageCoeff[(size_t) st];
+                        const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
+
+                        auto& sl = lS[st];
+                        const float yL = (-a * xL) + sl.z1;
+                        sl.z1 = xL + (a * yL);
+                        xL = yL;
+
+                        if (processR)
+                        {
+                            // WIDE: -a (complementary phase), DUAL: separate coeffs, STEREO: same a
+                            const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                            auto& sr = rS[st];
+                            const float yR = (-aR * xR) + sr.z1;
+                            sr.z1 = xR + (aR * yR);
+                            xR = yR;
+                        }
+                    }
+                }
+
+                ch0[n] = xL;
+                feedbackLastL = xL;
+                if (hasStereo)
+                {
+                    ch1[n] = processR ? xR : xL;
+                    feedbackLastR = processR ? xR : xL;
+                }
+            }
+        }
+
+    }
+    else
+    {
+    // Slow path: smoothing active or crossfade in progress
+    cascadePath = cost::PathSmoothed;
+    float modFreqMul = 1.0f;
+    for (int n = 0; n < numSamples; ++n)
+    {
+        const float smoothedStages = limit (0.0f, (float) kMaxStages, stagesSmoothed.getNextValue());
+        smoothedFreqValue += (targetFreq - smoothedFreqValue) * (1.0f - freqEmaCoeff);
+        float smoothedFreq = smoothedFreqValue;
+        float smoothedShape = shapeSmoothed.getNextValue();
+        float fb = feedbackSmoothed.getNextValue();
+
+        // Chaos D: advance S&H and modulate allpass centre frequency
+        if (chaosDelayEnabled_)
+        {
+            advanceChaosD();
+            if (chaosAmtD_ > 0.01f)
+            {
+                const float oct = chaosDOut_[0] * smoothedChaosFreqMaxOct_;
+                smoothedFreq = limit (20.0f, 20000.0f, smoothedFreq * std::exp2 (oct));
+            }
+        }
+
+        // Mod matrix: FREQ in octaves after the glide (like CHS D), SHAPE and
+        // FEEDBACK on top of their ramps.
+        if (cascadeModulated)
+        {
+            const int seg = n / ModMatrix::kSegmentSize;
+            if (modFreq != nullptr)
+            {
+                if (n % ModMatrix::kSegmentSize == 0)
+                    modFreqMul = std::exp2 (modFreq[seg]);
+                smoothedFreq = limit (20.0f, 20000.0f, smoothedFreq * modFreqMul);
+            }
+            if (modShape != nullptr)
+                smoothedShape = limit (0.0f, 1.0f, smoothedShape + modShape[seg]);
+            if (modFeedback != nullptr)
+                fb = limit (-1.0f, 1.0f, fb + modFeedback[seg]);
+        }
+
+        const int baseStages = limit (0, kMaxStages, (int) std::floor (smoothedStages));
+        const float stageFrac = limit (0.0f, 1.0f, smoothedStages - (float) baseStages);
+        const bool useFractionalStage = (stageFrac > 0.0001f && baseStages < kMaxStages);
+        const int coeffStages = limit (0, kMaxStages, baseStages + (useFractionalStage ? 1 : 0));
+
+        if (coeffStages > activeStages)
+            clearStageRange (activeStages, coeffStages, activeSeries);
+        activeStages = coeffStages;
+
+        if (coeffStages > 0)
+        {
+            // Batched coefficient update (every kCoeffUpdateInterval samples or on stage change)
+            --coeffUpdateCountdown;
+            if (coeffUpdateCountdown <= 0 || lastCoeffStages != coeffStages)
+            {
+                coeffUpdateCountdown = kCoeffUpdateInterval;
+                if (lastCoeffStages != coeffStages
+                    || std::abs (smoothedFreq - lastCoeffFreq) > 0.001f
+                    || std::abs (smoothedShape - lastCoeffShape) > 0.0002f)
+                {
+                    updateCoefficients (smoothedFreq, smoothedShape, coeffStages);
+                    lastCoeffStages = coeffStages;
+                    lastCoeffFreq = smoothedFreq;
+                    lastCoeffShape = smoothedShape;
+                }
+            }
+
+            // DUAL: update R coefficients in slow path
+            if (dualCoeffR)
+            {
+                const float freqR = smoothedFreq * 0.5f;
+                if (std::abs (freqR - lastCoeffFreqR) > 0.001f || lastCoeffStages != coeffStages)
+                {
+                    updateCoefficientsInto (freqR, smoothedShape, coeffStages, stageCoeffR);
+                    lastCoeffFreqR = freqR;
+                }
+            }
+
+            const float inputL = ch0[n] + fb * (crossFbk ? feedbackLastR : feedbackLastL);
+            const float inputR = processR ? (ch1[n] + fb * (crossFbk ? feedbackLastL : feedbackLastR)) : inputL;
+
+            // Process through current (new) topology
+            float xL = inputL;
+            float xR = inputR;
+
+            for (int s = 0; s < activeSeries; ++s)
+            {
+                auto* lStages = chainL[(size_t) s].data();
+                auto* rStages = chainR[(size_t) s].data();
+
+                for (int st = 0; st < baseStages; ++st)
+                {
+                    const float aRaw = stageCoeff[(size_t) st];
+                    const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
+
+                    auto& sl = lStages[st];
+                    const float yL = (-a * xL) + sl.z1;
+                    sl.z1 = xL + (a * yL);
+                    xL = yL;
+
+                    if (processR)
+                    {
+                        const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                        auto& sr = rStages[st];
+                        const float yR = (-aR * xR) + sr.z1;
+                        sr.z1 = xR + (aR * yR);
+                        xR = yR;
+                    }
+                }
+
+                if (useFractionalStage)
+                {
+                    const int st = baseStages;
+                    const float aRaw = stageCoeff[(size_t) st];
+                    const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
+
+                    const float inL = xL;
+                    auto& sl = lStages[st];
+                    const float yL = (-a * inL) + sl.z1;
+                    sl.z1 = inL + (a * yL);
+                    xL = inL + (stageFrac * (yL - inL));
+
+                    if (processR)
+                    {
+                        const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                        const float inR = xR;
+                        auto& sr = rStages[st];
+                        const float yR = (-aR * inR) + sr.z1;
+                        sr.z1 = inR + (aR * yR);
+                        xR = inR + (stageFrac * (yR - inR));
+                    }
+                }
+            }
+
+            // Series crossfade: blend old topology output during transition
+            if (crossfading && seriesXfadeSamplesRemaining > 0)
+            {
+                float xfL = inputL;
+                float xfR = inputR;
+
+                for (int s = 0; s < previousSeries; ++s)
+                {
+                    auto* lStages = xfadeChainL[(size_t) s].data();
+                    auto* rStages = xfadeChainR[(size_t) s].data();
+
+                    for (int st = 0; st < baseStages; ++st)
+                    {
+                        const float aRaw = stageCoeff[(size_t) st];
+                        const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
+
+                        auto& sl = lStages[st];
+                        const float yL = (-a * xfL) + sl.z1;
+                        sl.z1 = xfL + (a * yL);
+                        xfL = yL;
+
+                        if (processR)
+                        {
+                            const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                            auto& sr = rStages[st];
+                            const float yR = (-aR * xfR) + sr.z1;
+                            sr.z1 = xfR + (aR * yR);
+                            xfR = yR;
+                        }
+                    }
+
+                    if (useFractionalStage)
+                    {
+                        const int st = baseStages;
+                        const float aRaw = stageCoeff[(size_t) st];
+                        const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
+
+                        const float inL = xfL;
+                        auto& sl = lStages[st];
+                        const float yL = (-a * inL) + sl.z1;
+                        sl.z1 = inL + (a * yL);
+                        xfL = inL + (stageFrac * (yL - inL));
+
+                        if (processR)
+                        {
+                            const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
+                            const float inR = xfR;
+                            auto& sr = rStages[st];
+                            const float yR = (-aR * inR) + sr.z1;
+                            sr.z1 = inR + (aR * yR);
+                            xfR = inR + (stageFrac * (yR - inR));
+                        }
+                    }
+                }
+
+                const float alpha = (float) seriesXfadeSamplesRemaining / (float) seriesXfadeTotalSamples;
+                xL += alpha * (xfL - xL);
+                xR += alpha * (xfR - xR);
+                --seriesXfadeSamplesRemaining;
+            }
+
+            ch0[n] = xL;
+            feedbackLastL = xL;
+            if (hasStereo)
+            {
+                ch1[n] = processR ? xR : xL;
+                feedbackLastR = processR ? xR : xL;
+            }
+        }
+
+        // Chaos D gain modulation (per-channel, applied per-sample after allpass)
+        applyChaosGain (ch0, ch1, n);
+    }
+    } // end else (slow path)
+
+    // (ALT coefficient alternation is applied inside the allpass loops)
+
+    // ── Wet-signal HP/LP filter (POST position — only runs if !filterPre_) ──
+    if (! filterPre_)
+    {
+        const bool hpOn = p.hpOn;
+        const bool lpOn = p.lpOn;
+
+        if (hpOn || lpOn)
+        {
+            const float targetHpFreq = limit (kFilterFreqMin, kFilterFreqMax,
+                p.hpFreq);
+            const float targetLpFreq = limit (kFilterFreqMin, kFilterFreqMax,
+                p.lpFreq);
+            const int hpSlope = limit (kFilterSlopeMin, kFilterSlopeMax,
+                p.hpSlope);
+            const int lpSlope = limit (kFilterSlopeMin, kFilterSlopeMax,
+                p.lpSlope);
+
+            const int numSections_hp = (hpSlope == 2) ? 2 : 1;
+            const int numSections_lp = (lpSlope == 2) ? 2 : 1;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* data = wet[ch];
+                auto& fs = wetFilterState_[ch < 2 ? ch : 0];
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    // Per-sample EMA smoothing on filter frequencies (only on channel 0)
+                    if (ch == 0)
+                    {
+                        smoothedFilterHpFreq_ = smoothedFilterHpFreq_ * kGainSmoothCoeff
+                            + targetHpFreq * (1.0f - kGainSmoothCoeff);
+                        smoothedFilterLpFreq_ = smoothedFilterLpFreq_ * kGainSmoothCoeff
+                            + targetLpFreq * (1.0f - kGainSmoothCoeff);
+
+                        if (chaosFilterEnabled_) advanceChaosF();
+
+                        --filterCoeffCountdown_;
+                        if (filterCoeffCountdown_ <= 0)
+                        {
+                            filterCoeffCountdown_ = kFilterCoeffUpdateInterval;
+                            const int seg = n / ModMatrix::kSegmentSize;
+                            updateWetFilterCoeffs (hpOn, lpOn, modHp != nullptr ? modHp[seg] : 0.0f,
+                                                               modLp != nullptr ? modLp[seg] : 0.0f);
+                        }
+                    }
+
+                    float x = data[n];
+                    const auto& hpC = (ch == 0) ? hpCoeffs_ : hpCoeffsR_;
+                    const auto& lpC = (ch == 0) ? lpCoeffs_ : lpCoeffsR_;
+
+                    if (hpOn)
+                        for (int s = 0; s < numSections_hp; ++s)
+                            x = processBiquad (hpC[s], fs.hp[s], x);
+
+                    if (lpOn)
+                        for (int s = 0; s < numSections_lp; ++s)
+                            x = processBiquad (lpC[s], fs.lp[s], x);
+
+                    data[n] = x;
+                }
+            }
+        }
+        else if (chaosFilterEnabled_)
+        {
+            // Filters off but chaos F enabled: advance S&H to keep phase continuous
+            for (int n = 0; n < numSamples; ++n)
+            {
+                advanceChaosF();
+            }
+        }
+    }
+
+    // ── TILT filter (POST position) ──
+    if (!tiltPre_) applyTilt();
+
+    // ── Mode Out: M/S decode wet signal ──
+    if (modeOutVal > 0 && numChannels >= 2)
+    {
+        float* wL = wet[0];
+        float* wR = wet[1];
+        for (int n = 0; n < numSamples; ++n)
+        {
+            const float L = wL[n];
+            const float R = wR[n];
+            const float M = (L + R) * kSqrt2Over2;
+            const float S = (L - R) * kSqrt2Over2;
+            if (modeOutVal == 1) { wL[n] = M; wR[n] = M; }
+            else                 { wL[n] = S; wR[n] = S; }
+        }
+    }
+
+    // ── Limiter (WET mode: after effect + Mode Out, before mix) ──
+    {
+        const int limMode = p.limMode;
+        if (limMode == 1)
+        {
+            const float limThreshDb = p.limThresholdDb;
+            const float limThreshLin = fastDecibelsToGain (limThreshDb);
+            auto* chL = wet[0];
+            auto* chR = (numChannels >= 2) ? wet[1] : chL;
+            for (int i = 0; i < numSamples; ++i)
+                applyLimiter (chL[i], chR[i], limThreshLin);
+        }
+    }
+
+    // ── Invert Polarity / Stereo (WET mode: after Limiter WET, before mix) ──
+    {
+        const int invPol = p.invPol;
+        const int invStr = p.invStr;
+        if (invPol == 1)
+            for (int ch = 0; ch < numChannels; ++ch)
+                multiply (wet[ch], -1.0f, numSamples);
+        if (invStr == 1 && numChannels >= 2)
+        {
+            float* sL = wet[0];
+            float* sR = wet[1];
+            for (int n = 0; n < numSamples; ++n)
+                std::swap (sL[n], sR[n]);
+        }
+    }
+
+    // ── Per-sample smoothed Input/Output/Mix + Dry/Wet blend (fused loop) ──
+    // Compute dry/wet gain targets based on mix mode
+    float dryGainTarget, wetGainTarget;
+    if (mixMode == 0) // INSERT: classic crossfade
+    {
+        dryGainTarget = 1.0f - mixValue;
+        wetGainTarget = mixValue;
+    }
+    else // SEND: independent dry + wet levels
+    {
+        dryGainTarget = dryLevel;
+        wetGainTarget = wetLevel;
+    }
+
+    if (needsDryBlend)
+    {
+        if (sumBusVal == 0 || numChannels < 2)
+        {
+            // ST (stereo passthrough)
+            const bool gainsSettled = smoothedInputGain == inputGain
+                                   && smoothedOutputGain == outputGain
+                                   && smoothedMix == mixValue
+                                   && modMix == nullptr;
+            for (int ch = 0; ch < std::min (numChannels, kMaxChannels); ++ch)
+            {
+                // The output overwrites the dry input it is blended from.
+                float* out = channels[ch];
+                const float* dry = out;
+                const float* wetIn = wet[ch];
+                if (gainsSettled)
+                {
+                    if (mixMode == 0)
+                        kernels->mixInsert (dry, wetIn, out, numSamples, inputGain * outputGain, mixValue);
+                    else
+                        kernels->mixSend (dry, wetIn, out, numSamples, inputGain * outputGain, dryGainTarget, wetGainTarget);
+                    continue;
+                }
+
+                for (int n = 0; n < numSamples; ++n)
+                {
+                    smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
+                    smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
+                    const float mixTarget = modMix != nullptr ? limit (0.0f, 1.0f, mixValue + modMix[n / ModMatrix::kSegmentSize]) : mixValue;
+                    smoothedMix        = smoothedMix        * kGainSmoothCoeff + mixTarget  * (1.0f - kGainSmoothCoeff);
+
+                    const float dryS = dry[n];
+                    const float wetS = wetIn[n] * smoothedInputGain * smoothedOutputGain;
+                    if (mixMode == 0)
+                        out[n] = dryS + smoothedMix * (wetS - dryS);
+                    else
+                        out[n] = dryS * dryGainTarget + wetS * wetGainTarget;
+                }
+            }
+        }
+        else
+        {
+            // →M or →S bus: dry preserves stereo image, only wet goes through bus
+            const float* wetL = wet[0];
+            const float* wetR = wet[1];
+            float* outL = channels[0];
+            float* outR = channels[1];
+            for (int n = 0; n < numSamples; ++n)
+            {
+                smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
+                smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
+                const float mixTarget = modMix != nullptr ? limit (0.0f, 1.0f, mixValue + modMix[n / ModMatrix::kSegmentSize]) : mixValue;
+                smoothedMix        = smoothedMix        * kGainSmoothCoeff + mixTarget  * (1.0f - kGainSmoothCoeff);
+
+                const float dG = (mixMode == 0) ? (1.0f - smoothedMix) : dryGainTarget;
+                const float wG = (mixMode == 0) ? smoothedMix : wetGainTarget;
+                const float dL = outL[n] * dG;
+                const float dR = outR[n] * dG;
+                const float wL = wetL[n] * smoothedInputGain * smoothedOutputGain * wG;
+                const float wR = wetR[n] * smoothedInputGain * smoothedOutputGain * wG;
+
+                if (sumBusVal == 1) // →M
+                {
+                    const float midBus = (wL + wR) * 0.5f;
+                    outL[n] = dL + midBus;
+                    outR[n] = dR + midBus;
+                }
+                else // →S
+                {
+                    const float sideBus = (wL - wR) * 0.5f;
+                    outL[n] = dL + sideBus;
+                    outR[n] = dR - sideBus;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Full wet — apply input * output gain
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* data = channels[ch];
+            for (int n = 0; n < numSamples; ++n)
+            {
+                smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
+                smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
+                data[n] = data[n] * smoothedInputGain * smoothedOutputGain;
+            }
+        }
+    }
+    {
+        constexpr float kSnapEpsilon = 1e-5f;
+        if (std::abs (smoothedInputGain  - inputGain)  < kSnapEpsilon) smoothedInputGain  = inputGain;
+        if (std::abs (smoothedOutputGain - outputGain) < kSnapEpsilon) smoothedOutputGain = outputGain;
+        if (modMix == nullptr && std::abs (smoothedMix - mixValue) < kSnapEpsilon) smoothedMix = mixValue;
+    }
+
+    // ── Pan (equal-power, stereo only) ──
+    if (numChannels >= 2)
+    {
+        const float pan = p.pan;
+        if (std::abs (pan - lastPan_) > 0.001f)
+        {
+            lastPan_ = pan;
+            const float angle = pan * 1.5707963f; // π/2
+            lastPanLeft_  = std::cos (angle);
+            lastPanRight_ = std::sin (angle);
+        }
+        if (std::abs (lastPan_ - 0.5f) > 0.001f)
+        {
+            multiply (channels[0], lastPanLeft_,  numSamples);
+            multiply (channels[1], lastPanRight_, numSamples);
+        }
+    }
+
+    // ── Limiter (GLOBAL mode: after pan, before safety clip) ──
+    {
+        const int limMode = p.limMode;
+        if (limMode == 2)
+        {
+            const float limThreshDb = p.limThresholdDb;
+            const float limThreshLin = fastDecibelsToGain (limThreshDb);
+            auto* chL = channels[0];
+            auto* chR = (numChannels >= 2) ? channels[1] : chL;
+            for (int i = 0; i < numSamples; ++i)
+                applyLimiter (chL[i], chR[i], limThreshLin);
+        }
+    }
+
+    // ── Invert Polarity / Stereo (GLOBAL mode: after Limiter GLOBAL, before safety clip) ──
+    {
+        const int invPol = p.invPol;
+        const int invStr = p.invStr;
+        if (invPol == 2)
+            for (int ch = 0; ch < numChannels; ++ch)
+                multiply (channels[ch], -1.0f, numSamples);
+        if (invStr == 2 && numChannels >= 2)
+        {
+            float* sL = channels[0];
+            float* sR = channels[1];
+            for (int n = 0; n < numSamples; ++n)
+                std::swap (sL[n], sR[n]);
+        }
+    }
+
+    // ── Safety limiter (+48 dBFS ≈ 251.19) ──
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* data = channels[ch];
+        for (int n = 0; n < numSamples; ++n)
+            data[n] = limit (-251.19f, 251.19f, data[n]);
+    }
+
+}
@@ -0,0 +1,766 @@
+#pragma once
+
+// ============================================================================
+// DisperserEngine.h — DISP-TR signal path, independent of JUCE
+//
+// Everything between the host buffer and the plugin shell: all-pass cascade
+// (series, feedback, crossfade), chaos, the modulation matrix, wet HP/LP
+// filters, tilt, M/S, limiter, dry/wet blend, pan and inversion. Plain C++17 + the SIMD kernels; no JUCE
+// types, so the same engine runs in the plugin, the CLI and the benchmarks.
+//
+//   DisperserEngine engine;
+//   engine.prepare (sampleRate, maxBlockSize, params);
+//   engine.process (channels, numChannels, numSamples, params);   // RT-safe
+//
+// Params are plain values (dB, Hz, 0..1, enum ints) read once per call;
+// everything that changes over time is smoothed inside the engine. process()
+// never allocates: blocks longer than maxBlockSize are run in pieces.
+// ============================================================================
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+#include "CostModel.h"
+#include "ModMatrix.h"
+#include "SimdDispatch.h"
+
+class DisperserEngine
+{
+public:
+    static constexpr int kMaxStages   = 1024;
+    static constexpr int kMaxSeries   = 4;
+    static constexpr int kMaxChannels = 2;
+
+    // Stage type DELAY: each Schroeder section stands in for this many
+    // first-order stages of the STAGES count, up to kMaxDelaySections.
+    static constexpr int kMaxDelaySections      = 16;
+    static constexpr int kStagesPerDelaySection = 8;
+
+    // Coefficients are recomputed every kCoeffUpdateInterval samples counted
+    // from prepare(), so renders that should match sample for sample must
+    // start on this grid.
+    static constexpr int    kCoeffUpdateInterval = 32;
+    static constexpr double kMaxTailSeconds      = 60.0;
+
+    struct Params
+    {
+        int   stages       = 32;
+        int   series       = 1;
+        float freqHz       = 1000.0f;
+        float shape        = 0.0f;      // 0..1 (S0/S100 overrides applied by the caller)
+        bool  alt          = false;
+        float feedback     = 0.0f;      // −1..1, smoothstep-mapped inside
+        float mod          = 0.5f;      // FREQ multiplier, 0.5 = ×1
+        int   stageType    = 0;         // 0 = 1-POLE, 1 = DELAY (Schroeder sections)
+
+        // MIDI: a held note replaces FREQ and sets the glide speed.
+        float midiFreqHz   = 0.0f;      // 0 = no note
+        int   midiVelocity = 127;
+
+        float inputDb      = 0.0f;
+        float outputDb     = 0.0f;
+        float mix          = 1.0f;
+        int   mixMode      = 0;         // 0 = INSERT, 1 = SEND
+        float dryLevel     = 0.0f;      // SEND only
+        float wetLevel     = 1.0f;      // SEND only
+        float tiltDb       = 0.0f;
+        float pan          = 0.5f;
+        int   style        = 1;         // 0 = MONO, 1 = STEREO, 2 = WIDE, 3 = DUAL
+        int   filterPos    = 0;         // 0 = F▼T▼, 1 = F▲T▲, 2 = F▲T▼, 3 = F▼T▲
+
+        bool  hpOn         = false;
+        bool  lpOn         = false;
+        float hpFreq       = 250.0f;
+        float lpFreq       = 2000.0f;
+        int   hpSlope      = 1;         // 0 = 6, 1 = 12, 2 = 24 dB/oct
+        int   lpSlope      = 1;
+
+        bool  chaosFilter  = false;     // CHS F
+        bool  chaosDelay   = false;     // CHS D
+        float chaosAmtD    = 50.0f;     // %
+        float chaosSpdD    = 5.0f;      // Hz
+        float chaosAmtF    = 50.0f;
+        float chaosSpdF    = 5.0f;
+
+        int   modeIn       = 0;         // 0 = L/R, 1 = M, 2 = S
+        int   modeOut      = 0;
+        int   sumBus       = 0;         // 0 = ST, 1 = →M, 2 = →S
+        int   invPol       = 0;         // 0 = NONE, 1 = WET, 2 = GLOBAL
+        int   invStr       = 0;
+        float limThresholdDb = 0.0f;
+        int   limMode      = 0;         // 0 = NONE, 1 = WET, 2 = GLOBAL
+
+        // LFO / envelope / random routes, offsets on top of the values above.
+        ModMatrix::Settings modMatrix;
+    };
+
+    // Small, copyable PRNG (xorshift64*) so chaos is reproducible and its
+    // state fits in a snapshot.
+    struct Rng
+    {
+        uint64_t state = 0x9e3779b97f4a7c15ull;
+
+        void setSeed (uint64_t seed) noexcept { state = seed != 0 ? seed : 0x9e3779b97f4a7c15ull; }
+
+        float nextFloat() noexcept
+        {
+            state ^= state >> 12;
+            state ^= state << 25;
+            state ^= state >> 27;
+            return (float) ((state * 0x2545f4914f6cdd1dull) >> 40) * (1.0f / 16777216.0f);
+        }
+    };
+
+    // Linear ramp with the same stepping as juce::SmoothedValue<float, Linear>.
+    class LinearSmoother
+    {
+    public:
+        void reset (double sampleRate, double rampSeconds) noexcept
+        {
+            stepsToTarget = (int) std::floor (rampSeconds * sampleRate);
+            setCurrentAndTargetValue (target);
+        }
+
+        void setCurrentAndTargetValue (float v) noexcept { current = target = v; countdown = 0; }
+
+        void setTargetValue (float v) noexcept
+        {
+            if (v == target)
+                return;
+            if (stepsToTarget <= 0)
+            {
+                setCurrentAndTargetValue (v);
+                return;
+            }
+            target = v;
+            countdown = stepsToTarget;
+            step = (target - current) / (float) countdown;
+        }
+
+        float getNextValue() noexcept
+        {
+            if (countdown <= 0)
+                return target;
+            if (--countdown > 0)
+                current += step;
+            else
+                current = target;
+            return current;
+        }
+
+        bool  isSmoothing() const noexcept     { return countdown > 0; }
+        float getCurrentValue() const noexcept { return current; }
+
+    private:
+        float current = 0.0f, target = 0.0f, step = 0.0f;
+        int   countdown = 0, stepsToTarget = 0;
+    };
+
+    struct BiquadCoeffs { float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; };
+    struct BiquadState  { float z1 = 0.0f, z2 = 0.0f; };
+
+    struct WetFilterChannelState
+    {
+        BiquadState hp[2];   // up to 2 cascaded sections (24 dB/oct)
+        BiquadState lp[2];
+        void reset() { *this = {}; }
+    };
+
+    // Everything the signal path remembers between samples, as one fixed-size
+    // block (no heap), so capture/restore is a plain copy on the audio thread.
+    // The DELAY stage rings (up to megabytes) are left out: a restore restarts
+    // them from silence.
+    struct StateSnapshot
+    {
+        float z1L[kMaxSeries][kMaxStages];
+        float z1R[kMaxSeries][kMaxStages];
+        int   activeStages, activeSeries;
+        float feedbackLastL, feedbackLastR;
+        float stagesCurrent, shapeCurrent, feedbackCurrent, smoothedFreq;
+        float smoothedInputGain, smoothedOutputGain, smoothedMix;
+        float tiltB0, tiltB1, tiltA1, tiltState[2], lastTiltDb;
+        WetFilterChannelState wetFilter[2];
+        float smoothedFilterHpFreq, smoothedFilterLpFreq;
+        float chaosD[2][7], chaosG[2][7];          // prev, curr, next, phase, driftPhase, driftHz, out
+        Rng   chaosDRng[2], chaosGRng[2], chaosFRng;
+        float chaosF[6], chaosFOut[2];
+        float smoothedChaosShPeriodD, smoothedChaosFreqMaxOct, smoothedChaosGainMaxDb;
+        float smoothedChaosShPeriodF, smoothedChaosFilterMaxOct;
+        float limEnv1[2], limEnv2[2];
+        ModMatrix::State modMatrix;
+    };
+
+    DisperserEngine() = default;
+
+    // Allocates all state for up to maxBlockSize samples per chunk and resets it,
+    // with smoothers starting at `initial`. Also resolves the SIMD level.
+    void prepare (double sampleRate, int maxBlockSize, const Params& initial);
+    void release();
+
+    // In place; channels beyond kMaxChannels are left untouched.
+    void process (float* const* channels, int numChannels, int numSamples, const Params& p) noexcept;
+
+    void captureState (StateSnapshot& dest) const noexcept;
+    void restoreState (const StateSnapshot& src) noexcept;
+
+    // Advances the state that evolves without looking at the audio (chaos
+    // generators, LFO and random sources, the tilt ramp) exactly as if `numSamples` had been
+    // processed with `p` in maxBlockSize chunks right after prepare(). A render
+    // that starts mid-file calls this with a chunk-aligned start, then runs
+    // input through process() for the pre-roll; not real-time safe.
+    void skipAhead (int64_t numSamples, const Params& p) noexcept;
+
+    // How long the output keeps depending on past input and on prepare()'s
+    // starting state, down to `floorDb`: cascade group delay and pole decay,
+    // feedback recirculation, wet filters, limiter release, the frequency
+    // glide and the envelope follower's release, at the worst case the
+    // MOD/DUAL/chaos settings and the mod matrix depths allow. Analytic,
+    // no rendering; capped at kMaxTailSeconds (feedback at ±1 never decays).
+    static double estimateTailSeconds (const Params& p, double sampleRate, float floorDb = -120.0f) noexcept;
+
+    // Input-to-output transfer function of the left channel once every
+    // smoother has settled, at each of `freqsHz`: the cascade (1-POLE or
+    // DELAY, series, ALT, MOD, feedback loop), wet filters and tilt, wet
+    // polarity, the INSERT/SEND blend, gains and pan. Analytic; DELAY's
+    // interpolated read is taken as an exact fractional delay. Returns false
+    // when `p` uses something the model leaves out, so that the output is not
+    // a fixed function of the left input: M/S modes, a sum bus, WIDE's cross
+    // feedback, STR inversion, the limiter, chaos or mod routes.
+    static bool computeResponse (const Params& p, double sampleRate, const float* freqsHz, int numFreqs,
+                                 std::complex<double>* dest) noexcept;
+
+    // Predicted processing time of `p` from the cost model, in ns per sample
+    // frame: once every parameter has settled, and while FREQ, SHAPE or
+    // STAGES glide (or CHS D and mod routes keep the cascade per sample).
+    // Analytic, no rendering; what the editor shows before a setting is
+    // committed. blockSize is the chunk length process() would see.
+    struct CostEstimate
+    {
+        cost::Path path = cost::PathNone;   // settled cascade path
+        double settledNs = 0.0;
+        double glidingNs = 0.0;
+
+        // Share of one core needed to keep up at `sampleRate`.
+        double getLoad (double sampleRate) const noexcept          { return settledNs * sampleRate * 1.0e-9; }
+        double getGlidingLoad (double sampleRate) const noexcept   { return glidingNs * sampleRate * 1.0e-9; }
+    };
+    static CostEstimate estimateCost (const Params& p, int blockSize, int numChannels, simd::Isa isa,
+                                      float maxErrorDb = cost::kDefaultMaxErrorDb,
+                                      const cost::Profile& profile = cost::getDefaultProfile()) noexcept;
+
+    // The DELAY rings (about 1 MB at 48 kHz) are only allocated by prepare()
+    // when `initial` asks for DELAY stages. Until they exist, a switch to
+    // DELAY passes the cascade through and raises wantsDelayRings(). An owner
+    // that isn't processing concurrently calls reserveDelayRings(); one whose
+    // engine runs on the audio thread builds getDelayArenaSize() zeros
+    // elsewhere and hands them over with swapDelayArena() between blocks.
+    bool   wantsDelayRings() const noexcept         { return delayRingsWanted; }
+    size_t getDelayArenaSize() const noexcept;
+    void   reserveDelayRings();
+    void   swapDelayArena (std::vector<float>& arena) noexcept;   // ignored unless the size matches
+
+    // Heap bytes the engine holds, by what they are for; sizes only change in
+    // prepare(), release() and the DELAY ring handover.
+    struct MemoryUsage
+    {
+        size_t cascade   = 0;   // stage chains, coefficients, flattened kernel tables
+        size_t crossfade = 0;   // the outgoing chains a SERIES change fades from
+        size_t delay     = 0;   // DELAY section rings
+        size_t buffers   = 0;   // dry copy, mod matrix segment values
+
+        size_t getTotal() const noexcept   { return cascade + crossfade + delay + buffers; }
+    };
+    MemoryUsage getMemoryUsage() const noexcept;
+
+    // Largest rounding deviation from the per-sample arithmetic the cascade
+    // may trade for speed (see cost::kScanErrorDb); lower keeps to that
+    // arithmetic exactly.
+    void  setMaxErrorDb (float dB) noexcept      { maxErrorDb = dB; }
+    float getMaxErrorDb() const noexcept         { return maxErrorDb; }
+
+    // Kernel timings the cascade split is chosen by; nullptr restores the
+    // built-in defaults. The profile must outlive its use by this engine.
+    void setCostProfile (const cost::Profile* profile) noexcept { costProfile = profile != nullptr ? profile : &cost::getDefaultProfile(); }
+    const cost::Profile& getCostProfile() const noexcept        { return *costProfile; }
+
+    // Path the cascade took in the last chunk processed.
+    cost::Path getCascadePath() const noexcept   { return cascadePath; }
+
+    // Independent pieces of one process() call: today the left and right
+    // cascades when feedback is off (the feedback paths couple the channels
+    // sample by sample). An executor, e.g. a host thread pool, must call
+    // runTask (i) for every i in [0, numTasks) on any threads and return once
+    // all have finished, or return false without running any so the engine
+    // runs them itself. Only called from inside process().
+    using TaskExecutor = bool (*) (void* context, int numTasks) noexcept;
+    void setTaskExecutor (TaskExecutor executor, void* context) noexcept { taskExecutor = executor; taskContext = context; }
+    void runTask (int index) noexcept;
+
+    // Chaos generators are reseeded from this on every prepare().
+    void setSeed (uint64_t seed) noexcept { rngSeed = seed; }
+
+    void setIsa (simd::Isa isa) noexcept { dspIsa = isa; kernels = &simd::getKernels (isa); }
+    simd::Isa getIsa() const noexcept    { return dspIsa; }
+
+    double getSampleRate() const noexcept     { return currentSampleRate; }
+    int    getActiveSeries() const noexcept   { return activeSeries; }
+
+    // Stages the cascade ran in the last block: the gliding stage count, or
+    // the DELAY section count.
+    int    getEffectiveStages() const noexcept
+    {
+        return cascadePath == cost::PathDelay ? activeDelaySections
+                                              : (int) std::lround (stagesSmoothed.getCurrentValue());
+    }
+    int    getCrossfadeSamples() const noexcept { return seriesXfadeTotalSamples; }
+
+private:
+    // BatchEngine runs this signal path across many streams at once and
+    // shares its parameter mappings, coefficient maths and constants.
+    friend class BatchEngine;
+
+    static constexpr float kFilterFreqMin   = 20.0f;
+    static constexpr float kFilterFreqMax   = 20000.0f;
+    static constexpr float kGainMinDb       = -100.0f;
+    static constexpr float kInputMaxDb      = 0.0f;
+    static constexpr float kOutputMaxDb     = 24.0f;
+    static constexpr int   kFilterSlopeMin  = 0;
+    static constexpr int   kFilterSlopeMax  = 2;
+    static constexpr float kChaosSpdMin     = 0.01f;
+    static constexpr float kChaosSpdMax     = 100.0f;
+    static constexpr float kSqrt2Over2      = 0.707106781f;
+    static constexpr float kPi              = 3.14159265358979f;
+    static constexpr double kPiD            = 3.141592653589793;
+
+    // Gain / mix / filter-cutoff EMA coefficient: one-pole ~5 ms time constant at 44.1 kHz.
+    static constexpr float kGainSmoothCoeff = 0.9955f;
+
+    static float fastDecibelsToGain (float dB) noexcept
+    {
+        if (dB <= -100.0f) return 0.0f;
+        return std::exp2 (dB * 0.16609640474f);   // log2(10)/20
+    }
+
+    // MOD frequency multiplier (hyperbolic below centre, linear above).
+    static float modFreqMultiplier (float mod) noexcept
+    {
+        return (mod < 0.5f) ? 1.0f / (4.0f - 6.0f * mod)
+                            : (1.0f + (mod - 0.5f) * 6.0f);
+    }
+
+    // FEEDBACK −1..1 → loop gain: sign-preserving smoothstep.
+    static float mapFeedback (float feedback) noexcept
+    {
+        const float fb   = std::clamp (feedback, -1.0f, 1.0f);
+        const float sign = fb < 0.0f ? -1.0f : 1.0f;
+        const float af   = std::abs (fb);
+        return sign * af * af * (3.0f - 2.0f * af);
+    }
+
+    void processChunk (float* const* channels, int numChannels, int numSamples, const Params& p, int offsetInCall) noexcept;
+    void processCascadeNoFeedback (float* ch0, float* ch1, int numSamples, int stages,
+                                   bool altEnabled, bool processR, bool negateCoeffR, bool dualCoeffR) noexcept;
+    void runCascade (float* data, int numSamples, const float* coeffs, float* state, int numStages, int wavefrontStages) const noexcept;
+
+    static float calcAllPassCoeff (float frequency, float sampleRate) noexcept;
+    static void computeStageFreqs (float freqHz, float shapeNorm, int stages, float sampleRate, float* dest) noexcept;
+    static void computeStageCoeffs (float freqHz, float shapeNorm, int stages, float sampleRate, float* dest) noexcept;
+    // Wet HP or LP at `slope` (0 = 6, 1 = 12, 2 = 24 dB/oct) as up to two
+    // sections; an unused second section passes through.
+    static void calcWetFilterCoeffs (bool highPass, float freqHz, int slope, float sampleRate, BiquadCoeffs dest[2]) noexcept;
+    static void calcTiltCoeffs (float tiltDb, double sampleRate, float& b0, float& b1, float& a1) noexcept;
+    void loadChaosParams (const Params& p) noexcept;
+    // Input → wet with Mode In (M/S encode), PRE filter and PRE tilt in one
+    // pass per channel. `wet` may alias `in`.
+    void processInputStage (const float* const* in, float* const* wet, int numChannels, int numSamples,
+                            const Params& p, int modeIn, const float* modHp, const float* modLp,
+                            bool applyTilt) noexcept;
+    bool stepTiltCoeffs() noexcept;    // one smoothing step; false when tilt is bypassed
+    void setTiltTarget (float tiltDb) noexcept;
+    // TILT under the mod matrix: coefficients follow tiltDb_ + mod per control
+    // segment. With channels == nullptr only the coefficients advance.
+    void stepTiltSegments (const float* tiltMod, float* const* channels, int numChannels, int numSamples) noexcept;
+    void updateCoefficients (float freqHz, float shapeNorm, int stages);
+    void updateCoefficientsInto (float freqHz, float shapeNorm, int stages, std::vector<float>& dest);
+    void clearStageRange (int fromStageInclusive, int toStageExclusive, int seriesCount) noexcept;
+    void updateFilterCoeffs (bool forceHp, bool forceLp);
+    // Per-update-interval wet filter coefficients (L and R) with CHS F and the
+    // mod matrix's HP/LP offsets in octaves applied on top of the smoothed cutoffs.
+    void updateWetFilterCoeffs (bool hpOn, bool lpOn, float hpModOct, float lpModOct);
+    void applyChaosGain (float* ch0, float* ch1, int n) noexcept;
+
+    // Stage type DELAY: per-sample cascade of Schroeder sections with the same
+    // smoothing, feedback, CHS D and mod matrix handling as the slow path.
+    void processDelayCascade (float* ch0, float* ch1, int numSamples, float targetFreq,
+                              bool altEnabled, bool processR, bool crossFbk, bool negateR, bool dualR,
+                              const float* modFreq, const float* modShape, const float* modFeedback) noexcept;
+    // Section delays for the current FREQ/SHAPE; sections below `rampFrom`
+    // glide to them over one update interval, the rest jump.
+    void updateDelayTargets (float freqHz, float shapeNorm, int sections, bool dualR, int rampFrom) noexcept;
+    void clearDelaySections (int fromSection, int toSection, int fromSeries, int toSeries) noexcept;
+
+    struct AllPassState
+    {
+        float z1 = 0.0f;
+    };
+
+    double currentSampleRate = 44100.0;
+    int    maxChunkSize = 0;
+    uint64_t rngSeed = 0x44495350ull;   // "DISP"
+
+    // ── Modulation matrix ──
+    static_assert (ModMatrix::kSegmentSize == kCoeffUpdateInterval, "mod segments follow the coefficient grid");
+    ModMatrix modMatrix;
+
+    // ── SIMD dispatch ──
+    const simd::Kernels* kernels = &simd::getKernels (simd::Isa::Scalar);
+    simd::Isa dspIsa = simd::Isa::Scalar;
+
+    // ── Parallel tasks ──
+    struct CascadeTask
+    {
+        float* data = nullptr;
+        int numSamples = 0;
+        const float* coeffs = nullptr;
+        float* state = nullptr;
+        int numStages = 0;
+        int wavefrontStages = 0;
+    };
+    // Stage-samples per task below which a handoff costs more than it saves.
+    static constexpr int kMinTaskWork = 32768;
+
+    // ── Cost model ──
+    const cost::Profile* costProfile = &cost::getDefaultProfile();
+    float maxErrorDb = cost::kDefaultMaxErrorDb;
+    cost::Path cascadePath = cost::PathNone;
+
+    TaskExecutor taskExecutor = nullptr;
+    void* taskContext = nullptr;
+    std::array<CascadeTask, kMaxChannels> pendingTasks {};
+
+    // Flattened (series × stage) coefficients and states for the stage-major
+    // cascade kernel.
+    std::vector<float> cascadeCoeffL, cascadeCoeffR, cascadeStateL, cascadeStateR;
+
+    // ── All-pass cascade ──
+    std::array<std::vector<AllPassState>, kMaxSeries> chainL;
+    std::array<std::vector<AllPassState>, kMaxSeries> chainR;
+    std::vector<float> stageCoeff;
+    std::vector<float> stageCoeffR;   // R-channel coefficients for DUAL mode
+    LinearSmoother stagesSmoothed;
+    float smoothedFreqValue = 1000.0f;
+    float freqEmaCoeff = 0.0f;
+    float freqEmaCoeffDefault_ = 0.0f;
+    LinearSmoother shapeSmoothed;
+    static constexpr double kStageSmoothingSeconds = 0.06;
+    static constexpr float kFreqTauDefault   = 0.08f;
+    static constexpr float kMidiGlideTauMax  = 0.200f;
+    static constexpr float kMidiGlideTauMin  = 0.0002f;
+    static constexpr double kShapeSmoothingSeconds = 0.05;
+    static constexpr double kSeriesCrossfadeMs = 20.0;
+    int activeStages = 0;
+    int activeSeries = 1;
+    float lastCoeffFreq = -1.0f;
+    float lastCoeffShape = -1.0f;
+    int lastCoeffStages = -1;
+    float lastCoeffFreqR  = -1.0f;
+    int coeffUpdateCountdown = 0;
+
+    // ── Delay-line all-pass sections (stage type DELAY) ──
+    // v = x + g·v[n−M], y = v[n−M] − g·v. M is one period of the stage
+    // frequency the SHAPE/FREQ mapping gives that section, read with linear
+    // interpolation; every ring is a power-of-two slice of one arena sized in
+    // prepare() for the longest period, and all share one write index.
+    static constexpr float kDelayMinFreq     = 40.0f;
+    static constexpr float kDelayAllPassGain = 0.6f;
+    std::vector<float> delayArena;   // [series][section][channel][ring], empty until DELAY is used
+    bool delayRingsWanted = false;
+    int delayRingSize = 0;
+    int delayRingMask = 0;
+    int delayWritePos = 0;
+    std::array<float, kMaxDelaySections> delayCurrent {}, delayStep {}, delayCurrentR {}, delayStepR {};
+    int  activeDelaySections = 0;   // rings beyond this are stale until cleared
+    bool delayMode = false;         // last chunk ran DELAY stages
+    bool delaySnap = true;          // next target update jumps instead of gliding
+
+    float* delayRing (int series, int section, int channel) noexcept
+    {
+        return delayArena.data() + (size_t) ((series * kMaxDelaySections + section) * kMaxChannels + channel) * (size_t) delayRingSize;
+    }
+
+    // ── Feedback ──
+    LinearSmoother feedbackSmoothed;
+    static constexpr double kFeedbackSmoothingSeconds = 0.05;
+    float feedbackLastL = 0.0f;
+    float feedbackLastR = 0.0f;
+
+    std::array<std::vector<AllPassState>, kMaxSeries> xfadeChainL;
+    std::array<std::vector<AllPassState>, kMaxSeries> xfadeChainR;
+    int seriesXfadeSamplesRemaining = 0;
+    int seriesXfadeTotalSamples = 0;
+    int previousSeries = 1;
+
+    // ── Input / Output / Mix gain smoothing ──
+    float smoothedInputGain = 1.0f;
+    float smoothedOutputGain = 1.0f;
+    float smoothedMix = 1.0f;
+    bool  filterPre_  = false;
+    bool  tiltPre_    = false;
+
+    // ── Tilt EQ (1-pole shelving, pivot 1 kHz) ──
+    float tiltDb_        = 0.0f;
+    float tiltB0_ = 1.0f, tiltB1_ = 0.0f, tiltA1_ = 0.0f;
+    float tiltTargetB0_ = 1.0f, tiltTargetB1_ = 0.0f, tiltTargetA1_ = 0.0f;
+    float tiltState_[2]  = { 0.0f, 0.0f };
+    float lastTiltDb_    = 0.0f;
+    float tiltSmoothSc_  = 0.0f;
+    float tiltSegmentSc_ = 0.0f;    // per control segment, for modulated TILT
+
+    // Wet path scratch, maxChunkSize per channel. When a chunk blends dry
+    // and wet, the caller's buffers stay untouched as the dry signal until the
+    // blend writes the output over them.
+    std::array<std::vector<float>, kMaxChannels> wetBuffer;
+
+    // ── Wet filter (HP + LP) ──
+    WetFilterChannelState wetFilterState_[2];       // L, R
+    BiquadCoeffs hpCoeffs_[2];                      // section 0, 1
+    BiquadCoeffs lpCoeffs_[2];
+    BiquadCoeffs hpCoeffsR_[2];                     // R channel coeffs (stereo chaos)
+    BiquadCoeffs lpCoeffsR_[2];
+    float smoothedFilterHpFreq_ = 250.0f;
+    float smoothedFilterLpFreq_ = 2000.0f;
+    float lastCalcHpFreq_ = -1.0f;
+    float lastCalcLpFreq_ = -1.0f;
+    int   lastCalcHpSlope_ = -1;
+    int   lastCalcLpSlope_ = -1;
+    int   filterHpSlope_ = 1;                       // current block's slopes
+    int   filterLpSlope_ = 1;
+    static constexpr int kFilterCoeffUpdateInterval = 32;
+    int   filterCoeffCountdown_ = 0;
+
+    float lastPan_      = -1.0f;
+    float lastPanLeft_  = 1.0f;
+    float lastPanRight_ = 1.0f;
+
+    // ── Chaos state (Hermite + Drift, per-channel D/G, quadrature F) ──
+    bool  chaosFilterEnabled_ = false;
+    bool  chaosDelayEnabled_  = false;
+    bool  chaosStereo_        = false;   // true when style >= 1 (per-channel G, quadrature F)
+
+    // CHS D parameters (disperser frequency modulation + gain)
+    float chaosAmtD_                    = 0.0f;
+    float chaosAmtNormD_                = 0.0f;   // cached amtD * 0.01
+    float chaosShPeriodD_               = 8820.0f;
+    float smoothedChaosShPeriodD_       = 8820.0f;
+    float chaosFreqMaxOct_              = 0.0f;
+    float smoothedChaosFreqMaxOct_      = 0.0f;
+    float chaosGainMaxDb_               = 0.0f;
+    float smoothedChaosGainMaxDb_       = 0.0f;
+
+    // CHS D Hermite+Drift: freq (per-channel; ch0 used for allpass freq mod)
+    float chaosDPrev_[2]         = {};
+    float chaosDCurr_[2]         = {};
+    float chaosDNext_[2]         = {};
+    float chaosDPhase_[2]        = {};
+    float chaosDDriftPhase_[2]   = {};
+    float chaosDDriftFreqHz_[2]  = {};
+    float chaosDOut_[2]          = {};
+    Rng   chaosDRng_[2];
+
+    // CHS D Hermite+Drift: gain (per-channel, decorrelated)
+    float chaosGPrev_[2]         = {};
+    float chaosGCurr_[2]         = {};
+    float chaosGNext_[2]         = {};
+    float chaosGPhase_[2]        = {};
+    float chaosGDriftPhase_[2]   = {};
+    float chaosGDriftFreqHz_[2]  = {};
+    float chaosGOut_[2]          = {};
+    Rng   chaosGRng_[2];
+
+    // CHS F parameters (filter cutoff modulation)
+    float chaosAmtF_                  = 0.0f;
+    float chaosShPeriodF_             = 8820.0f;
+    float smoothedChaosShPeriodF_     = 8820.0f;
+    float chaosFilterMaxOct_          = 0.0f;
+    float smoothedChaosFilterMaxOct_  = 0.0f;
+
+    // CHS F Hermite+Drift: filter (mono S&H + quadrature drift)
+    float chaosFPrev_            = 0.0f;
+    float chaosFCurr_            = 0.0f;
+    float chaosFNext_            = 0.0f;
+    float chaosFPhase_           = 0.0f;
+    float chaosFDriftPhase_      = 0.0f;   // single phase; R = +90° offset
+    float chaosFDriftFreqHz_     = 0.0f;
+    float chaosFOut_[2]          = {};     // [0]=L, [1]=R (quadrature when stereo)
+    Rng   chaosFRng_;
+
+    // Chaos per-sample param smoothing (precomputed in prepare)
+    float chaosParamSmoothCoeff_ = 0.999f;
+    float cachedChaosParamSmoothCoeff_ = 0.999f;
+
+    static constexpr float kChaosDriftAmp = 0.3f;
+    static constexpr float kTwoPi = 6.283185307f;
+
+    // Generic Hermite + Drift chaos engine (per-sample advance)
+    inline void advanceChaosEngine (
+        float& prev, float& curr, float& next, float& phase,
+        float& driftPhase, float& driftFreqHz, float& output,
+        Rng& rng, float period, float amtNorm, float sr) noexcept
+    {
+        phase += 1.0f;
+        if (phase >= period)
+        {
+            phase -= period;
+            prev = curr;
+            curr = next;
+            next = rng.nextFloat() * 2.0f - 1.0f;
+            const float driftBase = sr / std::max (1.0f, period) * 0.37f;
+            driftFreqHz = driftBase * (0.88f + rng.nextFloat() * 0.24f);
+        }
+        const float t  = phase / period;
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        const float h00 =  2.0f * t3 - 3.0f * t2 + 1.0f;
+        const float h10 =         t3 - 2.0f * t2 + t;
+        const float h01 = -2.0f * t3 + 3.0f * t2;
+        const float h11 =         t3 -        t2;
+        const float tangCurr = (next - prev) * 0.5f;
+        const float tangNext = -curr * 0.5f;
+        const float shValue  = h00 * curr + h10 * tangCurr + h01 * next + h11 * tangNext;
+
+        driftPhase += driftFreqHz / sr;
+        if (driftPhase > 1e6f) driftPhase -= 1e6f;
+        const float driftValue = std::sin (driftPhase * kTwoPi) * kChaosDriftAmp;
+
+        const float shWeight = std::clamp (amtNorm * 1.5f - 0.15f, 0.0f, 1.0f);
+        output = driftValue + shValue * shWeight;
+    }
+
+    inline void advanceChaosD() noexcept
+    {
+        smoothedChaosFreqMaxOct_ += (chaosFreqMaxOct_ - smoothedChaosFreqMaxOct_) * (1.0f - chaosParamSmoothCoeff_);
+        smoothedChaosGainMaxDb_  += (chaosGainMaxDb_  - smoothedChaosGainMaxDb_)  * (1.0f - chaosParamSmoothCoeff_);
+        smoothedChaosShPeriodD_  += (chaosShPeriodD_  - smoothedChaosShPeriodD_)  * (1.0f - chaosParamSmoothCoeff_);
+
+        const float period = smoothedChaosShPeriodD_;
+        const float sr = (float) currentSampleRate;
+        const int nCh = chaosStereo_ ? 2 : 1;
+
+        for (int c = 0; c < nCh; ++c)
+        {
+            advanceChaosEngine (chaosDPrev_[c], chaosDCurr_[c], chaosDNext_[c], chaosDPhase_[c],
+                chaosDDriftPhase_[c], chaosDDriftFreqHz_[c], chaosDOut_[c],
+                chaosDRng_[c], period, chaosAmtNormD_, sr);
+
+            advanceChaosEngine (chaosGPrev_[c], chaosGCurr_[c], chaosGNext_[c], chaosGPhase_[c],
+                chaosGDriftPhase_[c], chaosGDriftFreqHz_[c], chaosGOut_[c],
+                chaosGRng_[c], period, chaosAmtNormD_, sr);
+        }
+
+        if (! chaosStereo_)
+        {
+            chaosDOut_[1] = chaosDOut_[0];
+            chaosGOut_[1] = chaosGOut_[0];
+        }
+    }
+
+    inline void advanceChaosF() noexcept
+    {
+        smoothedChaosFilterMaxOct_  += (chaosFilterMaxOct_  - smoothedChaosFilterMaxOct_)  * (1.0f - chaosParamSmoothCoeff_);
+        smoothedChaosShPeriodF_     += (chaosShPeriodF_     - smoothedChaosShPeriodF_)     * (1.0f - chaosParamSmoothCoeff_);
+
+        const float amtNormF = chaosAmtF_ * 0.01f;
+        const float period   = smoothedChaosShPeriodF_;
+        const float sr       = (float) currentSampleRate;
+
+        chaosFPhase_ += 1.0f;
+        if (chaosFPhase_ >= period)
+        {
+            chaosFPhase_ -= period;
+            chaosFPrev_ = chaosFCurr_;
+            chaosFCurr_ = chaosFNext_;
+            chaosFNext_ = chaosFRng_.nextFloat() * 2.0f - 1.0f;
+            const float driftBase = sr / std::max (1.0f, period) * 0.37f;
+            chaosFDriftFreqHz_ = driftBase * (0.88f + chaosFRng_.nextFloat() * 0.24f);
+        }
+
+        const float t  = chaosFPhase_ / period;
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        const float h00 =  2.0f * t3 - 3.0f * t2 + 1.0f;
+        const float h10 =         t3 - 2.0f * t2 + t;
+        const float h01 = -2.0f * t3 + 3.0f * t2;
+        const float h11 =         t3 -        t2;
+        const float tangCurr = (chaosFNext_ - chaosFPrev_) * 0.5f;
+        const float tangNext = -chaosFCurr_ * 0.5f;
+        const float shValue  = h00 * chaosFCurr_ + h10 * tangCurr + h01 * chaosFNext_ + h11 * tangNext;
+
+        chaosFDriftPhase_ += chaosFDriftFreqHz_ / sr;
+        if (chaosFDriftPhase_ > 1e6f) chaosFDriftPhase_ -= 1e6f;
+        const float driftL = std::sin (chaosFDriftPhase_ * kTwoPi) * kChaosDriftAmp;
+
+        const float shWeight = std::clamp (amtNormF * 1.5f - 0.15f, 0.0f, 1.0f);
+        chaosFOut_[0] = driftL + shValue * shWeight;
+
+        if (chaosStereo_)
+        {
+            const float driftR = std::sin (chaosFDriftPhase_ * kTwoPi + kTwoPi * 0.25f) * kChaosDriftAmp;
+            chaosFOut_[1] = driftR + shValue * shWeight;
+        }
+        else
+        {
+            chaosFOut_[1] = chaosFOut_[0];
+        }
+    }
+
+    // Dual-stage transparent limiter state (stereo-linked)
+    static constexpr float kLimFloor = 1.0e-12f;
+    float limEnv1_[2] = { kLimFloor, kLimFloor };
+    float limEnv2_[2] = { kLimFloor, kLimFloor };
+    float limAtt1_ = 0.0f;
+    float limRel1_ = 0.0f;
+    float limRel2_ = 0.0f;
+
+    inline void applyLimiter (float& sampleL, float& sampleR, float threshLin) noexcept
+    {
+        const float peakL = std::abs (sampleL);
+        const float peakR = std::abs (sampleR);
+
+        // Stage 1 — leveler (2 ms attack, 10 ms release)
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float p = (ch == 0) ? peakL : peakR;
+            if (p > limEnv1_[ch])
+                limEnv1_[ch] = limAtt1_ * limEnv1_[ch] + (1.0f - limAtt1_) * p;
+            else
+                limEnv1_[ch] = limRel1_ * limEnv1_[ch] + (1.0f - limRel1_) * p;
+            if (limEnv1_[ch] < kLimFloor) limEnv1_[ch] = kLimFloor;
+        }
+
+        // Stage 2 — brickwall (instant attack, 100 ms release)
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float p = (ch == 0) ? peakL : peakR;
+            if (p > limEnv2_[ch])
+                limEnv2_[ch] = p;
+            else
+                limEnv2_[ch] = limRel2_ * limEnv2_[ch] + (1.0f - limRel2_) * p;
+            if (limEnv2_[ch] < kLimFloor) limEnv2_[ch] = kLimFloor;
+        }
+
+        // Stereo-linked gain reduction
+        float gr = 1.0f;
+        const float maxEnv1 = std::max (limEnv1_[0], limEnv1_[1]);
+        const float maxEnv2 = std::max (limEnv2_[0], limEnv2_[1]);
+        if (maxEnv1 > threshLin)
+            gr = std::min (gr, threshLin / maxEnv1);
+        if (maxEnv2 > threshLin)
+            gr = std::min (gr, threshLin / maxEnv2);
+
+        sampleL *= gr;
+        sampleR *= gr;
+    }
+};
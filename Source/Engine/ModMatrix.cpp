@@ -0,0 +1,250 @@
+#include "ModMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    template <typename T>
+    inline T limit (T lo, T hi, T v) noexcept
+    {
+        return v < lo ? lo : (hi < v ? hi : v);
+    }
+
+    // Phases (0..1) in place → bipolar waveform. Branch-free per shape so each
+    // loop vectorises; the sine is a refined parabola (~0.1 % error).
+    void shapeLfo (float* x, int n, int shape) noexcept
+    {
+        switch (shape)
+        {
+            case ModMatrix::LfoTriangle:
+                for (int k = 0; k < n; ++k)
+                {
+                    float t = x[k] + 0.25f;
+                    t -= (float) (int) t;
+                    x[k] = 1.0f - 4.0f * std::abs (t - 0.5f);
+                }
+                break;
+
+            case ModMatrix::LfoSawUp:
+                for (int k = 0; k < n; ++k)
+                    x[k] = 2.0f * x[k] - 1.0f;
+                break;
+
+            case ModMatrix::LfoSawDown:
+                for (int k = 0; k < n; ++k)
+                    x[k] = 1.0f - 2.0f * x[k];
+                break;
+
+            case ModMatrix::LfoSquare:
+                for (int k = 0; k < n; ++k)
+                    x[k] = x[k] < 0.5f ? 1.0f : -1.0f;
+                break;
+
+            default:
+                for (int k = 0; k < n; ++k)
+                {
+                    const float p = x[k] - 0.5f;                 // sin (2πx) = −sin (2πp)
+                    float y = 8.0f * p * (1.0f - 2.0f * std::abs (p));
+                    y += 0.225f * (y * std::abs (y) - y);
+                    x[k] = -y;
+                }
+                break;
+        }
+    }
+}
+
+//==============================================================================
+void ModMatrix::prepare (double sr, int maxBlockSize, uint64_t seed)
+{
+    sampleRate  = std::max (1.0, sr);
+    maxSegments = (std::max (1, maxBlockSize) + kSegmentSize - 1) / kSegmentSize;
+
+    for (auto& v : sourceValues) v.assign ((size_t) maxSegments, 0.0f);
+    for (auto& v : targetValues) v.assign ((size_t) maxSegments, 0.0f);
+    activeTargets = 0;
+
+    for (auto& ph : lfoPhase) ph = 0.0;
+    envLevel = 0.0f;
+    rngState = seed != 0 ? seed : 0x9e3779b97f4a7c15ull;
+    randomPrev = 0.0f;
+    randomNext = nextRandom() * 2.0f - 1.0f;
+    randomElapsed = 0.0f;
+}
+
+float ModMatrix::nextRandom() noexcept
+{
+    // Same xorshift64* as DisperserEngine::Rng.
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (float) ((rngState * 0x2545f4914f6cdd1dull) >> 40) * (1.0f / 16777216.0f);
+}
+
+bool ModMatrix::usesSource (const Settings& s, int source) noexcept
+{
+    for (const auto& r : s.routes)
+        if (r.source == source && r.depth != 0.0f && r.target >= 0 && r.target < kNumTargets)
+            return true;
+    return false;
+}
+
+float ModMatrix::getMaxDepth (const Settings& s, int target) noexcept
+{
+    float sum = 0.0f;
+    for (const auto& r : s.routes)
+        if (r.target == target && r.source > SourceNone && r.source < kNumSources)
+            sum += std::abs (r.depth);
+    return sum;
+}
+
+void ModMatrix::render (const float* const* input, int numChannels, int numSamples, const Settings& s,
+                        double samplesIntoCall) noexcept
+{
+    activeTargets = 0;
+    if (maxSegments <= 0 || numSamples <= 0)
+        return;
+
+    const int numSegments = std::min (maxSegments, (numSamples + kSegmentSize - 1) / kSegmentSize);
+
+    uint32_t neededSources = 0;
+    for (const auto& r : s.routes)
+    {
+        if (r.source > SourceNone && r.source < kNumSources && r.target >= 0 && r.target < kNumTargets && r.depth != 0.0f)
+        {
+            neededSources |= 1u << r.source;
+            activeTargets |= 1u << r.target;
+        }
+    }
+
+    // ── LFOs: phases always advance, so a route switched on later lands in time ──
+    for (int i = 0; i < kNumLfos; ++i)
+    {
+        const auto& lfo = s.lfo[(size_t) i];
+        double inc;   // cycles per sample
+        if (lfo.sync)
+        {
+            const double beats = std::max (1.0e-3, (double) lfo.syncBeats);
+            const double beatsPerSample = limit (1.0, 999.0, s.bpm) / (60.0 * sampleRate);
+            inc = beatsPerSample / beats;
+            if (s.ppq >= 0.0)
+            {
+                const double cycles = (s.ppq + samplesIntoCall * beatsPerSample) / beats;
+                lfoPhase[i] = cycles - std::floor (cycles);
+            }
+        }
+        else
+        {
+            inc = limit (0.0, sampleRate * 0.5, (double) lfo.rateHz) / sampleRate;
+        }
+
+        if ((neededSources >> (SourceLfo1 + i)) & 1u)
+        {
+            float* out = sourceValues[(size_t) (SourceLfo1 + i)].data();
+            const double segInc = inc * kSegmentSize;
+            for (int k = 0; k < numSegments; ++k)
+            {
+                const double ph = lfoPhase[i] + k * segInc;
+                out[k] = (float) (ph - std::floor (ph));
+            }
+            shapeLfo (out, numSegments, lfo.shape);
+        }
+
+        lfoPhase[i] += inc * numSamples;
+        lfoPhase[i] -= std::floor (lfoPhase[i]);
+    }
+
+    // ── Envelope follower: segment peak → one-pole attack/release → 0..1 over 60 dB ──
+    if ((neededSources >> SourceEnv) & 1u)
+    {
+        const double segSeconds = kSegmentSize / sampleRate;
+        const float att = (float) std::exp (-segSeconds / std::max (1.0e-4, s.envAttackMs * 0.001));
+        const float rel = (float) std::exp (-segSeconds / std::max (1.0e-4, s.envReleaseMs * 0.001));
+        float* out = sourceValues[SourceEnv].data();
+
+        for (int k = 0; k < numSegments; ++k)
+        {
+            if (input != nullptr)
+            {
+                const int start = k * kSegmentSize;
+                const int len = std::min (kSegmentSize, numSamples - start);
+                float peak = 0.0f;
+                for (int ch = 0; ch < numChannels; ++ch)
+                    for (int n = 0; n < len; ++n)
+                        peak = std::max (peak, std::abs (input[ch][start + n]));
+
+                envLevel = peak + (envLevel - peak) * (peak > envLevel ? att : rel);
+            }
+
+            out[k] = limit (0.0f, 1.0f, 1.0f + 20.0f * std::log10 (envLevel + 1.0e-9f) * (1.0f / 60.0f));
+        }
+    }
+
+    // ── Random: S&H with a linear glide over `randomGlide` of each period ──
+    {
+        const float period = (float) (sampleRate / limit (0.01, 1000.0, (double) s.randomRateHz));
+        const float glideSamples = period * limit (1.0e-3f, 1.0f, s.randomGlide);
+        float* out = sourceValues[SourceRandom].data();
+
+        for (int k = 0; k < numSegments; ++k)
+        {
+            const float t = std::min (1.0f, randomElapsed / glideSamples);
+            out[k] = randomPrev + (randomNext - randomPrev) * t;
+
+            randomElapsed += (float) std::min (kSegmentSize, numSamples - k * kSegmentSize);
+            while (randomElapsed >= period)
+            {
+                randomElapsed -= period;
+                randomPrev = randomNext;
+                randomNext = nextRandom() * 2.0f - 1.0f;
+            }
+        }
+    }
+
+    // ── Routes ──
+    for (int t = 0; t < kNumTargets; ++t)
+        if (isActive (t))
+            std::fill (targetValues[(size_t) t].begin(), targetValues[(size_t) t].begin() + numSegments, 0.0f);
+
+    for (const auto& r : s.routes)
+    {
+        if (r.source <= SourceNone || r.source >= kNumSources || r.target < 0 || r.target >= kNumTargets || r.depth == 0.0f)
+            continue;
+
+        const float gain = limit (-1.0f, 1.0f, r.depth) * kTargetRange[r.target];
+        const float* src = sourceValues[(size_t) r.source].data();
+        float* dst = targetValues[(size_t) r.target].data();
+        for (int k = 0; k < numSegments; ++k)
+            dst[k] += gain * src[k];
+    }
+}
+
+size_t ModMatrix::getMemoryBytes() const noexcept
+{
+    size_t total = 0;
+    for (const auto& v : sourceValues) total += v.capacity() * sizeof (float);
+    for (const auto& v : targetValues) total += v.capacity() * sizeof (float);
+    return total;
+}
+
+void ModMatrix::captureState (State& d) const noexcept
+{
+    for (int i = 0; i < kNumLfos; ++i)
+        d.lfoPhase[i] = lfoPhase[i];
+    d.envLevel      = envLevel;
+    d.randomPrev    = randomPrev;
+    d.randomNext    = randomNext;
+    d.randomElapsed = randomElapsed;
+    d.rngState      = rngState;
+}
+
+void ModMatrix::restoreState (const State& d) noexcept
+{
+    for (int i = 0; i < kNumLfos; ++i)
+        lfoPhase[i] = d.lfoPhase[i];
+    envLevel      = d.envLevel;
+    randomPrev    = d.randomPrev;
+    randomNext    = d.randomNext;
+    randomElapsed = d.randomElapsed;
+    rngState      = d.rngState;
+}
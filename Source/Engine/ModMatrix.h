@@ -0,0 +1,114 @@
+#pragma once
+
+// ============================================================================
+// ModMatrix.h — control-rate modulation sources and routing for DisperserEngine
+//
+// Two LFOs (free or tempo-synced), an envelope follower on the input and a
+// smoothed random source, routed through up to kMaxRoutes slots to FREQ,
+// SHAPE, FEEDBACK, MIX, TILT and the wet HP/LP cutoffs. Everything runs once
+// per kSegmentSize-sample control segment: render() fills one value per
+// segment for each source, then each route adds depth × source into its
+// target's array. The engine reads those arrays where it already works at
+// control rate (coefficient updates, the mix blend), so eight active routes
+// cost a handful of multiply-adds per 32 samples.
+// ============================================================================
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ModMatrix
+{
+public:
+    static constexpr int kNumLfos     = 2;
+    static constexpr int kMaxRoutes   = 8;
+    static constexpr int kSegmentSize = 32;
+
+    enum Source : int { SourceNone = 0, SourceLfo1, SourceLfo2, SourceEnv, SourceRandom, kNumSources };
+    enum Target : int { TargetFreq = 0, TargetShape, TargetFeedback, TargetMix, TargetTilt, TargetHp, TargetLp, kNumTargets };
+    enum LfoShape : int { LfoSine = 0, LfoTriangle, LfoSawUp, LfoSawDown, LfoSquare };
+
+    // Target offset at depth ±1: octaves for FREQ/HP/LP, dB for TILT, plain
+    // units for SHAPE, FEEDBACK (after the smoothstep map) and MIX.
+    static constexpr float kTargetRange[kNumTargets] = { 4.0f, 1.0f, 1.0f, 1.0f, 12.0f, 4.0f, 4.0f };
+
+    struct Lfo
+    {
+        int   shape     = LfoSine;
+        float rateHz    = 1.0f;
+        bool  sync      = false;
+        float syncBeats = 1.0f;         // cycle length in quarter notes when synced
+    };
+
+    struct Route
+    {
+        int   source = SourceNone;
+        int   target = TargetFreq;
+        float depth  = 0.0f;            // −1..1
+    };
+
+    struct Settings
+    {
+        std::array<Lfo, kNumLfos> lfo {};
+        float envAttackMs   = 10.0f;
+        float envReleaseMs  = 250.0f;
+        float randomRateHz  = 2.0f;
+        float randomGlide   = 1.0f;     // 0 = steps, 1 = glide across the whole period
+        std::array<Route, kMaxRoutes> routes {};
+
+        // Host transport for synced LFOs: tempo, and the position in quarter
+        // notes at the first sample of the call (< 0 when stopped, in which
+        // case synced LFOs free-run at the tempo).
+        double bpm = 120.0;
+        double ppq = -1.0;
+    };
+
+    // Everything the sources remember, for DisperserEngine::StateSnapshot.
+    struct State
+    {
+        double   lfoPhase[kNumLfos];
+        float    envLevel;
+        float    randomPrev, randomNext, randomElapsed;
+        uint64_t rngState;
+    };
+
+    void prepare (double sampleRate, int maxBlockSize, uint64_t seed);
+
+    // Evaluates one chunk's worth of segments (segment k covers samples
+    // [k·kSegmentSize, (k+1)·kSegmentSize) of `input`); `samplesIntoCall` is
+    // the chunk's offset from the sample Settings::ppq refers to. With
+    // input == nullptr the envelope holds and everything else advances as
+    // usual, which is what DisperserEngine::skipAhead needs.
+    void render (const float* const* input, int numChannels, int numSamples, const Settings& s,
+                 double samplesIntoCall = 0.0) noexcept;
+
+    // Valid after render(): per-segment offsets for targets with a route.
+    bool isActive (int target) const noexcept           { return (activeTargets >> target) & 1u; }
+    bool anyActive() const noexcept                     { return activeTargets != 0; }
+    const float* getTarget (int target) const noexcept  { return isActive (target) ? targetValues[(size_t) target].data() : nullptr; }
+
+    static bool usesSource (const Settings& s, int source) noexcept;
+    static float getMaxDepth (const Settings& s, int target) noexcept;   // Σ|depth| of routes to `target`
+
+    void captureState (State& dest) const noexcept;
+    void restoreState (const State& src) noexcept;
+
+    // Heap bytes of the per-segment source and target arrays.
+    size_t getMemoryBytes() const noexcept;
+
+private:
+    float nextRandom() noexcept;
+
+    double sampleRate = 44100.0;
+    int    maxSegments = 0;
+
+    double lfoPhase[kNumLfos] {};
+    float  envLevel = 0.0f;
+    float  randomPrev = 0.0f, randomNext = 0.0f, randomElapsed = 0.0f;
+    uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+    uint32_t activeTargets = 0;
+    std::array<std::vector<float>, kNumSources> sourceValues;
+    std::array<std::vector<float>, kNumTargets> targetValues;
+};
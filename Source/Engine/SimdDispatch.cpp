@@ -0,0 +1,1074 @@
+#include "SimdDispatch.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <string>
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+ #define DISPTR_SIMD_X86 1
+ #include <immintrin.h>
+ #if defined (_MSC_VER) && ! defined (__clang__)
+  #include <intrin.h>
+  #define DISPTR_TARGET(isa)
+ #else
+  #include <cpuid.h>
+  #define DISPTR_TARGET(isa) __attribute__ ((target (isa)))
+ #endif
+#else
+ #define DISPTR_SIMD_X86 0
+#endif
+
+// The AVX-512 target implies FMA; keep GCC from contracting mul+add so every
+// variant rounds exactly like the scalar path.
+#if defined (__GNUC__) && ! defined (__clang__)
+ #pragma GCC optimize ("fp-contract=off")
+#endif
+
+namespace simd
+{
+namespace
+{
+    // ── Scalar kernels (also the fallback tails of the vector ones) ──
+
+    // Stage-major cascade: each stage runs over the whole buffer before the
+    // next, keeping one coefficient and one state value in registers.
+    void cascadeStages (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        for (int st = 0; st < numStages; ++st)
+        {
+            const float a = coeffs[st];
+            float z = state[st];
+            for (int n = 0; n < numSamples; ++n)
+            {
+                const float x = data[n];
+                const float y = z - a * x;
+                z = x + a * y;
+                data[n] = y;
+            }
+            state[st] = z;
+        }
+    }
+
+    // ── Block-scan cascade ──
+    // The all-pass state obeys z[n] = a·z[n−1] + (1 − a²)·x[n], a first-order
+    // linear recurrence, so a block of kScanBlock samples can be solved at once:
+    // a prefix scan (shift-and-add by 1, 2 and 4 samples, scaled by a, a², a⁴)
+    // gives the block's response from zero state, and the state carried in
+    // adds a^(k+1)·z. Only that carry is serial, so a group of stages runs
+    // staggered one block apart and several carries are in flight at once.
+    // Samples past the last whole block run per sample; z is the same z1 the
+    // other kernels keep, so the two can take turns on one cascade.
+    //
+    // Every variant performs the same operations in the same order on 8-sample
+    // blocks (shifted-in lanes are multiplied as zeros, as in the scalar loop),
+    // so the scan is bit-identical across ISAs. It rounds differently from the
+    // per-sample form, though, by a few ULP.
+    constexpr int kScanBlock = 8;
+    constexpr int kScanGroup = 4;
+
+    struct ScanGroup
+    {
+        int   numStages;
+        float a[kScanGroup], b[kScanGroup], a2[kScanGroup], a4[kScanGroup];
+        float carry[kScanGroup][kScanBlock];   // a^(k+1)
+        float z[kScanGroup];
+    };
+
+    // Runs the group's stages over data[0 .. numBlocks · kScanBlock).
+    using ScanFn = void (*) (ScanGroup& g, float* data, int numBlocks) noexcept;
+
+    void scanBlocksScalar (ScanGroup& g, float* data, int numBlocks) noexcept
+    {
+        for (int t = 0; t < numBlocks + g.numStages - 1; ++t)
+        {
+            for (int s = 0; s < g.numStages; ++s)
+            {
+                const int j = t - s;
+                if (j < 0 || j >= numBlocks)
+                    continue;
+
+                float* x = data + j * kScanBlock;
+                float u[kScanBlock], v[kScanBlock], w[kScanBlock], p[kScanBlock], zz[kScanBlock];
+                for (int k = 0; k < kScanBlock; ++k)
+                    u[k] = g.b[s] * x[k];
+                for (int k = 0; k < kScanBlock; ++k)
+                    v[k] = u[k] + g.a[s] * (k >= 1 ? u[k - 1] : 0.0f);
+                for (int k = 0; k < kScanBlock; ++k)
+                    w[k] = v[k] + g.a2[s] * (k >= 2 ? v[k - 2] : 0.0f);
+                for (int k = 0; k < kScanBlock; ++k)
+                    p[k] = w[k] + g.a4[s] * (k >= 4 ? w[k - 4] : 0.0f);
+
+                const float z = g.z[s];
+                for (int k = 0; k < kScanBlock; ++k)
+                    zz[k] = p[k] + g.carry[s][k] * z;
+                for (int k = 0; k < kScanBlock; ++k)
+                    x[k] = (k == 0 ? z : zz[k - 1]) - g.a[s] * x[k];
+                g.z[s] = zz[kScanBlock - 1];
+            }
+        }
+    }
+
+    void cascadeScan (float* data, int numSamples, const float* coeffs, float* state, int numStages, ScanFn blocks) noexcept
+    {
+        const int numBlocks = numSamples / kScanBlock;
+        const int done = numBlocks * kScanBlock;
+
+        for (int st = 0; st < numStages; st += kScanGroup)
+        {
+            ScanGroup g;
+            g.numStages = std::min (kScanGroup, numStages - st);
+            for (int s = 0; s < g.numStages; ++s)
+            {
+                const float a = coeffs[st + s];
+                g.a[s]  = a;
+                g.b[s]  = 1.0f - a * a;
+                g.a2[s] = a * a;
+                g.a4[s] = g.a2[s] * g.a2[s];
+                float power = a;
+                for (int k = 0; k < kScanBlock; ++k)
+                {
+                    g.carry[s][k] = power;
+                    power *= a;
+                }
+                g.z[s] = state[st + s];
+            }
+
+            if (numBlocks > 0)
+                blocks (g, data, numBlocks);
+
+            for (int s = 0; s < g.numStages; ++s)
+                state[st + s] = g.z[s];
+
+            cascadeStages (data + done, numSamples - done, coeffs + st, state + st, g.numStages);
+        }
+    }
+
+    void cascadeScanScalar (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeScan (data, numSamples, coeffs, state, numStages, scanBlocksScalar);
+    }
+
+    void mixInsertScalar (const float* dry, const float* wet, float* out, int numSamples, float wetGain, float mix) noexcept
+    {
+        for (int n = 0; n < numSamples; ++n)
+            out[n] = dry[n] + mix * (wet[n] * wetGain - dry[n]);
+    }
+
+    void mixSendScalar (const float* dry, const float* wet, float* out, int numSamples,
+                        float wetGain, float dryLevel, float wetLevel) noexcept
+    {
+        for (int n = 0; n < numSamples; ++n)
+            out[n] = dry[n] * dryLevel + (wet[n] * wetGain) * wetLevel;
+    }
+
+
+    // ── Lane-interleaved kernels ──
+    constexpr int kLaneTile = 64;   // rows per pass of the vector lane cascades
+
+    void lanesCascadeScalar (float* data, int numSamples, int numLanes, int groupSize,
+                             const float* coeffs, float* state, int numStages) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int st = 0; st < numStages; ++st)
+        {
+            for (int l = 0; l < numLanes; ++l)
+            {
+                const float a = coeffs[st * numGroups + l / groupSize];
+                float z = state[st * numLanes + l];
+                float* p = data + l;
+                for (int n = 0; n < numSamples; ++n, p += numLanes)
+                {
+                    const float x = *p;
+                    const float y = z - a * x;
+                    z = x + a * y;
+                    *p = y;
+                }
+                state[st * numLanes + l] = z;
+            }
+        }
+    }
+
+    // Feedback couples the lanes sample by sample (WIDE crosses L and R), so
+    // a whole row takes its feedback before any lane of it runs the stages.
+    void lanesCascadeFeedbackScalar (float* data, int numSamples, int numLanes, int groupSize,
+                                     const float* coeffs, float* state, int numStages,
+                                     const float* feedback, float* last, int feedbackShift) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            for (int l = 0; l < numLanes; ++l)
+                row[l] = row[l] + feedback[n] * last[(l + feedbackShift) % numLanes];
+
+            for (int st = 0; st < numStages; ++st)
+            {
+                const float* c = coeffs + st * numGroups;
+                float* z = state + st * numLanes;
+                for (int l = 0; l < numLanes; ++l)
+                {
+                    const float a = c[l / groupSize];
+                    const float x = row[l];
+                    const float y = z[l] - a * x;
+                    z[l] = x + a * y;
+                    row[l] = y;
+                }
+            }
+
+            std::copy (row, row + numLanes, last);
+        }
+    }
+
+    void biquadLanesScalar (float* data, int numSamples, int numLanes,
+                            const float* c, float* z1, float* z2) noexcept
+    {
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            for (int l = 0; l < numLanes; ++l)
+            {
+                const float x = row[l];
+                const float y = c[0] * x + z1[l];
+                z1[l] = c[1] * x - c[3] * y + z2[l];
+                z2[l] = c[2] * x - c[4] * y;
+                row[l] = y;
+            }
+        }
+    }
+
+   #if DISPTR_SIMD_X86
+    // ── Wavefront cascade ──
+    // A cascade is serial in both time and stage, but stage k at sample n only
+    // needs stage k-1 at sample n. Skewing by one sample per lane puts W
+    // consecutive stages in one vector: each step, lane k processes the sample
+    // lane k-1 produced on the previous step, and lane W-1 emits a finished
+    // sample W-1 steps after it entered lane 0. Fill and drain (the first and
+    // last W-1 steps, where only some lanes hold real samples) run scalar.
+    template <int W>
+    struct Wavefront
+    {
+        float a[W];
+        float z[W];
+        float in[W];   // in[k] = input waiting for lane k
+
+        // Steps lanes [lo, hi], highest first so outputs shift up in place.
+        // Returns lane W-1's output (meaningful only when hi == W-1).
+        float step (int lo, int hi) noexcept
+        {
+            float out = 0.0f;
+            for (int k = hi; k >= lo; --k)
+            {
+                const float x = in[k];
+                const float y = z[k] - a[k] * x;
+                z[k] = x + a[k] * y;
+                if (k + 1 < W)
+                    in[k + 1] = y;
+                else
+                    out = y;
+            }
+            return out;
+        }
+    };
+
+    // Steady-state loop for one ISA: consumes data[W-1 .. numSamples) into
+    // lane 0 and writes finished samples to data[0 .. numSamples-W+1).
+    template <int W>
+    using SteadyFn = void (*) (Wavefront<W>& wf, float* data, int numSamples) noexcept;
+
+    template <int W>
+    void cascadeWavefront (float* data, int numSamples, const float* coeffs, float* state,
+                           int numStages, SteadyFn<W> steady) noexcept
+    {
+        int st = 0;
+
+        // Fill + drain cost ~2W scalar steps per group; not worth it on tiny segments.
+        if (numSamples >= 4 * W)
+        {
+            for (; st + W <= numStages; st += W)
+            {
+                Wavefront<W> wf;
+                for (int k = 0; k < W; ++k)
+                {
+                    wf.a[k] = coeffs[st + k];
+                    wf.z[k] = state[st + k];
+                    wf.in[k] = 0.0f;
+                }
+
+                for (int t = 0; t < W - 1; ++t)
+                {
+                    wf.in[0] = data[t];
+                    wf.step (0, t);
+                }
+
+                steady (wf, data, numSamples);
+
+                for (int d = 1; d < W; ++d)
+                    data[numSamples - W + d] = wf.step (d, W - 1);
+
+                for (int k = 0; k < W; ++k)
+                    state[st + k] = wf.z[k];
+            }
+        }
+
+        cascadeStages (data, numSamples, coeffs + st, state + st, numStages - st);
+    }
+
+    // ── SSE4.1 ──
+    DISPTR_TARGET ("sse4.1")
+    void steadySse41 (Wavefront<4>& wf, float* data, int numSamples) noexcept
+    {
+        const __m128 a = _mm_loadu_ps (wf.a);
+        __m128 z = _mm_loadu_ps (wf.z);
+        __m128 p = _mm_loadu_ps (wf.in);
+
+        for (int t = 3; t < numSamples; ++t)
+        {
+            p = _mm_move_ss (p, _mm_set_ss (data[t]));
+            const __m128 y = _mm_sub_ps (z, _mm_mul_ps (a, p));
+            z = _mm_add_ps (p, _mm_mul_ps (a, y));
+            data[t - 3] = _mm_cvtss_f32 (_mm_shuffle_ps (y, y, _MM_SHUFFLE (3, 3, 3, 3)));
+            p = _mm_castsi128_ps (_mm_slli_si128 (_mm_castps_si128 (y), 4));
+        }
+
+        _mm_storeu_ps (wf.z, z);
+        _mm_storeu_ps (wf.in, p);
+    }
+
+    void cascadeSse41 (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeWavefront<4> (data, numSamples, coeffs, state, numStages, steadySse41);
+    }
+
+    // A block is two registers: lo = samples 0..3, hi = 4..7.
+    DISPTR_TARGET ("sse4.1")
+    void scanBlocksSse41 (ScanGroup& g, float* data, int numBlocks) noexcept
+    {
+        const __m128 zero = _mm_setzero_ps();
+
+        for (int t = 0; t < numBlocks + g.numStages - 1; ++t)
+        {
+            for (int s = 0; s < g.numStages; ++s)
+            {
+                const int j = t - s;
+                if (j < 0 || j >= numBlocks)
+                    continue;
+
+                float* x = data + j * kScanBlock;
+                const __m128 a = _mm_set1_ps (g.a[s]);
+                const __m128 xLo = _mm_loadu_ps (x);
+                const __m128 xHi = _mm_loadu_ps (x + 4);
+
+                const __m128 uLo = _mm_mul_ps (_mm_set1_ps (g.b[s]), xLo);
+                const __m128 uHi = _mm_mul_ps (_mm_set1_ps (g.b[s]), xHi);
+
+                const __m128 vLo = _mm_add_ps (uLo, _mm_mul_ps (a, _mm_castsi128_ps (_mm_slli_si128 (_mm_castps_si128 (uLo), 4))));
+                const __m128 vHi = _mm_add_ps (uHi, _mm_mul_ps (a, _mm_castsi128_ps (_mm_alignr_epi8 (_mm_castps_si128 (uHi), _mm_castps_si128 (uLo), 12))));
+
+                const __m128 a2 = _mm_set1_ps (g.a2[s]);
+                const __m128 wLo = _mm_add_ps (vLo, _mm_mul_ps (a2, _mm_castsi128_ps (_mm_slli_si128 (_mm_castps_si128 (vLo), 8))));
+                const __m128 wHi = _mm_add_ps (vHi, _mm_mul_ps (a2, _mm_castsi128_ps (_mm_alignr_epi8 (_mm_castps_si128 (vHi), _mm_castps_si128 (vLo), 8))));
+
+                const __m128 a4 = _mm_set1_ps (g.a4[s]);
+                const __m128 pLo = _mm_add_ps (wLo, _mm_mul_ps (a4, zero));
+                const __m128 pHi = _mm_add_ps (wHi, _mm_mul_ps (a4, wLo));
+
+                const __m128 z = _mm_set1_ps (g.z[s]);
+                const __m128 zzLo = _mm_add_ps (pLo, _mm_mul_ps (_mm_loadu_ps (g.carry[s]), z));
+                const __m128 zzHi = _mm_add_ps (pHi, _mm_mul_ps (_mm_loadu_ps (g.carry[s] + 4), z));
+
+                const __m128 prevLo = _mm_move_ss (_mm_castsi128_ps (_mm_slli_si128 (_mm_castps_si128 (zzLo), 4)), z);
+                const __m128 prevHi = _mm_castsi128_ps (_mm_alignr_epi8 (_mm_castps_si128 (zzHi), _mm_castps_si128 (zzLo), 12));
+                _mm_storeu_ps (x,     _mm_sub_ps (prevLo, _mm_mul_ps (a, xLo)));
+                _mm_storeu_ps (x + 4, _mm_sub_ps (prevHi, _mm_mul_ps (a, xHi)));
+
+                g.z[s] = _mm_cvtss_f32 (_mm_shuffle_ps (zzHi, zzHi, _MM_SHUFFLE (3, 3, 3, 3)));
+            }
+        }
+    }
+
+    void cascadeScanSse41 (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeScan (data, numSamples, coeffs, state, numStages, scanBlocksSse41);
+    }
+
+    DISPTR_TARGET ("sse4.1")
+    void mixInsertSse41 (const float* dry, const float* wet, float* out, int numSamples, float wetGain, float mix) noexcept
+    {
+        const __m128 g = _mm_set1_ps (wetGain);
+        const __m128 m = _mm_set1_ps (mix);
+        int n = 0;
+        for (; n + 4 <= numSamples; n += 4)
+        {
+            const __m128 d = _mm_loadu_ps (dry + n);
+            const __m128 w = _mm_mul_ps (_mm_loadu_ps (wet + n), g);
+            _mm_storeu_ps (out + n, _mm_add_ps (d, _mm_mul_ps (m, _mm_sub_ps (w, d))));
+        }
+        mixInsertScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, mix);
+    }
+
+    DISPTR_TARGET ("sse4.1")
+    void mixSendSse41 (const float* dry, const float* wet, float* out, int numSamples,
+                       float wetGain, float dryLevel, float wetLevel) noexcept
+    {
+        const __m128 g = _mm_set1_ps (wetGain);
+        const __m128 dl = _mm_set1_ps (dryLevel);
+        const __m128 wl = _mm_set1_ps (wetLevel);
+        int n = 0;
+        for (; n + 4 <= numSamples; n += 4)
+        {
+            const __m128 d = _mm_mul_ps (_mm_loadu_ps (dry + n), dl);
+            const __m128 w = _mm_mul_ps (_mm_mul_ps (_mm_loadu_ps (wet + n), g), wl);
+            _mm_storeu_ps (out + n, _mm_add_ps (d, w));
+        }
+        mixSendScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, dryLevel, wetLevel);
+    }
+
+    // Lane cascade: four stages per pass over a tile of rows, coefficients and
+    // states in registers; their recurrences overlap from sample to sample,
+    // and the tile stays in L1 while every stage goes over it.
+    DISPTR_TARGET ("sse4.1")
+    void lanesCascadeSse41 (float* data, int numSamples, int numLanes, int groupSize,
+                            const float* coeffs, float* state, int numStages) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int l = 0; l < numLanes; l += 4)
+        for (int t = 0; t < numSamples; t += kLaneTile)
+        {
+            const int rows = std::min (kLaneTile, numSamples - t);
+            const float* c = coeffs + l / groupSize;
+            float* zs = state + l;
+            int st = 0;
+            for (; st + 4 <= numStages; st += 4)
+            {
+                const __m128 a0 = _mm_set1_ps (c[(st + 0) * numGroups]);
+                const __m128 a1 = _mm_set1_ps (c[(st + 1) * numGroups]);
+                const __m128 a2 = _mm_set1_ps (c[(st + 2) * numGroups]);
+                const __m128 a3 = _mm_set1_ps (c[(st + 3) * numGroups]);
+                __m128 z0 = _mm_loadu_ps (zs + (st + 0) * numLanes);
+                __m128 z1 = _mm_loadu_ps (zs + (st + 1) * numLanes);
+                __m128 z2 = _mm_loadu_ps (zs + (st + 2) * numLanes);
+                __m128 z3 = _mm_loadu_ps (zs + (st + 3) * numLanes);
+
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m128 x = _mm_loadu_ps (p);
+                    const __m128 y0 = _mm_sub_ps (z0, _mm_mul_ps (a0, x));
+                    z0 = _mm_add_ps (x, _mm_mul_ps (a0, y0));
+                    const __m128 y1 = _mm_sub_ps (z1, _mm_mul_ps (a1, y0));
+                    z1 = _mm_add_ps (y0, _mm_mul_ps (a1, y1));
+                    const __m128 y2 = _mm_sub_ps (z2, _mm_mul_ps (a2, y1));
+                    z2 = _mm_add_ps (y1, _mm_mul_ps (a2, y2));
+                    const __m128 y3 = _mm_sub_ps (z3, _mm_mul_ps (a3, y2));
+                    z3 = _mm_add_ps (y2, _mm_mul_ps (a3, y3));
+                    _mm_storeu_ps (p, y3);
+                }
+
+                _mm_storeu_ps (zs + (st + 0) * numLanes, z0);
+                _mm_storeu_ps (zs + (st + 1) * numLanes, z1);
+                _mm_storeu_ps (zs + (st + 2) * numLanes, z2);
+                _mm_storeu_ps (zs + (st + 3) * numLanes, z3);
+            }
+
+            for (; st < numStages; ++st)
+            {
+                const __m128 a = _mm_set1_ps (c[st * numGroups]);
+                __m128 z = _mm_loadu_ps (zs + st * numLanes);
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m128 x = _mm_loadu_ps (p);
+                    const __m128 y = _mm_sub_ps (z, _mm_mul_ps (a, x));
+                    z = _mm_add_ps (x, _mm_mul_ps (a, y));
+                    _mm_storeu_ps (p, y);
+                }
+                _mm_storeu_ps (zs + st * numLanes, z);
+            }
+        }
+    }
+
+    DISPTR_TARGET ("sse4.1")
+    void lanesCascadeFeedbackSse41 (float* data, int numSamples, int numLanes, int groupSize,
+                                    const float* coeffs, float* state, int numStages,
+                                    const float* feedback, float* last, int feedbackShift) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            const __m128 fb = _mm_set1_ps (feedback[n]);
+            for (int l = 0; l < numLanes; l += 4)
+            {
+                const __m128 prev = _mm_loadu_ps (last + (l + feedbackShift) % numLanes);
+                _mm_storeu_ps (row + l, _mm_add_ps (_mm_loadu_ps (row + l), _mm_mul_ps (fb, prev)));
+            }
+
+            for (int st = 0; st < numStages; ++st)
+            {
+                const float* c = coeffs + st * numGroups;
+                float* z = state + st * numLanes;
+                for (int l = 0; l < numLanes; l += 4)
+                {
+                    const __m128 a = _mm_set1_ps (c[l / groupSize]);
+                    const __m128 x = _mm_loadu_ps (row + l);
+                    const __m128 y = _mm_sub_ps (_mm_loadu_ps (z + l), _mm_mul_ps (a, x));
+                    _mm_storeu_ps (z + l, _mm_add_ps (x, _mm_mul_ps (a, y)));
+                    _mm_storeu_ps (row + l, y);
+                }
+            }
+
+            for (int l = 0; l < numLanes; l += 4)
+                _mm_storeu_ps (last + l, _mm_loadu_ps (row + l));
+        }
+    }
+
+    DISPTR_TARGET ("sse4.1")
+    void biquadLanesSse41 (float* data, int numSamples, int numLanes,
+                           const float* c, float* z1, float* z2) noexcept
+    {
+        const __m128 b0 = _mm_set1_ps (c[0]), b1 = _mm_set1_ps (c[1]), b2 = _mm_set1_ps (c[2]);
+        const __m128 a1 = _mm_set1_ps (c[3]), a2 = _mm_set1_ps (c[4]);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            for (int l = 0; l < numLanes; l += 4)
+            {
+                const __m128 x = _mm_loadu_ps (row + l);
+                const __m128 y = _mm_add_ps (_mm_mul_ps (b0, x), _mm_loadu_ps (z1 + l));
+                _mm_storeu_ps (z1 + l, _mm_add_ps (_mm_sub_ps (_mm_mul_ps (b1, x), _mm_mul_ps (a1, y)), _mm_loadu_ps (z2 + l)));
+                _mm_storeu_ps (z2 + l, _mm_sub_ps (_mm_mul_ps (b2, x), _mm_mul_ps (a2, y)));
+                _mm_storeu_ps (row + l, y);
+            }
+        }
+    }
+
+    // ── AVX2 ──
+    DISPTR_TARGET ("avx2")
+    void steadyAvx2 (Wavefront<8>& wf, float* data, int numSamples) noexcept
+    {
+        const __m256i shiftUp = _mm256_setr_epi32 (0, 0, 1, 2, 3, 4, 5, 6);
+        const __m256i lastLane = _mm256_set1_epi32 (7);
+        const __m256 a = _mm256_loadu_ps (wf.a);
+        __m256 z = _mm256_loadu_ps (wf.z);
+        __m256 p = _mm256_loadu_ps (wf.in);
+
+        for (int t = 7; t < numSamples; ++t)
+        {
+            p = _mm256_blend_ps (p, _mm256_set1_ps (data[t]), 1);
+            const __m256 y = _mm256_sub_ps (z, _mm256_mul_ps (a, p));
+            z = _mm256_add_ps (p, _mm256_mul_ps (a, y));
+            data[t - 7] = _mm256_cvtss_f32 (_mm256_permutevar8x32_ps (y, lastLane));
+            p = _mm256_permutevar8x32_ps (y, shiftUp);
+        }
+
+        _mm256_storeu_ps (wf.z, z);
+        _mm256_storeu_ps (wf.in, p);
+    }
+
+    void cascadeAvx2 (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeWavefront<8> (data, numSamples, coeffs, state, numStages, steadyAvx2);
+    }
+
+    // One block per register; the shifts are lane permutes with zeros blended in.
+    DISPTR_TARGET ("avx2")
+    void scanBlocksAvx2 (ScanGroup& g, float* data, int numBlocks) noexcept
+    {
+        const __m256i shift1 = _mm256_setr_epi32 (0, 0, 1, 2, 3, 4, 5, 6);
+        const __m256i shift2 = _mm256_setr_epi32 (0, 0, 0, 1, 2, 3, 4, 5);
+        const __m256i shift4 = _mm256_setr_epi32 (0, 0, 0, 0, 0, 1, 2, 3);
+        const __m256i lastLane = _mm256_set1_epi32 (7);
+        const __m256 zero = _mm256_setzero_ps();
+
+        for (int t = 0; t < numBlocks + g.numStages - 1; ++t)
+        {
+            for (int s = 0; s < g.numStages; ++s)
+            {
+                const int j = t - s;
+                if (j < 0 || j >= numBlocks)
+                    continue;
+
+                float* x = data + j * kScanBlock;
+                const __m256 a = _mm256_set1_ps (g.a[s]);
+                const __m256 in = _mm256_loadu_ps (x);
+
+                const __m256 u = _mm256_mul_ps (_mm256_set1_ps (g.b[s]), in);
+                const __m256 v = _mm256_add_ps (u, _mm256_mul_ps (a, _mm256_blend_ps (zero, _mm256_permutevar8x32_ps (u, shift1), 0xfe)));
+                const __m256 w = _mm256_add_ps (v, _mm256_mul_ps (_mm256_set1_ps (g.a2[s]), _mm256_blend_ps (zero, _mm256_permutevar8x32_ps (v, shift2), 0xfc)));
+                const __m256 p = _mm256_add_ps (w, _mm256_mul_ps (_mm256_set1_ps (g.a4[s]), _mm256_blend_ps (zero, _mm256_permutevar8x32_ps (w, shift4), 0xf0)));
+
+                const __m256 z = _mm256_set1_ps (g.z[s]);
+                const __m256 zz = _mm256_add_ps (p, _mm256_mul_ps (_mm256_loadu_ps (g.carry[s]), z));
+                const __m256 prev = _mm256_blend_ps (_mm256_permutevar8x32_ps (zz, shift1), z, 0x01);
+                _mm256_storeu_ps (x, _mm256_sub_ps (prev, _mm256_mul_ps (a, in)));
+
+                // zz[7] again in scalar: the same two roundings, but the carry
+                // chain skips the vector broadcast and lane extract.
+                g.z[s] = _mm256_cvtss_f32 (_mm256_permutevar8x32_ps (p, lastLane)) + g.carry[s][kScanBlock - 1] * g.z[s];
+            }
+        }
+    }
+
+    void cascadeScanAvx2 (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeScan (data, numSamples, coeffs, state, numStages, scanBlocksAvx2);
+    }
+
+    DISPTR_TARGET ("avx2")
+    void mixInsertAvx2 (const float* dry, const float* wet, float* out, int numSamples, float wetGain, float mix) noexcept
+    {
+        const __m256 g = _mm256_set1_ps (wetGain);
+        const __m256 m = _mm256_set1_ps (mix);
+        int n = 0;
+        for (; n + 8 <= numSamples; n += 8)
+        {
+            const __m256 d = _mm256_loadu_ps (dry + n);
+            const __m256 w = _mm256_mul_ps (_mm256_loadu_ps (wet + n), g);
+            _mm256_storeu_ps (out + n, _mm256_add_ps (d, _mm256_mul_ps (m, _mm256_sub_ps (w, d))));
+        }
+        mixInsertScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, mix);
+    }
+
+    DISPTR_TARGET ("avx2")
+    void mixSendAvx2 (const float* dry, const float* wet, float* out, int numSamples,
+                      float wetGain, float dryLevel, float wetLevel) noexcept
+    {
+        const __m256 g = _mm256_set1_ps (wetGain);
+        const __m256 dl = _mm256_set1_ps (dryLevel);
+        const __m256 wl = _mm256_set1_ps (wetLevel);
+        int n = 0;
+        for (; n + 8 <= numSamples; n += 8)
+        {
+            const __m256 d = _mm256_mul_ps (_mm256_loadu_ps (dry + n), dl);
+            const __m256 w = _mm256_mul_ps (_mm256_mul_ps (_mm256_loadu_ps (wet + n), g), wl);
+            _mm256_storeu_ps (out + n, _mm256_add_ps (d, w));
+        }
+        mixSendScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, dryLevel, wetLevel);
+    }
+
+    DISPTR_TARGET ("avx2")
+    void lanesCascadeAvx2 (float* data, int numSamples, int numLanes, int groupSize,
+                           const float* coeffs, float* state, int numStages) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int l = 0; l < numLanes; l += 8)
+        for (int t = 0; t < numSamples; t += kLaneTile)
+        {
+            const int rows = std::min (kLaneTile, numSamples - t);
+            const float* c = coeffs + l / groupSize;
+            float* zs = state + l;
+            int st = 0;
+            for (; st + 4 <= numStages; st += 4)
+            {
+                const __m256 a0 = _mm256_set1_ps (c[(st + 0) * numGroups]);
+                const __m256 a1 = _mm256_set1_ps (c[(st + 1) * numGroups]);
+                const __m256 a2 = _mm256_set1_ps (c[(st + 2) * numGroups]);
+                const __m256 a3 = _mm256_set1_ps (c[(st + 3) * numGroups]);
+                __m256 z0 = _mm256_loadu_ps (zs + (st + 0) * numLanes);
+                __m256 z1 = _mm256_loadu_ps (zs + (st + 1) * numLanes);
+                __m256 z2 = _mm256_loadu_ps (zs + (st + 2) * numLanes);
+                __m256 z3 = _mm256_loadu_ps (zs + (st + 3) * numLanes);
+
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m256 x = _mm256_loadu_ps (p);
+                    const __m256 y0 = _mm256_sub_ps (z0, _mm256_mul_ps (a0, x));
+                    z0 = _mm256_add_ps (x, _mm256_mul_ps (a0, y0));
+                    const __m256 y1 = _mm256_sub_ps (z1, _mm256_mul_ps (a1, y0));
+                    z1 = _mm256_add_ps (y0, _mm256_mul_ps (a1, y1));
+                    const __m256 y2 = _mm256_sub_ps (z2, _mm256_mul_ps (a2, y1));
+                    z2 = _mm256_add_ps (y1, _mm256_mul_ps (a2, y2));
+                    const __m256 y3 = _mm256_sub_ps (z3, _mm256_mul_ps (a3, y2));
+                    z3 = _mm256_add_ps (y2, _mm256_mul_ps (a3, y3));
+                    _mm256_storeu_ps (p, y3);
+                }
+
+                _mm256_storeu_ps (zs + (st + 0) * numLanes, z0);
+                _mm256_storeu_ps (zs + (st + 1) * numLanes, z1);
+                _mm256_storeu_ps (zs + (st + 2) * numLanes, z2);
+                _mm256_storeu_ps (zs + (st + 3) * numLanes, z3);
+            }
+
+            for (; st < numStages; ++st)
+            {
+                const __m256 a = _mm256_set1_ps (c[st * numGroups]);
+                __m256 z = _mm256_loadu_ps (zs + st * numLanes);
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m256 x = _mm256_loadu_ps (p);
+                    const __m256 y = _mm256_sub_ps (z, _mm256_mul_ps (a, x));
+                    z = _mm256_add_ps (x, _mm256_mul_ps (a, y));
+                    _mm256_storeu_ps (p, y);
+                }
+                _mm256_storeu_ps (zs + st * numLanes, z);
+            }
+        }
+    }
+
+    DISPTR_TARGET ("avx2")
+    void lanesCascadeFeedbackAvx2 (float* data, int numSamples, int numLanes, int groupSize,
+                                   const float* coeffs, float* state, int numStages,
+                                   const float* feedback, float* last, int feedbackShift) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            const __m256 fb = _mm256_set1_ps (feedback[n]);
+            for (int l = 0; l < numLanes; l += 8)
+            {
+                const __m256 prev = _mm256_loadu_ps (last + (l + feedbackShift) % numLanes);
+                _mm256_storeu_ps (row + l, _mm256_add_ps (_mm256_loadu_ps (row + l), _mm256_mul_ps (fb, prev)));
+            }
+
+            for (int st = 0; st < numStages; ++st)
+            {
+                const float* c = coeffs + st * numGroups;
+                float* z = state + st * numLanes;
+                for (int l = 0; l < numLanes; l += 8)
+                {
+                    const __m256 a = _mm256_set1_ps (c[l / groupSize]);
+                    const __m256 x = _mm256_loadu_ps (row + l);
+                    const __m256 y = _mm256_sub_ps (_mm256_loadu_ps (z + l), _mm256_mul_ps (a, x));
+                    _mm256_storeu_ps (z + l, _mm256_add_ps (x, _mm256_mul_ps (a, y)));
+                    _mm256_storeu_ps (row + l, y);
+                }
+            }
+
+            for (int l = 0; l < numLanes; l += 8)
+                _mm256_storeu_ps (last + l, _mm256_loadu_ps (row + l));
+        }
+    }
+
+    DISPTR_TARGET ("avx2")
+    void biquadLanesAvx2 (float* data, int numSamples, int numLanes,
+                          const float* c, float* z1, float* z2) noexcept
+    {
+        const __m256 b0 = _mm256_set1_ps (c[0]), b1 = _mm256_set1_ps (c[1]), b2 = _mm256_set1_ps (c[2]);
+        const __m256 a1 = _mm256_set1_ps (c[3]), a2 = _mm256_set1_ps (c[4]);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            for (int l = 0; l < numLanes; l += 8)
+            {
+                const __m256 x = _mm256_loadu_ps (row + l);
+                const __m256 y = _mm256_add_ps (_mm256_mul_ps (b0, x), _mm256_loadu_ps (z1 + l));
+                _mm256_storeu_ps (z1 + l, _mm256_add_ps (_mm256_sub_ps (_mm256_mul_ps (b1, x), _mm256_mul_ps (a1, y)), _mm256_loadu_ps (z2 + l)));
+                _mm256_storeu_ps (z2 + l, _mm256_sub_ps (_mm256_mul_ps (b2, x), _mm256_mul_ps (a2, y)));
+                _mm256_storeu_ps (row + l, y);
+            }
+        }
+    }
+
+    // ── AVX-512 ──
+    DISPTR_TARGET ("avx512f")
+    void steadyAvx512 (Wavefront<16>& wf, float* data, int numSamples) noexcept
+    {
+        const __m512i shiftUp = _mm512_setr_epi32 (0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+        const __m512i lastLane = _mm512_set1_epi32 (15);
+        const __m512 a = _mm512_loadu_ps (wf.a);
+        __m512 z = _mm512_loadu_ps (wf.z);
+        __m512 p = _mm512_loadu_ps (wf.in);
+
+        for (int t = 15; t < numSamples; ++t)
+        {
+            p = _mm512_mask_mov_ps (p, (__mmask16) 1, _mm512_set1_ps (data[t]));
+            const __m512 y = _mm512_sub_ps (z, _mm512_mul_ps (a, p));
+            z = _mm512_add_ps (p, _mm512_mul_ps (a, y));
+            data[t - 15] = _mm512_cvtss_f32 (_mm512_permutexvar_ps (lastLane, y));
+            p = _mm512_permutexvar_ps (shiftUp, y);
+        }
+
+        _mm512_storeu_ps (wf.z, z);
+        _mm512_storeu_ps (wf.in, p);
+    }
+
+    void cascadeAvx512 (float* data, int numSamples, const float* coeffs, float* state, int numStages) noexcept
+    {
+        cascadeWavefront<16> (data, numSamples, coeffs, state, numStages, steadyAvx512);
+    }
+
+    DISPTR_TARGET ("avx512f")
+    void mixInsertAvx512 (const float* dry, const float* wet, float* out, int numSamples, float wetGain, float mix) noexcept
+    {
+        const __m512 g = _mm512_set1_ps (wetGain);
+        const __m512 m = _mm512_set1_ps (mix);
+        int n = 0;
+        for (; n + 16 <= numSamples; n += 16)
+        {
+            const __m512 d = _mm512_loadu_ps (dry + n);
+            const __m512 w = _mm512_mul_ps (_mm512_loadu_ps (wet + n), g);
+            _mm512_storeu_ps (out + n, _mm512_add_ps (d, _mm512_mul_ps (m, _mm512_sub_ps (w, d))));
+        }
+        mixInsertScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, mix);
+    }
+
+    DISPTR_TARGET ("avx512f")
+    void mixSendAvx512 (const float* dry, const float* wet, float* out, int numSamples,
+                        float wetGain, float dryLevel, float wetLevel) noexcept
+    {
+        const __m512 g = _mm512_set1_ps (wetGain);
+        const __m512 dl = _mm512_set1_ps (dryLevel);
+        const __m512 wl = _mm512_set1_ps (wetLevel);
+        int n = 0;
+        for (; n + 16 <= numSamples; n += 16)
+        {
+            const __m512 d = _mm512_mul_ps (_mm512_loadu_ps (dry + n), dl);
+            const __m512 w = _mm512_mul_ps (_mm512_mul_ps (_mm512_loadu_ps (wet + n), g), wl);
+            _mm512_storeu_ps (out + n, _mm512_add_ps (d, w));
+        }
+        mixSendScalar (dry + n, wet + n, out + n, numSamples - n, wetGain, dryLevel, wetLevel);
+    }
+
+    DISPTR_TARGET ("avx512f")
+    void lanesCascadeAvx512 (float* data, int numSamples, int numLanes, int groupSize,
+                             const float* coeffs, float* state, int numStages) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int l = 0; l < numLanes; l += 16)
+        for (int t = 0; t < numSamples; t += kLaneTile)
+        {
+            const int rows = std::min (kLaneTile, numSamples - t);
+            const float* c = coeffs + l / groupSize;
+            float* zs = state + l;
+            int st = 0;
+            for (; st + 4 <= numStages; st += 4)
+            {
+                const __m512 a0 = _mm512_set1_ps (c[(st + 0) * numGroups]);
+                const __m512 a1 = _mm512_set1_ps (c[(st + 1) * numGroups]);
+                const __m512 a2 = _mm512_set1_ps (c[(st + 2) * numGroups]);
+                const __m512 a3 = _mm512_set1_ps (c[(st + 3) * numGroups]);
+                __m512 z0 = _mm512_loadu_ps (zs + (st + 0) * numLanes);
+                __m512 z1 = _mm512_loadu_ps (zs + (st + 1) * numLanes);
+                __m512 z2 = _mm512_loadu_ps (zs + (st + 2) * numLanes);
+                __m512 z3 = _mm512_loadu_ps (zs + (st + 3) * numLanes);
+
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m512 x = _mm512_loadu_ps (p);
+                    const __m512 y0 = _mm512_sub_ps (z0, _mm512_mul_ps (a0, x));
+                    z0 = _mm512_add_ps (x, _mm512_mul_ps (a0, y0));
+                    const __m512 y1 = _mm512_sub_ps (z1, _mm512_mul_ps (a1, y0));
+                    z1 = _mm512_add_ps (y0, _mm512_mul_ps (a1, y1));
+                    const __m512 y2 = _mm512_sub_ps (z2, _mm512_mul_ps (a2, y1));
+                    z2 = _mm512_add_ps (y1, _mm512_mul_ps (a2, y2));
+                    const __m512 y3 = _mm512_sub_ps (z3, _mm512_mul_ps (a3, y2));
+                    z3 = _mm512_add_ps (y2, _mm512_mul_ps (a3, y3));
+                    _mm512_storeu_ps (p, y3);
+                }
+
+                _mm512_storeu_ps (zs + (st + 0) * numLanes, z0);
+                _mm512_storeu_ps (zs + (st + 1) * numLanes, z1);
+                _mm512_storeu_ps (zs + (st + 2) * numLanes, z2);
+                _mm512_storeu_ps (zs + (st + 3) * numLanes, z3);
+            }
+
+            for (; st < numStages; ++st)
+            {
+                const __m512 a = _mm512_set1_ps (c[st * numGroups]);
+                __m512 z = _mm512_loadu_ps (zs + st * numLanes);
+                float* p = data + (size_t) t * (size_t) numLanes + l;
+                for (int n = 0; n < rows; ++n, p += numLanes)
+                {
+                    const __m512 x = _mm512_loadu_ps (p);
+                    const __m512 y = _mm512_sub_ps (z, _mm512_mul_ps (a, x));
+                    z = _mm512_add_ps (x, _mm512_mul_ps (a, y));
+                    _mm512_storeu_ps (p, y);
+                }
+                _mm512_storeu_ps (zs + st * numLanes, z);
+            }
+        }
+    }
+
+    DISPTR_TARGET ("avx512f")
+    void lanesCascadeFeedbackAvx512 (float* data, int numSamples, int numLanes, int groupSize,
+                                     const float* coeffs, float* state, int numStages,
+                                     const float* feedback, float* last, int feedbackShift) noexcept
+    {
+        const int numGroups = numLanes / groupSize;
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            const __m512 fb = _mm512_set1_ps (feedback[n]);
+            for (int l = 0; l < numLanes; l += 16)
+            {
+                const __m512 prev = _mm512_loadu_ps (last + (l + feedbackShift) % numLanes);
+                _mm512_storeu_ps (row + l, _mm512_add_ps (_mm512_loadu_ps (row + l), _mm512_mul_ps (fb, prev)));
+            }
+
+            for (int st = 0; st < numStages; ++st)
+            {
+                const float* c = coeffs + st * numGroups;
+                float* z = state + st * numLanes;
+                for (int l = 0; l < numLanes; l += 16)
+                {
+                    const __m512 a = _mm512_set1_ps (c[l / groupSize]);
+                    const __m512 x = _mm512_loadu_ps (row + l);
+                    const __m512 y = _mm512_sub_ps (_mm512_loadu_ps (z + l), _mm512_mul_ps (a, x));
+                    _mm512_storeu_ps (z + l, _mm512_add_ps (x, _mm512_mul_ps (a, y)));
+                    _mm512_storeu_ps (row + l, y);
+                }
+            }
+
+            for (int l = 0; l < numLanes; l += 16)
+                _mm512_storeu_ps (last + l, _mm512_loadu_ps (row + l));
+        }
+    }
+
+    DISPTR_TARGET ("avx512f")
+    void biquadLanesAvx512 (float* data, int numSamples, int numLanes,
+                            const float* c, float* z1, float* z2) noexcept
+    {
+        const __m512 b0 = _mm512_set1_ps (c[0]), b1 = _mm512_set1_ps (c[1]), b2 = _mm512_set1_ps (c[2]);
+        const __m512 a1 = _mm512_set1_ps (c[3]), a2 = _mm512_set1_ps (c[4]);
+        for (int n = 0; n < numSamples; ++n)
+        {
+            float* row = data + (size_t) n * (size_t) numLanes;
+            for (int l = 0; l < numLanes; l += 16)
+            {
+                const __m512 x = _mm512_loadu_ps (row + l);
+                const __m512 y = _mm512_add_ps (_mm512_mul_ps (b0, x), _mm512_loadu_ps (z1 + l));
+                _mm512_storeu_ps (z1 + l, _mm512_add_ps (_mm512_sub_ps (_mm512_mul_ps (b1, x), _mm512_mul_ps (a1, y)), _mm512_loadu_ps (z2 + l)));
+                _mm512_storeu_ps (z2 + l, _mm512_sub_ps (_mm512_mul_ps (b2, x), _mm512_mul_ps (a2, y)));
+                _mm512_storeu_ps (row + l, y);
+            }
+        }
+    }
+
+    // ── CPUID ──
+    void cpuid (unsigned leaf, unsigned subLeaf, unsigned regs[4]) noexcept
+    {
+       #if defined (_MSC_VER) && ! defined (__clang__)
+        int r[4];
+        __cpuidex (r, (int) leaf, (int) subLeaf);
+        for (int i = 0; i < 4; ++i)
+            regs[i] = (unsigned) r[i];
+       #else
+        __cpuid_count (leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+       #endif
+    }
+
+    unsigned long long readXcr0() noexcept
+    {
+       #if defined (_MSC_VER) && ! defined (__clang__)
+        return _xgetbv (0);
+       #else
+        unsigned lo = 0, hi = 0;
+        __asm__ volatile ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+        return ((unsigned long long) hi << 32) | lo;
+       #endif
+    }
+   #endif // DISPTR_SIMD_X86
+
+    const Kernels kScalarKernels { cascadeStages, cascadeScanScalar, mixInsertScalar, mixSendScalar,
+                                   lanesCascadeScalar, lanesCascadeFeedbackScalar, biquadLanesScalar };
+
+   #if DISPTR_SIMD_X86
+    // AVX-512 keeps the AVX2 scan: a wider block would change its rounding.
+    const Kernels kSse41Kernels  { cascadeSse41,  cascadeScanSse41, mixInsertSse41,  mixSendSse41,
+                                   lanesCascadeSse41,  lanesCascadeFeedbackSse41,  biquadLanesSse41 };
+    const Kernels kAvx2Kernels   { cascadeAvx2,   cascadeScanAvx2,  mixInsertAvx2,   mixSendAvx2,
+                                   lanesCascadeAvx2,   lanesCascadeFeedbackAvx2,   biquadLanesAvx2 };
+    const Kernels kAvx512Kernels { cascadeAvx512, cascadeScanAvx2,  mixInsertAvx512, mixSendAvx512,
+                                   lanesCascadeAvx512, lanesCascadeFeedbackAvx512, biquadLanesAvx512 };
+   #endif
+
+    // DISPTR_ISA spellings, indexed by Isa.
+    constexpr const char* kIsaTokens[(int) Isa::kNumIsas] { "scalar", "sse41", "avx2", "avx512" };
+}
+
+const char* getIsaName (Isa isa) noexcept
+{
+    switch (isa)
+    {
+        case Isa::Scalar:   return "Scalar";
+        case Isa::SSE41:    return "SSE4.1";
+        case Isa::AVX2:     return "AVX2";
+        case Isa::AVX512:   return "AVX-512";
+        case Isa::kNumIsas: break;
+    }
+    return "?";
+}
+
+Isa detectHostIsa() noexcept
+{
+   #if DISPTR_SIMD_X86
+    unsigned r[4] {};
+    cpuid (0, 0, r);
+    const unsigned maxLeaf = r[0];
+    if (maxLeaf < 1)
+        return Isa::Scalar;
+
+    cpuid (1, 0, r);
+    const bool sse41   = (r[2] & (1u << 19)) != 0;
+    const bool osxsave = (r[2] & (1u << 27)) != 0;
+    const bool avx     = (r[2] & (1u << 28)) != 0;
+
+    if (! sse41)
+        return Isa::Scalar;
+
+    // AVX state must be enabled by the OS (XMM|YMM in XCR0), not just present.
+    if (! (osxsave && avx && maxLeaf >= 7))
+        return Isa::SSE41;
+
+    const auto xcr0 = readXcr0();
+    if ((xcr0 & 0x6) != 0x6)
+        return Isa::SSE41;
+
+    cpuid (7, 0, r);
+    const bool avx2    = (r[1] & (1u << 5)) != 0;
+    const bool avx512f = (r[1] & (1u << 16)) != 0;
+
+    if (! avx2)
+        return Isa::SSE41;
+
+    // AVX-512 additionally needs opmask + ZMM state (XCR0 bits 5..7).
+    if (avx512f && (xcr0 & 0xe6) == 0xe6)
+        return Isa::AVX512;
+
+    return Isa::AVX2;
+   #else
+    return Isa::Scalar;
+   #endif
+}
+
+Isa resolveIsa()
+{
+    const auto host = detectHostIsa();
+    const char* env = std::getenv ("DISPTR_ISA");
+    if (env == nullptr || *env == '\0')
+        return host;
+
+    std::string requested (env);
+    for (auto& c : requested)
+        c = (char) std::tolower ((unsigned char) c);
+
+    // An unknown spelling keeps the host level; a known one is clamped to it.
+    for (int i = 0; i < (int) Isa::kNumIsas; ++i)
+        if (requested == kIsaTokens[i])
+            return (Isa) std::min (i, (int) host);
+
+    return host;
+}
+
+const Kernels& getKernels (Isa isa) noexcept
+{
+   #if DISPTR_SIMD_X86
+    switch (isa)
+    {
+        case Isa::SSE41:    return kSse41Kernels;
+        case Isa::AVX2:     return kAvx2Kernels;
+        case Isa::AVX512:   return kAvx512Kernels;
+        case Isa::Scalar:
+        case Isa::kNumIsas: break;
+    }
+   #else
+    (void) isa;
+   #endif
+    return kScalarKernels;
+}
+}
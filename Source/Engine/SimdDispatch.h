@@ -0,0 +1,89 @@
+#pragma once
+
+// ============================================================================
+// SimdDispatch.h — runtime CPU-feature dispatch for DISP-TR's vector kernels
+//
+// One binary runs everywhere: every kernel is compiled for each ISA level
+// (per-function target attributes, no per-file compiler flags), and the
+// processor picks a table of function pointers once in prepareToPlay().
+//
+//   simd::Isa isa = simd::resolveIsa();          // CPUID + DISPTR_ISA override
+//   const simd::Kernels& k = simd::getKernels (isa);
+//   k.allpassCascade (data, numSamples, coeffs, state, numStages);
+//
+// DISPTR_ISA=scalar|sse41|avx2|avx512 forces a level for benchmarking and bug
+// triage; a request above what the host supports is clamped down.
+//
+// All variants produce bit-identical output (no FMA contraction), so switching
+// ISA never changes the sound.
+// ============================================================================
+
+namespace simd
+{
+    enum class Isa : int
+    {
+        Scalar = 0,
+        SSE41,
+        AVX2,
+        AVX512,
+        kNumIsas
+    };
+
+    const char* getIsaName (Isa isa) noexcept;
+
+    // Highest level the CPU and OS both support (CPUID + XGETBV).
+    Isa detectHostIsa() noexcept;
+
+    // detectHostIsa(), lowered by the DISPTR_ISA environment variable if set.
+    Isa resolveIsa();
+
+    // Lane-interleaved kernels (BatchEngine) take lane counts in multiples of
+    // this, the widest vector, so no variant needs a scalar tail.
+    constexpr int kLaneAlign = 16;
+
+    struct Kernels
+    {
+        // In-place cascade of first-order all-pass stages over one channel:
+        //   y = z - a*x;  z = x + a*y
+        // coeffs/state hold numStages entries; state is updated in place.
+        void (*allpassCascade) (float* data, int numSamples,
+                                const float* coeffs, float* state, int numStages) noexcept;
+
+        // Same cascade and state, solved 8 samples at a time per stage as a
+        // prefix scan of the linear recurrence; pays off on long blocks. Rounds
+        // slightly differently from allpassCascade (identical across ISAs).
+        void (*allpassCascadeScan) (float* data, int numSamples,
+                                    const float* coeffs, float* state, int numStages) noexcept;
+
+        // INSERT blend at settled gains: out = dry + mix * (wet * wetGain - dry).
+        // `out` may be `dry` or `wet`.
+        void (*mixInsert) (const float* dry, const float* wet, float* out, int numSamples,
+                           float wetGain, float mix) noexcept;
+
+        // SEND blend at settled gains: out = dry * dryLevel + (wet * wetGain) * wetLevel
+        void (*mixSend) (const float* dry, const float* wet, float* out, int numSamples,
+                         float wetGain, float dryLevel, float wetLevel) noexcept;
+
+        // ── Lane-interleaved: many independent streams side by side ──
+        // Sample n of lane l is data[n * numLanes + l]. Lanes form groups of
+        // groupSize (a multiple of kLaneAlign) that share coefficients, and each
+        // lane does exactly the arithmetic of the one-channel per-sample loops.
+
+        // All-pass cascade: coeffs[stage * numGroups + group], state[stage * numLanes + lane].
+        void (*allpassLanes) (float* data, int numSamples, int numLanes, int groupSize,
+                              const float* coeffs, float* state, int numStages) noexcept;
+
+        // The same with feedback: each sample, lane l first adds
+        // feedback[n] * last[(l + feedbackShift) % numLanes], then last[] takes
+        // the cascade's outputs.
+        void (*allpassLanesFeedback) (float* data, int numSamples, int numLanes, int groupSize,
+                                      const float* coeffs, float* state, int numStages,
+                                      const float* feedback, float* last, int feedbackShift) noexcept;
+
+        // Transposed direct form II biquad, coeffs = { b0, b1, b2, a1, a2 } for all lanes.
+        void (*biquadLanes) (float* data, int numSamples, int numLanes,
+                             const float* coeffs, float* z1, float* z2) noexcept;
+    };
+
+    const Kernels& getKernels (Isa isa) noexcept;
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+// ============================================================================
+// InstanceRegistry.h — live cost of every DISP-TR instance in the process
+//
+// One fixed table shared by all instances loaded from the same plugin binary.
+// Each processor claims a slot on construction and, after every block,
+// publishes what that block cost; any editor can then list all instances.
+//
+//   const int slot = InstanceRegistry::get().claim();   // message thread
+//   InstanceRegistry::get().publish (slot, stats);      // audio thread
+//   InstanceRegistry::get().collect (entries);          // message thread
+//
+// publish() is wait-free: relaxed stores between two bumps of a per-slot
+// sequence counter. Only the owning instance writes a slot's stats, and they
+// sit on their own cache line, so audio threads never contend. Readers copy a
+// slot and retry if a write overlapped; a slot still changing after a few
+// tries is left out of that refresh.
+//
+// Hosts that sandbox plugins in several processes show one table per process.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class InstanceRegistry
+{
+public:
+    static constexpr int kMaxInstances = 256;
+
+    enum Degradation : int
+    {
+        DegradationNone = 0,
+        DegradationApproximate,   // block scan in use, within the engine's error target
+        DegradationBypassed,      // DELAY selected before its rings arrived: wet is dry
+        kNumDegradations
+    };
+
+    static const char* getDegradationName (int d) noexcept
+    {
+        switch (d)
+        {
+            case DegradationNone:        return "full";
+            case DegradationApproximate: return "approx";
+            case DegradationBypassed:    return "bypass";
+            default:                     return "?";
+        }
+    }
+
+    struct Stats
+    {
+        float blockUs     = 0.0f;   // last block
+        float load        = 0.0f;   // block time / block duration, smoothed
+        float peakLoad    = 0.0f;   // decaying peak of the same
+        int   stages      = 0;      // effective: mid-glide value, DELAY sections
+        int   series      = 0;
+        int   path        = 0;      // cost::Path
+        int   degradation = DegradationNone;
+    };
+
+    struct Entry
+    {
+        int          slot   = -1;
+        int          number = 0;    // 1-based, in order of creation
+        juce::String label;
+        juce::String track;
+        Stats        stats;
+    };
+
+    static InstanceRegistry& get() noexcept
+    {
+        static InstanceRegistry registry;
+        return registry;
+    }
+
+    // Returns the slot index, or -1 when the table is full (the instance then
+    // runs normally but is not listed).
+    int claim() noexcept
+    {
+        for (int i = 0; i < kMaxInstances; ++i)
+        {
+            auto& text = slots[(size_t) i].text;
+            int expected = 0;
+            if (text.inUse.compare_exchange_strong (expected, 1, std::memory_order_acq_rel))
+            {
+                text.number.store (nextNumber.fetch_add (1, std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                setText (i, {}, {});
+                publish (i, {});
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    void release (int slot) noexcept
+    {
+        if (isValidSlot (slot))
+            slots[(size_t) slot].text.inUse.store (0, std::memory_order_release);
+    }
+
+    int getNumber (int slot) const noexcept
+    {
+        return isValidSlot (slot) ? slots[(size_t) slot].text.number.load (std::memory_order_relaxed) : 0;
+    }
+
+    // Label and track name; truncated to kMaxTextBytes of UTF-8 each. Rare,
+    // and never from the audio thread: a concurrent writer spins briefly.
+    void setText (int slot, const juce::String& label, const juce::String& track) noexcept
+    {
+        if (! isValidSlot (slot))
+            return;
+
+        auto& text = slots[(size_t) slot].text;
+        uint32_t s = text.seq.load (std::memory_order_relaxed);
+        for (;;)
+        {
+            if ((s & 1u) == 0 && text.seq.compare_exchange_weak (s, s + 1, std::memory_order_acquire))
+                break;
+            s = text.seq.load (std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence (std::memory_order_release);
+
+        packText (label, text.label);
+        packText (track, text.track);
+        text.seq.store (s + 2, std::memory_order_release);
+    }
+
+    // Audio thread, owner of `slot` only.
+    void publish (int slot, const Stats& st) noexcept
+    {
+        if (! isValidSlot (slot))
+            return;
+
+        auto& line = slots[(size_t) slot].stats;
+        const uint32_t s = line.seq.load (std::memory_order_relaxed);
+        line.seq.store (s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        line.blockUs.store (st.blockUs, std::memory_order_relaxed);
+        line.load.store (st.load, std::memory_order_relaxed);
+        line.peakLoad.store (st.peakLoad, std::memory_order_relaxed);
+        line.stages.store (st.stages, std::memory_order_relaxed);
+        line.series.store (st.series, std::memory_order_relaxed);
+        line.path.store (st.path, std::memory_order_relaxed);
+        line.degradation.store (st.degradation, std::memory_order_relaxed);
+
+        line.seq.store (s + 2, std::memory_order_release);
+    }
+
+    // Replaces `out` with every claimed slot, in slot order.
+    void collect (std::vector<Entry>& out) const
+    {
+        out.clear();
+        for (int i = 0; i < kMaxInstances; ++i)
+        {
+            const auto& slot = slots[(size_t) i];
+            if (slot.text.inUse.load (std::memory_order_acquire) == 0)
+                continue;
+
+            Entry e;
+            e.slot   = i;
+            e.number = slot.text.number.load (std::memory_order_relaxed);
+            if (readStats (slot.stats, e.stats) && readText (slot.text, e.label, e.track))
+                out.push_back (std::move (e));
+        }
+    }
+
+private:
+    InstanceRegistry() = default;
+
+    static constexpr int kMaxTextBytes = 47;
+    static constexpr int kTextWords    = (kMaxTextBytes + 1 + 7) / 8;
+    static constexpr int kReadAttempts = 4;
+
+    using TextWords = std::array<std::atomic<uint64_t>, (size_t) kTextWords>;
+
+    // Written by the owner's audio thread only.
+    struct alignas (64) StatsLine
+    {
+        std::atomic<uint32_t> seq { 0 };
+        std::atomic<float>    blockUs { 0.0f }, load { 0.0f }, peakLoad { 0.0f };
+        std::atomic<int>      stages { 0 }, series { 0 }, path { 0 }, degradation { 0 };
+    };
+
+    // Claim state and names; message thread.
+    struct alignas (64) TextLines
+    {
+        std::atomic<int>      inUse { 0 };
+        std::atomic<int>      number { 0 };
+        std::atomic<uint32_t> seq { 0 };
+        TextWords label {}, track {};
+    };
+
+    struct Slot
+    {
+        StatsLine stats;
+        TextLines text;
+    };
+
+    static bool isValidSlot (int slot) noexcept { return slot >= 0 && slot < kMaxInstances; }
+
+    static void packText (const juce::String& s, TextWords& words) noexcept
+    {
+        char bytes[kTextWords * 8] {};
+        s.copyToUTF8 (bytes, (size_t) kMaxTextBytes + 1);   // stops at a whole character
+
+        for (int w = 0; w < kTextWords; ++w)
+        {
+            uint64_t v = 0;
+            std::memcpy (&v, bytes + w * 8, 8);
+            words[(size_t) w].store (v, std::memory_order_relaxed);
+        }
+    }
+
+    static void unpackText (const TextWords& words, char* bytes) noexcept
+    {
+        for (int w = 0; w < kTextWords; ++w)
+        {
+            const uint64_t v = words[(size_t) w].load (std::memory_order_relaxed);
+            std::memcpy (bytes + w * 8, &v, 8);
+        }
+        bytes[kMaxTextBytes] = 0;
+    }
+
+    static bool readStats (const StatsLine& line, Stats& st) noexcept
+    {
+        for (int attempt = 0; attempt < kReadAttempts; ++attempt)
+        {
+            const uint32_t s = line.seq.load (std::memory_order_acquire);
+            if ((s & 1u) != 0)
+                continue;
+
+            st.blockUs     = line.blockUs.load (std::memory_order_relaxed);
+            st.load        = line.load.load (std::memory_order_relaxed);
+            st.peakLoad    = line.peakLoad.load (std::memory_order_relaxed);
+            st.stages      = line.stages.load (std::memory_order_relaxed);
+            st.series      = line.series.load (std::memory_order_relaxed);
+            st.path        = line.path.load (std::memory_order_relaxed);
+            st.degradation = line.degradation.load (std::memory_order_relaxed);
+
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (line.seq.load (std::memory_order_relaxed) == s)
+                return true;
+        }
+        return false;
+    }
+
+    static bool readText (const TextLines& text, juce::String& label, juce::String& track)
+    {
+        for (int attempt = 0; attempt < kReadAttempts; ++attempt)
+        {
+            const uint32_t s = text.seq.load (std::memory_order_acquire);
+            if ((s & 1u) != 0)
+                continue;
+
+            char labelBytes[kTextWords * 8], trackBytes[kTextWords * 8];
+            unpackText (text.label, labelBytes);
+            unpackText (text.track, trackBytes);
+
+            // Only a consistent copy is decoded; a torn one may not be valid UTF-8.
+            std::atomic_thread_fence (std::memory_order_acquire);
+            if (text.seq.load (std::memory_order_relaxed) == s)
+            {
+                label = juce::String::fromUTF8 (labelBytes);
+                track = juce::String::fromUTF8 (trackBytes);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::array<Slot, (size_t) kMaxInstances> slots {};
+    std::atomic<int> nextNumber { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (InstanceRegistry)
+};
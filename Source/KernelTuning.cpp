@@ -0,0 +1,146 @@
+#include "KernelTuning.h"
+
+namespace
+{
+    bool isDisabled()
+    {
+        return juce::SystemStats::getEnvironmentVariable ("DISPTR_KERNEL_PROFILE", {}).equalsIgnoreCase ("off");
+    }
+}
+
+KernelTuning& KernelTuning::get()
+{
+    static KernelTuning tuning;
+    return tuning;
+}
+
+KernelTuning::KernelTuning()
+    : juce::Thread ("DISP-TR kernel tuning")
+{
+}
+
+KernelTuning::~KernelTuning()
+{
+    stopThread (4000);
+}
+
+//==============================================================================
+juce::File KernelTuning::getProfileFile()
+{
+    return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+        .getChildFile ("NMSTR").getChildFile ("DISP-TR").getChildFile ("KernelProfile.txt");
+}
+
+juce::String KernelTuning::getMachineId()
+{
+    // A roaming profile directory can carry the file to another machine.
+    return juce::SystemStats::getCpuModel().trim() + " / " + simd::getIsaName (simd::detectHostIsa());
+}
+
+const cost::Profile& KernelTuning::getProfile() const noexcept
+{
+    return published.load (std::memory_order_acquire) ? measured : cost::getDefaultProfile();
+}
+
+void KernelTuning::prepare()
+{
+    const juce::ScopedLock sl (lock);
+    if (prepared)
+        return;
+    prepared = true;
+
+    if (isDisabled())
+        return;
+
+    const auto file = getProfileFile();
+    cost::Profile p;
+    if (file.existsAsFile()
+        && cost::parseProfile (file.loadFileAsString().toStdString(), getMachineId().toStdString(), p))
+    {
+        publish (p);
+        return;
+    }
+
+    if (backgroundMeasuring)
+        startThread (juce::Thread::Priority::low);   // not background: that can mean efficiency cores
+}
+
+bool KernelTuning::calibrate (cost::Profile& dest, juce::String& error)
+{
+    cost::Profile p;
+    if (! cost::measureKernels (p, simd::detectHostIsa()))
+    {
+        error = "measurement interrupted";
+        return false;
+    }
+
+    dest = p;
+    if (! save (p, error))
+        return false;
+
+    const juce::ScopedLock sl (lock);
+    prepared = true;
+    publish (p);
+    return true;
+}
+
+//==============================================================================
+void KernelTuning::run()
+{
+    // Let the host finish loading the session first; a machine busy with
+    // that would read slow.
+    wait (kStartDelayMs);
+    if (threadShouldExit())
+        return;
+
+    auto shouldStop = [] (void* context) noexcept
+    {
+        return static_cast<KernelTuning*> (context)->threadShouldExit();
+    };
+
+    cost::Profile p;
+    if (! cost::measureKernels (p, simd::detectHostIsa(), shouldStop, this))
+        return;
+
+    // Not being able to save only means measuring again next session.
+    juce::String error;
+    save (p, error);
+
+    const juce::ScopedLock sl (lock);
+    publish (p);
+}
+
+void KernelTuning::publish (const cost::Profile& p)
+{
+    // Engines may already hold a reference to `measured`: it is written once.
+    if (published.load (std::memory_order_relaxed))
+        return;
+
+    measured = p;
+    published.store (true, std::memory_order_release);
+}
+
+bool KernelTuning::save (const cost::Profile& p, juce::String& error)
+{
+    const auto file = getProfileFile();
+    if (! file.getParentDirectory().createDirectory())
+    {
+        error = "could not create " + file.getParentDirectory().getFullPathName();
+        return false;
+    }
+
+    // Through a temporary file, so a second process measuring at the same
+    // time never leaves half a profile behind.
+    juce::TemporaryFile temp (file);
+    if (! temp.getFile().replaceWithText (juce::String (cost::formatProfile (p, getMachineId().toStdString()))))
+    {
+        error = "could not write " + temp.getFile().getFullPathName();
+        return false;
+    }
+    if (! temp.overwriteTargetFileWithTemporary())
+    {
+        error = "could not replace " + file.getFullPathName();
+        return false;
+    }
+    return true;
+}
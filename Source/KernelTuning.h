@@ -0,0 +1,70 @@
+#pragma once
+
+// ============================================================================
+// KernelTuning.h — cascade kernel timings measured on this machine, kept on disk
+//
+// The cost::Profile defaults come from one desktop core, and the fastest
+// split of a cascade between wavefront and block scan moves with the CPU.
+// The first prepareToPlay() in a process looks for a profile measured on this
+// machine; without one it measures in the background and saves the result,
+// the way FFTW keeps its wisdom. `DISP-TR-Bench --calibrate` measures in the
+// foreground instead, e.g. from an installer.
+//
+//   KernelTuning::get().prepare();                                // prepareToPlay
+//   engine.setCostProfile (&KernelTuning::get().getProfile());
+//
+// A profile an engine points at never changes: it is either the built-in
+// default or the measured one, which is published at most once per process.
+// Engines prepared before a background measurement finishes switch to it at
+// their next block.
+//
+// DISPTR_KERNEL_PROFILE=off keeps the defaults (no file, no measuring), for
+// benchmarking and bug triage.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <atomic>
+#include "Engine/CostModel.h"
+
+class KernelTuning : private juce::Thread
+{
+public:
+    static KernelTuning& get();
+
+    // Loads this machine's profile or starts measuring one; only the first
+    // call in a process does anything. Message thread or prepareToPlay.
+    void prepare();
+
+    // Tools that time or render things themselves turn this off before the
+    // first prepare(): a saved profile is still used, none is measured.
+    void setBackgroundMeasuring (bool shouldMeasure) noexcept { backgroundMeasuring = shouldMeasure; }
+
+    // The measured profile once there is one, else the default. Any thread.
+    const cost::Profile& getProfile() const noexcept;
+    bool isMeasured() const noexcept { return published.load (std::memory_order_acquire); }
+
+    // Measures on the calling thread and saves the result. It is also
+    // published, unless this process already uses a profile.
+    bool calibrate (cost::Profile& dest, juce::String& error);
+
+    static juce::File getProfileFile();
+    static juce::String getMachineId();   // CPU model and vector level; a profile is only read back on a match
+
+private:
+    KernelTuning();
+    ~KernelTuning() override;
+
+    static constexpr int kStartDelayMs = 5000;   // past the session load
+
+    void run() override;
+    void publish (const cost::Profile& p);
+    static bool save (const cost::Profile& p, juce::String& error);
+
+    juce::CriticalSection lock;
+    bool prepared = false;
+    bool backgroundMeasuring = true;
+    cost::Profile measured;
+    std::atomic<bool> published { false };
+
+    JUCE_DECLARE_NON_COPYABLE (KernelTuning)
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+// ============================================================================
+// MemoryReport.h — bytes held by one DISP-TR instance, per subsystem
+//
+// An explicit registry rather than a tagged allocator: when a report is taken,
+// each owner adds what it holds (container capacities, image sizes, its own
+// object), so nothing is counted while the plugin runs. The processor fills
+// in the DSP side and asks an open editor for the UI side:
+//
+//   const auto report = processor.getMemoryReport();   // message thread
+//   DBG (report.toString());
+//
+// Heap that JUCE owns on the instance's behalf (parameter objects, the
+// ValueTree, listeners, component peers) is not itemised. The bench's
+// --memory run measures each instance's whole heap delta next to its report,
+// which shows how much is left untracked.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstddef>
+
+struct MemoryReport
+{
+    enum Subsystem : int
+    {
+        ProcessorObject = 0,   // the processor object, engine object included
+        EngineCascade,
+        EngineCrossfade,
+        EngineDelay,
+        EngineBuffers,
+        Snapshots,
+        Presets,               // apply slots, morph slots, bank index tables
+        StateCache,
+        DebugLog,
+        Analyzer,              // transfer analyzer ring and spectra, while it runs
+        EditorObject,
+        EditorImages,          // buffered editor image, CRT outputBuf/prevSrc
+        EditorCaches,          // legend strings, cached paths
+        kNumSubsystems
+    };
+
+    static const char* getSubsystemName (int subsystem) noexcept
+    {
+        switch (subsystem)
+        {
+            case ProcessorObject: return "processor";
+            case EngineCascade:   return "engine cascade";
+            case EngineCrossfade: return "engine crossfade";
+            case EngineDelay:     return "engine delay";
+            case EngineBuffers:   return "engine buffers";
+            case Snapshots:       return "snapshots";
+            case Presets:         return "presets";
+            case StateCache:      return "state cache";
+            case DebugLog:        return "debug log";
+            case Analyzer:        return "analyzer";
+            case EditorObject:    return "editor";
+            case EditorImages:    return "editor images";
+            case EditorCaches:    return "editor caches";
+            default:              return "?";
+        }
+    }
+
+    void add (Subsystem s, size_t numBytes) noexcept   { bytes[(size_t) s] += numBytes; }
+    size_t get (int s) const noexcept                  { return bytes[(size_t) s]; }
+
+    size_t getTotal() const noexcept
+    {
+        size_t total = 0;
+        for (auto b : bytes)
+            total += b;
+        return total;
+    }
+
+    // One "name: KB" line per non-empty subsystem, then the total.
+    juce::String toString() const
+    {
+        juce::String s;
+        for (int i = 0; i < kNumSubsystems; ++i)
+            if (bytes[(size_t) i] > 0)
+                s << getSubsystemName (i) << ": " << juce::String ((double) bytes[(size_t) i] / 1024.0, 1) << " KB\n";
+        s << "total: " << juce::String ((double) getTotal() / 1024.0, 1) << " KB\n";
+        return s;
+    }
+
+    // ── Sizing helpers for owners ──
+    template <typename Vector>
+    static size_t getCapacityBytes (const Vector& v) noexcept
+    {
+        return v.capacity() * sizeof (typename Vector::value_type);
+    }
+
+    // Pixel storage only; native images may pad rows slightly more.
+    static size_t getImageBytes (const juce::Image& img) noexcept
+    {
+        if (! img.isValid())
+            return 0;
+
+        const size_t bytesPerPixel = img.getFormat() == juce::Image::ARGB ? 4
+                                   : img.getFormat() == juce::Image::RGB  ? 3 : 1;
+        return (size_t) img.getWidth() * (size_t) img.getHeight() * bytesPerPixel;
+    }
+
+    // Approximate: the UTF-8 text plus JUCE's shared holder header. Strings
+    // that share a holder are counted once per owner.
+    static size_t getStringBytes (const juce::String& s) noexcept
+    {
+        return s.isEmpty() ? 0 : s.getNumBytesAsUTF8() + 1 + 2 * sizeof (size_t);
+    }
+
+    std::array<size_t, kNumSubsystems> bytes {};
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+// ============================================================================
+// PerfTrace.h — scoped zone timing for DISP-TR (audio + editor)
+//
+// Each zone accumulates its wall time for the current frame; the editor closes
+// a frame once per vblank, which pushes the per-zone totals into a rolling
+// history used by the frame-time overlay.
+//
+// Usage:
+//   #define DISPTR_PERF_TRACE 1   // enable tracing (0 = no overhead)
+//
+//   tracer.beginSession();                    // editor constructor
+//   PERF_TRACE_ZONE (&tracer, EditorPaint);   // times the enclosing scope
+//   tracer.endFrame();                        // message thread, once per frame
+//
+// Zones may be entered from any thread; endFrame() and the history getters are
+// message-thread only.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#ifndef DISPTR_PERF_TRACE
+ #define DISPTR_PERF_TRACE 0
+#endif
+
+#if DISPTR_PERF_TRACE
+
+class PerfTrace
+{
+public:
+    enum Zone : int
+    {
+        AudioBlock = 0,
+        EditorPaint,
+        EditorPaintOverChildren,
+        CrtApply,
+        LegendCache,
+        EditorResized,
+        kNumZones
+    };
+
+    static constexpr int kHistory = 128;   // ~2 s at 60 Hz
+
+    static const char* getZoneName (int zone) noexcept
+    {
+        switch (zone)
+        {
+            case AudioBlock:              return "processBlock";
+            case EditorPaint:             return "paint";
+            case EditorPaintOverChildren: return "paintOverChildren";
+            case CrtApply:                return "CrtEffect::apply";
+            case LegendCache:             return "legendTextCache";
+            case EditorResized:           return "resized";
+            default:                      return "?";
+        }
+    }
+
+    // Audio zones keep adding while no editor closes frames; a new editor
+    // starts from nothing instead of one frame holding all of that.
+    void beginSession() noexcept
+    {
+        for (auto& zs : zones)
+        {
+            zs.frameTicks.store (0, std::memory_order_relaxed);
+            zs.history.fill (0.0f);
+            zs.peakUs = 0.0f;
+        }
+
+        writePos = 0;
+        framesRecorded = 0;
+    }
+
+    void addSample (int zone, int64_t ticks) noexcept
+    {
+        zones[(size_t) zone].frameTicks.fetch_add (ticks, std::memory_order_relaxed);
+    }
+
+    void endFrame() noexcept
+    {
+        for (int z = 0; z < kNumZones; ++z)
+        {
+            auto& zs = zones[(size_t) z];
+            const auto ticks = zs.frameTicks.exchange (0, std::memory_order_relaxed);
+            const float us = (float) (juce::Time::highResolutionTicksToSeconds (ticks) * 1000000.0);
+            zs.history[(size_t) writePos] = us;
+            zs.peakUs = juce::jmax (zs.peakUs, us);
+        }
+
+        writePos = (writePos + 1) % kHistory;
+        framesRecorded = juce::jmin (framesRecorded + 1, kHistory);
+    }
+
+    // framesAgo = 0 is the most recently closed frame.
+    float getHistoryUs (int zone, int framesAgo) const noexcept
+    {
+        if (framesAgo < 0 || framesAgo >= framesRecorded)
+            return 0.0f;
+
+        const int idx = (writePos - 1 - framesAgo + kHistory * 2) % kHistory;
+        return zones[(size_t) zone].history[(size_t) idx];
+    }
+
+    float getWindowWorstUs (int zone) const noexcept
+    {
+        float worst = 0.0f;
+        for (int i = 0; i < framesRecorded; ++i)
+            worst = juce::jmax (worst, getHistoryUs (zone, i));
+        return worst;
+    }
+
+    float getPeakUs (int zone) const noexcept  { return zones[(size_t) zone].peakUs; }
+    int   getNumFramesRecorded() const noexcept { return framesRecorded; }
+
+    void resetPeaks() noexcept
+    {
+        for (auto& zs : zones)
+            zs.peakUs = 0.0f;
+    }
+
+private:
+    struct ZoneState
+    {
+        std::atomic<int64_t> frameTicks { 0 };
+        std::array<float, kHistory> history {};
+        float peakUs = 0.0f;
+    };
+
+    std::array<ZoneState, kNumZones> zones;
+    int writePos = 0;
+    int framesRecorded = 0;
+};
+
+class PerfTraceScopedZone
+{
+public:
+    PerfTraceScopedZone (PerfTrace* t, int z) noexcept
+        : tracer (t), zone (z), start (juce::Time::getHighResolutionTicks()) {}
+
+    ~PerfTraceScopedZone()
+    {
+        if (tracer != nullptr)
+            tracer->addSample (zone, juce::Time::getHighResolutionTicks() - start);
+    }
+
+private:
+    PerfTrace* tracer;
+    int zone;
+    int64_t start;
+
+    JUCE_DECLARE_NON_COPYABLE (PerfTraceScopedZone)
+};
+
+#define PERF_TRACE_ZONE(tracerPtr, zoneId) \
+    const PerfTraceScopedZone JUCE_JOIN_MACRO (_perfTraceZone, __LINE__) ((tracerPtr), PerfTrace::zoneId)
+
+#else // DISPTR_PERF_TRACE == 0
+
+class PerfTrace
+{
+public:
+    void beginSession() noexcept {}
+    void endFrame() noexcept {}
+    void resetPeaks() noexcept {}
+};
+
+#define PERF_TRACE_ZONE(tracerPtr, zoneId)  ((void)0)
+
+#endif // DISPTR_PERF_TRACE
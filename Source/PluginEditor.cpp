@@ -697,6 +697,291 @@ void DisperserAudioProcessorEditor::FilterBarComponent::mouseDoubleClick (const
     }
 }
 
+//========================== InstanceTableComponent ==========================
+
+void DisperserAudioProcessorEditor::InstanceTableComponent::refresh()
+{
+    InstanceRegistry::get().collect (entries);
+    sortEntries();
+    repaint();
+}
+
+void DisperserAudioProcessorEditor::InstanceTableComponent::sortEntries()
+{
+    using Entry = InstanceRegistry::Entry;
+    const int column = sortColumn;
+
+    auto compare = [column] (const Entry& a, const Entry& b) -> int
+    {
+        auto cmp = [] (auto x, auto y) { return x < y ? -1 : (y < x ? 1 : 0); };
+        switch (column)
+        {
+            case ColInstance: return cmp (a.number, b.number);
+            case ColTrack:    return a.track.compareNatural (b.track);
+            case ColBlockUs:  return cmp (a.stats.blockUs, b.stats.blockUs);
+            case ColLoad:     return cmp (a.stats.load, b.stats.load);
+            case ColPeak:     return cmp (a.stats.peakLoad, b.stats.peakLoad);
+            case ColStages:   return cmp (a.stats.stages, b.stats.stages);
+            case ColSeries:   return cmp (a.stats.series, b.stats.series);
+            case ColPath:     return cmp (a.stats.degradation * cost::kNumPaths + a.stats.path,
+                                          b.stats.degradation * cost::kNumPaths + b.stats.path);
+            default:          return 0;
+        }
+    };
+
+    // Ties keep creation order, so rows don't swap places between refreshes.
+    const bool ascending = sortAscending;
+    std::sort (entries.begin(), entries.end(), [&] (const Entry& a, const Entry& b)
+    {
+        const int c = compare (a, b);
+        if (c != 0)
+            return ascending ? c < 0 : c > 0;
+        return a.number < b.number;
+    });
+}
+
+int DisperserAudioProcessorEditor::InstanceTableComponent::getPreferredHeight (int maxHeight) const
+{
+    return juce::jmin (maxHeight, kRowH * (1 + juce::jmax (1, (int) entries.size())) + 8);
+}
+
+juce::Rectangle<int> DisperserAudioProcessorEditor::InstanceTableComponent::getColumnBounds (int column, juce::Rectangle<int> row) const
+{
+    // Fractions of the row width; the path column takes the rest.
+    static constexpr float widths[kNumColumns] { 0.16f, 0.20f, 0.11f, 0.10f, 0.10f, 0.09f, 0.08f, 0.16f };
+
+    const float w = (float) row.getWidth();
+    float x = 0.0f;
+    for (int c = 0; c < column; ++c)
+        x += widths[c] * w;
+
+    const int left  = row.getX() + (int) x;
+    const int right = column == kNumColumns - 1 ? row.getRight() : row.getX() + (int) (x + widths[column] * w);
+    return { left, row.getY(), right - left, row.getHeight() };
+}
+
+void DisperserAudioProcessorEditor::InstanceTableComponent::paint (juce::Graphics& g)
+{
+    TR::drawOverlayPanel (g, getLocalBounds(), scheme.bg.withAlpha (0.94f), scheme.outline);
+
+    static const char* const headings[kNumColumns] { "instance", "track", "block us", "load %", "peak %", "stages", "series", "path" };
+
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+    auto rows = getLocalBounds().reduced (4);
+
+    auto header = rows.removeFromTop (kRowH);
+    g.setColour (scheme.text.withAlpha (0.6f));
+    for (int c = 0; c < kNumColumns; ++c)
+    {
+        juce::String text (headings[c]);
+        if (c == sortColumn)
+            text << (sortAscending ? " ^" : " v");
+
+        const auto just = c <= ColTrack || c == ColPath ? juce::Justification::centredLeft : juce::Justification::centredRight;
+        g.drawText (text, getColumnBounds (c, header).reduced (2, 0), just, true);
+    }
+
+    const int visibleRows = juce::jmax (0, rows.getHeight() / kRowH);
+    const int numEntries  = (int) entries.size();
+    const int shown       = numEntries > visibleRows ? juce::jmax (0, visibleRows - 1) : numEntries;
+
+    for (int i = 0; i < shown; ++i)
+    {
+        const auto& e = entries[(size_t) i];
+        auto row = rows.removeFromTop (kRowH);
+
+        if (e.slot == ownSlot)
+        {
+            g.setColour (scheme.fg.withAlpha (0.15f));
+            g.fillRect (row);
+        }
+
+        const auto& st = e.stats;
+        const juce::String path = st.degradation != InstanceRegistry::DegradationNone
+                                    ? juce::String (cost::getPathName (st.path)) + " (" + InstanceRegistry::getDegradationName (st.degradation) + ")"
+                                    : juce::String (cost::getPathName (st.path));
+
+        const juce::String cells[kNumColumns] {
+            e.label.isNotEmpty() ? e.label : "#" + juce::String (e.number),
+            e.track,
+            juce::String (st.blockUs, 0),
+            juce::String (st.load * 100.0f, 1),
+            juce::String (st.peakLoad * 100.0f, 1),
+            juce::String (st.stages),
+            juce::String (st.series),
+            path
+        };
+
+        g.setColour (scheme.text);
+        for (int c = 0; c < kNumColumns; ++c)
+        {
+            const auto just = c <= ColTrack || c == ColPath ? juce::Justification::centredLeft : juce::Justification::centredRight;
+            g.drawText (cells[c], getColumnBounds (c, row).reduced (2, 0), just, true);
+        }
+    }
+
+    if (shown < numEntries)
+    {
+        g.setColour (scheme.text.withAlpha (0.6f));
+        g.drawText ("+" + juce::String (numEntries - shown) + " more", rows.removeFromTop (kRowH).reduced (2, 0),
+                    juce::Justification::centredLeft, false);
+    }
+    else if (numEntries == 0)
+    {
+        g.setColour (scheme.text.withAlpha (0.6f));
+        g.drawText ("no instances registered", rows.removeFromTop (kRowH).reduced (2, 0),
+                    juce::Justification::centredLeft, false);
+    }
+}
+
+void DisperserAudioProcessorEditor::InstanceTableComponent::mouseDown (const juce::MouseEvent& e)
+{
+    const auto header = getLocalBounds().reduced (4).removeFromTop (kRowH);
+    if (! header.contains (e.getPosition()))
+        return;
+
+    for (int c = 0; c < kNumColumns; ++c)
+    {
+        if (getColumnBounds (c, header).contains (e.getPosition()))
+        {
+            // Numbers start largest-first, names A–Z.
+            sortAscending = c == sortColumn ? ! sortAscending : (c <= ColTrack);
+            sortColumn = c;
+            sortEntries();
+            repaint();
+            return;
+        }
+    }
+}
+
+size_t DisperserAudioProcessorEditor::InstanceTableComponent::getMemoryBytes() const
+{
+    size_t bytes = MemoryReport::getCapacityBytes (entries);
+    for (const auto& e : entries)
+        bytes += MemoryReport::getStringBytes (e.label) + MemoryReport::getStringBytes (e.track);
+    return bytes;
+}
+
+//========================== GroupDelayViewComponent ==========================
+
+void DisperserAudioProcessorEditor::GroupDelayViewComponent::paint (juce::Graphics& g)
+{
+    TR::drawOverlayPanel (g, getLocalBounds(), scheme.bg.withAlpha (0.94f), scheme.outline);
+
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+    auto area = getLocalBounds().reduced (6);
+    auto header = area.removeFromTop (14);
+
+    g.setColour (scheme.text.withAlpha (0.6f));
+    g.drawText ("group delay, ms", header, juce::Justification::centredLeft, false);
+
+    if (! hasResult)
+    {
+        g.drawText ("waiting for signal", header, juce::Justification::centredRight, false);
+        return;
+    }
+
+    const auto& r = result;
+    constexpr int n = TransferAnalyzer::kNumPoints;
+
+    juce::String status = juce::String (r.fftSize) + " pt / " + juce::String (r.averages) + " avg   ";
+    if (r.averages < TransferAnalyzer::kMinAverages)
+        status << "waiting for signal";
+    else if (! r.modelExact)
+        status << "model approximate";
+    else if (r.deviation)
+        status << "DEVIATES " << (r.worstDeviationMs >= 0.0f ? "+" : "") << juce::String (r.worstDeviationMs, 2)
+               << " ms at " << juce::String (juce::roundToInt (r.worstDeviationHz)) << " Hz";
+    else
+        status << "MATCH";
+
+    g.setColour (r.deviation ? scheme.text : scheme.text.withAlpha (0.6f));
+    g.drawText (status, header, juce::Justification::centredRight, false);
+
+    auto labels = area.removeFromBottom (12);
+    auto plot = area.reduced (0, 4).toFloat();
+    if (plot.getWidth() < 8.0f || plot.getHeight() < 8.0f)
+        return;
+
+    // Vertical range from everything that will be drawn, zero always included.
+    float lo = 0.0f, hi = 1.0f;
+    for (int i = 0; i < n; ++i)
+    {
+        lo = juce::jmin (lo, r.analyticMs[(size_t) i]);
+        hi = juce::jmax (hi, r.analyticMs[(size_t) i]);
+        if (r.isValid (i))
+        {
+            lo = juce::jmin (lo, r.measuredMs[(size_t) i]);
+            hi = juce::jmax (hi, r.measuredMs[(size_t) i]);
+        }
+    }
+    hi += (hi - lo) * 0.05f;
+
+    const float logLo = std::log (TransferAnalyzer::kMinFreqHz);
+    const float logHi = std::log (TransferAnalyzer::kMaxFreqHz);
+    auto xFor = [&] (float hz) { return plot.getX() + plot.getWidth() * (std::log (juce::jmax (hz, 1.0f)) - logLo) / (logHi - logLo); };
+    auto yFor = [&] (float ms) { return plot.getBottom() - plot.getHeight() * (ms - lo) / (hi - lo); };
+
+    g.setColour (scheme.outline.withAlpha (0.25f));
+    for (const float hz : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const float x = xFor (hz);
+        g.drawVerticalLine (juce::roundToInt (x), plot.getY(), plot.getBottom());
+        g.setColour (scheme.text.withAlpha (0.6f));
+        g.drawText (hz >= 1000.0f ? juce::String (juce::roundToInt (hz / 1000.0f)) + "k" : juce::String (juce::roundToInt (hz)),
+                    juce::Rectangle<float> (x - 20.0f, (float) labels.getY(), 40.0f, (float) labels.getHeight()),
+                    juce::Justification::centred, false);
+        g.setColour (scheme.outline.withAlpha (0.25f));
+    }
+    g.drawHorizontalLine (juce::roundToInt (yFor (0.0f)), plot.getX(), plot.getRight());
+
+    g.setColour (scheme.text.withAlpha (0.6f));
+    g.drawText (juce::String (hi, hi < 10.0f ? 2 : 1), plot.toNearestInt().removeFromTop (12).reduced (2, 0),
+                juce::Justification::topLeft, false);
+
+    juce::Path analytic;
+    for (int i = 0; i < n; ++i)
+    {
+        const juce::Point<float> pt (xFor (r.freqHz[(size_t) i]), yFor (r.analyticMs[(size_t) i]));
+        if (i == 0)
+            analytic.startNewSubPath (pt);
+        else
+            analytic.lineTo (pt);
+    }
+    g.setColour (scheme.text.withAlpha (0.45f));
+    g.strokePath (analytic, juce::PathStrokeType (1.0f));
+
+    // Measured: only where the estimate is trustworthy, broken across gaps.
+    juce::Path measured;
+    bool drawing = false;
+    for (int i = 0; i < n; ++i)
+    {
+        if (! r.isValid (i))
+        {
+            drawing = false;
+            continue;
+        }
+
+        const juce::Point<float> pt (xFor (r.freqHz[(size_t) i]), yFor (r.measuredMs[(size_t) i]));
+        if (drawing)
+            measured.lineTo (pt);
+        else
+            measured.startNewSubPath (pt);
+        drawing = true;
+    }
+    g.setColour (scheme.fg);
+    g.strokePath (measured, juce::PathStrokeType (1.5f));
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (r.deviates[(size_t) i])
+        {
+            const juce::Point<float> pt (xFor (r.freqHz[(size_t) i]), yFor (r.measuredMs[(size_t) i]));
+            g.drawRect (juce::Rectangle<float> (5.0f, 5.0f).withCentre (pt), 1.0f);
+        }
+    }
+}
+
 //========================== Editor ==========================
 
 DisperserAudioProcessorEditor::DisperserAudioProcessorEditor (DisperserAudioProcessor& p)
@@ -893,6 +1178,13 @@ DisperserAudioProcessorEditor::DisperserAudioProcessorEditor (DisperserAudioProc
     dualMixBar_.setOwner (this);
     dualMixBar_.setVisible (false);
 
+    // Session instance table, hidden until alt-click on the gear
+    instanceTable_.setOwnSlot (audioProcessor.getInstanceRegistrySlot());
+    instanceTable_.setScheme (activeScheme);
+    addChildComponent (instanceTable_);
+    groupDelayView_.setScheme (activeScheme);
+    addChildComponent (groupDelayView_);
+
     seriesSlider.setRange ((double) DisperserAudioProcessor::kSeriesMin,
                            (double) DisperserAudioProcessor::kSeriesMax,
                            1.0);
@@ -990,16 +1282,22 @@ DisperserAudioProcessorEditor::DisperserAudioProcessorEditor (DisperserAudioProc
         safeThis->applyPersistedUiStateFromProcessor (true, true);
     });
 
+    audioProcessor.perfTrace.beginSession();
+    crtEffect.setTracer (&audioProcessor.perfTrace);
     applyCrtState (crtEnabled);
 
+    frameVBlank_ = std::make_unique<juce::VBlankAttachment> (this, [this] { onVBlankFrame(); });
+
     refreshLegendTextCache();
     resized();
 }
 
 DisperserAudioProcessorEditor::~DisperserAudioProcessorEditor()
 {
+    frameVBlank_.reset();
     setComponentEffect (nullptr);
     stopTimer();
+    audioProcessor.getTransferAnalyzer().stop();
 
     for (auto* paramId : kUiMirrorParamIds)
         audioProcessor.apvts.removeParameterListener (paramId, this);
@@ -1043,6 +1341,8 @@ void DisperserAudioProcessorEditor::applyActivePalette()
     lnf.setScheme (activeScheme);
     filterBar_.setScheme (activeScheme);
     dualMixBar_.setScheme (activeScheme);
+    instanceTable_.setScheme (activeScheme);
+    groupDelayView_.setScheme (activeScheme);
 
     for (auto* combo : { &modeInCombo, &modeOutCombo, &sumBusCombo, &limModeCombo, &invPolCombo, &invStrCombo, &mixModeCombo, &filterPosCombo })
     {
@@ -1157,17 +1457,35 @@ void DisperserAudioProcessorEditor::parameterChanged (const juce::String& parame
     if (! isSizeParam && ! isUiVisualParam)
         return;
 
-    juce::Component::SafePointer<DisperserAudioProcessorEditor> safeThis (this);
-    juce::MessageManager::callAsync ([safeThis, isSizeParam]()
+    // May arrive on any thread (automation, preset loads). Only record what changed;
+    // the next vblank applies the union once, however many changes arrived.
+    const uint32_t bit = isSizeParam ? kUiDirtySize : kUiDirtyVisual;
+    const uint32_t prev = pendingUiDirty_.fetch_or (bit, std::memory_order_acq_rel);
+
+    // Fallback for when no vblank is delivered (editor hidden / not on a display):
+    // post a single flush per burst, never one per change.
+    if (prev == 0 && ! uiFlushPosted_.exchange (true, std::memory_order_acq_rel))
     {
-        if (safeThis == nullptr)
-            return;
+        juce::Component::SafePointer<DisperserAudioProcessorEditor> safeThis (this);
+        juce::Timer::callAfterDelay (kUiFlushFallbackMs, [safeThis]()
+        {
+            if (safeThis == nullptr)
+                return;
 
-        if (isSizeParam)
-            safeThis->applyPersistedUiStateFromProcessor (true, false);
-        else
-            safeThis->applyPersistedUiStateFromProcessor (false, true);
-    });
+            safeThis->uiFlushPosted_.store (false, std::memory_order_release);
+            safeThis->flushPendingUiState();
+        });
+    }
+}
+
+void DisperserAudioProcessorEditor::flushPendingUiState()
+{
+    const uint32_t dirty = pendingUiDirty_.exchange (0, std::memory_order_acq_rel);
+    if (dirty == 0)
+        return;
+
+    applyPersistedUiStateFromProcessor ((dirty & kUiDirtySize) != 0,
+                                        (dirty & kUiDirtyVisual) != 0);
 }
 
 void DisperserAudioProcessorEditor::timerCallback()
@@ -1192,7 +1510,7 @@ void DisperserAudioProcessorEditor::timerCallback()
     const uint32_t now = juce::Time::getMillisecondCounter();
     const bool userRecent = (now - last) <= (uint32_t) kUserInteractionPersistWindowMs;
 
-    if ((w != lastPersistedEditorW || h != lastPersistedEditorH) && userRecent)
+    if (! liveResizeActive_ && (w != lastPersistedEditorW || h != lastPersistedEditorH) && userRecent)
     {
         audioProcessor.setUiEditorSize (w, h);
         lastPersistedEditorW = w;
@@ -1325,6 +1643,8 @@ void DisperserAudioProcessorEditor::applyPersistedUiStateFromProcessor (bool app
 
 bool DisperserAudioProcessorEditor::refreshLegendTextCache()
 {
+    PERF_TRACE_ZONE (&audioProcessor.perfTrace, LegendCache);
+
     const int amountV = (int) std::llround (amountSlider.getValue());
     const int seriesV = (int) std::llround (seriesSlider.getValue());
     const double hz = freqSlider.getValue();
@@ -2003,7 +2323,7 @@ void DisperserAudioProcessorEditor::openNumericEntryPopupForSlider (juce::Slider
         aw->addAndMakeVisible (suffixLabel);
 
         juce::String worstCaseText;
-        if (&s == &amountSlider)       worstCaseText = "256";
+        if (&s == &amountSlider)       worstCaseText = "1024";
         else if (&s == &seriesSlider)  worstCaseText = "4";
         else if (&s == &freqSlider)    worstCaseText = "20000.000";
         else if (&s == &shapeSlider)   worstCaseText = "100.0000";
@@ -2076,6 +2396,51 @@ void DisperserAudioProcessorEditor::openNumericEntryPopupForSlider (juce::Slider
             suffixLabel->setBounds (labelX, labelY, labelW, labelH);
         };
 
+        // STAGES, SERIES and FEEDBACK decide which path the cascade takes and
+        // what it costs: show the cost model's estimate for the typed value
+        // under it, before anything is committed.
+        if (&s == &amountSlider || &s == &seriesSlider || &s == &feedbackSlider)
+        {
+            auto* costLabel = new juce::Label ("cost", juce::String());
+            costLabel->setJustificationType (juce::Justification::centred);
+            applyLabelTextColour (*costLabel, scheme.text);
+            costLabel->setBorderSize (juce::BorderSize<int> (0));
+            costLabel->setFont (juce::Font (juce::FontOptions (18.0f).withStyle ("Bold")));
+            aw->addAndMakeVisible (costLabel);
+
+            const int field = (&s == &amountSlider) ? 0 : (&s == &seriesSlider) ? 1 : 2;
+            juce::Component::SafePointer<DisperserAudioProcessorEditor> safeEditor (this);
+
+            layoutValueAndSuffix = [layoutValue = layoutValueAndSuffix, aw, te, costLabel, field, safeEditor]()
+            {
+                layoutValue();
+                if (safeEditor == nullptr)
+                    return;
+
+                const auto& proc = safeEditor->audioProcessor;
+                auto p = proc.makeEngineParams();
+                const double v = te->getText().trim().replaceCharacter (',', '.').getDoubleValue();
+                if (field == 0)
+                    p.stages = juce::jlimit (DisperserAudioProcessor::kAmountMin, DisperserAudioProcessor::kAmountMax, (int) std::llround (v));
+                else if (field == 1)
+                    p.series = juce::jlimit (DisperserAudioProcessor::kSeriesMin, DisperserAudioProcessor::kSeriesMax, (int) std::llround (v));
+                else
+                    p.feedback = juce::jlimit (DisperserAudioProcessor::kFeedbackMin, DisperserAudioProcessor::kFeedbackMax, (float) (v * 0.01));
+
+                const auto estimate = proc.estimateDspCost (p);
+                const double sampleRate = juce::jmax (1.0, proc.getSampleRate());
+                costLabel->setText ("EST. CPU " + juce::String (estimate.getLoad (sampleRate) * 100.0, 1)
+                                        + " %  GLIDE " + juce::String (estimate.getGlidingLoad (sampleRate) * 100.0, 1) + " %",
+                                    juce::dontSendNotification);
+
+                constexpr int kCostLabelGapPx = 6;
+                const int pad = kPromptInlineContentPadPx;
+                costLabel->setBounds (pad, te->getBottom() + kCostLabelGapPx,
+                                      juce::jmax (1, aw->getWidth() - 2 * pad),
+                                      (int) std::ceil (costLabel->getFont().getHeight()) + 2);
+            };
+        }
+
         te->setBounds (editorBaseBounds);
         int labelW0 = stringWidth (suffixLabel->getFont(), suffixText) + 2;
         suffixLabel->setBounds (r.getRight() + 2, r.getY() + 1, labelW0, juce::jmax (1, r.getHeight() - 2));
@@ -2088,9 +2453,9 @@ void DisperserAudioProcessorEditor::openNumericEntryPopupForSlider (juce::Slider
 
         if (&s == &amountSlider)
         {
-            maxVal = 256.0;
+            maxVal = (double) DisperserAudioProcessor::kAmountMax;
             maxDecs = 0;
-            maxLen = 3;
+            maxLen = 4;
         }
         else if (&s == &seriesSlider)
         {
@@ -3759,6 +4124,24 @@ void DisperserAudioProcessorEditor::openInfoPopup()
         }
     }
 
+    // The SIMD level the DSP runs at, for bug reports; DISPTR_ISA can lower it.
+    {
+        const auto isa = audioProcessor.getDspIsa();
+        const auto hostIsa = simd::detectHostIsa();
+        juce::String text ("DSP: ");
+        text << simd::getIsaName (isa);
+        if (isa != hostIsa)
+            text << " (DISPTR_ISA, CPU: " << simd::getIsaName (hostIsa) << ")";
+
+        auto* l = new juce::Label ("dspIsa", text);
+        l->setComponentID ("dspIsa");
+        l->setJustificationType (juce::Justification::centred);
+        applyLabelTextColour (*l, activeScheme.text);
+        l->setFont (infoFont);
+        l->setBorderSize (juce::BorderSize<int> (0));
+        bodyContent->addAndMakeVisible (l);
+    }
+
     auto* viewport = new juce::Viewport();
     viewport->setComponentID ("bodyViewport");
     viewport->setViewedComponent (bodyContent, true);  // viewport owns bodyContent
@@ -3812,6 +4195,36 @@ void DisperserAudioProcessorEditor::openInfoPopup()
         }));
 }
 
+void DisperserAudioProcessorEditor::openMorphMenu()
+{
+    lnf.setScheme (activeScheme);
+
+    const bool hasA = audioProcessor.hasMorphSlot (0);
+    const bool hasB = audioProcessor.hasMorphSlot (1);
+
+    juce::PopupMenu menu;
+    menu.setLookAndFeel (&lnf);
+    menu.addItem (1, "STORE A", true, hasA);
+    menu.addItem (2, "STORE B", true, hasB);
+    menu.addSeparator();
+    menu.addItem (3, "CLEAR A/B", hasA || hasB);
+
+    juce::Component::SafePointer<DisperserAudioProcessorEditor> safeThis (this);
+    menu.showMenuAsync (juce::PopupMenu::Options()
+                            .withTargetComponent (this)
+                            .withTargetScreenArea (localAreaToGlobal (getInfoIconArea())),
+                        [safeThis] (int result)
+    {
+        if (safeThis == nullptr)
+            return;
+
+        auto& proc = safeThis->audioProcessor;
+        if (result == 1)      proc.captureMorphSlot (0);
+        else if (result == 2) proc.captureMorphSlot (1);
+        else if (result == 3) proc.clearMorphSlots();
+    });
+}
+
 void DisperserAudioProcessorEditor::openGraphicsPopup()
 {
     lnf.setScheme (activeScheme);
@@ -4362,9 +4775,9 @@ juce::String DisperserAudioProcessorEditor::getFilterTextShort() const
 
 namespace
 {
-    constexpr const char* kAmountLegendFull  = "256 STAGES";
-    constexpr const char* kAmountLegendShort = "256 STG";
-    constexpr const char* kAmountLegendInt   = "256";
+    constexpr const char* kAmountLegendFull  = "1024 STAGES";
+    constexpr const char* kAmountLegendShort = "1024 STG";
+    constexpr const char* kAmountLegendInt   = "1024";
 
     constexpr const char* kSeriesLegendFull  = "999 SERIES";
     constexpr const char* kSeriesLegendShort = "999 SRS";
@@ -4486,8 +4899,9 @@ DisperserAudioProcessorEditor::buildVerticalLayout (int editorH, int biasY, bool
 
 void DisperserAudioProcessorEditor::updateCachedLayout()
 {
-    cachedHLayout_ = buildHorizontalLayout (getWidth(), getTargetValueColumnWidth());
-    cachedVLayout_ = buildVerticalLayout (getHeight(), kLayoutVerticalBiasPx, ioSectionExpanded_);
+    const auto& layout = getMemoizedLayout (getWidth(), getHeight(), ioSectionExpanded_);
+    cachedHLayout_ = layout.horizontal;
+    cachedVLayout_ = layout.vertical;
 
     const juce::Slider* sliders[11] = { &freqSlider, &modSlider, &feedbackSlider, &amountSlider,
                                          &seriesSlider, &shapeSlider, &styleSlider,
@@ -4570,6 +4984,26 @@ void DisperserAudioProcessorEditor::updateCachedLayout()
                              cachedHLayout_.contentW, cachedVLayout_.toggleBarH };
 }
 
+const DisperserAudioProcessorEditor::LayoutMemoEntry&
+DisperserAudioProcessorEditor::getMemoizedLayout (int editorW, int editorH, bool ioExpanded)
+{
+    for (const auto& e : layoutMemo_)
+        if (e.w == editorW && e.h == editorH && e.ioExpanded == ioExpanded)
+            return e;
+
+    // Round-robin eviction: a drag sweeps monotonically, so the oldest entry
+    // is the least likely to be revisited.
+    auto& e = layoutMemo_[(size_t) layoutMemoNext_];
+    layoutMemoNext_ = (layoutMemoNext_ + 1) % kLayoutMemoSize;
+
+    e.w = editorW;
+    e.h = editorH;
+    e.ioExpanded = ioExpanded;
+    e.horizontal = buildHorizontalLayout (editorW, getTargetValueColumnWidth());
+    e.vertical   = buildVerticalLayout (editorH, kLayoutVerticalBiasPx, ioExpanded);
+    return e;
+}
+
 int DisperserAudioProcessorEditor::getTargetValueColumnWidth() const
 {
     std::uint64_t key = 1469598103934665603ull;
@@ -4651,7 +5085,7 @@ int DisperserAudioProcessorEditor::getTargetValueColumnWidth() const
 
 juce::Rectangle<int> DisperserAudioProcessorEditor::getValueAreaFor (const juce::Rectangle<int>& barBounds) const
 {
-    const auto layout = buildHorizontalLayout (getWidth(), getTargetValueColumnWidth());
+    const auto& layout = cachedHLayout_;
 
     const int valueX = barBounds.getRight() + layout.valuePad;
     const int maxW = juce::jmax (0, getWidth() - valueX - kValueAreaRightMarginPx);
@@ -4758,7 +5192,7 @@ juce::Rectangle<int> DisperserAudioProcessorEditor::getInfoIconArea() const
                           :                            amountSlider;
     const auto refValueArea = getValueAreaFor (refSlider.getBounds());
     const int contentRight = refValueArea.getRight();
-    const auto verticalLayout = buildVerticalLayout (getHeight(), kLayoutVerticalBiasPx, ioSectionExpanded_);
+    const auto& verticalLayout = cachedVLayout_;
     const int titleH = verticalLayout.titleH;
     const int titleY = verticalLayout.titleTopPad;
     const int titleAreaH = verticalLayout.titleAreaH;
@@ -4795,6 +5229,43 @@ void DisperserAudioProcessorEditor::mouseDown (const juce::MouseEvent& e)
 
     if (getInfoIconArea().contains (p))
     {
+       #if DISPTR_PERF_TRACE
+        // Shift-click on the gear toggles the frame-time overlay.
+        if (e.mods.isShiftDown())
+        {
+            perfOverlayVisible_ = ! perfOverlayVisible_;
+            audioProcessor.perfTrace.resetPeaks();
+            repaint();
+            return;
+        }
+       #endif
+
+        // Alt-click shows or hides the session instance table.
+        if (e.mods.isAltDown())
+        {
+            instanceTable_.setVisible (! instanceTable_.isVisible());
+            if (instanceTable_.isVisible())
+            {
+                instanceTable_.refresh();
+                instanceTable_.setBounds (getInstanceTableBounds());
+                instanceTable_.toFront (false);
+            }
+            return;
+        }
+
+        // Cmd/ctrl-click shows or hides the measured group delay.
+        if (e.mods.isCommandDown())
+        {
+            setGroupDelayViewVisible (! groupDelayView_.isVisible());
+            return;
+        }
+
+        if (e.mods.isPopupMenu())
+        {
+            openMorphMenu();
+            return;
+        }
+
         openInfoPopup();
         return;
     }
@@ -4883,6 +5354,8 @@ void DisperserAudioProcessorEditor::mouseDoubleClick (const juce::MouseEvent& e)
 
 void DisperserAudioProcessorEditor::paint (juce::Graphics& g)
 {
+    PERF_TRACE_ZONE (&audioProcessor.perfTrace, EditorPaint);
+
     const int W = getWidth();
     const auto& horizontalLayout = cachedHLayout_;
     const auto& verticalLayout   = cachedVLayout_;
@@ -5206,9 +5679,203 @@ void DisperserAudioProcessorEditor::paint (juce::Graphics& g)
 
 void DisperserAudioProcessorEditor::paintOverChildren (juce::Graphics& g)
 {
+    {
+        PERF_TRACE_ZONE (&audioProcessor.perfTrace, EditorPaintOverChildren);
+        // Nothing is painted over children yet; the zone is kept so any future
+        // overlay work shows up in the trace.
+    }
+
+   #if DISPTR_PERF_TRACE
+    // Drawn outside the zone so the overlay doesn't count itself.
+    if (perfOverlayVisible_)
+        drawPerfOverlay (g);
+   #else
     juce::ignoreUnused (g);
+   #endif
 }
 
+void DisperserAudioProcessorEditor::addMemoryUsage (MemoryReport& r) const
+{
+    r.add (MemoryReport::EditorObject, sizeof (*this));
+
+    // setBufferedToImage keeps one ARGB image of the whole editor at the
+    // display scale; JUCE doesn't expose it, so size it from the bounds.
+    if (getCachedComponentImage() != nullptr)
+    {
+        const double scale = juce::Component::getApproximateScaleFactorForComponent (this);
+        r.add (MemoryReport::EditorImages, (size_t) (getWidth() * scale) * (size_t) (getHeight() * scale) * 4);
+    }
+    r.add (MemoryReport::EditorImages, crtEffect.getBufferBytes());
+
+    const juce::String* legendStrings[] {
+        &cachedAmountTextFull, &cachedAmountTextShort, &cachedAmountIntOnly,
+        &cachedSeriesTextFull, &cachedSeriesTextShort, &cachedSeriesIntOnly,
+        &cachedFreqTextHz, &cachedFreqTextShort, &cachedFreqIntOnly, &cachedMidiDisplay,
+        &cachedShapeTextFull, &cachedShapeTextShort, &cachedShapeIntOnly,
+        &cachedStyleTextFull, &cachedStyleTextShort,
+        &cachedFeedbackTextFull, &cachedFeedbackTextShort, &cachedFeedbackIntOnly,
+        &cachedModTextFull, &cachedModTextShort, &cachedModIntOnly,
+        &cachedMixTextFull, &cachedMixTextShort, &cachedMixIntOnly,
+        &cachedLimThresholdTextFull, &cachedLimThresholdTextShort, &cachedLimThresholdIntOnly,
+        &cachedTiltTextFull, &cachedTiltTextShort, &cachedTiltIntOnly,
+        &cachedInputTextFull, &cachedInputTextShort, &cachedInputIntOnly,
+        &cachedOutputTextFull, &cachedOutputTextShort, &cachedOutputIntOnly,
+        &cachedFilterTextFull, &cachedFilterTextShort, &cachedPanTextFull, &cachedPanTextShort
+    };
+    for (const auto* str : legendStrings)
+        r.add (MemoryReport::EditorCaches, MemoryReport::getStringBytes (*str));
+
+    r.add (MemoryReport::EditorCaches, instanceTable_.getMemoryBytes());
+}
+
+juce::Rectangle<int> DisperserAudioProcessorEditor::getInstanceTableBounds() const
+{
+    // Along the bottom edge, over at most half the editor.
+    auto area = getLocalBounds().reduced (8);
+    return area.removeFromBottom (instanceTable_.getPreferredHeight (area.getHeight() / 2));
+}
+
+juce::Rectangle<int> DisperserAudioProcessorEditor::getGroupDelayViewBounds() const
+{
+    // Along the top edge, clear of the instance table.
+    auto area = getLocalBounds().reduced (8);
+    return area.removeFromTop (juce::jmin (area.getHeight() / 2, 220));
+}
+
+void DisperserAudioProcessorEditor::setGroupDelayViewVisible (bool shouldBeVisible)
+{
+    auto& analyzer = audioProcessor.getTransferAnalyzer();
+    groupDelayView_.setVisible (shouldBeVisible);
+
+    if (! shouldBeVisible)
+    {
+        analyzer.stop();
+        return;
+    }
+
+    groupDelayView_.clearResult();
+    groupDelayFrameCounter_ = 0;
+    analyzer.setModel (audioProcessor.makeEngineParams(), audioProcessor.getSampleRate());
+    analyzer.start();
+    groupDelayView_.setBounds (getGroupDelayViewBounds());
+    groupDelayView_.toFront (false);
+}
+
+void DisperserAudioProcessorEditor::refreshGroupDelayView()
+{
+    // The model follows the controls; the analyzer restarts its average only
+    // when the response actually changes.
+    auto& analyzer = audioProcessor.getTransferAnalyzer();
+    analyzer.setModel (audioProcessor.makeEngineParams(), audioProcessor.getSampleRate());
+
+    TransferAnalyzer::Result r;
+    if (analyzer.getResult (r))
+        groupDelayView_.setResult (r);
+}
+
+#if DISPTR_PERF_TRACE
+void DisperserAudioProcessorEditor::drawPerfOverlay (juce::Graphics& g)
+{
+    const auto& trace = audioProcessor.perfTrace;
+
+    static const juce::Colour zoneColours[PerfTrace::kNumZones] {
+        juce::Colour (0xff808080),   // processBlock
+        juce::Colour (0xff4fc3f7),   // paint
+        juce::Colour (0xff9575cd),   // paintOverChildren
+        juce::Colour (0xffff8a65),   // CrtEffect::apply
+        juce::Colour (0xffffd54f),   // legendTextCache
+        juce::Colour (0xff81c784)    // resized
+    };
+
+    constexpr int rowH = 14;
+    constexpr int graphH = 60;
+    const int panelW = juce::jmin (getWidth() - 8, 300);
+    constexpr int memRows = (MemoryReport::kNumSubsystems + 1) / 2 + 1;
+    const int panelH = graphH + 8 + rowH * (PerfTrace::kNumZones + 3 + memRows) + 8;
+    const auto panel = juce::Rectangle<int> (4, 4, panelW, panelH);
+
+    g.setColour (juce::Colours::black.withAlpha (0.78f));
+    g.fillRect (panel);
+
+    // Rolling graph: one polyline per zone, scaled to the window worst (min 1 ms).
+    auto graph = panel.reduced (4).removeFromTop (graphH).toFloat();
+    float scaleUs = 1000.0f;
+    for (int z = 0; z < PerfTrace::kNumZones; ++z)
+        scaleUs = juce::jmax (scaleUs, trace.getWindowWorstUs (z));
+
+    // 16.7 ms frame budget reference
+    const float budgetY = graph.getBottom() - graph.getHeight() * juce::jmin (1.0f, 16667.0f / scaleUs);
+    g.setColour (juce::Colours::white.withAlpha (0.25f));
+    g.drawHorizontalLine ((int) budgetY, graph.getX(), graph.getRight());
+
+    const int frames = trace.getNumFramesRecorded();
+    const float dx = graph.getWidth() / (float) juce::jmax (1, PerfTrace::kHistory - 1);
+    for (int z = 0; z < PerfTrace::kNumZones; ++z)
+    {
+        juce::Path line;
+        for (int i = 0; i < frames; ++i)
+        {
+            const float x = graph.getRight() - dx * (float) i;
+            const float y = graph.getBottom() - graph.getHeight() * (trace.getHistoryUs (z, i) / scaleUs);
+            if (i == 0)
+                line.startNewSubPath (x, y);
+            else
+                line.lineTo (x, y);
+        }
+        g.setColour (zoneColours[z]);
+        g.strokePath (line, juce::PathStrokeType (1.0f));
+    }
+
+    // Table: last / window worst / peak since open, in microseconds.
+    g.setFont (juce::Font (juce::FontOptions (11.0f)));
+    auto rows = panel.reduced (4).withTrimmedTop (graphH + 4);
+    auto header = rows.removeFromTop (rowH);
+    g.setColour (juce::Colours::white.withAlpha (0.6f));
+    g.drawText ("zone", header.removeFromLeft (130), juce::Justification::centredLeft, false);
+    g.drawText ("last us", header.removeFromLeft (50), juce::Justification::centredRight, false);
+    g.drawText ("worst", header.removeFromLeft (55), juce::Justification::centredRight, false);
+    g.drawText ("peak", header, juce::Justification::centredRight, false);
+
+    for (int z = 0; z < PerfTrace::kNumZones; ++z)
+    {
+        auto row = rows.removeFromTop (rowH);
+        g.setColour (zoneColours[z]);
+        g.drawText (PerfTrace::getZoneName (z), row.removeFromLeft (130), juce::Justification::centredLeft, false);
+        g.drawText (juce::String (trace.getHistoryUs (z, 0), 0), row.removeFromLeft (50), juce::Justification::centredRight, false);
+        g.drawText (juce::String (trace.getWindowWorstUs (z), 0), row.removeFromLeft (55), juce::Justification::centredRight, false);
+        g.drawText (juce::String (trace.getPeakUs (z), 0), row, juce::Justification::centredRight, false);
+    }
+
+    g.setColour (juce::Colours::white.withAlpha (0.6f));
+    g.drawText (juce::String ("dsp isa: ") + simd::getIsaName (audioProcessor.getDspIsa()),
+                rows.removeFromTop (rowH), juce::Justification::centredLeft, false);
+
+    // Cost model prediction for the current settings, next to the path the
+    // engine actually took, to compare against the processBlock row.
+    const auto estimate = audioProcessor.estimateDspCost (audioProcessor.makeEngineParams());
+    const double sampleRate = juce::jmax (1.0, audioProcessor.getSampleRate());
+    g.drawText (juce::String ("model: ") + juce::String (estimate.getLoad (sampleRate) * 100.0, 1) + " % "
+                    + cost::getPathName (estimate.path)
+                    + "  (dsp: " + cost::getPathName (audioProcessor.getDspCascadePath()) + ")",
+                rows.removeFromTop (rowH), juce::Justification::centredLeft, false);
+
+    // Instance memory, two subsystems per row, in KB.
+    const auto memory = audioProcessor.getMemoryReport();
+    for (int i = 0; i < MemoryReport::kNumSubsystems; i += 2)
+    {
+        auto row = rows.removeFromTop (rowH);
+        for (int k = i; k < juce::jmin (i + 2, (int) MemoryReport::kNumSubsystems); ++k)
+        {
+            auto cell = row.removeFromLeft (panelW / 2 - 4);
+            g.drawText (MemoryReport::getSubsystemName (k), cell.removeFromLeft (90), juce::Justification::centredLeft, false);
+            g.drawText (juce::String ((double) memory.get (k) / 1024.0, 1), cell.withTrimmedRight (8), juce::Justification::centredRight, false);
+        }
+    }
+    g.drawText ("memory: " + juce::String ((double) memory.getTotal() / 1024.0, 1) + " KB",
+                rows.removeFromTop (rowH), juce::Justification::centredLeft, false);
+}
+#endif
+
 void DisperserAudioProcessorEditor::updateInfoIconCache()
 {
     const auto iconArea = getInfoIconArea();
@@ -5239,21 +5906,110 @@ void DisperserAudioProcessorEditor::updateInfoIconCache()
 
 void DisperserAudioProcessorEditor::resized()
 {
-    refreshLegendTextCache();
-
-    if (! suppressSizePersistence)
+    if (! suppressSizePersistence && isLiveResizing())
     {
-        if (juce::ModifierKeys::getCurrentModifiers().isAnyMouseButtonDown()
-            || juce::Desktop::getInstance().getMainMouseSource().isDragging())
+        lastUserInteractionMs.store (juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+
+        if (! liveResizeActive_)
+        {
+            liveResizeActive_ = true;
+            crtEffect.setDeferReallocation (true);
+        }
+
+        // Coalesce to frame rate: host/OS resize callbacks can arrive several
+        // times per frame during a corner drag; the pending layout is picked
+        // up by the next vblank.
+        const double nowMs = juce::Time::getMillisecondCounterHiRes();
+        if (nowMs - lastLiveLayoutMs_ < kLiveResizeFrameMs)
         {
-            lastUserInteractionMs.store (juce::Time::getMillisecondCounter(), std::memory_order_relaxed);
+            layoutPending_ = true;
+            return;
         }
+        lastLiveLayoutMs_ = nowMs;
+    }
+
+    layoutPending_ = false;
+    layoutChildren();
+}
+
+bool DisperserAudioProcessorEditor::isLiveResizing() const
+{
+    if (resizerCorner != nullptr && resizerCorner->isMouseButtonDown())
+        return true;
+
+    return juce::ModifierKeys::getCurrentModifiers().isAnyMouseButtonDown()
+        && juce::Desktop::getInstance().getMainMouseSource().isDragging();
+}
+
+void DisperserAudioProcessorEditor::onVBlankFrame()
+{
+    flushPendingUiState();
+
+    audioProcessor.perfTrace.endFrame();
+   #if DISPTR_PERF_TRACE
+    // ~10 Hz overlay refresh; repainting every vblank would dominate what it measures.
+    if (perfOverlayVisible_ && ++perfOverlayFrameCounter_ >= 6)
+    {
+        perfOverlayFrameCounter_ = 0;
+        repaint();
+    }
+   #endif
+
+    // ~4 Hz: enough to follow load, cheap next to a full registry scan per frame.
+    if (instanceTable_.isVisible() && ++instanceTableFrameCounter_ >= 15)
+    {
+        instanceTableFrameCounter_ = 0;
+        instanceTable_.refresh();
+        instanceTable_.setBounds (getInstanceTableBounds());
+    }
+
+    if (groupDelayView_.isVisible() && ++groupDelayFrameCounter_ >= 15)
+    {
+        groupDelayFrameCounter_ = 0;
+        refreshGroupDelayView();
+    }
+
+    if (layoutPending_)
+    {
+        layoutPending_ = false;
+        lastLiveLayoutMs_ = juce::Time::getMillisecondCounterHiRes();
+        layoutChildren();
+        repaint();
     }
 
+    if (liveResizeActive_ && ! isLiveResizing())
+        finishLiveResize();
+}
+
+void DisperserAudioProcessorEditor::finishLiveResize()
+{
+    liveResizeActive_ = false;
+    crtEffect.setDeferReallocation (false);
+
+    const int W = getWidth();
+    const int H = getHeight();
+
+    // Persist once per gesture instead of on every intermediate size.
+    if (W != lastPersistedEditorW || H != lastPersistedEditorH)
+    {
+        audioProcessor.setUiEditorSize (W, H);
+        lastPersistedEditorW = W;
+        lastPersistedEditorH = H;
+    }
+
+    repaint();
+}
+
+void DisperserAudioProcessorEditor::layoutChildren()
+{
+    // Traced as "resized": this is the layout work, whether it runs directly
+    // from resized() or deferred to the vblank during a live drag.
+    PERF_TRACE_ZONE (&audioProcessor.perfTrace, EditorResized);
+
     const int W = getWidth();
     const int H = getHeight();
 
-    if (! suppressSizePersistence)
+    if (! suppressSizePersistence && ! liveResizeActive_)
     {
         const uint32_t last = lastUserInteractionMs.load (std::memory_order_relaxed);
         const uint32_t now = juce::Time::getMillisecondCounter();
@@ -5266,8 +6022,9 @@ void DisperserAudioProcessorEditor::resized()
         }
     }
 
-    const auto horizontalLayout = buildHorizontalLayout (W, getTargetValueColumnWidth());
-    const auto verticalLayout = buildVerticalLayout (H, kLayoutVerticalBiasPx, ioSectionExpanded_);
+    const auto& memo = getMemoizedLayout (W, H, ioSectionExpanded_);
+    const auto& horizontalLayout = memo.horizontal;
+    const auto& verticalLayout   = memo.vertical;
 
     // Position sliders — toggle bar always at top, swaps between main and IO bars
     const int mainTop = verticalLayout.toggleBarY + verticalLayout.toggleBarH + verticalLayout.gapY;
@@ -5455,6 +6212,11 @@ void DisperserAudioProcessorEditor::resized()
     if (resizerCorner != nullptr)
         resizerCorner->setBounds (W - kResizerCornerPx, H - kResizerCornerPx, kResizerCornerPx, kResizerCornerPx);
 
+    if (instanceTable_.isVisible())
+        instanceTable_.setBounds (getInstanceTableBounds());
+    if (groupDelayView_.isVisible())
+        groupDelayView_.setBounds (getGroupDelayViewBounds());
+
     promptOverlay.setBounds (getLocalBounds());
     if (promptOverlayActive)
         promptOverlay.toFront (false);
@@ -5462,6 +6224,7 @@ void DisperserAudioProcessorEditor::resized()
     updateCachedLayout();
 
     updateInfoIconCache();
-    crtEffect.setResolution (static_cast<float> (W), static_cast<float> (H));
+    if (! liveResizeActive_)
+        crtEffect.setResolution (static_cast<float> (W), static_cast<float> (H));
 }
 
@@ -16,6 +16,14 @@ public:
     explicit DisperserAudioProcessorEditor (DisperserAudioProcessor&);
     ~DisperserAudioProcessorEditor() override;
 
+    // Headless render and memory benchmarks (Bench/) drive CRT time and UI
+    // state directly.
+    friend class EditorRenderBench;
+    friend class MemoryBench;
+
+    // Adds the editor's share to the processor's MemoryReport.
+    void addMemoryUsage (MemoryReport& report) const;
+
     void paint (juce::Graphics&) override;
     void paintOverChildren (juce::Graphics&) override;
     void resized() override;
@@ -221,6 +229,73 @@ private:
 
     DualMixBarComponent dualMixBar_;
 
+    // ── Session instance table (alt-click the gear) ──
+    // Every DISP-TR instance in the process, from InstanceRegistry, with its
+    // live cost. Click a header to sort by that column; again to reverse.
+    class InstanceTableComponent : public juce::Component
+    {
+    public:
+        enum Column : int
+        {
+            ColInstance = 0, ColTrack, ColBlockUs, ColLoad, ColPeak, ColStages, ColSeries, ColPath,
+            kNumColumns
+        };
+
+        void setOwnSlot (int slot) { ownSlot = slot; }
+        void setScheme (const DISPScheme& s) { scheme = s; repaint(); }
+
+        // Re-reads the registry and re-sorts; message thread.
+        void refresh();
+
+        // Header plus one row per instance, capped at `maxHeight`.
+        int getPreferredHeight (int maxHeight) const;
+
+        void paint (juce::Graphics& g) override;
+        void mouseDown (const juce::MouseEvent& e) override;
+
+        size_t getMemoryBytes() const;
+
+    private:
+        static constexpr int kRowH = 14;
+
+        void sortEntries();
+        juce::Rectangle<int> getColumnBounds (int column, juce::Rectangle<int> row) const;
+
+        DISPScheme scheme {};
+        std::vector<InstanceRegistry::Entry> entries;
+        int  ownSlot       = -1;
+        int  sortColumn    = ColLoad;
+        bool sortAscending = false;
+    };
+
+    InstanceTableComponent instanceTable_;
+    int instanceTableFrameCounter_ = 0;
+    juce::Rectangle<int> getInstanceTableBounds() const;
+
+    // ── Measured group delay (cmd/ctrl-click the gear) ──
+    // TransferAnalyzer's estimate drawn over the analytic curve. The analyzer
+    // only captures while this is shown.
+    class GroupDelayViewComponent : public juce::Component
+    {
+    public:
+        void setScheme (const DISPScheme& s) { scheme = s; repaint(); }
+        void setResult (const TransferAnalyzer::Result& r) { result = r; hasResult = true; repaint(); }
+        void clearResult() { hasResult = false; repaint(); }
+
+        void paint (juce::Graphics& g) override;
+
+    private:
+        DISPScheme scheme {};
+        TransferAnalyzer::Result result;
+        bool hasResult = false;
+    };
+
+    GroupDelayViewComponent groupDelayView_;
+    int groupDelayFrameCounter_ = 0;
+    juce::Rectangle<int> getGroupDelayViewBounds() const;
+    void setGroupDelayViewVisible (bool shouldBeVisible);
+    void refreshGroupDelayView();
+
     juce::ToggleButton altButton;
     juce::ToggleButton midiButton;
     juce::Label midiChannelDisplay;
@@ -312,6 +387,24 @@ private:
     static VerticalLayoutMetrics buildVerticalLayout (int editorH, int biasY, bool ioExpanded);
     void updateCachedLayout();
 
+    // Memoized layout per (width, height, ioExpanded) — a corner drag revisits
+    // the same handful of sizes, so the metrics are computed once per size.
+    struct LayoutMemoEntry
+    {
+        int w = -1;
+        int h = -1;
+        bool ioExpanded = false;
+        HorizontalLayoutMetrics horizontal;
+        VerticalLayoutMetrics vertical;
+    };
+
+    const LayoutMemoEntry& getMemoizedLayout (int editorW, int editorH, bool ioExpanded);
+    void layoutChildren();
+    bool isLiveResizing() const;
+    void onVBlankFrame();
+    void finishLiveResize();
+    void flushPendingUiState();
+
     class MinimalLNF : public juce::LookAndFeel_V4
     {
     public:
@@ -436,6 +529,7 @@ private:
     juce::String getFilterTextShort() const;
 
     void openFilterPrompt();
+    void openMorphMenu();
 
     int getTargetValueColumnWidth() const;
 
@@ -456,6 +550,9 @@ private:
     juce::Rectangle<int> getInfoIconArea() const;
     void updateInfoIconCache();
     bool refreshLegendTextCache();
+   #if DISPTR_PERF_TRACE
+    void drawPerfOverlay (juce::Graphics& g);
+   #endif
     juce::Rectangle<int> getRowRepaintBounds (const juce::Slider& s) const;
     void applyActivePalette();
     void applyCrtState (bool enabled);
@@ -547,6 +644,29 @@ private:
     CrtEffect crtEffect;
     float     crtTime = 0.0f;
 
+    // ── Live resize coalescing ──
+    static constexpr int    kLayoutMemoSize    = 16;
+    static constexpr double kLiveResizeFrameMs = 1000.0 / 60.0;
+    std::array<LayoutMemoEntry, kLayoutMemoSize> layoutMemo_;
+    int    layoutMemoNext_    = 0;
+    bool   liveResizeActive_  = false;
+    bool   layoutPending_     = false;
+    double lastLiveLayoutMs_  = 0.0;
+    std::unique_ptr<juce::VBlankAttachment> frameVBlank_;
+
+    // ── Coalesced UI mirror param notifications ──
+    static constexpr uint32_t kUiDirtySize       = 1u << 0;
+    static constexpr uint32_t kUiDirtyVisual     = 1u << 1;
+    static constexpr int      kUiFlushFallbackMs = 33;
+    std::atomic<uint32_t> pendingUiDirty_ { 0 };
+    std::atomic<bool>     uiFlushPosted_ { false };
+
+   #if DISPTR_PERF_TRACE
+    // ── Frame-time overlay (shift-click the gear) ──
+    bool perfOverlayVisible_ = false;
+    int  perfOverlayFrameCounter_ = 0;
+   #endif
+
     // IO collapsible section state
     juce::Rectangle<int> cachedToggleBarArea_;
     bool ioSectionExpanded_ = false;
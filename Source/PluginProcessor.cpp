@@ -19,84 +19,49 @@ namespace
 		return loadAtomicOrDefault (p, def ? 1.0f : 0.0f) > 0.5f;
 	}
 
-	inline void setParameterPlainValue (juce::AudioProcessorValueTreeState& apvts,
+	// Returns true if the parameter actually changed. Unchanged values are not
+	// re-sent so repeated UI writes don't generate host/listener traffic.
+	inline bool setParameterPlainValue (juce::AudioProcessorValueTreeState& apvts,
 										const char* paramId,
 										float plainValue)
 	{
 		if (auto* param = apvts.getParameter (paramId))
 		{
 			const float norm = param->convertTo0to1 (plainValue);
+			if (param->getValue() == norm)
+				return false;
+
 			param->setValueNotifyingHost (norm);
+			return true;
 		}
-	}
-
-	// Gain / mix EMA coefficient: one-pole ~5 ms time constant at 44.1 kHz.
-	constexpr float kGainSmoothCoeff = 0.9955f;
-
-	inline float fastDecibelsToGain (float dB) noexcept
-	{
-		if (dB <= -100.0f) return 0.0f;
-		return std::exp2 (dB * 0.16609640474f);   // log2(10)/20
-	}
-
-	// ── Biquad coefficient calculators for wet HP/LP filters ──
-	using BQC = DisperserAudioProcessor::WetFilterBiquadCoeffs;
-
-	inline BQC calcOnePoleLP (float freq, float sr)
-	{
-		const float w = juce::MathConstants<float>::twoPi * freq / sr;
-		const float alpha = w / (1.0f + w);
-		return { alpha, 0.0f, 0.0f, -(1.0f - alpha), 0.0f };
-	}
 
-	inline BQC calcOnePoleHP (float freq, float sr)
-	{
-		const float w = juce::MathConstants<float>::twoPi * freq / sr;
-		const float a = 1.0f / (1.0f + w);
-		return { a, -a, 0.0f, -(1.0f - a), 0.0f };
+		return false;
 	}
 
-	inline BQC calcBiquadLP (float freq, float sr, float Q)
-	{
-		const float w0 = juce::MathConstants<float>::twoPi * freq / sr;
-		const float cs = std::cos (w0);
-		const float sn = std::sin (w0);
-		const float alpha = sn / (2.0f * Q);
-		const float a0 = 1.0f + alpha;
-		return { ((1.0f - cs) * 0.5f) / a0,
-				 (1.0f - cs) / a0,
-				 ((1.0f - cs) * 0.5f) / a0,
-				 (-2.0f * cs) / a0,
-				 (1.0f - alpha) / a0 };
-	}
+	// Tempo-synced LFO cycle lengths in quarter notes, in the order of the
+	// division choices in createParameterLayout.
+	constexpr std::array<float, 16> kLfoDivisionBeats {
+		16.0f, 8.0f, 4.0f, 2.0f, 1.0f, 0.5f, 0.25f, 0.125f,         // 4/1 … 1/32
+		4.0f / 3.0f, 2.0f / 3.0f, 1.0f / 3.0f, 1.0f / 6.0f,          // 1/2T … 1/16T
+		3.0f, 1.5f, 0.75f, 0.375f                                    // 1/2D … 1/16D
+	};
 
-	inline BQC calcBiquadHP (float freq, float sr, float Q)
+	// Remembers whether any read wanted more bytes than were left; a short
+	// read otherwise just yields zeros.
+	class StateInputStream : public juce::MemoryInputStream
 	{
-		const float w0 = juce::MathConstants<float>::twoPi * freq / sr;
-		const float cs = std::cos (w0);
-		const float sn = std::sin (w0);
-		const float alpha = sn / (2.0f * Q);
-		const float a0 = 1.0f + alpha;
-		return { ((1.0f + cs) * 0.5f) / a0,
-				 -(1.0f + cs) / a0,
-				 ((1.0f + cs) * 0.5f) / a0,
-				 (-2.0f * cs) / a0,
-				 (1.0f - alpha) / a0 };
-	}
+	public:
+		using juce::MemoryInputStream::MemoryInputStream;
 
-	// 4th-order Butterworth Q values
-	constexpr float kBW4_Q1 = 0.54119610f;   // 1 / (2 cos(3π/8))
-	constexpr float kBW4_Q2 = 1.30656296f;   // 1 / (2 cos(π/8))
+		int read (void* destBuffer, int maxBytesToRead) override
+		{
+			const int n = juce::MemoryInputStream::read (destBuffer, maxBytesToRead);
+			ranDry = ranDry || n < maxBytesToRead;
+			return n;
+		}
 
-	inline float processBiquad (const BQC& c,
-							   DisperserAudioProcessor::WetFilterBiquadState& s,
-							   float x) noexcept
-	{
-		const float y = c.b0 * x + s.z1;
-		s.z1 = c.b1 * x - c.a1 * y + s.z2;
-		s.z2 = c.b2 * x - c.a2 * y;
-		return y;
-	}
+		bool ranDry = false;
+	};
 }
 
 DisperserAudioProcessor::DisperserAudioProcessor()
@@ -159,10 +124,128 @@ DisperserAudioProcessor::DisperserAudioProcessor()
 	dryLevelParam  = apvts.getRawParameterValue (kParamDryLevel);
 	wetLevelParam  = apvts.getRawParameterValue (kParamWetLevel);
 	filterPosParam = apvts.getRawParameterValue (kParamFilterPos);
+	morphParam     = apvts.getRawParameterValue (kParamMorph);
+
+	for (int i = 0; i < ModMatrix::kNumLfos; ++i)
+	{
+		auto& lfo = lfoParams[(size_t) i];
+		lfo.shape    = apvts.getRawParameterValue (getLfoParamId (i, kLfoFieldShape));
+		lfo.rate     = apvts.getRawParameterValue (getLfoParamId (i, kLfoFieldRate));
+		lfo.sync     = apvts.getRawParameterValue (getLfoParamId (i, kLfoFieldSync));
+		lfo.division = apvts.getRawParameterValue (getLfoParamId (i, kLfoFieldDivision));
+	}
+	for (int i = 0; i < ModMatrix::kMaxRoutes; ++i)
+	{
+		auto& route = routeParams[(size_t) i];
+		route.source = apvts.getRawParameterValue (getRouteParamId (i, kRouteFieldSource));
+		route.target = apvts.getRawParameterValue (getRouteParamId (i, kRouteFieldTarget));
+		route.depth  = apvts.getRawParameterValue (getRouteParamId (i, kRouteFieldDepth));
+	}
+	envAttackParam  = apvts.getRawParameterValue (kParamEnvAttack);
+	envReleaseParam = apvts.getRawParameterValue (kParamEnvRelease);
+	rndRateParam    = apvts.getRawParameterValue (kParamRndRate);
+	rndGlideParam   = apvts.getRawParameterValue (kParamRndGlide);
+	stageTypeParam  = apvts.getRawParameterValue (kParamStageType);
+
+	for (auto* p : getParameters())
+		p->addListener (this);
+	apvts.state.addListener (this);
+
+	for (auto& slot : presetSlots)
+		slot.values.assign ((size_t) getParameters().size(), std::numeric_limits<float>::quiet_NaN());
+
+	// Morph targets: everything that shapes the sound. UI mirrors, MIDI/debug
+	// switches and MORPH itself are left alone.
+	{
+		const auto& params = getParameters();
+		for (int i = 0; i < params.size(); ++i)
+		{
+			auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (params[i]);
+			if (ranged == nullptr)
+				continue;
+
+			const auto& id = ranged->paramID;
+			if (id.startsWith ("ui_") || id == kParamMorph || id == kParamMidi
+				|| id == kParamS0 || id == kParamS100)
+				continue;
+
+			const bool discrete = ranged->isDiscrete() || ranged->isBoolean()
+				|| ranged->getNumSteps() <= kMorphMaxInterpolatedSteps;
+			morphTargets.push_back ({ i, discrete, apvts.getRawParameterValue (id), ranged });
+		}
+
+		// makeEngineParams() finds a target from the raw value it reads.
+		std::sort (morphTargets.begin(), morphTargets.end(), [] (const MorphTarget& a, const MorphTarget& b)
+		{
+			return std::less<const std::atomic<float>*>() (a.raw, b.raw);
+		});
+
+		for (auto& slot : morphSlots)
+		{
+			slot.reset (new std::atomic<float>[(size_t) params.size()]);
+			for (int i = 0; i < params.size(); ++i)
+				slot[(size_t) i].store (0.0f, std::memory_order_relaxed);
+		}
+
+		morphHeld.reset (new std::atomic<bool>[(size_t) params.size()]);
+		for (int i = 0; i < params.size(); ++i)
+			morphHeld[(size_t) i].store (true, std::memory_order_relaxed);
+	}
+
+	loadPresetBank (getDefaultPresetBankFile());
+
+	// No audio thread yet: the estimate for hosts that ask before prepareToPlay.
+	tailSeconds.store (DisperserEngine::estimateTailSeconds (makeEngineParams(), currentSampleRate),
+					   std::memory_order_relaxed);
+
+	auto& registry = InstanceRegistry::get();
+	registrySlot = registry.claim();
+	registry.setText (registrySlot, "DISP-TR " + juce::String (registry.getNumber (registrySlot)), {});
 }
 
 DisperserAudioProcessor::~DisperserAudioProcessor()
 {
+	InstanceRegistry::get().release (registrySlot);
+	apvts.state.removeListener (this);
+	for (auto* p : getParameters())
+		p->removeListener (this);
+
+	cancelPendingUpdate();
+}
+
+void DisperserAudioProcessor::requestHostDisplayUpdate()
+{
+	// AsyncUpdater collapses any number of triggers into one message-thread callback.
+	hostDisplayUpdatePending.store (true, std::memory_order_relaxed);
+	triggerAsyncUpdate();
+}
+
+void DisperserAudioProcessor::handleAsyncUpdate()
+{
+	buildRequestedDelayArena();
+
+	if (hostDisplayUpdatePending.exchange (false, std::memory_order_relaxed))
+		updateHostDisplay();
+}
+
+void DisperserAudioProcessor::buildRequestedDelayArena()
+{
+	// Claimed first, so two main-thread callers never build it twice.
+	int requested = DelayArenaRequested;
+	if (! delayArenaState.compare_exchange_strong (requested, DelayArenaBuilding, std::memory_order_acq_rel))
+		return;
+
+	pendingDelayArena.assign (engine.getDelayArenaSize(), 0.0f);
+	delayArenaState.store (DelayArenaReady, std::memory_order_release);
+}
+
+void DisperserAudioProcessor::adoptPendingDelayArena() noexcept
+{
+	if (delayArenaState.load (std::memory_order_acquire) == DelayArenaReady)
+	{
+		engine.swapDelayArena (pendingDelayArena);
+		delayArenaState.store (DelayArenaIdle, std::memory_order_release);
+	}
 }
 
 const juce::String DisperserAudioProcessor::getName() const { return JucePlugin_Name; }
@@ -190,1289 +273,893 @@ bool DisperserAudioProcessor::isMidiEffect() const
 	return false;
 #endif
 }
-double DisperserAudioProcessor::getTailLengthSeconds() const { return 0.0; }
-int DisperserAudioProcessor::getNumPrograms() { return 1; }
-int DisperserAudioProcessor::getCurrentProgram() { return 0; }
-void DisperserAudioProcessor::setCurrentProgram (int) {}
-const juce::String DisperserAudioProcessor::getProgramName (int) { return {}; }
-void DisperserAudioProcessor::changeProgramName (int, const juce::String&) {}
-
-void DisperserAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+double DisperserAudioProcessor::getTailLengthSeconds() const
 {
-	juce::ignoreUnused (samplesPerBlock);
-	currentSampleRate = juce::jmax (1.0, sampleRate);
-	const int stages = juce::jlimit (kAmountMin, kAmountMax,
-									 loadIntParamOrDefault (amountParam, kAmountDefault));
-	const int series = juce::jlimit (kSeriesMin, kSeriesMax,
-									 loadIntParamOrDefault (seriesParam, kSeriesDefault));
-	const float freq = loadAtomicOrDefault (freqParam, kFreqDefault);
-	const float shape = juce::jlimit (0.0f, 1.0f, loadAtomicOrDefault (shapeParam, kShapeDefault));
-
-	resizeDspState (kAmountMax, kSeriesMax);
-	activeStages = stages;
-	activeSeries = series;
-	coeffUpdateCountdown = 0;
-
-	for (int i = 0; i < kSeriesMax; ++i)
-	{
-		xfadeChainL[(size_t) i].assign ((size_t) kAmountMax, {});
-		xfadeChainR[(size_t) i].assign ((size_t) kAmountMax, {});
-	}
-	seriesXfadeSamplesRemaining = 0;
-	seriesXfadeTotalSamples = 0;
-	previousSeries = series;
-
-	stagesSmoothed.reset (currentSampleRate, kStageSmoothingSeconds);
-	stagesSmoothed.setCurrentAndTargetValue ((float) stages);
-	smoothedFreqValue = freq;
-	freqEmaCoeffDefault_ = std::exp (-1.0f / ((float) currentSampleRate * kFreqTauDefault));
-	freqEmaCoeff = freqEmaCoeffDefault_;
-	shapeSmoothed.reset (currentSampleRate, kShapeSmoothingSeconds);
-	shapeSmoothed.setCurrentAndTargetValue (shape);
-	feedbackSmoothed.reset (currentSampleRate, kFeedbackSmoothingSeconds);
-	feedbackSmoothed.setCurrentAndTargetValue (juce::jlimit (kFeedbackMin, kFeedbackMax, loadAtomicOrDefault (feedbackParam, kFeedbackDefault)));
-	feedbackLastL = 0.0f;
-	feedbackLastR = 0.0f;
-
-	// Input/Output/Mix gain smoothing init (same as ECHO-TR)
-	smoothedInputGain = 1.0f;
-	smoothedOutputGain = 1.0f;
-	smoothedMix = 1.0f;
-
-	// Reset tilt state
-	tiltDb_ = 0.0f;
-	tiltB0_ = 1.0f; tiltB1_ = 0.0f; tiltA1_ = 0.0f;
-	tiltTargetB0_ = 1.0f; tiltTargetB1_ = 0.0f; tiltTargetA1_ = 0.0f;
-	tiltState_[0] = tiltState_[1] = 0.0f;
-	lastTiltDb_ = 0.0f;
-	tiltSmoothSc_ = 1.0f - std::exp (-1.0f / (static_cast<float> (currentSampleRate) * 0.03f));
-
-	// Pre-allocate dry buffer (avoids malloc in processBlock)
-	dryBuffer.setSize (getTotalNumOutputChannels(), samplesPerBlock);
-
-	lastCoeffFreq = -1.0f;
-	lastCoeffShape = -1.0f;
-	lastCoeffStages = -1;
-
-	// Reset MIDI note tracking
-	lastMidiNote.store (-1, std::memory_order_relaxed);
-	currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
+	// Feedback and DELAY ring for seconds; hosts stop bounces at this.
+	return tailSeconds.load (std::memory_order_relaxed);
+}
 
-	// Reset wet filter state
-	wetFilterState_[0].reset();
-	wetFilterState_[1].reset();
-	smoothedFilterHpFreq_ = loadAtomicOrDefault (filterHpFreqParam, kFilterHpFreqDefault);
-	smoothedFilterLpFreq_ = loadAtomicOrDefault (filterLpFreqParam, kFilterLpFreqDefault);
-	lastCalcHpFreq_ = -1.0f;
-	lastCalcLpFreq_ = -1.0f;
-	lastCalcHpSlope_ = -1;
-	lastCalcLpSlope_ = -1;
-	filterCoeffCountdown_ = 0;
-	updateFilterCoeffs (true, true);
-
-	// Reset chaos state
-	chaosFilterEnabled_ = false;
-	chaosDelayEnabled_  = false;
-	chaosStereo_ = false;
-	chaosAmtD_ = 0.0f; chaosAmtNormD_ = 0.0f; chaosAmtF_ = 0.0f;
-	for (int c = 0; c < 2; ++c)
-	{
-		chaosDPrev_[c] = chaosDCurr_[c] = chaosDNext_[c] = 0.0f;
-		chaosDPhase_[c] = 0.0f; chaosDDriftPhase_[c] = 0.0f; chaosDDriftFreqHz_[c] = 0.0f; chaosDOut_[c] = 0.0f;
-		chaosGPrev_[c] = chaosGCurr_[c] = chaosGNext_[c] = 0.0f;
-		chaosGPhase_[c] = 0.0f; chaosGDriftPhase_[c] = 0.0f; chaosGDriftFreqHz_[c] = 0.0f; chaosGOut_[c] = 0.0f;
-	}
-	chaosFPrev_ = chaosFCurr_ = chaosFNext_ = 0.0f;
-	chaosFPhase_ = 0.0f; chaosFDriftPhase_ = 0.0f; chaosFDriftFreqHz_ = 0.0f;
-	chaosFOut_[0] = chaosFOut_[1] = 0.0f;
-	smoothedChaosFreqMaxOct_ = 0.0f;
-	smoothedChaosGainMaxDb_ = 0.0f;
-	smoothedChaosFilterMaxOct_ = 0.0f;
-	chaosParamSmoothCoeff_ = 0.999f;
-
-	// Precompute chaos smooth coefficients (sampleRate-dependent but constant between prepareToPlay)
-	cachedChaosParamSmoothCoeff_ = std::exp (-1.0f / ((float) currentSampleRate * 0.010f));
-
-	// Reset limiter state and precompute coefficients
-	limEnv1_[0] = limEnv1_[1] = kLimFloor;
-	limEnv2_[0] = limEnv2_[1] = kLimFloor;
+void DisperserAudioProcessor::updateTailEstimate (int numSamples) noexcept
+{
+	if (samplesSinceTailEstimate < (int) (kTailEstimateIntervalSeconds * currentSampleRate))
 	{
-		const float sr = (float) getSampleRate();
-		limAtt1_ = std::exp (-1.0f / (sr * 0.002f));
-		limRel1_ = std::exp (-1.0f / (sr * 0.010f));
-		limRel2_ = std::exp (-1.0f / (sr * 0.100f));
+		samplesSinceTailEstimate += numSamples;
+		return;
 	}
+	if (! tailEstimateDirty.exchange (false, std::memory_order_relaxed))
+		return;
 
-	dspLog.enableDesktopAutoDump();
+	samplesSinceTailEstimate = 0;
+	tailSeconds.store (DisperserEngine::estimateTailSeconds (makeEngineParams(), currentSampleRate),
+					   std::memory_order_relaxed);
 }
+int DisperserAudioProcessor::getNumPrograms() { return juce::jmax (1, presetBank.getNumPresets()); }
+int DisperserAudioProcessor::getCurrentProgram() { return currentProgram.load (std::memory_order_relaxed); }
+void DisperserAudioProcessor::setCurrentProgram (int index) { applyPreset (index); }
+const juce::String DisperserAudioProcessor::getProgramName (int index) { return presetBank.getName (index); }
+void DisperserAudioProcessor::changeProgramName (int, const juce::String&) {}
 
-void DisperserAudioProcessor::updateFilterCoeffs (bool forceHp, bool forceLp)
+//==============================================================================
+juce::File DisperserAudioProcessor::getDefaultPresetBankFile()
 {
-	const float sr = (float) currentSampleRate;
-	const int hpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-									  loadIntParamOrDefault (filterHpSlopeParam, kFilterSlopeDefault));
-	const int lpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-									  loadIntParamOrDefault (filterLpSlopeParam, kFilterSlopeDefault));
-
-	const float hpFreq = juce::jlimit (kFilterFreqMin, juce::jmin (kFilterFreqMax, 0.49f * sr), smoothedFilterHpFreq_);
-	const float lpFreq = juce::jlimit (kFilterFreqMin, juce::jmin (kFilterFreqMax, 0.49f * sr), smoothedFilterLpFreq_);
+	return juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+		.getChildFile ("NMSTR").getChildFile ("DISP-TR").getChildFile ("Presets.dtpb");
+}
 
-	if (forceHp || hpSlope != lastCalcHpSlope_ || std::abs (hpFreq - lastCalcHpFreq_) > 0.01f)
-	{
-		lastCalcHpFreq_  = hpFreq;
-		lastCalcHpSlope_ = hpSlope;
+bool DisperserAudioProcessor::loadPresetBank (const juce::File& file)
+{
+	presetParamMap.clear();
+	currentProgram.store (0, std::memory_order_relaxed);
 
-		if (hpSlope == 0)      // 6 dB/oct — single 1-pole
-		{
-			hpCoeffs_[0] = calcOnePoleHP (hpFreq, sr);
-			hpCoeffs_[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };  // pass-through
-		}
-		else if (hpSlope == 1) // 12 dB/oct — single Butterworth biquad
-		{
-			constexpr float kBW2_Q = 0.70710678f;  // 1/sqrt(2)
-			hpCoeffs_[0] = calcBiquadHP (hpFreq, sr, kBW2_Q);
-			hpCoeffs_[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-		}
-		else                   // 24 dB/oct — two cascaded Butterworth biquads
-		{
-			hpCoeffs_[0] = calcBiquadHP (hpFreq, sr, kBW4_Q1);
-			hpCoeffs_[1] = calcBiquadHP (hpFreq, sr, kBW4_Q2);
-		}
-	}
+	if (! presetBank.open (file))
+		return false;
 
-	if (forceLp || lpSlope != lastCalcLpSlope_ || std::abs (lpFreq - lastCalcLpFreq_) > 0.01f)
+	// Resolve the bank's param IDs once; applying a preset is then index-only.
+	const auto& params = getParameters();
+	for (int i = 0; i < presetBank.getNumParams(); ++i)
 	{
-		lastCalcLpFreq_  = lpFreq;
-		lastCalcLpSlope_ = lpSlope;
-
-		if (lpSlope == 0)
-		{
-			lpCoeffs_[0] = calcOnePoleLP (lpFreq, sr);
-			lpCoeffs_[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-		}
-		else if (lpSlope == 1)
+		const auto id = getCurrentParamId (presetBank.getParamId (i));
+		int target = -1;
+		for (int p = 0; p < params.size(); ++p)
 		{
-			constexpr float kBW2_Q = 0.70710678f;
-			lpCoeffs_[0] = calcBiquadLP (lpFreq, sr, kBW2_Q);
-			lpCoeffs_[1] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f };
-		}
-		else
-		{
-			lpCoeffs_[0] = calcBiquadLP (lpFreq, sr, kBW4_Q1);
-			lpCoeffs_[1] = calcBiquadLP (lpFreq, sr, kBW4_Q2);
+			if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (params[p]))
+			{
+				if (ranged->paramID == id)
+				{
+					target = p;
+					break;
+				}
+			}
 		}
+		presetParamMap.push_back (target);
 	}
-}
 
-void DisperserAudioProcessor::releaseResources()
-{
-	for (auto& c : chainL) c.clear();
-	for (auto& c : chainR) c.clear();
-	for (auto& c : xfadeChainL) c.clear();
-	for (auto& c : xfadeChainR) c.clear();
-	stageCoeff.clear();
-	stageCoeffR.clear();
+	updateHostDisplay (juce::AudioProcessorListener::ChangeDetails().withProgramChanged (true));
+	return true;
 }
 
-#if ! JucePlugin_PreferredChannelConfigurations
-bool DisperserAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+bool DisperserAudioProcessor::applyPreset (int presetIndex)
 {
-	const auto in = layouts.getMainInputChannelSet();
-	const auto out = layouts.getMainOutputChannelSet();
-	if (in != out)
+	const float* values = presetBank.getValues (presetIndex);
+	if (values == nullptr)
 		return false;
-	return (out == juce::AudioChannelSet::mono() || out == juce::AudioChannelSet::stereo());
-}
-#endif
-
-float DisperserAudioProcessor::calcAllPassCoeff (float frequency, float sampleRate) noexcept
-{
-	const float f = juce::jlimit (20.0f, 0.49f * sampleRate, frequency);
-	const float t = std::tan (juce::MathConstants<float>::pi * f / sampleRate);
-	if (! std::isfinite (t))
-		return 0.0f;
-	return (1.0f - t) / (1.0f + t);
-}
 
-void DisperserAudioProcessor::resizeDspState (int stages, int series)
-{
-	juce::ignoreUnused (stages, series);
-	const int nStages = kAmountMax;
-
-	const size_t coeffSize = (size_t) nStages;
-	if (stageCoeff.size() != coeffSize)
-		stageCoeff.assign (coeffSize, 0.0f);
-	if (stageCoeffR.size() != coeffSize)
-		stageCoeffR.assign (coeffSize, 0.0f);
+	// The write slot belongs to this thread until it is exchanged below.
+	const auto& params = getParameters();
+	auto& slot = presetSlots[(size_t) presetWriteSlot];
+	auto& dest = slot.values;
+	std::fill (dest.begin(), dest.end(), std::numeric_limits<float>::quiet_NaN());
+	slot.program = presetIndex;
 
-	for (int i = 0; i < kSeriesMax; ++i)
+	for (size_t i = 0; i < presetParamMap.size(); ++i)
 	{
-		const size_t newSize = (size_t) nStages;
-		if (chainL[(size_t) i].size() != newSize)
-			chainL[(size_t) i].assign (newSize, {});
-		if (chainR[(size_t) i].size() != newSize)
-			chainR[(size_t) i].assign (newSize, {});
-	}
-}
+		const int target = presetParamMap[i];
+		if (target < 0)
+			continue;
 
-void DisperserAudioProcessor::clearStageRange (int fromStageInclusive,
-													   int toStageExclusive,
-													   int seriesCount) noexcept
-{
-	const int fromStage = juce::jlimit (0, kAmountMax, fromStageInclusive);
-	const int toStage = juce::jlimit (0, kAmountMax, toStageExclusive);
-	const int nSeries = juce::jlimit (kSeriesMin, kSeriesMax, seriesCount);
+		if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (params[target]))
+			dest[(size_t) target] = ranged->convertTo0to1 (values[i]);
+	}
 
-	if (toStage <= fromStage)
-		return;
+	currentProgram.store (presetIndex, std::memory_order_relaxed);
 
-	for (int s = 0; s < nSeries; ++s)
+	if (audioPrepared.load (std::memory_order_acquire))
 	{
-		auto* left = chainL[(size_t) s].data();
-		auto* right = chainR[(size_t) s].data();
-		for (int st = fromStage; st < toStage; ++st)
-		{
-			left[st].z1 = 0.0f;
-			right[st].z1 = 0.0f;
-		}
+		// Whatever comes back is free: either never picked up (superseded) or
+		// already applied by the audio thread.
+		const int previous = presetMiddleSlot.exchange (presetWriteSlot | kPresetSlotFresh, std::memory_order_acq_rel);
+		presetWriteSlot = previous & kPresetSlotMask;
 	}
+	else
+	{
+		// No audio callback to pick it up; apply directly.
+		for (int i = 0; i < params.size(); ++i)
+			if (! std::isnan (dest[(size_t) i]))
+				params[i]->setValueNotifyingHost (dest[(size_t) i]);
+	}
+
+	return true;
 }
 
-void DisperserAudioProcessor::updateCoefficientsInto (float freqHz, float shapeNorm, int stages, std::vector<float>& dest)
+void DisperserAudioProcessor::applyPendingPreset() noexcept
 {
-	const int nStages = juce::jmax (1, stages);
-	if ((int) dest.size() < nStages)
-		dest.assign ((size_t) kAmountMax, 0.0f);
-
-	const float sr = (float) currentSampleRate;
-	const float minFreq = 20.0f;
-	const float maxFreq = 0.49f * sr;
-	const float center = juce::jlimit (minFreq, maxFreq, freqHz);
-	const float shape = juce::jlimit (0.0f, 1.0f, shapeNorm);
-
-	const float logPos = std::log2 (center / minFreq) / std::log2 (maxFreq / minFreq);
-	const float lowComp = std::pow (juce::jlimit (0.0f, 1.0f, 1.0f - logPos), 1.15f);
-	const float shapeStrength = 1.0f + (0.95f * lowComp);
-	const float shapeComp = juce::jlimit (0.0f, 1.0f, 0.5f + ((shape - 0.5f) * shapeStrength));
+	if ((presetMiddleSlot.load (std::memory_order_relaxed) & kPresetSlotFresh) == 0)
+		return;
 
-	const float spreadMax = 4.0f + (1.1f * lowComp);
-	const float spreadMin = 0.12f;
-	const float spreadOct = juce::jmap (shapeComp, spreadMax, spreadMin);
-	const float warpGamma = juce::jmap (shapeComp, 0.45f, 3.0f + (0.8f * lowComp));
+	presetReadSlot = presetMiddleSlot.exchange (presetReadSlot, std::memory_order_acq_rel) & kPresetSlotMask;
+	const auto& slot = presetSlots[(size_t) presetReadSlot];
 
-	if (nStages == 1)
+	// Park the outgoing program's DSP state and pick up the incoming one's, so
+	// recalling a preset resumes warm instead of refilling the cascade.
+	const int program = slot.program;
+	const bool switching = program != audioProgram;
+	if (switching && audioProgram >= 0)
 	{
-		dest[0] = calcAllPassCoeff (center, sr);
-		return;
+		auto* parked = findSnapshot (SnapshotKey::Program, audioProgram);
+		auto& dest = parked != nullptr ? *parked : allocateSnapshot (SnapshotKey::Program, audioProgram);
+		engine.captureState (dest.state);
+		dest.settings = getSoundSettingsHash();
 	}
 
-	const float denom = (float) juce::jmax (1, nStages - 1);
-	for (int i = 0; i < nStages; ++i)
+	// Same sequence the plugin wrappers use for sample-accurate automation:
+	// set the value, then notify listeners (APVTS raw values, host, editor).
+	const auto& params = getParameters();
+	for (int i = 0; i < params.size(); ++i)
 	{
-		const float u = (2.0f * ((float) i / denom)) - 1.0f;
-		const float absWarped = std::pow (std::abs (u), warpGamma);
-		const float warped = std::copysign (absWarped, u);
-		const float oct = 0.5f * spreadOct * warped;
-		const float f = juce::jlimit (minFreq, maxFreq, center * std::pow (2.0f, oct));
-		dest[(size_t) i] = calcAllPassCoeff (f, sr);
+		const float v = slot.values[(size_t) i];
+		if (std::isnan (v))
+			continue;
+
+		params[i]->setValue (v);
+		params[i]->sendValueChangedMessageToListeners (v);
 	}
-}
 
-void DisperserAudioProcessor::updateCoefficients (float freqHz, float shapeNorm, int stages)
-{
-	updateCoefficientsInto (freqHz, shapeNorm, stages, stageCoeff);
+	if (switching)
+	{
+		// A program parked after hand edits, or whose preset was saved over
+		// since, left state that belongs to other settings.
+		if (auto* recalled = findSnapshot (SnapshotKey::Program, program))
+		{
+			if (recalled->settings == getSoundSettingsHash())
+				engine.restoreState (recalled->state);
+			else
+				recalled->keyType = SnapshotKey::None;
+		}
+
+		audioProgram = program;
+	}
 }
 
-void DisperserAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+bool DisperserAudioProcessor::saveCurrentAsPreset (const juce::String& name, const juce::StringArray& tags)
 {
-	juce::ScopedNoDenormals noDenormals;
-	DSP_LOG_BLOCK_BEGIN();
-
-	const int numSamples = buffer.getNumSamples();
-	const int numChannels = buffer.getNumChannels();
-	if (numSamples <= 0 || numChannels <= 0)
-		return;
-
-	for (int ch = getTotalNumInputChannels(); ch < getTotalNumOutputChannels(); ++ch)
-		buffer.clear (ch, 0, numSamples);
-
-	const int targetStages = juce::jlimit (kAmountMin, kAmountMax, loadIntParamOrDefault (amountParam, kAmountDefault));
-	const int targetSeries = juce::jlimit (kSeriesMin, kSeriesMax, loadIntParamOrDefault (seriesParam, kSeriesDefault));
-	float targetFreq = loadAtomicOrDefault (freqParam, kFreqDefault);
-	float targetShape = juce::jlimit (0.0f, 1.0f, loadAtomicOrDefault (shapeParam, kShapeDefault));
-
-	// Debug overrides preserved.
-	if (loadBoolParamOrDefault (s0Param, false))
-		targetShape = 0.0f;
-	if (loadBoolParamOrDefault (s100Param, false))
-		targetShape = 1.0f;
-	const bool altEnabled = loadBoolParamOrDefault (altParam, false);
+	if (name.trim().isEmpty())
+		return false;
 
-	// ── MIDI note tracking ───────────────────────────────────
-	const bool midiEnabled = loadBoolParamOrDefault (midiParam, false);
-	if (midiEnabled && ! midi.isEmpty())
+	// UI mirror params describe the window, not the sound.
+	juce::StringArray ids;
+	std::vector<float> values;
+	for (auto* p : getParameters())
 	{
-		const int ch = midiChannel.load (std::memory_order_relaxed);
-		for (const auto metadata : midi)
+		if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p))
 		{
-			const auto msg = metadata.getMessage();
-			if (ch != 0 && msg.getChannel() != ch)
+			if (ranged->paramID.startsWith ("ui_") || ranged->paramID == kParamMorph)
 				continue;
-			if (msg.isNoteOn())
-			{
-				const int note = msg.getNoteNumber();
-				lastMidiNote.store (note, std::memory_order_relaxed);
-				lastMidiVelocity.store (msg.getVelocity(), std::memory_order_relaxed);
-				currentMidiFrequency.store (440.0f * std::exp2 ((note - 69) * (1.0f / 12.0f)),
-					std::memory_order_relaxed);
-			}
-			else if (msg.isNoteOff())
-			{
-				if (msg.getNoteNumber() == lastMidiNote.load (std::memory_order_relaxed))
-				{
-					lastMidiNote.store (-1, std::memory_order_relaxed);
-					currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
-				}
-			}
+			ids.add (ranged->paramID);
+			const auto* t = findMorphTarget (apvts.getRawParameterValue (ranged->paramID));
+			values.push_back (ranged->convertFrom0to1 (t != nullptr ? getMorphedValue (*t) : ranged->getValue()));
 		}
 	}
-	else if (! midiEnabled && lastMidiNote.load (std::memory_order_relaxed) >= 0)
-	{
-		lastMidiNote.store (-1, std::memory_order_relaxed);
-		currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
-	}
 
-	// MIDI frequency override (priority: MIDI > manual slider)
-	const float midiFreq = currentMidiFrequency.load (std::memory_order_relaxed);
-	if (midiEnabled && midiFreq > 0.0f)
-		targetFreq = midiFreq;
-
-	// ── MOD frequency multiplier (hyperbolic below centre, linear above) ──
-	const float modValue = loadAtomicOrDefault (modParam, kModDefault);
-	const float freqMultiplier = (modValue < 0.5f)
-		? 1.0f / (4.0f - 6.0f * modValue)
-		: (1.0f + (modValue - 0.5f) * 6.0f);
-	targetFreq *= freqMultiplier;
-
-	// ── Smoothstep feedback mapping (sign-preserving bipolar) ─
-	float rawFeedback = juce::jlimit (kFeedbackMin, kFeedbackMax, loadAtomicOrDefault (feedbackParam, kFeedbackDefault));
-	const float sign = rawFeedback < 0.0f ? -1.0f : 1.0f;
-	const float af   = std::abs (rawFeedback);
-	const float targetFeedback = sign * af * af * (3.0f - 2.0f * af);
-
-	stagesSmoothed.setTargetValue ((float) targetStages);
-	shapeSmoothed.setTargetValue (targetShape);
-	feedbackSmoothed.setTargetValue (targetFeedback);
-
-	// ── MIX (dry/wet) ───────────────────────────────────────
-	const float mixValue = juce::jlimit (0.0f, 1.0f, loadAtomicOrDefault (mixParam, kMixDefault));
-	const int   mixMode  = loadIntParamOrDefault (mixModeParam, kMixModeDefault);
-	const float dryLevel = (mixMode == 1) ? loadAtomicOrDefault (dryLevelParam, kDryLevelDefault) : 0.0f;
-	const float wetLevel = (mixMode == 1) ? loadAtomicOrDefault (wetLevelParam, kWetLevelDefault) : 0.0f;
-
-	// Filter / Tilt position
+	// Re-key existing presets onto the current ID list (unknown IDs dropped,
+	// new IDs take the current value).
+	std::vector<PresetBank::Preset> presets;
+	for (int i = 0; i < presetBank.getNumPresets(); ++i)
 	{
-		const int fltPos = loadIntParamOrDefault (filterPosParam, kFilterPosDefault);
-		// 0=F▼T▼  1=F▲T▲  2=F▲T▼  3=F▼T▲
-		filterPre_ = (fltPos == 1 || fltPos == 2);
-		tiltPre_   = (fltPos == 1 || fltPos == 3);
+		if (presetBank.getName (i).equalsIgnoreCase (name))
+			continue;
+
+		PresetBank::Preset preset { presetBank.getName (i), presetBank.getTags (i), values };
+		const float* src = presetBank.getValues (i);
+		for (int b = 0; b < presetBank.getNumParams(); ++b)
+		{
+			const int idx = ids.indexOf (getCurrentParamId (presetBank.getParamId (b)));
+			if (idx >= 0)
+				preset.values[(size_t) idx] = src[b];
+		}
+		presets.push_back (std::move (preset));
 	}
+	presets.push_back ({ name.trim(), tags, values });
 
-	// ── TILT EQ parameter load ──
-	tiltDb_ = loadAtomicOrDefault (tiltParam, kTiltDefault);
+	auto file = presetBank.isOpen() ? presetBank.getFile() : getDefaultPresetBankFile();
 
-	// ── INPUT / OUTPUT gain (dB → linear, same as ECHO-TR) ───
-	const float inputGainDb  = juce::jlimit (kInputMin,  kInputMax,  loadAtomicOrDefault (inputParam,  kInputDefault));
-	const float outputGainDb = juce::jlimit (kOutputMin, kOutputMax, loadAtomicOrDefault (outputParam, kOutputDefault));
-	const float inputGain    = fastDecibelsToGain (inputGainDb);
-	const float outputGain   = fastDecibelsToGain (outputGainDb);
+	// Unmap before replacing; the target must not be open while it is swapped.
+	presetBank.close();
+	presetParamMap.clear();
+	const bool written = PresetBank::write (file, ids, std::move (presets));
+	loadPresetBank (file);
 
-	// ── STYLE: 0=MONO, 1=STEREO, 2=WIDE, 3=DUAL ────────────
-	const int style = juce::jlimit (kStyleMin, kStyleMax, loadIntParamOrDefault (styleParam, (int) kStyleDefault));
+	if (written)
+		currentProgram.store (juce::jmax (0, presetBank.findByName (name.trim())), std::memory_order_relaxed);
 
-	// ── Sum Bus (needed early for needsDryBlend) ────────────
-	const int sumBusVal  = juce::jlimit (0, 2, (int) sumBusParam->load());
+	return written;
+}
 
-	// Save dry input for dry/wet blend (only when mix < 1 or sum bus active or SEND mode)
-	const bool needsDryBlend = (mixValue < 0.999f) || (sumBusVal != 0) || (mixMode == 1);
-	if (needsDryBlend)
-	{
-		if (dryBuffer.getNumChannels() < numChannels || dryBuffer.getNumSamples() < numSamples)
-			dryBuffer.setSize (numChannels, numSamples, false, false, true);
-		for (int ch = 0; ch < numChannels; ++ch)
-			dryBuffer.copyFrom (ch, 0, buffer, ch, 0, numSamples);
-	}
+//==============================================================================
+void DisperserAudioProcessor::captureMorphSlot (int slot)
+{
+	if (slot < 0 || slot > 1)
+		return;
 
-	// ── MIDI glide: velocity-dependent EMA coefficient ──────
-	if (midiEnabled && lastMidiNote.load (std::memory_order_relaxed) >= 0)
-	{
-		const float vel  = (float) lastMidiVelocity.load (std::memory_order_relaxed);
-		const float tLin = juce::jlimit (0.0f, 1.0f, (vel - 1.0f) / 126.0f);
-		const float t    = std::pow (tLin, 0.05f);
-		const float tau  = kMidiGlideTauMax - t * (kMidiGlideTauMax - kMidiGlideTauMin);
-		freqEmaCoeff = std::exp (-1.0f / ((float) currentSampleRate * tau));
-	}
-	else
-	{
-		freqEmaCoeff = freqEmaCoeffDefault_;
-	}
+	// What is heard, so storing mid-morph keeps the blend.
+	for (const auto& t : morphTargets)
+		morphSlots[(size_t) slot][(size_t) t.paramIndex].store (getMorphedValue (t), std::memory_order_relaxed);
 
-	// ── Direct mode (per-sample all-pass) ────────────────────
+	// Capturing must not make the next block jump to the other slot.
+	holdAllMorphTargets();
+	morphResync.store (true, std::memory_order_release);
+	morphSlotValid[(size_t) slot].store (true, std::memory_order_release);
+	storeMorphSlotsInState();
+}
 
-	// Detect series change → start crossfade
-	if (targetSeries != activeSeries)
-	{
-		for (int s = 0; s < kSeriesMax; ++s)
-		{
-			xfadeChainL[(size_t) s] = chainL[(size_t) s];
-			xfadeChainR[(size_t) s] = chainR[(size_t) s];
-		}
-		previousSeries = activeSeries;
-		seriesXfadeTotalSamples = (int) std::round (currentSampleRate * kSeriesCrossfadeMs / 1000.0);
-		seriesXfadeSamplesRemaining = seriesXfadeTotalSamples;
-		DSP_LOG_CROSSFADE(dspLog, previousSeries, targetSeries, seriesXfadeTotalSamples);
-
-		if (targetSeries > activeSeries)
-			clearStageRange (0, kAmountMax, targetSeries);
-		activeSeries = targetSeries;
-	}
+void DisperserAudioProcessor::clearMorphSlots()
+{
+	for (auto& v : morphSlotValid)
+		v.store (false, std::memory_order_release);
+	storeMorphSlotsInState();
+}
+
+bool DisperserAudioProcessor::hasMorphSlot (int slot) const noexcept
+{
+	return slot >= 0 && slot <= 1 && morphSlotValid[(size_t) slot].load (std::memory_order_acquire);
+}
 
-	auto* ch0 = buffer.getWritePointer (0);
-	float* ch1 = (numChannels > 1) ? buffer.getWritePointer (1) : nullptr;
-	const bool hasStereo = (ch1 != nullptr);
+void DisperserAudioProcessor::parameterValueChanged (int parameterIndex, float)
+{
+	// Any thread: the host may automate from the audio thread.
+	if (morphHeld != nullptr && juce::isPositiveAndBelow (parameterIndex, getParameters().size()))
+		morphHeld[(size_t) parameterIndex].store (true, std::memory_order_relaxed);
+	tailEstimateDirty.store (true, std::memory_order_relaxed);
+	markStateDirty();
+}
+
+void DisperserAudioProcessor::holdAllMorphTargets() noexcept
+{
+	for (const auto& t : morphTargets)
+		morphHeld[(size_t) t.paramIndex].store (true, std::memory_order_relaxed);
+}
 
-	// ── Mode In: M/S encode input before effect processing ──
-	const int modeInVal  = juce::jlimit (0, 2, (int) modeInParam->load());
-	const int modeOutVal = juce::jlimit (0, 2, (int) modeOutParam->load());
+void DisperserAudioProcessor::updateMorphHolds() noexcept
+{
+	const float m = juce::jlimit (0.0f, 1.0f, loadAtomicOrDefault (morphParam, 0.0f));
 
-	if (modeInVal > 0 && hasStereo)
+	if (morphResync.exchange (false, std::memory_order_acq_rel))
 	{
-		for (int n = 0; n < numSamples; ++n)
-		{
-			const float L = ch0[n];
-			const float R = ch1[n];
-			const float M = (L + R) * kSqrt2Over2;
-			const float S = (L - R) * kSqrt2Over2;
-			if (modeInVal == 1) { ch0[n] = M; ch1[n] = M; }
-			else                { ch0[n] = S; ch1[n] = S; }
-		}
+		lastMorph = m;
+		return;
 	}
 
-	const bool processR     = (style >= 1 && hasStereo);
-	const bool crossFbk     = (style == 2);  // WIDE
-	const bool negateCoeffR = (style == 2);  // WIDE: complementary phase
-	const bool dualCoeffR   = (style == 3);  // DUAL: separate R coefficients
-	const bool crossfading = (seriesXfadeSamplesRemaining > 0);
-
-	// ── Chaos per-block parameter read ──
-	chaosFilterEnabled_ = loadBoolParamOrDefault (chaosParam, false);
-	chaosDelayEnabled_  = loadBoolParamOrDefault (chaosDelayParam, false);
-	const bool anyChaos = chaosFilterEnabled_ || chaosDelayEnabled_;
-	if (anyChaos)
-	{
-		if (chaosDelayEnabled_)
-		{
-			const float rawAmtD = loadAtomicOrDefault (chaosAmtParam, kChaosAmtDefault);
-			const float rawSpdD = loadAtomicOrDefault (chaosSpdParam, kChaosSpdDefault);
-			chaosAmtD_       = rawAmtD;
-			chaosAmtNormD_   = rawAmtD * 0.01f;
-			chaosShPeriodD_  = (float) currentSampleRate / rawSpdD;
-			chaosFreqMaxOct_ = chaosAmtNormD_ * 2.0f;   // ±2 oct at 100%
-			chaosGainMaxDb_  = chaosAmtNormD_ * 1.0f;    // ±1 dB at 100%
-		}
-		else
-		{
-			chaosFreqMaxOct_ = 0.0f;
-			chaosGainMaxDb_ = 0.0f;
-		}
+	if (std::abs (m - lastMorph) < 1.0e-5f)
+		return;
+	lastMorph = m;
 
-		if (chaosFilterEnabled_)
-		{
-			const float rawAmtF = loadAtomicOrDefault (chaosAmtFilterParam, kChaosAmtDefault);
-			const float rawSpdF = loadAtomicOrDefault (chaosSpdFilterParam, kChaosSpdDefault);
-			chaosAmtF_       = rawAmtF;
-			chaosShPeriodF_  = (float) currentSampleRate / rawSpdF;
-			const float amtNormF = rawAmtF * 0.01f;
-			chaosFilterMaxOct_ = amtNormF * 2.0f;  // ±2 oct at 100%
-		}
-		else
+	// MORPH moved: every target follows the blend again.
+	for (const auto& t : morphTargets)
+		morphHeld[(size_t) t.paramIndex].store (false, std::memory_order_relaxed);
+}
+
+const DisperserAudioProcessor::MorphTarget* DisperserAudioProcessor::findMorphTarget (const std::atomic<float>* raw) const noexcept
+{
+	const auto it = std::lower_bound (morphTargets.begin(), morphTargets.end(), raw,
+		[] (const MorphTarget& t, const std::atomic<float>* r)
 		{
-			chaosFilterMaxOct_ = 0.0f;
-		}
+			return std::less<const std::atomic<float>*>() (t.raw, r);
+		});
+	return it != morphTargets.end() && it->raw == raw ? &*it : nullptr;
+}
 
-		chaosParamSmoothCoeff_ = cachedChaosParamSmoothCoeff_;
-	}
-	else
-	{
-		chaosAmtD_ = 0.0f; chaosAmtF_ = 0.0f;
-		chaosFreqMaxOct_ = 0.0f;
-		chaosGainMaxDb_ = 0.0f;
-		chaosFilterMaxOct_ = 0.0f;
-	}
+float DisperserAudioProcessor::getMorphedValue (const MorphTarget& t) const noexcept
+{
+	if (morphHeld[(size_t) t.paramIndex].load (std::memory_order_relaxed)
+		|| ! morphSlotValid[0].load (std::memory_order_acquire)
+		|| ! morphSlotValid[1].load (std::memory_order_acquire))
+		return t.param->getValue();
+
+	const float m  = juce::jlimit (0.0f, 1.0f, loadAtomicOrDefault (morphParam, 0.0f));
+	const float va = morphSlots[0][(size_t) t.paramIndex].load (std::memory_order_relaxed);
+	const float vb = morphSlots[1][(size_t) t.paramIndex].load (std::memory_order_relaxed);
+	return t.discrete ? (m < 0.5f ? va : vb) : va + (vb - va) * m;
+}
 
-	chaosStereo_ = (style >= 1);
+float DisperserAudioProcessor::loadEngineParam (std::atomic<float>* raw, float def) const noexcept
+{
+	if (raw != nullptr)
+		if (const auto* t = findMorphTarget (raw))
+			if (! morphHeld[(size_t) t->paramIndex].load (std::memory_order_relaxed))
+				return t->param->convertFrom0to1 (getMorphedValue (*t));
 
-	// ── Wet-signal HP/LP filter (PRE position — only runs if filterPre_) ──
-	if (filterPre_)
-	{
-		const bool hpOn = loadBoolParamOrDefault (filterHpOnParam, false);
-		const bool lpOn = loadBoolParamOrDefault (filterLpOnParam, false);
+	return loadAtomicOrDefault (raw, def);
+}
 
-		if (hpOn || lpOn)
-		{
-			const float targetHpFreq = juce::jlimit (kFilterFreqMin, kFilterFreqMax,
-				loadAtomicOrDefault (filterHpFreqParam, kFilterHpFreqDefault));
-			const float targetLpFreq = juce::jlimit (kFilterFreqMin, kFilterFreqMax,
-				loadAtomicOrDefault (filterLpFreqParam, kFilterLpFreqDefault));
-			const int hpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-				loadIntParamOrDefault (filterHpSlopeParam, kFilterSlopeDefault));
-			const int lpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-				loadIntParamOrDefault (filterLpSlopeParam, kFilterSlopeDefault));
-
-			const int numSections_hp = (hpSlope == 2) ? 2 : 1;
-			const int numSections_lp = (lpSlope == 2) ? 2 : 1;
-
-			for (int ch = 0; ch < numChannels; ++ch)
-			{
-				float* wet = buffer.getWritePointer (ch);
-				auto& fs = wetFilterState_[ch < 2 ? ch : 0];
+void DisperserAudioProcessor::storeMorphSlotsInState()
+{
+	static const juce::Identifier morphSlotsType ("MORPH_SLOTS");
+	static const juce::Identifier slotType ("SLOT");
 
-				for (int n = 0; n < numSamples; ++n)
-				{
-					if (ch == 0)
-					{
-						smoothedFilterHpFreq_ = smoothedFilterHpFreq_ * kGainSmoothCoeff
-							+ targetHpFreq * (1.0f - kGainSmoothCoeff);
-						smoothedFilterLpFreq_ = smoothedFilterLpFreq_ * kGainSmoothCoeff
-							+ targetLpFreq * (1.0f - kGainSmoothCoeff);
-
-						if (chaosFilterEnabled_) advanceChaosF();
-
-						--filterCoeffCountdown_;
-						if (filterCoeffCountdown_ <= 0)
-						{
-							filterCoeffCountdown_ = kFilterCoeffUpdateInterval;
-							if (chaosFilterEnabled_ && chaosAmtF_ > 0.01f)
-							{
-								const float sHp = smoothedFilterHpFreq_;
-								const float sLp = smoothedFilterLpFreq_;
-								const float hpBase = hpOn ? sHp : kFilterFreqMin;
-								const float lpBase = lpOn ? sLp : kFilterFreqMax;
-
-								// L channel coefficients
-								const float octL = chaosFOut_[0] * smoothedChaosFilterMaxOct_;
-								const float multL = std::exp2 (octL);
-								smoothedFilterHpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, hpBase * multL);
-								smoothedFilterLpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, lpBase * multL);
-								updateFilterCoeffs (true, true);
-
-								if (chaosStereo_)
-								{
-									auto hpL0 = hpCoeffs_[0]; auto hpL1 = hpCoeffs_[1];
-									auto lpL0 = lpCoeffs_[0]; auto lpL1 = lpCoeffs_[1];
-
-									const float octR = chaosFOut_[1] * smoothedChaosFilterMaxOct_;
-									const float multR = std::exp2 (octR);
-									smoothedFilterHpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, hpBase * multR);
-									smoothedFilterLpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, lpBase * multR);
-									updateFilterCoeffs (true, true);
-
-									hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-									lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-									hpCoeffs_[0] = hpL0; hpCoeffs_[1] = hpL1;
-									lpCoeffs_[0] = lpL0; lpCoeffs_[1] = lpL1;
-								}
-								else
-								{
-									hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-									lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-								}
-
-								smoothedFilterHpFreq_ = sHp;
-								smoothedFilterLpFreq_ = sLp;
-							}
-							else
-							{
-								updateFilterCoeffs (false, false);
-								hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-								lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-							}
-						}
-					}
-
-					float x = wet[n];
-					const auto& hpC = (ch == 0) ? hpCoeffs_ : hpCoeffsR_;
-					const auto& lpC = (ch == 0) ? lpCoeffs_ : lpCoeffsR_;
-
-					if (hpOn)
-						for (int s = 0; s < numSections_hp; ++s)
-							x = processBiquad (hpC[s], fs.hp[s], x);
-
-					if (lpOn)
-						for (int s = 0; s < numSections_lp; ++s)
-							x = processBiquad (lpC[s], fs.lp[s], x);
-
-					wet[n] = x;
-				}
-			}
-		}
-		else if (chaosFilterEnabled_)
-		{
-			for (int n = 0; n < numSamples; ++n)
-			{
-				advanceChaosF();
-			}
-		}
-	}
+	auto existing = apvts.state.getChildWithName (morphSlotsType);
+	if (existing.isValid())
+		apvts.state.removeChild (existing, nullptr);
 
-	// ── TILT filter lambda (1-pole shelving, pivot 1 kHz) ──
-	auto applyTilt = [&]()
+	juce::ValueTree slots (morphSlotsType);
+	const auto& params = getParameters();
+	for (int s = 0; s < 2; ++s)
 	{
-		if (std::abs (tiltDb_) > 0.05f)
-		{
-			if (std::abs (tiltDb_ - lastTiltDb_) > 0.02f)
-			{
-				lastTiltDb_ = tiltDb_;
-				const double pivot = 1000.0;
-				const double octToNy = std::log2 ((currentSampleRate * 0.5) / pivot);
-				const double gainNyDb = static_cast<double> (tiltDb_) * octToNy;
-				const double gNy = std::pow (10.0, gainNyDb / 20.0);
-				const double wc = 2.0 * currentSampleRate
-				                * std::tan (juce::MathConstants<double>::pi * pivot / currentSampleRate);
-				const double K = wc / (2.0 * currentSampleRate);
-				const double g = std::sqrt (gNy);
-				const double norm = 1.0 / (1.0 + K * g);
-				tiltTargetB0_ = static_cast<float> ((g + K) * norm);
-				tiltTargetB1_ = static_cast<float> ((K - g) * norm);
-				tiltTargetA1_ = static_cast<float> ((K * g - 1.0) * norm);
-			}
-
-			const float sc = tiltSmoothSc_;
-			tiltB0_ += (tiltTargetB0_ - tiltB0_) * sc;
-			tiltB1_ += (tiltTargetB1_ - tiltB1_) * sc;
-			tiltA1_ += (tiltTargetA1_ - tiltA1_) * sc;
+		if (! hasMorphSlot (s))
+			continue;
+
+		juce::ValueTree slot (slotType);
+		slot.setProperty ("index", s, nullptr);
+		for (const auto& t : morphTargets)
+			if (auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (params[t.paramIndex]))
+				slot.setProperty (ranged->paramID, morphSlots[(size_t) s][(size_t) t.paramIndex].load (std::memory_order_relaxed), nullptr);
+		slots.appendChild (slot, nullptr);
+	}
 
-			for (int ch = 0; ch < juce::jmin (numChannels, 2); ++ch)
-			{
-				float* data = buffer.getWritePointer (ch);
-				for (int n = 0; n < numSamples; ++n)
-				{
-					const float x = data[n];
-					const float y = tiltB0_ * x + tiltState_[ch];
-					tiltState_[ch] = tiltB1_ * x - tiltA1_ * y;
-					data[n] = y;
-				}
-			}
-		}
-		else if (std::abs (lastTiltDb_) > 0.05f)
-		{
-			lastTiltDb_ = 0.0f;
-			tiltB0_ = 1.0f; tiltB1_ = 0.0f; tiltA1_ = 0.0f;
-			tiltTargetB0_ = 1.0f; tiltTargetB1_ = 0.0f; tiltTargetA1_ = 0.0f;
-			tiltState_[0] = tiltState_[1] = 0.0f;
-		}
-	};
+	apvts.state.appendChild (slots, nullptr);
+}
 
-	if (tiltPre_) applyTilt();
+void DisperserAudioProcessor::restoreMorphSlotsFromState()
+{
+	for (auto& v : morphSlotValid)
+		v.store (false, std::memory_order_release);
 
-	const bool freqConverged = std::abs (smoothedFreqValue - targetFreq) < 0.01f;
+	const auto slots = apvts.state.getChildWithName ("MORPH_SLOTS");
+	const auto& params = getParameters();
 
-	// Fast path: parameters converged + no crossfade → tight inner loop
-	// without per-sample smoothing, coefficient checks, or fractional stages.
-	// Chaos D forces slow path because it needs per-sample coefficient modulation.
-	if (!crossfading
-		&& !stagesSmoothed.isSmoothing()
-		&& freqConverged
-		&& !shapeSmoothed.isSmoothing()
-		&& !feedbackSmoothed.isSmoothing()
-		&& !chaosDelayEnabled_)
+	for (const auto& slot : slots)
 	{
-		smoothedFreqValue = targetFreq;   // snap EMA to avoid drift
-		const int stgs = activeStages;
-		const float fb = feedbackSmoothed.getCurrentValue();
+		const int s = (int) slot.getProperty ("index", -1);
+		if (s < 0 || s > 1)
+			continue;
 
-		// DUAL: update R coefficients for fast path
-		if (dualCoeffR && stgs > 0)
+		for (const auto& t : morphTargets)
 		{
-			const float freqR = targetFreq * 0.5f;
-			if (std::abs (freqR - lastCoeffFreqR) > 0.001f || lastCoeffStages != stgs)
-			{
-				updateCoefficientsInto (freqR, targetShape, stgs, stageCoeffR);
-				lastCoeffFreqR = freqR;
-			}
+			auto* p = params[t.paramIndex];
+			auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p);
+			const auto v = ranged != nullptr ? slot.getProperty (ranged->paramID) : juce::var();
+			// Params missing from an older slot keep their current value.
+			morphSlots[(size_t) s][(size_t) t.paramIndex].store (v.isVoid() ? p->getValue() : (float) v,
+																 std::memory_order_relaxed);
 		}
 
-		if (stgs > 0)
-		{
-			for (int n = 0; n < numSamples; ++n)
-			{
-				// Feedback routing: cross for WIDE, independent otherwise
-				float xL = ch0[n] + fb * (crossFbk ? feedbackLastR : feedbackLastL);
-				float xR = processR ? (ch1[n] + fb * (crossFbk ? feedbackLastL : feedbackLastR)) : xL;
-
-				for (int s = 0; s < activeSeries; ++s)
-				{
-					auto* lS = chainL[(size_t) s].data();
-					auto* rS = chainR[(size_t) s].data();
-
-					for (int st = 0; st < stgs; ++st)
-					{
-						const float aRaw = stageCoeff[(size_t) st];
-						const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
-
-						auto& sl = lS[st];
-						const float yL = (-a * xL) + sl.z1;
-						sl.z1 = xL + (a * yL);
-						xL = yL;
-
-						if (processR)
-						{
-							// WIDE: -a (complementary phase), DUAL: separate coeffs, STEREO: same a
-							const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
-							auto& sr = rS[st];
-							const float yR = (-aR * xR) + sr.z1;
-							sr.z1 = xR + (aR * yR);
-							xR = yR;
-						}
-					}
-				}
-
-				ch0[n] = xL;
-				feedbackLastL = xL;
-				if (hasStereo)
-				{
-					ch1[n] = processR ? xR : xL;
-					feedbackLastR = processR ? xR : xL;
-				}
-			}
-		}
+		morphSlotValid[(size_t) s].store (true, std::memory_order_release);
+	}
 
+	// Sessions from before the blend moved into the engine stored the
+	// morphed values in the parameters themselves: hold everything.
+	const auto heldState = apvts.state.getProperty (kMorphHeldKey);
+	if (heldState.isVoid())
+	{
+		holdAllMorphTargets();
 	}
 	else
 	{
-	// Slow path: smoothing active or crossfade in progress
-	for (int n = 0; n < numSamples; ++n)
-	{
-		const float smoothedStages = juce::jlimit (0.0f, (float) kAmountMax, stagesSmoothed.getNextValue());
-		smoothedFreqValue += (targetFreq - smoothedFreqValue) * (1.0f - freqEmaCoeff);
-		float smoothedFreq = smoothedFreqValue;
-		const float smoothedShape = shapeSmoothed.getNextValue();
-		const float fb = feedbackSmoothed.getNextValue();
-
-		// Chaos D: advance S&H and modulate allpass centre frequency
-		if (chaosDelayEnabled_)
-		{
-			advanceChaosD();
-			if (chaosAmtD_ > 0.01f)
-			{
-				const float oct = chaosDOut_[0] * smoothedChaosFreqMaxOct_;
-				smoothedFreq = juce::jlimit (20.0f, 20000.0f, smoothedFreq * std::exp2 (oct));
-			}
-		}
+		juce::StringArray held;
+		for (const auto& id : juce::StringArray::fromTokens (heldState.toString(), " ", {}))
+			held.add (getCurrentParamId (id));
 
-		const int baseStages = juce::jlimit (0, kAmountMax, (int) std::floor (smoothedStages));
-		const float stageFrac = juce::jlimit (0.0f, 1.0f, smoothedStages - (float) baseStages);
-		const bool useFractionalStage = (stageFrac > 0.0001f && baseStages < kAmountMax);
-		const int coeffStages = juce::jlimit (0, kAmountMax, baseStages + (useFractionalStage ? 1 : 0));
-
-		if (coeffStages > activeStages)
-			clearStageRange (activeStages, coeffStages, activeSeries);
-		activeStages = coeffStages;
+		for (const auto& t : morphTargets)
+			morphHeld[(size_t) t.paramIndex].store (held.contains (t.param->paramID), std::memory_order_relaxed);
+	}
 
-		if (coeffStages > 0)
-		{
-			// Batched coefficient update (every kCoeffUpdateInterval samples or on stage change)
-			--coeffUpdateCountdown;
-			if (coeffUpdateCountdown <= 0 || lastCoeffStages != coeffStages)
-			{
-				coeffUpdateCountdown = kCoeffUpdateInterval;
-				if (lastCoeffStages != coeffStages
-					|| std::abs (smoothedFreq - lastCoeffFreq) > 0.001f
-					|| std::abs (smoothedShape - lastCoeffShape) > 0.0002f)
-				{
-					updateCoefficients (smoothedFreq, smoothedShape, coeffStages);
-					lastCoeffStages = coeffStages;
-					lastCoeffFreq = smoothedFreq;
-					lastCoeffShape = smoothedShape;
-				}
-			}
+	morphResync.store (true, std::memory_order_release);
+}
 
-			// DUAL: update R coefficients in slow path
-			if (dualCoeffR)
-			{
-				const float freqR = smoothedFreq * 0.5f;
-				if (std::abs (freqR - lastCoeffFreqR) > 0.001f || lastCoeffStages != coeffStages)
-				{
-					updateCoefficientsInto (freqR, smoothedShape, coeffStages, stageCoeffR);
-					lastCoeffFreqR = freqR;
-				}
-			}
+void DisperserAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+	currentSampleRate = juce::jmax (1.0, sampleRate);
 
-			const float inputL = ch0[n] + fb * (crossFbk ? feedbackLastR : feedbackLastL);
-			const float inputR = processR ? (ch1[n] + fb * (crossFbk ? feedbackLastL : feedbackLastR)) : inputL;
+	// The audio callback is stopped: drop any ring handover in flight, since
+	// the ring size follows the sample rate.
+	delayArenaState.store (DelayArenaIdle, std::memory_order_relaxed);
+	std::vector<float>().swap (pendingDelayArena);
+	if (snapshotSlots == nullptr)
+		snapshotSlots = std::make_unique<std::array<SnapshotSlot, kNumSnapshotSlots>>();
+
+	// The cascade split follows this machine's kernel timings once measured.
+	auto& tuning = KernelTuning::get();
+	tuning.prepare();
+	engine.setCostProfile (&tuning.getProfile());
+	engineProfileMeasured = tuning.isMeasured();
+
+	engine.prepare (currentSampleRate, samplesPerBlock, makeEngineParams());
+	tailSeconds.store (DisperserEngine::estimateTailSeconds (makeEngineParams(), currentSampleRate),
+					   std::memory_order_relaxed);
+	tailEstimateDirty.store (false, std::memory_order_relaxed);
+	samplesSinceTailEstimate = 0;
+	dspIsa.store ((int) engine.getIsa(), std::memory_order_relaxed);
 
-			// Process through current (new) topology
-			float xL = inputL;
-			float xR = inputR;
+	// Reset MIDI note tracking
+	lastMidiNote.store (-1, std::memory_order_relaxed);
+	currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
 
-			for (int s = 0; s < activeSeries; ++s)
-			{
-				auto* lStages = chainL[(size_t) s].data();
-				auto* rStages = chainR[(size_t) s].data();
+	// Snapshots are only valid at the rate they were taken at (findSnapshot
+	// checks); the transport tracker starts over.
+	transportWasPlaying = false;
+	expectedNextSample = -1;
 
-				for (int st = 0; st < baseStages; ++st)
-				{
-					const float aRaw = stageCoeff[(size_t) st];
-					const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
-
-					auto& sl = lStages[st];
-					const float yL = (-a * xL) + sl.z1;
-					sl.z1 = xL + (a * yL);
-					xL = yL;
-
-					if (processR)
-					{
-						const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
-						auto& sr = rStages[st];
-						const float yR = (-aR * xR) + sr.z1;
-						sr.z1 = xR + (aR * yR);
-						xR = yR;
-					}
-				}
+	dspLog.enableDesktopAutoDump();
+	audioPrepared.store (true, std::memory_order_release);
+}
 
-				if (useFractionalStage)
-				{
-					const int st = baseStages;
-					const float aRaw = stageCoeff[(size_t) st];
-					const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
-
-					const float inL = xL;
-					auto& sl = lStages[st];
-					const float yL = (-a * inL) + sl.z1;
-					sl.z1 = inL + (a * yL);
-					xL = inL + (stageFrac * (yL - inL));
-
-					if (processR)
-					{
-						const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
-						const float inR = xR;
-						auto& sr = rStages[st];
-						const float yR = (-aR * inR) + sr.z1;
-						sr.z1 = inR + (aR * yR);
-						xR = inR + (stageFrac * (yR - inR));
-					}
-				}
-			}
+DisperserEngine::CostEstimate DisperserAudioProcessor::estimateDspCost (const DisperserEngine::Params& p) const noexcept
+{
+	const int numChannels = juce::jlimit (1, DisperserEngine::kMaxChannels, getTotalNumInputChannels());
+	return DisperserEngine::estimateCost (p, juce::jmax (1, getBlockSize()), numChannels, getDspIsa(),
+										  cost::kDefaultMaxErrorDb, KernelTuning::get().getProfile());
+}
 
-			// Series crossfade: blend old topology output during transition
-			if (crossfading && seriesXfadeSamplesRemaining > 0)
-			{
-				float xfL = inputL;
-				float xfR = inputR;
+MemoryReport DisperserAudioProcessor::getMemoryReport() const
+{
+	MemoryReport r;
+
+	// The debug ring is an inline member; report it on its own.
+	r.add (MemoryReport::ProcessorObject, sizeof (*this) - sizeof (dspLog));
+	r.add (MemoryReport::DebugLog, sizeof (dspLog));
+	r.add (MemoryReport::Analyzer, transferAnalyzer.getMemoryBytes());
+
+	const auto dsp = engine.getMemoryUsage();
+	r.add (MemoryReport::EngineCascade,   dsp.cascade);
+	r.add (MemoryReport::EngineCrossfade, dsp.crossfade);
+	r.add (MemoryReport::EngineDelay,     dsp.delay);
+	r.add (MemoryReport::EngineBuffers,   dsp.buffers);
+
+	if (snapshotSlots != nullptr)
+		r.add (MemoryReport::Snapshots, sizeof (*snapshotSlots));
+
+	// The bank itself is a read-only file mapping, shared through the page
+	// cache by every instance, so only the per-instance tables count here.
+	r.add (MemoryReport::Presets, MemoryReport::getCapacityBytes (presetParamMap)
+	                              + MemoryReport::getCapacityBytes (morphTargets));
+	for (const auto& slot : presetSlots)
+		r.add (MemoryReport::Presets, MemoryReport::getCapacityBytes (slot.values));
+	for (const auto& slot : morphSlots)
+		if (slot != nullptr)
+			r.add (MemoryReport::Presets, (size_t) getParameters().size() * sizeof (std::atomic<float>));
+	r.add (MemoryReport::Presets, (size_t) getParameters().size() * sizeof (std::atomic<bool>));
 
-				for (int s = 0; s < previousSeries; ++s)
-				{
-					auto* lStages = xfadeChainL[(size_t) s].data();
-					auto* rStages = xfadeChainR[(size_t) s].data();
-
-					for (int st = 0; st < baseStages; ++st)
-					{
-						const float aRaw = stageCoeff[(size_t) st];
-						const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
-
-						auto& sl = lStages[st];
-						const float yL = (-a * xfL) + sl.z1;
-						sl.z1 = xfL + (a * yL);
-						xfL = yL;
-
-						if (processR)
-						{
-							const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
-							auto& sr = rStages[st];
-							const float yR = (-aR * xfR) + sr.z1;
-							sr.z1 = xfR + (aR * yR);
-							xfR = yR;
-						}
-					}
-
-					if (useFractionalStage)
-					{
-						const int st = baseStages;
-						const float aRaw = stageCoeff[(size_t) st];
-						const float a = (altEnabled && (st & 1)) ? -aRaw : aRaw;
-
-						const float inL = xfL;
-						auto& sl = lStages[st];
-						const float yL = (-a * inL) + sl.z1;
-						sl.z1 = inL + (a * yL);
-						xfL = inL + (stageFrac * (yL - inL));
-
-						if (processR)
-						{
-							const float aR = negateCoeffR ? -a : (dualCoeffR ? ((altEnabled && (st & 1)) ? -stageCoeffR[(size_t) st] : stageCoeffR[(size_t) st]) : a);
-							const float inR = xfR;
-							auto& sr = rStages[st];
-							const float yR = (-aR * inR) + sr.z1;
-							sr.z1 = inR + (aR * yR);
-							xfR = inR + (stageFrac * (yR - inR));
-						}
-					}
-				}
+	{
+		const juce::ScopedLock sl (cachedStateLock);
+		r.add (MemoryReport::StateCache, cachedState.getSize());
+	}
 
-				const float alpha = (float) seriesXfadeSamplesRemaining / (float) seriesXfadeTotalSamples;
-				xL += alpha * (xfL - xL);
-				xR += alpha * (xfR - xR);
-				--seriesXfadeSamplesRemaining;
-			}
+	if (auto* editor = dynamic_cast<DisperserAudioProcessorEditor*> (getActiveEditor()))
+		editor->addMemoryUsage (r);
 
-			ch0[n] = xL;
-			feedbackLastL = xL;
-			if (hasStereo)
-			{
-				ch1[n] = processR ? xR : xL;
-				feedbackLastR = processR ? xR : xL;
-			}
-		}
+	return r;
+}
 
-		// Chaos D gain modulation (per-channel, applied per-sample after allpass)
-		if (chaosDelayEnabled_ && chaosAmtD_ > 0.01f)
-		{
-			{
-				const float gainDb  = chaosGOut_[0] * smoothedChaosGainMaxDb_;
-				const float ex = gainDb * 0.16609640474f;
-				const float exln2 = ex * 0.6931472f;
-				const float gainLin = 1.0f + exln2 * (1.0f + exln2 * 0.5f);
-				ch0[n] *= gainLin;
-			}
-			if (hasStereo)
-			{
-				const float gainDb  = chaosGOut_[1] * smoothedChaosGainMaxDb_;
-				const float ex = gainDb * 0.16609640474f;
-				const float exln2 = ex * 0.6931472f;
-				const float gainLin = 1.0f + exln2 * (1.0f + exln2 * 0.5f);
-				ch1[n] *= gainLin;
-			}
-		}
-	}
-	} // end else (slow path)
+DisperserEngine::Params DisperserAudioProcessor::makeEngineParams() const noexcept
+{
+	// Morph targets read through the A/B blend.
+	auto loadFloat = [this] (std::atomic<float>* raw, float def) noexcept { return loadEngineParam (raw, def); };
+	auto loadInt   = [&] (std::atomic<float>* raw, int def) noexcept { return (int) std::lround (loadFloat (raw, (float) def)); };
+	auto loadBool  = [&] (std::atomic<float>* raw, bool def) noexcept { return loadFloat (raw, def ? 1.0f : 0.0f) > 0.5f; };
 
-	// (ALT coefficient alternation is applied inside the allpass loops)
+	DisperserEngine::Params p;
+	p.stages   = juce::jlimit (kAmountMin, kAmountMax, loadInt (amountParam, kAmountDefault));
+	p.series   = juce::jlimit (kSeriesMin, kSeriesMax, loadInt (seriesParam, kSeriesDefault));
+	p.freqHz   = loadFloat (freqParam, kFreqDefault);
+	p.shape    = juce::jlimit (0.0f, 1.0f, loadFloat (shapeParam, kShapeDefault));
 
-	// ── Wet-signal HP/LP filter (POST position — only runs if !filterPre_) ──
-	if (! filterPre_)
-	{
-		const bool hpOn = loadBoolParamOrDefault (filterHpOnParam, false);
-		const bool lpOn = loadBoolParamOrDefault (filterLpOnParam, false);
+	// Debug overrides preserved.
+	if (loadBool (s0Param, false))
+		p.shape = 0.0f;
+	if (loadBool (s100Param, false))
+		p.shape = 1.0f;
 
-		if (hpOn || lpOn)
-		{
-			const float targetHpFreq = juce::jlimit (kFilterFreqMin, kFilterFreqMax,
-				loadAtomicOrDefault (filterHpFreqParam, kFilterHpFreqDefault));
-			const float targetLpFreq = juce::jlimit (kFilterFreqMin, kFilterFreqMax,
-				loadAtomicOrDefault (filterLpFreqParam, kFilterLpFreqDefault));
-			const int hpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-				loadIntParamOrDefault (filterHpSlopeParam, kFilterSlopeDefault));
-			const int lpSlope = juce::jlimit (kFilterSlopeMin, kFilterSlopeMax,
-				loadIntParamOrDefault (filterLpSlopeParam, kFilterSlopeDefault));
-
-			const int numSections_hp = (hpSlope == 2) ? 2 : 1;
-			const int numSections_lp = (lpSlope == 2) ? 2 : 1;
-
-			for (int ch = 0; ch < numChannels; ++ch)
-			{
-				float* wet = buffer.getWritePointer (ch);
-				auto& fs = wetFilterState_[ch < 2 ? ch : 0];
+	p.alt      = loadBool (altParam, false);
+	p.feedback = juce::jlimit (kFeedbackMin, kFeedbackMax, loadFloat (feedbackParam, kFeedbackDefault));
+	p.mod      = loadFloat (modParam, kModDefault);
+	p.stageType = loadInt (stageTypeParam, kStageTypeDefault);
 
-				for (int n = 0; n < numSamples; ++n)
-				{
-					// Per-sample EMA smoothing on filter frequencies (only on channel 0)
-					if (ch == 0)
-					{
-						smoothedFilterHpFreq_ = smoothedFilterHpFreq_ * kGainSmoothCoeff
-							+ targetHpFreq * (1.0f - kGainSmoothCoeff);
-						smoothedFilterLpFreq_ = smoothedFilterLpFreq_ * kGainSmoothCoeff
-							+ targetLpFreq * (1.0f - kGainSmoothCoeff);
-
-						if (chaosFilterEnabled_) advanceChaosF();
-
-						--filterCoeffCountdown_;
-						if (filterCoeffCountdown_ <= 0)
-						{
-							filterCoeffCountdown_ = kFilterCoeffUpdateInterval;
-							if (chaosFilterEnabled_ && chaosAmtF_ > 0.01f)
-							{
-								const float sHp = smoothedFilterHpFreq_;
-								const float sLp = smoothedFilterLpFreq_;
-								const float hpBase = hpOn ? sHp : kFilterFreqMin;
-								const float lpBase = lpOn ? sLp : kFilterFreqMax;
-
-								// L channel coefficients
-								const float octL = chaosFOut_[0] * smoothedChaosFilterMaxOct_;
-								const float multL = std::exp2 (octL);
-								smoothedFilterHpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, hpBase * multL);
-								smoothedFilterLpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, lpBase * multL);
-								updateFilterCoeffs (true, true);
-
-								if (chaosStereo_)
-								{
-									auto hpL0 = hpCoeffs_[0]; auto hpL1 = hpCoeffs_[1];
-									auto lpL0 = lpCoeffs_[0]; auto lpL1 = lpCoeffs_[1];
-
-									const float octR = chaosFOut_[1] * smoothedChaosFilterMaxOct_;
-									const float multR = std::exp2 (octR);
-									smoothedFilterHpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, hpBase * multR);
-									smoothedFilterLpFreq_ = juce::jlimit (kFilterFreqMin, kFilterFreqMax, lpBase * multR);
-									updateFilterCoeffs (true, true);
-
-									hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-									lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-									hpCoeffs_[0] = hpL0; hpCoeffs_[1] = hpL1;
-									lpCoeffs_[0] = lpL0; lpCoeffs_[1] = lpL1;
-								}
-								else
-								{
-									hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-									lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-								}
-
-								smoothedFilterHpFreq_ = sHp;
-								smoothedFilterLpFreq_ = sLp;
-							}
-							else
-							{
-								updateFilterCoeffs (false, false);
-								hpCoeffsR_[0] = hpCoeffs_[0]; hpCoeffsR_[1] = hpCoeffs_[1];
-								lpCoeffsR_[0] = lpCoeffs_[0]; lpCoeffsR_[1] = lpCoeffs_[1];
-							}
-						}
-					}
-
-					float x = wet[n];
-					const auto& hpC = (ch == 0) ? hpCoeffs_ : hpCoeffsR_;
-					const auto& lpC = (ch == 0) ? lpCoeffs_ : lpCoeffsR_;
-
-					if (hpOn)
-						for (int s = 0; s < numSections_hp; ++s)
-							x = processBiquad (hpC[s], fs.hp[s], x);
-
-					if (lpOn)
-						for (int s = 0; s < numSections_lp; ++s)
-							x = processBiquad (lpC[s], fs.lp[s], x);
-
-					wet[n] = x;
-				}
-			}
-		}
-		else if (chaosFilterEnabled_)
-		{
-			// Filters off but chaos F enabled: advance S&H to keep phase continuous
-			for (int n = 0; n < numSamples; ++n)
-			{
-				advanceChaosF();
-			}
-		}
+	if (loadBool (midiParam, false) && lastMidiNote.load (std::memory_order_relaxed) >= 0)
+	{
+		p.midiFreqHz   = currentMidiFrequency.load (std::memory_order_relaxed);
+		p.midiVelocity = lastMidiVelocity.load (std::memory_order_relaxed);
 	}
 
-	// ── TILT filter (POST position) ──
-	if (!tiltPre_) applyTilt();
+	p.inputDb   = juce::jlimit (kInputMin,  kInputMax,  loadFloat (inputParam,  kInputDefault));
+	p.outputDb  = juce::jlimit (kOutputMin, kOutputMax, loadFloat (outputParam, kOutputDefault));
+	p.mix       = juce::jlimit (kMixMin, kMixMax, loadFloat (mixParam, kMixDefault));
+	p.mixMode   = loadInt (mixModeParam, kMixModeDefault);
+	p.dryLevel  = loadFloat (dryLevelParam, kDryLevelDefault);
+	p.wetLevel  = loadFloat (wetLevelParam, kWetLevelDefault);
+	p.tiltDb    = loadFloat (tiltParam, kTiltDefault);
+	p.pan       = loadFloat (panParam, kPanDefault);
+	p.style     = juce::jlimit (kStyleMin, kStyleMax, loadInt (styleParam, (int) kStyleDefault));
+	p.filterPos = loadInt (filterPosParam, kFilterPosDefault);
+
+	p.hpOn    = loadBool (filterHpOnParam, false);
+	p.lpOn    = loadBool (filterLpOnParam, false);
+	p.hpFreq  = loadFloat (filterHpFreqParam, kFilterHpFreqDefault);
+	p.lpFreq  = loadFloat (filterLpFreqParam, kFilterLpFreqDefault);
+	p.hpSlope = loadInt (filterHpSlopeParam, kFilterSlopeDefault);
+	p.lpSlope = loadInt (filterLpSlopeParam, kFilterSlopeDefault);
+
+	p.chaosFilter = loadBool (chaosParam, false);
+	p.chaosDelay  = loadBool (chaosDelayParam, false);
+	p.chaosAmtD   = loadFloat (chaosAmtParam, kChaosAmtDefault);
+	p.chaosSpdD   = loadFloat (chaosSpdParam, kChaosSpdDefault);
+	p.chaosAmtF   = loadFloat (chaosAmtFilterParam, kChaosAmtDefault);
+	p.chaosSpdF   = loadFloat (chaosSpdFilterParam, kChaosSpdDefault);
+
+	p.modeIn  = loadInt (modeInParam, kModeInOutDefault);
+	p.modeOut = loadInt (modeOutParam, kModeInOutDefault);
+	p.sumBus  = loadInt (sumBusParam, kSumBusDefault);
+	p.invPol  = loadInt (invPolParam, kInvPolDefault);
+	p.invStr  = loadInt (invStrParam, kInvStrDefault);
+	p.limThresholdDb = loadFloat (limThresholdParam, kLimThresholdDefault);
+	p.limMode = loadInt (limModeParam, kLimModeDefault);
+
+	auto& mm = p.modMatrix;
+	for (int i = 0; i < ModMatrix::kNumLfos; ++i)
+	{
+		const auto& src = lfoParams[(size_t) i];
+		auto& lfo = mm.lfo[(size_t) i];
+		lfo.shape     = loadInt (src.shape, ModMatrix::LfoSine);
+		lfo.rateHz    = loadFloat (src.rate, kLfoRateDefault);
+		lfo.sync      = loadBool (src.sync, false);
+		lfo.syncBeats = kLfoDivisionBeats[(size_t) juce::jlimit (0, (int) kLfoDivisionBeats.size() - 1,
+			loadInt (src.division, kLfoDivisionDefault))];
+	}
+	for (int i = 0; i < ModMatrix::kMaxRoutes; ++i)
+	{
+		const auto& src = routeParams[(size_t) i];
+		auto& route = mm.routes[(size_t) i];
+		route.source = loadInt (src.source, ModMatrix::SourceNone);
+		route.target = loadInt (src.target, ModMatrix::TargetFreq);
+		route.depth  = loadFloat (src.depth, 0.0f);
+	}
+	mm.envAttackMs  = loadFloat (envAttackParam, kEnvAttackDefault);
+	mm.envReleaseMs = loadFloat (envReleaseParam, kEnvReleaseDefault);
+	mm.randomRateHz = loadFloat (rndRateParam, kRndRateDefault);
+	mm.randomGlide  = loadFloat (rndGlideParam, kRndGlideDefault);
+	mm.bpm = hostBpm;
+	mm.ppq = hostPpq;
+	return p;
+}
 
-	// ── Mode Out: M/S decode wet signal ──
-	if (modeOutVal > 0 && numChannels >= 2)
+//==============================================================================
+juce::uint64 DisperserAudioProcessor::getSoundSettingsHash() const noexcept
+{
+	// FNV-1a over the values the engine runs on.
+	juce::uint64 h = 14695981039346656037ull;
+	for (const auto& t : morphTargets)
 	{
-		float* wL = buffer.getWritePointer (0);
-		float* wR = buffer.getWritePointer (1);
-		for (int n = 0; n < numSamples; ++n)
-		{
-			const float L = wL[n];
-			const float R = wR[n];
-			const float M = (L + R) * kSqrt2Over2;
-			const float S = (L - R) * kSqrt2Over2;
-			if (modeOutVal == 1) { wL[n] = M; wR[n] = M; }
-			else                 { wL[n] = S; wR[n] = S; }
-		}
+		const float v = getMorphedValue (t);
+		juce::uint32 bits;
+		std::memcpy (&bits, &v, sizeof (bits));
+		h = (h ^ bits) * 1099511628211ull;
 	}
+	return h;
+}
 
-	// ── Limiter (WET mode: after effect + Mode Out, before mix) ──
+DisperserAudioProcessor::SnapshotSlot* DisperserAudioProcessor::findSnapshot (SnapshotKey type, juce::int64 key) noexcept
+{
+	for (auto& slot : *snapshotSlots)
 	{
-		const int limMode = loadIntParamOrDefault (limModeParam, kLimModeDefault);
-		if (limMode == 1)
+		if (slot.keyType == type && slot.key == key && slot.sampleRate == currentSampleRate)
 		{
-			const float limThreshDb = loadAtomicOrDefault (limThresholdParam, kLimThresholdDefault);
-			const float limThreshLin = fastDecibelsToGain (limThreshDb);
-			auto* chL = buffer.getWritePointer (0);
-			auto* chR = (numChannels >= 2) ? buffer.getWritePointer (1) : chL;
-			for (int i = 0; i < numSamples; ++i)
-				applyLimiter (chL[i], chR[i], limThreshLin);
+			slot.lastUsed = ++snapshotClock;
+			return &slot;
 		}
 	}
+	return nullptr;
+}
 
-	// ── Invert Polarity / Stereo (WET mode: after Limiter WET, before mix) ──
+DisperserAudioProcessor::SnapshotSlot& DisperserAudioProcessor::allocateSnapshot (SnapshotKey type, juce::int64 key) noexcept
+{
+	// Free slot first, otherwise evict the least recently used.
+	auto* victim = &(*snapshotSlots)[0];
+	for (auto& slot : *snapshotSlots)
 	{
-		const int invPol = loadIntParamOrDefault (invPolParam, kInvPolDefault);
-		const int invStr = loadIntParamOrDefault (invStrParam, kInvStrDefault);
-		if (invPol == 1)
-			for (int ch = 0; ch < numChannels; ++ch)
-				juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch), -1.0f, numSamples);
-		if (invStr == 1 && numChannels >= 2)
+		if (slot.keyType == SnapshotKey::None)
 		{
-			float* sL = buffer.getWritePointer (0);
-			float* sR = buffer.getWritePointer (1);
-			for (int n = 0; n < numSamples; ++n)
-				std::swap (sL[n], sR[n]);
+			victim = &slot;
+			break;
 		}
+		if (slot.lastUsed < victim->lastUsed)
+			victim = &slot;
 	}
 
-	// ── Per-sample smoothed Input/Output/Mix + Dry/Wet blend (fused loop) ──
-	// Compute dry/wet gain targets based on mix mode
-	float dryGainTarget, wetGainTarget;
-	if (mixMode == 0) // INSERT: classic crossfade
-	{
-		dryGainTarget = 1.0f - mixValue;
-		wetGainTarget = mixValue;
-	}
-	else // SEND: independent dry + wet levels
+	victim->keyType    = type;
+	victim->key        = key;
+	victim->sampleRate = currentSampleRate;
+	victim->lastUsed   = ++snapshotClock;
+	return *victim;
+}
+
+void DisperserAudioProcessor::handleTransportSnapshots (int numSamples) noexcept
+{
+	auto* playHead = getPlayHead();
+	if (playHead == nullptr)
+		return;
+
+	const auto pos = playHead->getPosition();
+	const auto time = pos.hasValue() ? pos->getTimeInSamples() : juce::Optional<juce::int64>();
+
+	if (! pos.hasValue() || ! pos->getIsPlaying() || ! time.hasValue())
 	{
-		dryGainTarget = dryLevel;
-		wetGainTarget = wetLevel;
+		transportWasPlaying = false;
+		expectedNextSample = -1;
+		return;
 	}
 
-	if (needsDryBlend)
+	const juce::int64 now = *time;
+	const bool discontinuity = ! transportWasPlaying || now != expectedNextSample;
+
+	// Only a loop wrap while playing: on a transport start the user expects
+	// the tail of whatever played before, not the state of an earlier pass.
+	if (discontinuity && transportWasPlaying && pos->getIsLooping())
 	{
-		if (sumBusVal == 0 || numChannels < 2)
+		// Later passes resume from the same state every time, as long as the
+		// settings are the ones it was taken under. After an edit the state
+		// at the wrap is the new natural tail: take that instead.
+		const auto settings = getSoundSettingsHash();
+		auto* slot = findSnapshot (SnapshotKey::TransportPosition, now);
+		if (slot != nullptr && slot->settings == settings)
 		{
-			// ST (stereo passthrough)
-			for (int ch = 0; ch < juce::jmin (numChannels, dryBuffer.getNumChannels()); ++ch)
-			{
-				const float* dry = dryBuffer.getReadPointer (ch);
-				float* wet = buffer.getWritePointer (ch);
-				for (int n = 0; n < numSamples; ++n)
-				{
-					smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
-					smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
-					smoothedMix        = smoothedMix        * kGainSmoothCoeff + mixValue   * (1.0f - kGainSmoothCoeff);
-
-					const float dryS = dry[n];
-					const float wetS = wet[n] * smoothedInputGain * smoothedOutputGain;
-					if (mixMode == 0)
-						wet[n] = dryS + smoothedMix * (wetS - dryS);
-					else
-						wet[n] = dryS * dryGainTarget + wetS * wetGainTarget;
-				}
-			}
+			engine.restoreState (slot->state);
 		}
 		else
 		{
-			// →M or →S bus: dry preserves stereo image, only wet goes through bus
-			const float* dryL = dryBuffer.getReadPointer (0);
-			const float* dryR = dryBuffer.getReadPointer (1);
-			float* outL = buffer.getWritePointer (0);
-			float* outR = buffer.getWritePointer (1);
-			for (int n = 0; n < numSamples; ++n)
-			{
-				smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
-				smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
-				smoothedMix        = smoothedMix        * kGainSmoothCoeff + mixValue   * (1.0f - kGainSmoothCoeff);
-
-				const float dG = (mixMode == 0) ? (1.0f - smoothedMix) : dryGainTarget;
-				const float wG = (mixMode == 0) ? smoothedMix : wetGainTarget;
-				const float dL = dryL[n] * dG;
-				const float dR = dryR[n] * dG;
-				const float wL = outL[n] * smoothedInputGain * smoothedOutputGain * wG;
-				const float wR = outR[n] * smoothedInputGain * smoothedOutputGain * wG;
-
-				if (sumBusVal == 1) // →M
-				{
-					const float midBus = (wL + wR) * 0.5f;
-					outL[n] = dL + midBus;
-					outR[n] = dR + midBus;
-				}
-				else // →S
-				{
-					const float sideBus = (wL - wR) * 0.5f;
-					outL[n] = dL + sideBus;
-					outR[n] = dR - sideBus;
-				}
-			}
+			auto& dest = slot != nullptr ? *slot : allocateSnapshot (SnapshotKey::TransportPosition, now);
+			engine.captureState (dest.state);
+			dest.settings = settings;
 		}
 	}
-	else
+
+	transportWasPlaying = true;
+	expectedNextSample = now + numSamples;
+}
+
+void DisperserAudioProcessor::updateHostTransport() noexcept
+{
+	hostPpq = -1.0;
+
+	auto* playHead = getPlayHead();
+	if (playHead == nullptr)
+		return;
+
+	const auto pos = playHead->getPosition();
+	if (! pos.hasValue())
+		return;
+
+	if (const auto bpm = pos->getBpm())
+		hostBpm = *bpm;
+	if (pos->getIsPlaying())
+		if (const auto ppq = pos->getPpqPosition())
+			hostPpq = *ppq;
+}
+
+void DisperserAudioProcessor::releaseResources()
+{
+	audioPrepared.store (false, std::memory_order_release);
+	engine.release();
+	delayArenaState.store (DelayArenaIdle, std::memory_order_relaxed);
+	std::vector<float>().swap (pendingDelayArena);
+}
+
+#if ! JucePlugin_PreferredChannelConfigurations
+bool DisperserAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+	const auto in = layouts.getMainInputChannelSet();
+	const auto out = layouts.getMainOutputChannelSet();
+	if (in != out)
+		return false;
+	return (out == juce::AudioChannelSet::mono() || out == juce::AudioChannelSet::stereo());
+}
+#endif
+
+void DisperserAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+	processBlockWithParamChanges (buffer, midi, nullptr, 0);
+}
+
+void DisperserAudioProcessor::processBlockWithParamChanges (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi,
+															 const ParamChange* changes, int numChanges)
+{
+	juce::ScopedNoDenormals noDenormals;
+	PERF_TRACE_ZONE (&perfTrace, AudioBlock);
+	const auto blockStartTicks = juce::Time::getHighResolutionTicks();
+
+	applyPendingPreset();
+	updateMorphHolds();
+	adoptPendingDelayArena();
+	if (! engineProfileMeasured && KernelTuning::get().isMeasured())
 	{
-		// Full wet — apply input * output gain
-		for (int ch = 0; ch < numChannels; ++ch)
-		{
-			float* data = buffer.getWritePointer (ch);
-			for (int n = 0; n < numSamples; ++n)
-			{
-				smoothedInputGain  = smoothedInputGain  * kGainSmoothCoeff + inputGain  * (1.0f - kGainSmoothCoeff);
-				smoothedOutputGain = smoothedOutputGain * kGainSmoothCoeff + outputGain * (1.0f - kGainSmoothCoeff);
-				data[n] = data[n] * smoothedInputGain * smoothedOutputGain;
-			}
-		}
+		engine.setCostProfile (&KernelTuning::get().getProfile());
+		engineProfileMeasured = true;
 	}
+	handleTransportSnapshots (buffer.getNumSamples());
+	updateHostTransport();
+
+	const int numSamples = buffer.getNumSamples();
+	const int numChannels = buffer.getNumChannels();
+	if (numSamples <= 0 || numChannels <= 0)
+		return;
+
+	for (int ch = getTotalNumInputChannels(); ch < getTotalNumOutputChannels(); ++ch)
+		buffer.clear (ch, 0, numSamples);
+
+	const bool analyzerCapturing = transferAnalyzer.beginCapture (buffer.getReadPointer (0), numSamples);
+
+	// ── MIDI event scheduling ────────────────────────────────
+	// The block is split only where a note actually retunes the filter, so the
+	// new frequency lands on the event's sample. Cost scales with the number of
+	// relevant events; a block without any runs as a single segment. Timed
+	// parameter changes split it the same way.
+	const bool midiEnabled = loadBoolParamOrDefault (midiParam, false);
+	if (! midiEnabled && lastMidiNote.load (std::memory_order_relaxed) >= 0)
 	{
-		constexpr float kSnapEpsilon = 1e-5f;
-		if (std::abs (smoothedInputGain  - inputGain)  < kSnapEpsilon) smoothedInputGain  = inputGain;
-		if (std::abs (smoothedOutputGain - outputGain) < kSnapEpsilon) smoothedOutputGain = outputGain;
-		if (std::abs (smoothedMix        - mixValue)   < kSnapEpsilon) smoothedMix        = mixValue;
+		lastMidiNote.store (-1, std::memory_order_relaxed);
+		currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
 	}
 
-	// ── Pan (equal-power, stereo only) ──
-	if (numChannels >= 2)
+	int segmentStart = 0;
+	int changeIndex = 0;
+	const auto& params = getParameters();
+
+	// Runs the engine up to `pos`, applying the parameter changes on the way.
+	auto renderTo = [&] (int pos)
 	{
-		const float pan = panParam->load();
-		if (std::abs (pan - lastPan_) > 0.001f)
+		for (; changeIndex < numChanges; ++changeIndex)
 		{
-			lastPan_ = pan;
-			const float angle = pan * 1.5707963f; // π/2
-			lastPanLeft_  = std::cos (angle);
-			lastPanRight_ = std::sin (angle);
+			const auto& c = changes[changeIndex];
+			const int at = juce::jlimit (segmentStart, numSamples, c.sample);
+			if (at > pos)
+				break;
+
+			if (at > segmentStart)
+			{
+				processSegment (buffer, segmentStart, at - segmentStart);
+				segmentStart = at;
+			}
+
+			// Same sequence as the plugin wrappers' own automation.
+			if (juce::isPositiveAndBelow (c.paramIndex, params.size()) && params[c.paramIndex]->getValue() != c.value)
+			{
+				params[c.paramIndex]->setValue (c.value);
+				params[c.paramIndex]->sendValueChangedMessageToListeners (c.value);
+				updateMorphHolds();
+			}
 		}
-		if (std::abs (lastPan_ - 0.5f) > 0.001f)
+
+		if (pos > segmentStart)
 		{
-			juce::FloatVectorOperations::multiply (buffer.getWritePointer (0), lastPanLeft_,  numSamples);
-			juce::FloatVectorOperations::multiply (buffer.getWritePointer (1), lastPanRight_, numSamples);
+			processSegment (buffer, segmentStart, pos - segmentStart);
+			segmentStart = pos;
 		}
-	}
+	};
 
-	// ── Limiter (GLOBAL mode: after pan, before safety clip) ──
+	if (midiEnabled && ! midi.isEmpty())
 	{
-		const int limMode = loadIntParamOrDefault (limModeParam, kLimModeDefault);
-		if (limMode == 2)
+		for (const auto metadata : midi)
 		{
-			const float limThreshDb = loadAtomicOrDefault (limThresholdParam, kLimThresholdDefault);
-			const float limThreshLin = fastDecibelsToGain (limThreshDb);
-			auto* chL = buffer.getWritePointer (0);
-			auto* chR = (numChannels >= 2) ? buffer.getWritePointer (1) : chL;
-			for (int i = 0; i < numSamples; ++i)
-				applyLimiter (chL[i], chR[i], limThreshLin);
+			const auto msg = metadata.getMessage();
+			if (! isRelevantMidiEvent (msg))
+				continue;
+
+			renderTo (juce::jlimit (segmentStart, numSamples, metadata.samplePosition));
+			handleMidiEvent (msg);
 		}
 	}
 
-	// ── Invert Polarity / Stereo (GLOBAL mode: after Limiter GLOBAL, before safety clip) ──
+	renderTo (numSamples);
+
+	if (analyzerCapturing)
+		transferAnalyzer.endCapture (buffer.getReadPointer (0), numSamples);
+
+	// DELAY was selected after prepareToPlay; have the message thread build the rings.
+	int idle = DelayArenaIdle;
+	if (engine.wantsDelayRings()
+		&& delayArenaState.compare_exchange_strong (idle, DelayArenaRequested, std::memory_order_acq_rel))
+		triggerAsyncUpdate();
+
+	updateTailEstimate (numSamples);
+	publishInstanceStats (blockStartTicks, numSamples);
+}
+
+void DisperserAudioProcessor::publishInstanceStats (juce::int64 blockStartTicks, int numSamples) noexcept
+{
+	if (registrySlot < 0)
+		return;
+
+	const double busySeconds  = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - blockStartTicks);
+	const double blockSeconds = (double) numSamples / currentSampleRate;
+	const float load = (float) (busySeconds / blockSeconds);
+
+	// ~300 ms average; the peak falls back over ~2 s.
+	auto& st = instanceStats;
+	st.blockUs  = (float) (busySeconds * 1000000.0);
+	st.load    += (load - st.load) * (float) (1.0 - std::exp (-blockSeconds / 0.3));
+	st.peakLoad = juce::jmax (load, st.peakLoad * (float) std::exp (-blockSeconds / 2.0));
+	st.stages   = engine.getEffectiveStages();
+	st.series   = engine.getActiveSeries();
+	st.path     = (int) engine.getCascadePath();
+
+	st.degradation = engine.wantsDelayRings() ? InstanceRegistry::DegradationBypassed
+				   : (st.path == cost::PathScan || st.path == cost::PathWavefrontScan) ? InstanceRegistry::DegradationApproximate
+				   : InstanceRegistry::DegradationNone;
+
+	InstanceRegistry::get().publish (registrySlot, st);
+}
+
+void DisperserAudioProcessor::updateTrackProperties (const TrackProperties& properties)
+{
+	auto& registry = InstanceRegistry::get();
+	registry.setText (registrySlot, "DISP-TR " + juce::String (registry.getNumber (registrySlot)),
+		properties.name.value_or (juce::String()));
+}
+
+bool DisperserAudioProcessor::isRelevantMidiEvent (const juce::MidiMessage& msg) const noexcept
+{
+	const int ch = midiChannel.load (std::memory_order_relaxed);
+	if (ch != 0 && msg.getChannel() != ch)
+		return false;
+
+	if (msg.isNoteOn())
+		return true;
+
+	// Note-offs only matter when they release the note currently steering FREQ.
+	return msg.isNoteOff() && msg.getNoteNumber() == lastMidiNote.load (std::memory_order_relaxed);
+}
+
+void DisperserAudioProcessor::handleMidiEvent (const juce::MidiMessage& msg) noexcept
+{
+	if (msg.isNoteOn())
 	{
-		const int invPol = loadIntParamOrDefault (invPolParam, kInvPolDefault);
-		const int invStr = loadIntParamOrDefault (invStrParam, kInvStrDefault);
-		if (invPol == 2)
-			for (int ch = 0; ch < numChannels; ++ch)
-				juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch), -1.0f, numSamples);
-		if (invStr == 2 && numChannels >= 2)
-		{
-			float* sL = buffer.getWritePointer (0);
-			float* sR = buffer.getWritePointer (1);
-			for (int n = 0; n < numSamples; ++n)
-				std::swap (sL[n], sR[n]);
-		}
+		const int note = msg.getNoteNumber();
+		lastMidiNote.store (note, std::memory_order_relaxed);
+		lastMidiVelocity.store (msg.getVelocity(), std::memory_order_relaxed);
+		currentMidiFrequency.store (440.0f * std::exp2 ((note - 69) * (1.0f / 12.0f)),
+			std::memory_order_relaxed);
 	}
-
-	// ── Safety limiter (+48 dBFS ≈ 251.19) ──
-	for (int ch = 0; ch < numChannels; ++ch)
+	else if (msg.isNoteOff())
 	{
-		float* data = buffer.getWritePointer (ch);
-		juce::FloatVectorOperations::clip (data, data, -251.19f, 251.19f, numSamples);
+		lastMidiNote.store (-1, std::memory_order_relaxed);
+		currentMidiFrequency.store (0.0f, std::memory_order_relaxed);
 	}
 
-	DSP_LOG_BLOCK_END(dspLog, numSamples, currentSampleRate,
-		targetStages, targetSeries, targetFreq, targetShape, altEnabled);
+	tailEstimateDirty.store (true, std::memory_order_relaxed);   // a note retunes the cascade
+}
+
+void DisperserAudioProcessor::processSegment (juce::AudioBuffer<float>& fullBuffer, int startSample, int length)
+{
+	DSP_LOG_BLOCK_BEGIN();
+
+	auto params = makeEngineParams();
+	const int seriesBefore = engine.getActiveSeries();
+
+	// The engine runs at most stereo; the bus layouts never offer more.
+	std::array<float*, DisperserEngine::kMaxChannels> channels {};
+	const int numChannels = juce::jmin (fullBuffer.getNumChannels(), DisperserEngine::kMaxChannels);
+	for (int ch = 0; ch < numChannels; ++ch)
+		channels[(size_t) ch] = fullBuffer.getWritePointer (ch, startSample);
+
+	// Synced LFOs lock to the transport position of this segment's first sample.
+	if (params.modMatrix.ppq >= 0.0)
+		params.modMatrix.ppq += startSample * params.modMatrix.bpm / (60.0 * currentSampleRate);
+
+	engine.process (channels.data(), numChannels, length, params);
+	dspCascadePath.store ((int) engine.getCascadePath(), std::memory_order_relaxed);
+
+	if (engine.getActiveSeries() != seriesBefore)
+		DSP_LOG_CROSSFADE(dspLog, seriesBefore, engine.getActiveSeries(), engine.getCrossfadeSamples());
+
+	DSP_LOG_BLOCK_END(dspLog, length, currentSampleRate,
+		params.stages, params.series, params.midiFreqHz > 0.0f ? params.midiFreqHz : params.freqHz,
+		params.shape, params.alt);
 }
 
 bool DisperserAudioProcessor::hasEditor() const { return true; }
@@ -1485,8 +1172,12 @@ juce::AudioProcessorValueTreeState::ParameterLayout DisperserAudioProcessor::cre
 {
 	std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
 
-	params.push_back (std::make_unique<juce::AudioParameterInt> (
-		kParamAmount, "Stages", kAmountMin, kAmountMax, kAmountDefault));
+	// Up to 1024 stages, with 0..128 (the whole range of the old "amount")
+	// on the lower half of the control.
+	juce::NormalisableRange<float> stagesRange ((float) kAmountMin, (float) kAmountMax, 1.0f);
+	stagesRange.setSkewForCentre ((float) kAmountMaxV1);
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamAmount, "Stages", stagesRange, (float) kAmountDefault));
 
 	params.push_back (std::make_unique<juce::AudioParameterInt> (
 		kParamSeries, "Series", kSeriesMin, kSeriesMax, kSeriesDefault));
@@ -1630,6 +1321,58 @@ juce::AudioProcessorValueTreeState::ParameterLayout DisperserAudioProcessor::cre
 	params.push_back (std::make_unique<juce::AudioParameterInt> (kParamUiColor2, "UI Color 2", 0, 0xFFFFFF, 0xFFFFFF));
 	params.push_back (std::make_unique<juce::AudioParameterInt> (kParamUiColor3, "UI Color 3", 0, 0xFFFFFF, 0x000000));
 
+	// Appended last so existing sessions keep their parameter indices.
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamMorph, "Morph", juce::NormalisableRange<float> (0.0f, 1.0f, 0.0f), 0.0f));
+
+	// Mod matrix (also appended, after MORPH)
+	for (int i = 0; i < ModMatrix::kNumLfos; ++i)
+	{
+		const juce::String name = "LFO " + juce::String (i + 1);
+		params.push_back (std::make_unique<juce::AudioParameterChoice> (
+			getLfoParamId (i, kLfoFieldShape), name + " Shape",
+			juce::StringArray { "SINE", "TRI", "SAW+", "SAW-", "SQR" }, ModMatrix::LfoSine));
+		params.push_back (std::make_unique<juce::AudioParameterFloat> (
+			getLfoParamId (i, kLfoFieldRate), name + " Rate",
+			juce::NormalisableRange<float> (0.01f, 20.0f, 0.01f, 0.3f), kLfoRateDefault));
+		params.push_back (std::make_unique<juce::AudioParameterBool> (getLfoParamId (i, kLfoFieldSync), name + " Sync", false));
+		params.push_back (std::make_unique<juce::AudioParameterChoice> (
+			getLfoParamId (i, kLfoFieldDivision), name + " Division",
+			juce::StringArray { "4/1", "2/1", "1/1", "1/2", "1/4", "1/8", "1/16", "1/32",
+			                    "1/2T", "1/4T", "1/8T", "1/16T", "1/2D", "1/4D", "1/8D", "1/16D" },
+			kLfoDivisionDefault));
+	}
+
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamEnvAttack, "Env Attack",
+		juce::NormalisableRange<float> (0.1f, 500.0f, 0.1f, 0.4f), kEnvAttackDefault));
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamEnvRelease, "Env Release",
+		juce::NormalisableRange<float> (1.0f, 5000.0f, 1.0f, 0.3f), kEnvReleaseDefault));
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamRndRate, "Random Rate",
+		juce::NormalisableRange<float> (0.01f, 50.0f, 0.01f, 0.3f), kRndRateDefault));
+	params.push_back (std::make_unique<juce::AudioParameterFloat> (
+		kParamRndGlide, "Random Glide",
+		juce::NormalisableRange<float> (0.0f, 1.0f, 0.0f, 1.0f), kRndGlideDefault));
+
+	for (int i = 0; i < ModMatrix::kMaxRoutes; ++i)
+	{
+		const juce::String name = "Route " + juce::String (i + 1);
+		params.push_back (std::make_unique<juce::AudioParameterChoice> (
+			getRouteParamId (i, kRouteFieldSource), name + " Source",
+			juce::StringArray { "OFF", "LFO1", "LFO2", "ENV", "RND" }, ModMatrix::SourceNone));
+		params.push_back (std::make_unique<juce::AudioParameterChoice> (
+			getRouteParamId (i, kRouteFieldTarget), name + " Target",
+			juce::StringArray { "FREQ", "SHAPE", "FEEDBACK", "MIX", "TILT", "HP", "LP" }, ModMatrix::TargetFreq));
+		params.push_back (std::make_unique<juce::AudioParameterFloat> (
+			getRouteParamId (i, kRouteFieldDepth), name + " Depth",
+			juce::NormalisableRange<float> (-1.0f, 1.0f, 0.0f, 1.0f), 0.0f));
+	}
+
+	params.push_back (std::make_unique<juce::AudioParameterChoice> (
+		kParamStageType, "Stage Type", juce::StringArray { "1-POLE", "DELAY" }, kStageTypeDefault));
+
 	return { params.begin(), params.end() };
 }
 
@@ -1641,9 +1384,10 @@ void DisperserAudioProcessor::setUiEditorSize (int width, int height)
 	uiEditorHeight.store (h, std::memory_order_relaxed);
 	apvts.state.setProperty (UiStateKeys::editorWidth, w, nullptr);
 	apvts.state.setProperty (UiStateKeys::editorHeight, h, nullptr);
-	setParameterPlainValue (apvts, kParamUiWidth, (float) w);
-	setParameterPlainValue (apvts, kParamUiHeight, (float) h);
-	updateHostDisplay();
+	bool changed = setParameterPlainValue (apvts, kParamUiWidth, (float) w);
+	changed = setParameterPlainValue (apvts, kParamUiHeight, (float) h) || changed;
+	if (changed)
+		requestHostDisplayUpdate();
 }
 
 int DisperserAudioProcessor::getUiEditorWidth() const noexcept
@@ -1670,8 +1414,8 @@ void DisperserAudioProcessor::setUiUseCustomPalette (bool shouldUseCustomPalette
 {
 	uiUseCustomPalette.store (shouldUseCustomPalette ? 1 : 0, std::memory_order_relaxed);
 	apvts.state.setProperty (UiStateKeys::useCustomPalette, shouldUseCustomPalette, nullptr);
-	setParameterPlainValue (apvts, kParamUiPalette, shouldUseCustomPalette ? 1.0f : 0.0f);
-	updateHostDisplay();
+	if (setParameterPlainValue (apvts, kParamUiPalette, shouldUseCustomPalette ? 1.0f : 0.0f))
+		requestHostDisplayUpdate();
 }
 
 bool DisperserAudioProcessor::getUiUseCustomPalette() const noexcept
@@ -1688,8 +1432,8 @@ void DisperserAudioProcessor::setUiFxTailEnabled (bool shouldEnableFxTail)
 {
 	uiFxTailEnabled.store (shouldEnableFxTail ? 1 : 0, std::memory_order_relaxed);
 	apvts.state.setProperty (UiStateKeys::fxTailEnabled, shouldEnableFxTail, nullptr);
-	setParameterPlainValue (apvts, kParamUiFxTail, shouldEnableFxTail ? 1.0f : 0.0f);
-	updateHostDisplay();
+	if (setParameterPlainValue (apvts, kParamUiFxTail, shouldEnableFxTail ? 1.0f : 0.0f))
+		requestHostDisplayUpdate();
 }
 
 bool DisperserAudioProcessor::getUiFxTailEnabled() const noexcept
@@ -1712,8 +1456,8 @@ void DisperserAudioProcessor::setUiCustomPaletteColour (int index, juce::Colour
 	apvts.state.setProperty (UiStateKeys::customPalette[(size_t) safeIndex], (int) argb, nullptr);
 
 	const char* colorParamIds[4] { kParamUiColor0, kParamUiColor1, kParamUiColor2, kParamUiColor3 };
-	setParameterPlainValue (apvts, colorParamIds[safeIndex], (float) rgb);
-	updateHostDisplay();
+	if (setParameterPlainValue (apvts, colorParamIds[safeIndex], (float) rgb))
+		requestHostDisplayUpdate();
 }
 
 juce::Colour DisperserAudioProcessor::getUiCustomPaletteColour (int index) const noexcept
@@ -1738,25 +1482,183 @@ juce::Colour DisperserAudioProcessor::getUiCustomPaletteColour (int index) const
 
 void DisperserAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-	auto state = apvts.copyState();
-	state.setProperty (UiStateKeys::editorWidth, getUiEditorWidth(), nullptr);
-	state.setProperty (UiStateKeys::editorHeight, getUiEditorHeight(), nullptr);
-	state.setProperty (UiStateKeys::useCustomPalette, getUiUseCustomPalette(), nullptr);
-	state.setProperty (UiStateKeys::fxTailEnabled, getUiFxTailEnabled(), nullptr);
-	state.setProperty (UiStateKeys::midiPort, getMidiChannel(), nullptr);
+	const juce::ScopedLock sl (cachedStateLock);
+
+	// Hosts poll this for autosave/undo far more often than anything changes;
+	// only re-serialise when a parameter or state property has been touched.
+	if (stateDirty.exchange (false, std::memory_order_acq_rel) || cachedState.isEmpty())
+		writeCompactState (cachedState);
+
+	destData = cachedState;
+}
+
+void DisperserAudioProcessor::writeCompactState (juce::MemoryBlock& dest)
+{
+	// UI values may still only live in the atomics (set before the tree had
+	// them), so merge them over the tree's properties without mutating it.
+	auto props = apvts.state.getProperties();
+	props.set (UiStateKeys::editorWidth, getUiEditorWidth());
+	props.set (UiStateKeys::editorHeight, getUiEditorHeight());
+	props.set (UiStateKeys::useCustomPalette, getUiUseCustomPalette());
+	props.set (UiStateKeys::fxTailEnabled, getUiFxTailEnabled());
+	props.set (UiStateKeys::midiPort, getMidiChannel());
 	for (int i = 0; i < 4; ++i)
-		state.setProperty (UiStateKeys::customPalette[(size_t) i], (int) getUiCustomPaletteColour (i).getARGB(), nullptr);
+		props.set (UiStateKeys::customPalette[(size_t) i], (int) getUiCustomPaletteColour (i).getARGB());
+
+	// Which targets follow the morph is part of the sound.
+	juce::StringArray held;
+	for (const auto& t : morphTargets)
+		if (morphHeld[(size_t) t.paramIndex].load (std::memory_order_relaxed))
+			held.add (t.param->paramID);
+	props.set (kMorphHeldKey, held.joinIntoString (" "));
+
+	juce::MemoryOutputStream out (dest, false);
+	out.writeInt (kStateMagic);
+	out.writeInt (kStateVersion);
+
+	const auto& params = getParameters();
+	out.writeInt (params.size());
+	for (auto* p : params)
+	{
+		auto* ranged = dynamic_cast<juce::RangedAudioParameter*> (p);
+		out.writeString (ranged != nullptr ? ranged->paramID : juce::String());
+		out.writeFloat (ranged != nullptr ? ranged->convertFrom0to1 (ranged->getValue()) : p->getValue());
+	}
+
+	out.writeInt (props.size());
+	for (int i = 0; i < props.size(); ++i)
+	{
+		out.writeString (props.getName (i).toString());
+		props.getValueAt (i).writeToStream (out);
+	}
+
+	const auto& state = apvts.state;
+	int numExtraChildren = 0;
+	for (const auto& child : state)
+		if (! child.hasType ("PARAM"))
+			++numExtraChildren;
+
+	out.writeInt (numExtraChildren);
+	for (const auto& child : state)
+		if (! child.hasType ("PARAM"))
+			child.writeToStream (out);
+
+	out.flush();   // trims dest to the written size
+}
+
+bool DisperserAudioProcessor::readCompactState (const void* data, int sizeInBytes)
+{
+	if (data == nullptr || sizeInBytes < 8)
+		return false;
+
+	// A truncated blob is rejected as a whole, so the XML fallback gets a
+	// go and a half-read state never replaces the current one.
+	StateInputStream in (data, (size_t) sizeInBytes, false);
+	if (in.readInt() != kStateMagic)
+		return false;
+
+	const int version = in.readInt();
+	if (version < 1 || version > kStateVersion)
+		return false;
+
+	juce::ValueTree newState (apvts.state.getType());
+
+	const int numParams = in.readInt();
+	if (in.ranDry || numParams < 0)
+		return false;
+	for (int i = 0; i < numParams; ++i)
+	{
+		const auto id = in.readString();
+		const float value = in.readFloat();
+		if (in.ranDry)
+			return false;
+		if (id.isNotEmpty())
+			newState.appendChild (juce::ValueTree ("PARAM", { { "id", id }, { "value", value } }), nullptr);
+	}
+
+	const int numProps = in.readInt();
+	if (in.ranDry || numProps < 0)
+		return false;
+	for (int i = 0; i < numProps; ++i)
+	{
+		const auto name = in.readString();
+		const auto value = juce::var::readFromStream (in);
+		if (in.ranDry)
+			return false;
+		if (name.isNotEmpty())
+			newState.setProperty (name, value, nullptr);
+	}
+
+	const int numChildren = in.readInt();
+	if (in.ranDry || numChildren < 0)
+		return false;
+	for (int i = 0; i < numChildren; ++i)
+	{
+		auto child = juce::ValueTree::readFromStream (in);
+		if (in.ranDry)
+			return false;
+		if (child.isValid())
+			newState.appendChild (child, nullptr);
+	}
+
+	migrateState (newState);
+	apvts.replaceState (newState);
+	return true;
+}
+
+juce::String DisperserAudioProcessor::getCurrentParamId (const juce::String& storedId)
+{
+	return storedId == kParamAmountV1 ? juce::String (kParamAmount) : storedId;
+}
 
-	if (auto xml = state.createXml())
-		copyXmlToBinary (*xml, destData);
+void DisperserAudioProcessor::migrateState (juce::ValueTree& state) const
+{
+	// Plain values keep their meaning under the new ID; a state that already
+	// has the new one wins.
+	for (int i = state.getNumChildren(); --i >= 0;)
+	{
+		auto child = state.getChild (i);
+		if (! child.hasType ("PARAM") || child.getProperty ("id").toString() != kParamAmountV1)
+			continue;
+
+		if (state.getChildWithProperty ("id", kParamAmount).isValid())
+			state.removeChild (i, nullptr);
+		else
+			child.setProperty ("id", kParamAmount, nullptr);
+	}
+
+	// Morph slots hold normalised values, and the mapping changed with the ID.
+	const auto& range = apvts.getParameterRange (kParamAmount);
+	auto slots = state.getChildWithName ("MORPH_SLOTS");
+	for (auto slot : slots)
+	{
+		const auto legacy = slot.getProperty (kParamAmountV1);
+		if (legacy.isVoid())
+			continue;
+
+		if (! slot.hasProperty (kParamAmount))
+		{
+			const float stages = juce::jlimit (0.0f, (float) kAmountMaxV1, (float) legacy * (float) kAmountMaxV1);
+			slot.setProperty (kParamAmount, range.convertTo0to1 (stages), nullptr);
+		}
+		slot.removeProperty (kParamAmountV1, nullptr);
+	}
 }
 
 void DisperserAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-	if (auto xmlState = getXmlFromBinary (data, sizeInBytes))
+	if (! readCompactState (data, sizeInBytes))
 	{
-		if (xmlState->hasTagName (apvts.state.getType()))
-			apvts.replaceState (juce::ValueTree::fromXml (*xmlState));
+		// Sessions saved before the compact format: JUCE XML-in-binary.
+		if (auto xmlState = getXmlFromBinary (data, sizeInBytes))
+		{
+			if (xmlState->hasTagName (apvts.state.getType()))
+			{
+				auto state = juce::ValueTree::fromXml (*xmlState);
+				migrateState (state);
+				apvts.replaceState (state);
+			}
+		}
 	}
 
 	const auto w = apvts.state.getProperty (UiStateKeys::editorWidth);
@@ -1772,6 +1674,8 @@ void DisperserAudioProcessor::setStateInformation (const void* data, int sizeInB
 	const auto mp = apvts.state.getProperty (UiStateKeys::midiPort);
 	if (! mp.isVoid()) midiChannel.store (juce::jlimit (0, 16, (int) mp), std::memory_order_relaxed);
 
+	restoreMorphSlotsFromState();
+
 	for (int i = 0; i < 4; ++i)
 	{
 		const auto c = apvts.state.getProperty (UiStateKeys::customPalette[(size_t) i]);
@@ -5,14 +5,25 @@
 #include <atomic>
 #include <vector>
 #include "DspDebugLog.h"
-
-class DisperserAudioProcessor : public juce::AudioProcessor
+#include "InstanceRegistry.h"
+#include "KernelTuning.h"
+#include "MemoryReport.h"
+#include "PerfTrace.h"
+#include "PresetBank.h"
+#include "TransferAnalyzer.h"
+#include "Engine/DisperserEngine.h"
+
+class DisperserAudioProcessor : public juce::AudioProcessor,
+								private juce::AsyncUpdater,
+								private juce::AudioProcessorParameter::Listener,
+								private juce::ValueTree::Listener
 {
 public:
 	DisperserAudioProcessor();
 	~DisperserAudioProcessor() override;
 
-	static constexpr const char* kParamAmount    = "amount";
+	static constexpr const char* kParamAmount    = "stages";
+	static constexpr const char* kParamAmountV1  = "amount";   // 0..128, linear; migrated on load
 	static constexpr const char* kParamSeries    = "series";
 	static constexpr const char* kParamFreq      = "freq";
 	static constexpr const char* kParamShape     = "shape";
@@ -60,10 +71,33 @@ public:
 	// Filter position
 	static constexpr const char* kParamFilterPos = "filter_pos";
 
+	// A/B morph position
+	static constexpr const char* kParamMorph = "morph";
+
 	// Limiter
 	static constexpr const char* kParamLimThreshold = "lim_threshold";
 	static constexpr const char* kParamLimMode      = "lim_mode";
 
+	// Mod matrix. Per-LFO and per-route IDs are built from a field name
+	// ("lfo1_rate", "route3_depth") by getLfoParamId / getRouteParamId.
+	static constexpr const char* kParamEnvAttack  = "env_attack";
+	static constexpr const char* kParamEnvRelease = "env_release";
+	static constexpr const char* kParamRndRate    = "rnd_rate";
+	static constexpr const char* kParamRndGlide   = "rnd_glide";
+	static constexpr const char* kLfoFieldShape    = "shape";
+	static constexpr const char* kLfoFieldRate     = "rate";
+	static constexpr const char* kLfoFieldSync     = "sync";
+	static constexpr const char* kLfoFieldDivision = "div";
+	static constexpr const char* kRouteFieldSource = "src";
+	static constexpr const char* kRouteFieldTarget = "dst";
+	static constexpr const char* kRouteFieldDepth  = "depth";
+
+	// Stage type: first-order all-passes or delay-line (Schroeder) sections
+	static constexpr const char* kParamStageType = "stage_type";
+
+	static juce::String getLfoParamId (int lfo, const char* field)     { return "lfo" + juce::String (lfo + 1) + "_" + field; }
+	static juce::String getRouteParamId (int route, const char* field) { return "route" + juce::String (route + 1) + "_" + field; }
+
 	static constexpr const char* kParamUiWidth   = "ui_width";
 	static constexpr const char* kParamUiHeight  = "ui_height";
 	static constexpr const char* kParamUiPalette = "ui_palette";
@@ -74,11 +108,12 @@ public:
 	static constexpr const char* kParamUiColor3  = "ui_color3";
 
 	static constexpr int kAmountMin = 0;
-	static constexpr int kAmountMax = 128;
+	static constexpr int kAmountMax = DisperserEngine::kMaxStages;
 	static constexpr int kAmountDefault = 32;
+	static constexpr int kAmountMaxV1 = 128;   // also the centre of the skewed range
 
 	static constexpr int kSeriesMin = 1;
-	static constexpr int kSeriesMax = 4;
+	static constexpr int kSeriesMax = DisperserEngine::kMaxSeries;
 	static constexpr int kSeriesDefault = 1;
 
 	static constexpr float kFreqDefault = 1000.0f;
@@ -169,6 +204,9 @@ public:
 	void getCurrentProgramStateInformation (juce::MemoryBlock& destData) override;
 	void setCurrentProgramStateInformation (const void* data, int sizeInBytes) override;
 
+	// Track name for the session-wide instance table.
+	void updateTrackProperties (const TrackProperties& properties) override;
+
 	void setUiEditorSize (int width, int height);
 	int getUiEditorWidth() const noexcept;
 	int getUiEditorHeight() const noexcept;
@@ -194,11 +232,187 @@ public:
 	juce::AudioProcessorValueTreeState apvts;
 	static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+	// Zone timings shared by processBlock and the editor's frame-time overlay.
+	PerfTrace perfTrace;
+
+	// Current parameter values in engine form. processBlock takes one per MIDI
+	// segment; offline tools take one after applying a state.
+	DisperserEngine::Params makeEngineParams() const noexcept;
+
+	// Vector ISA the engine's kernels were dispatched to at the last prepareToPlay.
+	simd::Isa getDspIsa() const noexcept { return (simd::Isa) dspIsa.load (std::memory_order_relaxed); }
+
+	// Cascade path the engine took in the last block processed.
+	cost::Path getDspCascadePath() const noexcept { return (cost::Path) dspCascadePath.load (std::memory_order_relaxed); }
+
+	// Predicted cost of `p` at the current block size, channel count and ISA,
+	// for the editor to show before a setting is committed.
+	DisperserEngine::CostEstimate estimateDspCost (const DisperserEngine::Params& p) const noexcept;
+
+	// Bytes this instance holds, per subsystem, including an open editor's.
+	// Message thread.
+	MemoryReport getMemoryReport() const;
+
+	// For format wrappers whose host lends worker threads (CLAP thread-pool):
+	// the engine hands independent work to `executor` during processBlock, and
+	// the host's workers come back through runDspTask.
+	void setDspTaskExecutor (DisperserEngine::TaskExecutor executor, void* context) noexcept { engine.setTaskExecutor (executor, context); }
+	void runDspTask (int index) noexcept { engine.runTask (index); }
+
+	// For format wrappers that get automation as timed events (CLAP): one
+	// processBlock that applies each change on its own sample, splitting the
+	// engine run there like at a MIDI note. `changes` is sorted by sample;
+	// values are normalised, indices into getParameters().
+	struct ParamChange
+	{
+		int   sample;
+		int   paramIndex;
+		float value;
+	};
+	void processBlockWithParamChanges (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi,
+									   const ParamChange* changes, int numChanges);
+
+	// This instance's row in the process-wide InstanceRegistry (-1 if the table was full).
+	int getInstanceRegistrySlot() const noexcept { return registrySlot; }
+
+	// Measured group delay for the editor. Idle (no buffers, no thread) until
+	// started; processBlock then feeds it the left input and output.
+	TransferAnalyzer& getTransferAnalyzer() noexcept { return transferAnalyzer; }
+
+	// Main-thread half of the lazy DELAY ring handover (see below). The
+	// processor's own AsyncUpdater calls this; wrappers without a JUCE message
+	// loop poll isDelayArenaRequested() after processing and call it from
+	// their host's main-thread callback.
+	bool isDelayArenaRequested() const noexcept { return delayArenaState.load (std::memory_order_relaxed) == DelayArenaRequested; }
+	void buildRequestedDelayArena();
+
+	// ── Preset library ──
+	static juce::File getDefaultPresetBankFile();
+	bool loadPresetBank (const juce::File& file);
+	const PresetBank& getPresetBank() const noexcept { return presetBank; }
+	bool applyPreset (int presetIndex);
+	// Appends/replaces a preset built from the current (non-UI) parameter values.
+	bool saveCurrentAsPreset (const juce::String& name, const juce::StringArray& tags);
+
+	// ── A/B morph ──
+	// Slot 0 = A, 1 = B. Once both are stored, MORPH interpolates every
+	// continuous parameter between them in the engine; the parameters keep
+	// their own values.
+	void captureMorphSlot (int slot);
+	void clearMorphSlots();
+	bool hasMorphSlot (int slot) const noexcept;
+
 private:
-	struct AllPassState
+	// Batches updateHostDisplay(): bursts of UI mirror writes produce one host refresh.
+	// The same callback builds DELAY rings the audio thread asked for.
+	void requestHostDisplayUpdate();
+	void handleAsyncUpdate() override;
+	std::atomic<bool> hostDisplayUpdatePending { false };
+
+	// ── Lazy DELAY rings ──
+	// prepareToPlay only allocates the engine's DELAY rings when DELAY is
+	// selected. A later switch asks for them from the audio thread; the message
+	// thread fills pendingDelayArena and the next block swaps it in, handing
+	// the engine's empty vector back.
+	enum DelayArenaState : int { DelayArenaIdle = 0, DelayArenaRequested, DelayArenaBuilding, DelayArenaReady };
+	void adoptPendingDelayArena() noexcept;
+	std::vector<float> pendingDelayArena;
+	std::atomic<int> delayArenaState { DelayArenaIdle };
+
+	// ── Compact binary state + cache ──
+	// Layout (little-endian): magic, version, then name-keyed param records,
+	// top-level state properties and any non-PARAM child trees. Old sessions
+	// (JUCE XML-in-binary) are still accepted by setStateInformation.
+	static constexpr juce::int32 kStateMagic   = 0x42525444; // "DTRB"
+	static constexpr juce::int32 kStateVersion = 1;
+
+	void writeCompactState (juce::MemoryBlock& dest);
+	bool readCompactState (const void* data, int sizeInBytes);
+
+	// Renames parameters whose ID changed (see kParamAmountV1) in a loaded
+	// tree, morph slots included, before it replaces the state.
+	void migrateState (juce::ValueTree& state) const;
+	static juce::String getCurrentParamId (const juce::String& storedId);
+	void markStateDirty() noexcept { stateDirty.store (true, std::memory_order_release); }
+
+	void parameterValueChanged (int parameterIndex, float) override;
+	void parameterGestureChanged (int, bool) override {}
+	void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override { markStateDirty(); }
+	void valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) override { markStateDirty(); }
+	void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override { markStateDirty(); }
+	void valueTreeRedirected (juce::ValueTree&) override { markStateDirty(); }
+
+	// ── Preset apply (triple buffer) ──
+	// A preset is decoded on the message thread into its write slot of
+	// normalised values (NaN = not in the preset) plus the program index, and
+	// handed over by exchanging that slot's index, with the fresh bit, into
+	// presetMiddleSlot. processBlock exchanges its read slot for a fresh one and
+	// applies it whole before it reads any parameter, so a block never sees a
+	// half-applied preset and neither side ever touches the other's slot.
+	static constexpr int kNumPresetSlots  = 3;
+	static constexpr int kPresetSlotMask  = 3;
+	static constexpr int kPresetSlotFresh = 4;
+	void applyPendingPreset() noexcept;
+
+	struct PresetSlot
 	{
-		float z1 = 0.0f;
+		std::vector<float> values;
+		int program = -1;
+	};
+
+	PresetBank presetBank;
+	std::vector<int> presetParamMap;   // bank param index -> getParameters() index (-1 = unknown)
+	std::array<PresetSlot, kNumPresetSlots> presetSlots;
+	int presetWriteSlot = 0;                   // message thread
+	std::atomic<int> presetMiddleSlot { 1 };   // index | kPresetSlotFresh
+	int presetReadSlot = 2;                    // audio thread
+	std::atomic<bool> audioPrepared { false };
+	std::atomic<int> currentProgram { 0 };
+
+	// ── A/B morph ──
+	// Continuous params are interpolated in the normalised domain (so skewed
+	// ranges such as FREQ move perceptually and the coefficient tables follow
+	// the interpolated FREQ/SHAPE/STAGES through the usual smoothers).
+	// Discrete/stepped params switch at the midpoint; SERIES therefore goes
+	// through the existing series crossfade exactly once per morph.
+	//
+	// The blend is read in makeEngineParams(), never written back to the
+	// parameters, so automation and the host's undo history only see what
+	// the user did. A target set by hand, by automation or by a preset keeps
+	// its own value ("held") until MORPH moves again.
+	struct MorphTarget
+	{
+		int  paramIndex;
+		bool discrete;
+		const std::atomic<float>* raw;              // morphTargets is sorted by this
+		const juce::RangedAudioParameter* param;
+	};
+
+	static constexpr int kMorphMaxInterpolatedSteps = 16; // fewer steps → switch, not sweep
+
+	void updateMorphHolds() noexcept;
+	void holdAllMorphTargets() noexcept;
+	const MorphTarget* findMorphTarget (const std::atomic<float>* raw) const noexcept;
+	float getMorphedValue (const MorphTarget& t) const noexcept;   // normalised, what the engine uses
+	float loadEngineParam (std::atomic<float>* raw, float def) const noexcept;
+	void storeMorphSlotsInState();
+	void restoreMorphSlotsFromState();
+
+	std::vector<MorphTarget> morphTargets;
+	std::array<std::unique_ptr<std::atomic<float>[]>, 2> morphSlots;
+	std::array<std::atomic<bool>, 2> morphSlotValid {
+		std::atomic<bool> { false },
+		std::atomic<bool> { false }
 	};
+	std::unique_ptr<std::atomic<bool>[]> morphHeld;  // per parameter index
+	static constexpr const char* kMorphHeldKey = "morphHeld";   // state: IDs of held targets
+	std::atomic<float>* morphParam = nullptr;
+	float lastMorph = 0.0f;                          // audio thread only
+	std::atomic<bool> morphResync { true };          // next block adopts MORPH without releasing holds
+
+	std::atomic<bool> stateDirty { true };
+	juce::MemoryBlock cachedState;
+	juce::CriticalSection cachedStateLock;
 
 	struct UiStateKeys
 	{
@@ -213,47 +427,11 @@ private:
 		};
 	};
 
-	static float calcAllPassCoeff (float frequency, float sampleRate) noexcept;
-	void resizeDspState (int stages, int series);
-	void updateCoefficients (float freqHz, float shapeNorm, int stages);
-	void updateCoefficientsInto (float freqHz, float shapeNorm, int stages, std::vector<float>& dest);
-	void clearStageRange (int fromStageInclusive, int toStageExclusive, int seriesCount) noexcept;
-
-	std::array<std::vector<AllPassState>, kSeriesMax> chainL;
-	std::array<std::vector<AllPassState>, kSeriesMax> chainR;
-	std::vector<float> stageCoeff;
-	std::vector<float> stageCoeffR;   // R-channel coefficients for DUAL mode
-	juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> stagesSmoothed;
-	float smoothedFreqValue = 1000.0f;
-	float freqEmaCoeff = 0.0f;
-	float freqEmaCoeffDefault_ = 0.0f;
-	juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> shapeSmoothed;
-	static constexpr double kStageSmoothingSeconds = 0.06;
-	static constexpr float kFreqTauDefault   = 0.08f;
-	static constexpr float kMidiGlideTauMax  = 0.200f;
-	static constexpr float kMidiGlideTauMin  = 0.0002f;
-	static constexpr double kShapeSmoothingSeconds = 0.05;
-	static constexpr int kCoeffUpdateInterval = 32;
-	static constexpr double kSeriesCrossfadeMs = 20.0;
-	int activeStages = 0;
-	int activeSeries = kSeriesDefault;
-	float lastCoeffFreq = -1.0f;
-	float lastCoeffShape = -1.0f;
-	int lastCoeffStages = -1;
-	float lastCoeffFreqR  = -1.0f;
-	int coeffUpdateCountdown = 0;
-
-	// ── Feedback ──
-	juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> feedbackSmoothed;
-	static constexpr double kFeedbackSmoothingSeconds = 0.05;
-	float feedbackLastL = 0.0f;
-	float feedbackLastR = 0.0f;
-
-	std::array<std::vector<AllPassState>, kSeriesMax> xfadeChainL;
-	std::array<std::vector<AllPassState>, kSeriesMax> xfadeChainR;
-	int seriesXfadeSamplesRemaining = 0;
-	int seriesXfadeTotalSamples = 0;
-	int previousSeries = kSeriesDefault;
+	// ── Signal path ──
+	// All DSP state lives in the engine; the processor reads parameters, splits
+	// blocks at MIDI events and handles presets, morph and snapshots around it.
+	DisperserEngine engine;
+	bool engineProfileMeasured = false;   // audio thread: engine already on KernelTuning's measured profile
 
 	// ── MIDI note tracking ──
 	std::atomic<float> currentMidiFrequency { 0.0f };
@@ -263,50 +441,15 @@ private:
 
 	double currentSampleRate = 44100.0;
 
-	// ── Input / Output / Mix gain smoothing (same as ECHO-TR) ──
-	float smoothedInputGain = 1.0f;
-	float smoothedOutputGain = 1.0f;
-	float smoothedMix = 1.0f;
-	bool  filterPre_  = false;
-	bool  tiltPre_    = false;
-
-	// ── Tilt EQ (1-pole shelving, pivot 1 kHz) ──
-	float tiltDb_        = 0.0f;
-	float tiltB0_ = 1.0f, tiltB1_ = 0.0f, tiltA1_ = 0.0f;
-	float tiltTargetB0_ = 1.0f, tiltTargetB1_ = 0.0f, tiltTargetA1_ = 0.0f;
-	float tiltState_[2]  = { 0.0f, 0.0f };
-	float lastTiltDb_    = 0.0f;
-	float tiltSmoothSc_  = 0.0f;
-
-	// Pre-allocated dry buffer for mix blend (avoids malloc in processBlock)
-	juce::AudioBuffer<float> dryBuffer;
-
-public:
-	// ── Wet filter (HP + LP) ──
-	struct WetFilterBiquadCoeffs { float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f; };
-	struct WetFilterBiquadState  { float z1 = 0.0f, z2 = 0.0f; };
-private:
-	struct WetFilterChannelState
-	{
-		WetFilterBiquadState hp[2];   // up to 2 cascaded sections (24 dB/oct)
-		WetFilterBiquadState lp[2];
-		void reset() { *this = {}; }
-	};
-	WetFilterChannelState wetFilterState_[2];       // L, R
-	WetFilterBiquadCoeffs hpCoeffs_[2];             // section 0, 1
-	WetFilterBiquadCoeffs lpCoeffs_[2];
-	WetFilterBiquadCoeffs hpCoeffsR_[2];             // R channel coeffs (stereo chaos)
-	WetFilterBiquadCoeffs lpCoeffsR_[2];
-	float smoothedFilterHpFreq_ = kFilterHpFreqDefault;
-	float smoothedFilterLpFreq_ = kFilterLpFreqDefault;
-	float lastCalcHpFreq_ = -1.0f;
-	float lastCalcLpFreq_ = -1.0f;
-	int   lastCalcHpSlope_ = -1;
-	int   lastCalcLpSlope_ = -1;
-	static constexpr int kFilterCoeffUpdateInterval = 32;
-	int   filterCoeffCountdown_ = 0;
-
-	void updateFilterCoeffs (bool forceHp, bool forceLp);
+	// ── Tail length ──
+	// Hosts ask from the message thread, and makeEngineParams() reads
+	// audio-thread state, so the audio thread publishes the estimate: after
+	// a change, at most every kTailEstimateIntervalSeconds while automation runs.
+	static constexpr double kTailEstimateIntervalSeconds = 0.1;
+	void updateTailEstimate (int numSamples) noexcept;
+	std::atomic<double> tailSeconds { 0.0 };
+	std::atomic<bool>   tailEstimateDirty { true };
+	int samplesSinceTailEstimate = 0;              // audio thread
 
 	std::atomic<float>* inputParam = nullptr;
 	std::atomic<float>* outputParam = nullptr;
@@ -352,9 +495,6 @@ private:
 	std::atomic<float>* filterPosParam = nullptr;
 
 	std::atomic<float>* panParam       = nullptr;
-	float lastPan_      = -1.0f;
-	float lastPanLeft_  = 1.0f;
-	float lastPanRight_ = 1.0f;
 
 	std::atomic<float>* uiWidthParam = nullptr;
 	std::atomic<float>* uiHeightParam = nullptr;
@@ -373,178 +513,43 @@ private:
 		std::atomic<juce::uint32> { juce::Colours::black.getARGB() }
 	};
 
-	// ── Chaos state (Hermite + Drift, per-channel D/G, quadrature F) ──
-	bool  chaosFilterEnabled_ = false;
-	bool  chaosDelayEnabled_  = false;
-	bool  chaosStereo_        = false;   // true when style >= 1 (per-channel G, quadrature F)
-
-	// CHS D parameters (disperser frequency modulation + gain)
-	float chaosAmtD_                    = 0.0f;
-	float chaosAmtNormD_                = 0.0f;   // cached amtD * 0.01
-	float chaosShPeriodD_               = 8820.0f;
-	float smoothedChaosShPeriodD_       = 8820.0f;
-	float chaosFreqMaxOct_              = 0.0f;
-	float smoothedChaosFreqMaxOct_      = 0.0f;
-	float chaosGainMaxDb_               = 0.0f;
-	float smoothedChaosGainMaxDb_       = 0.0f;
-
-	// CHS D Hermite+Drift: freq (per-channel; ch0 used for allpass freq mod)
-	float chaosDPrev_[2]         = {};
-	float chaosDCurr_[2]         = {};
-	float chaosDNext_[2]         = {};
-	float chaosDPhase_[2]        = {};
-	float chaosDDriftPhase_[2]   = {};
-	float chaosDDriftFreqHz_[2]  = {};
-	float chaosDOut_[2]          = {};
-	juce::Random chaosDRng_[2];
-
-	// CHS D Hermite+Drift: gain (per-channel, decorrelated)
-	float chaosGPrev_[2]         = {};
-	float chaosGCurr_[2]         = {};
-	float chaosGNext_[2]         = {};
-	float chaosGPhase_[2]        = {};
-	float chaosGDriftPhase_[2]   = {};
-	float chaosGDriftFreqHz_[2]  = {};
-	float chaosGOut_[2]          = {};
-	juce::Random chaosGRng_[2];
-
-	// CHS F parameters (filter cutoff modulation)
-	float chaosAmtF_                  = 0.0f;
-	float chaosShPeriodF_             = 8820.0f;
-	float smoothedChaosShPeriodF_     = 8820.0f;
-	float chaosFilterMaxOct_          = 0.0f;
-	float smoothedChaosFilterMaxOct_  = 0.0f;
-
-	// CHS F Hermite+Drift: filter (mono S&H + quadrature drift)
-	float chaosFPrev_            = 0.0f;
-	float chaosFCurr_            = 0.0f;
-	float chaosFNext_            = 0.0f;
-	float chaosFPhase_           = 0.0f;
-	float chaosFDriftPhase_      = 0.0f;   // single phase; R = +90° offset
-	float chaosFDriftFreqHz_     = 0.0f;
-	float chaosFOut_[2]          = {};     // [0]=L, [1]=R (quadrature when stereo)
-	juce::Random chaosFRng_;
-
-	// Chaos per-sample param smoothing (precomputed in prepareToPlay)
-	float chaosParamSmoothCoeff_ = 0.999f;
-	float cachedChaosParamSmoothCoeff_ = 0.999f;
-
-	static constexpr float kChaosDriftAmp = 0.3f;
-	static constexpr float kTwoPi = 6.283185307f;
-
-	// Generic Hermite + Drift chaos engine (per-sample advance)
-	inline void advanceChaosEngine (
-		float& prev, float& curr, float& next, float& phase,
-		float& driftPhase, float& driftFreqHz, float& output,
-		juce::Random& rng, float period, float amtNorm, float sr) noexcept
-	{
-		phase += 1.0f;
-		if (phase >= period)
-		{
-			phase -= period;
-			prev = curr;
-			curr = next;
-			next = rng.nextFloat() * 2.0f - 1.0f;
-			const float driftBase = sr / juce::jmax (1.0f, period) * 0.37f;
-			driftFreqHz = driftBase * (0.88f + rng.nextFloat() * 0.24f);
-		}
-		const float t  = phase / period;
-		const float t2 = t * t;
-		const float t3 = t2 * t;
-		const float h00 =  2.0f * t3 - 3.0f * t2 + 1.0f;
-		const float h10 =         t3 - 2.0f * t2 + t;
-		const float h01 = -2.0f * t3 + 3.0f * t2;
-		const float h11 =         t3 -        t2;
-		const float tangCurr = (next - prev) * 0.5f;
-		const float tangNext = -curr * 0.5f;
-		const float shValue  = h00 * curr + h10 * tangCurr + h01 * next + h11 * tangNext;
-
-		driftPhase += driftFreqHz / sr;
-		if (driftPhase > 1e6f) driftPhase -= 1e6f;
-		const float driftValue = std::sin (driftPhase * kTwoPi) * kChaosDriftAmp;
-
-		const float shWeight = juce::jlimit (0.0f, 1.0f, amtNorm * 1.5f - 0.15f);
-		output = driftValue + shValue * shWeight;
-	}
-
-	inline void advanceChaosD() noexcept
+	DspDebugLog dspLog;
+
+	// ── Mod matrix ──
+	struct LfoParams
 	{
-		smoothedChaosFreqMaxOct_ += (chaosFreqMaxOct_ - smoothedChaosFreqMaxOct_) * (1.0f - chaosParamSmoothCoeff_);
-		smoothedChaosGainMaxDb_  += (chaosGainMaxDb_  - smoothedChaosGainMaxDb_)  * (1.0f - chaosParamSmoothCoeff_);
-		smoothedChaosShPeriodD_  += (chaosShPeriodD_  - smoothedChaosShPeriodD_)  * (1.0f - chaosParamSmoothCoeff_);
-
-		const float period = smoothedChaosShPeriodD_;
-		const float sr = (float) currentSampleRate;
-		const int nCh = chaosStereo_ ? 2 : 1;
-
-		for (int c = 0; c < nCh; ++c)
-		{
-			advanceChaosEngine (chaosDPrev_[c], chaosDCurr_[c], chaosDNext_[c], chaosDPhase_[c],
-				chaosDDriftPhase_[c], chaosDDriftFreqHz_[c], chaosDOut_[c],
-				chaosDRng_[c], period, chaosAmtNormD_, sr);
-
-			advanceChaosEngine (chaosGPrev_[c], chaosGCurr_[c], chaosGNext_[c], chaosGPhase_[c],
-				chaosGDriftPhase_[c], chaosGDriftFreqHz_[c], chaosGOut_[c],
-				chaosGRng_[c], period, chaosAmtNormD_, sr);
-		}
-
-		if (! chaosStereo_)
-		{
-			chaosDOut_[1] = chaosDOut_[0];
-			chaosGOut_[1] = chaosGOut_[0];
-		}
-	}
-
-	inline void advanceChaosF() noexcept
+		std::atomic<float>* shape    = nullptr;
+		std::atomic<float>* rate     = nullptr;
+		std::atomic<float>* sync     = nullptr;
+		std::atomic<float>* division = nullptr;
+	};
+
+	struct RouteParams
 	{
-		smoothedChaosFilterMaxOct_  += (chaosFilterMaxOct_  - smoothedChaosFilterMaxOct_)  * (1.0f - chaosParamSmoothCoeff_);
-		smoothedChaosShPeriodF_     += (chaosShPeriodF_     - smoothedChaosShPeriodF_)     * (1.0f - chaosParamSmoothCoeff_);
-
-		const float amtNormF = chaosAmtF_ * 0.01f;
-		const float period   = smoothedChaosShPeriodF_;
-		const float sr       = (float) currentSampleRate;
-
-		chaosFPhase_ += 1.0f;
-		if (chaosFPhase_ >= period)
-		{
-			chaosFPhase_ -= period;
-			chaosFPrev_ = chaosFCurr_;
-			chaosFCurr_ = chaosFNext_;
-			chaosFNext_ = chaosFRng_.nextFloat() * 2.0f - 1.0f;
-			const float driftBase = sr / juce::jmax (1.0f, period) * 0.37f;
-			chaosFDriftFreqHz_ = driftBase * (0.88f + chaosFRng_.nextFloat() * 0.24f);
-		}
-
-		const float t  = chaosFPhase_ / period;
-		const float t2 = t * t;
-		const float t3 = t2 * t;
-		const float h00 =  2.0f * t3 - 3.0f * t2 + 1.0f;
-		const float h10 =         t3 - 2.0f * t2 + t;
-		const float h01 = -2.0f * t3 + 3.0f * t2;
-		const float h11 =         t3 -        t2;
-		const float tangCurr = (chaosFNext_ - chaosFPrev_) * 0.5f;
-		const float tangNext = -chaosFCurr_ * 0.5f;
-		const float shValue  = h00 * chaosFCurr_ + h10 * tangCurr + h01 * chaosFNext_ + h11 * tangNext;
-
-		chaosFDriftPhase_ += chaosFDriftFreqHz_ / sr;
-		if (chaosFDriftPhase_ > 1e6f) chaosFDriftPhase_ -= 1e6f;
-		const float driftL = std::sin (chaosFDriftPhase_ * kTwoPi) * kChaosDriftAmp;
-
-		const float shWeight = juce::jlimit (0.0f, 1.0f, amtNormF * 1.5f - 0.15f);
-		chaosFOut_[0] = driftL + shValue * shWeight;
-
-		if (chaosStereo_)
-		{
-			const float driftR = std::sin (chaosFDriftPhase_ * kTwoPi + kTwoPi * 0.25f) * kChaosDriftAmp;
-			chaosFOut_[1] = driftR + shValue * shWeight;
-		}
-		else
-		{
-			chaosFOut_[1] = chaosFOut_[0];
-		}
-	}
+		std::atomic<float>* source = nullptr;
+		std::atomic<float>* target = nullptr;
+		std::atomic<float>* depth  = nullptr;
+	};
 
-	DspDebugLog dspLog;
+	std::array<LfoParams, ModMatrix::kNumLfos> lfoParams {};
+	std::array<RouteParams, ModMatrix::kMaxRoutes> routeParams {};
+	std::atomic<float>* envAttackParam  = nullptr;
+	std::atomic<float>* envReleaseParam = nullptr;
+	std::atomic<float>* rndRateParam    = nullptr;
+	std::atomic<float>* rndGlideParam   = nullptr;
+
+	static constexpr float kLfoRateDefault       = 1.0f;
+	static constexpr int   kLfoDivisionDefault   = 4;       // 1/4
+	static constexpr float kEnvAttackDefault     = 10.0f;   // ms
+	static constexpr float kEnvReleaseDefault    = 250.0f;  // ms
+	static constexpr float kRndRateDefault       = 2.0f;
+	static constexpr float kRndGlideDefault      = 1.0f;
+
+	// Host tempo and transport position at the start of the current block, for
+	// tempo-synced LFOs (audio thread only; ppq < 0 while stopped).
+	double hostBpm = 120.0;
+	double hostPpq = -1.0;
+	void updateHostTransport() noexcept;
 
 	// Limiter ranges and defaults
 	static constexpr float kLimThresholdMin     = -36.0f;
@@ -552,53 +557,62 @@ private:
 	static constexpr float kLimThresholdDefault = 0.0f;
 	static constexpr int   kLimModeDefault      = 0;   // 0=NONE  1=WET  2=GLOBAL
 
-	// Dual-stage transparent limiter state (stereo-linked)
-	static constexpr float kLimFloor = 1.0e-12f;
-	float limEnv1_[2] = { kLimFloor, kLimFloor };
-	float limEnv2_[2] = { kLimFloor, kLimFloor };
-	float limAtt1_ = 0.0f;
-	float limRel1_ = 0.0f;
-	float limRel2_ = 0.0f;
+	static constexpr int   kStageTypeDefault    = 0;   // 0=1-POLE  1=DELAY
+	std::atomic<float>* stageTypeParam = nullptr;
 
-	inline void applyLimiter (float& sampleL, float& sampleR, float threshLin) noexcept
+	// ── Warm-start DSP state snapshots ──
+	// Engine state captured as one fixed-size block (~33 KB, no heap).
+	// Snapshots are keyed by transport position (loop starts / render starts) or
+	// by program index, and live in a small table allocated by the first
+	// prepareToPlay (instances that are only scanned never need it).
+	using DspStateSnapshot = DisperserEngine::StateSnapshot;
+
+	enum class SnapshotKey : int { None = 0, TransportPosition, Program };
+
+	struct SnapshotSlot
 	{
-		const float peakL = std::abs (sampleL);
-		const float peakR = std::abs (sampleR);
-
-		// Stage 1 — leveler (2 ms attack, 10 ms release)
-		for (int ch = 0; ch < 2; ++ch)
-		{
-			const float p = (ch == 0) ? peakL : peakR;
-			if (p > limEnv1_[ch])
-				limEnv1_[ch] = limAtt1_ * limEnv1_[ch] + (1.0f - limAtt1_) * p;
-			else
-				limEnv1_[ch] = limRel1_ * limEnv1_[ch] + (1.0f - limRel1_) * p;
-			if (limEnv1_[ch] < kLimFloor) limEnv1_[ch] = kLimFloor;
-		}
-
-		// Stage 2 — brickwall (instant attack, 100 ms release)
-		for (int ch = 0; ch < 2; ++ch)
-		{
-			const float p = (ch == 0) ? peakL : peakR;
-			if (p > limEnv2_[ch])
-				limEnv2_[ch] = p;
-			else
-				limEnv2_[ch] = limRel2_ * limEnv2_[ch] + (1.0f - limRel2_) * p;
-			if (limEnv2_[ch] < kLimFloor) limEnv2_[ch] = kLimFloor;
-		}
-
-		// Stereo-linked gain reduction
-		float gr = 1.0f;
-		const float maxEnv1 = juce::jmax (limEnv1_[0], limEnv1_[1]);
-		const float maxEnv2 = juce::jmax (limEnv2_[0], limEnv2_[1]);
-		if (maxEnv1 > threshLin)
-			gr = juce::jmin (gr, threshLin / maxEnv1);
-		if (maxEnv2 > threshLin)
-			gr = juce::jmin (gr, threshLin / maxEnv2);
-
-		sampleL *= gr;
-		sampleR *= gr;
-	}
+		SnapshotKey  keyType  = SnapshotKey::None;
+		juce::int64  key      = 0;
+		double       sampleRate = 0.0;
+		juce::uint64 settings = 0;                  // getSoundSettingsHash() when captured
+		juce::uint32 lastUsed = 0;
+		DspStateSnapshot state;
+	};
+
+	static constexpr int kNumSnapshotSlots = 8;
+
+	SnapshotSlot* findSnapshot (SnapshotKey type, juce::int64 key) noexcept;
+	SnapshotSlot& allocateSnapshot (SnapshotKey type, juce::int64 key) noexcept;
+	void handleTransportSnapshots (int numSamples) noexcept;
+	juce::uint64 getSoundSettingsHash() const noexcept;
+
+	std::unique_ptr<std::array<SnapshotSlot, kNumSnapshotSlots>> snapshotSlots;
+	juce::uint32 snapshotClock = 0;
+	bool         transportWasPlaying = false;
+	juce::int64  expectedNextSample = -1;
+	int          audioProgram = -1;             // program the DSP state belongs to (audio thread)
+
+	// Published for the editor (info popup, perf overlay); the engine itself is
+	// audio-thread only. The ISA starts as the level prepare() will pick.
+	std::atomic<int> dspIsa { (int) simd::resolveIsa() };
+	std::atomic<int> dspCascadePath { (int) cost::PathNone };
+
+	// ── Instance registry ──
+	// Claimed by the constructor; processBlock publishes its own time, the
+	// engine's effective size and path after every block.
+	void publishInstanceStats (juce::int64 blockStartTicks, int numSamples) noexcept;
+	int registrySlot = -1;
+	InstanceRegistry::Stats instanceStats;   // audio thread
+
+	TransferAnalyzer transferAnalyzer;
+
+	// ── Sample-accurate MIDI ──
+	// processBlock splits the host block at relevant note events (and timed
+	// parameter changes) and runs the engine once per segment on offset
+	// channel pointers.
+	bool isRelevantMidiEvent (const juce::MidiMessage& msg) const noexcept;
+	void handleMidiEvent (const juce::MidiMessage& msg) noexcept;
+	void processSegment (juce::AudioBuffer<float>& fullBuffer, int startSample, int length);
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DisperserAudioProcessor)
 };
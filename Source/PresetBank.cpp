@@ -0,0 +1,225 @@
+#include "PresetBank.h"
+
+#include <algorithm>
+
+bool PresetBank::open (const juce::File& file)
+{
+    close();
+
+    if (! file.existsAsFile())
+        return false;
+
+    auto mapped = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly, false);
+    if (mapped->getData() == nullptr || mapped->getSize() < sizeof (Header))
+        return false;
+
+    const auto* base = static_cast<const char*> (mapped->getData());
+    header     = reinterpret_cast<const Header*> (base);
+
+    if (header->magic != kMagic || header->version < 1 || header->version > kVersion)
+    {
+        header = nullptr;
+        return false;
+    }
+
+    paramIds   = reinterpret_cast<const StringRef*>  (base + header->paramIdsOffset);
+    index      = reinterpret_cast<const IndexEntry*> (base + header->indexOffset);
+    records    = reinterpret_cast<const float*>      (base + header->recordsOffset);
+    stringPool = base + header->stringPoolOffset;
+
+    if (! validate (mapped->getSize()))
+    {
+        header = nullptr;
+        return false;
+    }
+
+    mapping = std::move (mapped);
+    bankFile = file;
+    return true;
+}
+
+void PresetBank::close()
+{
+    header = nullptr;
+    paramIds = nullptr;
+    index = nullptr;
+    records = nullptr;
+    stringPool = nullptr;
+    mapping.reset();
+    bankFile = juce::File();
+}
+
+bool PresetBank::validate (size_t fileSize) const
+{
+    const auto sectionFits = [fileSize] (uint64_t offset, uint64_t bytes)
+    {
+        return (offset % 4) == 0 && offset <= fileSize && bytes <= fileSize - offset;
+    };
+
+    const uint64_t presets = header->presetCount;
+    const uint64_t params  = header->paramCount;
+
+    if (! sectionFits (header->paramIdsOffset, params * sizeof (StringRef))
+        || ! sectionFits (header->indexOffset, presets * sizeof (IndexEntry))
+        || ! sectionFits (header->recordsOffset, presets * params * sizeof (float))
+        || header->stringPoolOffset > fileSize
+        || header->stringPoolSize > fileSize - header->stringPoolOffset)
+        return false;
+
+    const auto refFits = [this] (const StringRef& r)
+    {
+        return (uint64_t) r.offset + r.length <= header->stringPoolSize;
+    };
+
+    for (uint64_t i = 0; i < params; ++i)
+        if (! refFits (paramIds[i]))
+            return false;
+
+    for (uint64_t i = 0; i < presets; ++i)
+        if (! refFits (index[i].name) || ! refFits (index[i].tags))
+            return false;
+
+    return true;
+}
+
+juce::String PresetBank::poolString (const StringRef& ref) const
+{
+    return juce::String::fromUTF8 (stringPool + ref.offset, (int) ref.length);
+}
+
+juce::String PresetBank::getParamId (int paramIndex) const
+{
+    if (! juce::isPositiveAndBelow (paramIndex, getNumParams()))
+        return {};
+    return poolString (paramIds[paramIndex]);
+}
+
+juce::String PresetBank::getName (int presetIndex) const
+{
+    if (! juce::isPositiveAndBelow (presetIndex, getNumPresets()))
+        return {};
+    return poolString (index[presetIndex].name);
+}
+
+juce::StringArray PresetBank::getTags (int presetIndex) const
+{
+    if (! juce::isPositiveAndBelow (presetIndex, getNumPresets()))
+        return {};
+    return juce::StringArray::fromTokens (poolString (index[presetIndex].tags), ",", {});
+}
+
+const float* PresetBank::getValues (int presetIndex) const noexcept
+{
+    if (! juce::isPositiveAndBelow (presetIndex, getNumPresets()))
+        return nullptr;
+    return records + (size_t) presetIndex * header->paramCount;
+}
+
+int PresetBank::findByName (const juce::String& name) const
+{
+    int lo = 0, hi = getNumPresets() - 1;
+    while (lo <= hi)
+    {
+        const int mid = (lo + hi) / 2;
+        const int cmp = getName (mid).compareIgnoreCase (name);
+        if (cmp == 0)
+            return mid;
+        if (cmp < 0)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return -1;
+}
+
+juce::Array<int> PresetBank::search (const juce::String& text, const juce::String& tag) const
+{
+    juce::Array<int> result;
+
+    for (int i = 0; i < getNumPresets(); ++i)
+    {
+        if (text.isNotEmpty() && ! getName (i).containsIgnoreCase (text))
+            continue;
+
+        if (tag.isNotEmpty() && ! getTags (i).contains (tag, true))
+            continue;
+
+        result.add (i);
+    }
+
+    return result;
+}
+
+std::vector<PresetBank::Preset> PresetBank::readAll() const
+{
+    std::vector<Preset> out;
+    out.reserve ((size_t) getNumPresets());
+
+    for (int i = 0; i < getNumPresets(); ++i)
+    {
+        const auto* v = getValues (i);
+        out.push_back ({ getName (i), getTags (i), std::vector<float> (v, v + getNumParams()) });
+    }
+
+    return out;
+}
+
+bool PresetBank::write (const juce::File& file,
+                        const juce::StringArray& ids,
+                        std::vector<Preset> presets)
+{
+    std::stable_sort (presets.begin(), presets.end(), [] (const Preset& a, const Preset& b)
+    {
+        return a.name.compareIgnoreCase (b.name) < 0;
+    });
+
+    juce::MemoryOutputStream pool;
+    const auto addString = [&pool] (const juce::String& s) -> StringRef
+    {
+        const auto offset = (uint32_t) pool.getDataSize();
+        const auto utf8 = s.toUTF8();
+        const auto bytes = (uint32_t) utf8.sizeInBytes() - 1;
+        pool.write (utf8.getAddress(), bytes);
+        return { offset, bytes };
+    };
+
+    std::vector<StringRef> idRefs;
+    for (const auto& id : ids)
+        idRefs.push_back (addString (id));
+
+    std::vector<IndexEntry> entries;
+    for (const auto& p : presets)
+        entries.push_back ({ addString (p.name), addString (p.tags.joinIntoString (",")) });
+
+    Header h {};
+    h.magic            = kMagic;
+    h.version          = kVersion;
+    h.presetCount      = (uint32_t) presets.size();
+    h.paramCount       = (uint32_t) ids.size();
+    h.paramIdsOffset   = (uint32_t) sizeof (Header);
+    h.indexOffset      = h.paramIdsOffset + h.paramCount * (uint32_t) sizeof (StringRef);
+    h.recordsOffset    = h.indexOffset + h.presetCount * (uint32_t) sizeof (IndexEntry);
+    h.stringPoolOffset = h.recordsOffset + h.presetCount * h.paramCount * (uint32_t) sizeof (float);
+    h.stringPoolSize   = (uint32_t) pool.getDataSize();
+
+    juce::MemoryOutputStream out;
+    out.write (&h, sizeof (h));
+    out.write (idRefs.data(), idRefs.size() * sizeof (StringRef));
+    out.write (entries.data(), entries.size() * sizeof (IndexEntry));
+
+    for (const auto& p : presets)
+    {
+        std::vector<float> rec (h.paramCount, 0.0f);
+        std::copy_n (p.values.begin(), juce::jmin (p.values.size(), rec.size()), rec.begin());
+        out.write (rec.data(), rec.size() * sizeof (float));
+    }
+
+    out << pool;
+
+    file.getParentDirectory().createDirectory();
+    juce::TemporaryFile temp (file);
+    if (! temp.getFile().replaceWithData (out.getData(), out.getDataSize()))
+        return false;
+
+    return temp.overwriteTargetFileWithTemporary();
+}
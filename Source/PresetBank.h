@@ -0,0 +1,112 @@
+#pragma once
+
+// ============================================================================
+// PresetBank.h — memory-mapped preset library for DISP-TR
+//
+// One file holds the whole library. It is mapped read-only and never parsed
+// into objects: browsing and searching read the index straight out of the
+// mapping, and a preset's values are a pointer into it.
+//
+// File layout (little-endian, every section 4-byte aligned):
+//
+//   Header
+//   StringRef   paramIds[paramCount]       parameter IDs, in record order
+//   IndexEntry  index[presetCount]         sorted by name (case-insensitive)
+//   float       records[presetCount][paramCount]   plain (denormalised) values
+//   char        stringPool[stringPoolSize] UTF-8, not null-terminated
+//
+// Records are keyed by the paramIds table, so banks written by older builds
+// still apply after parameters are added or removed.
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <vector>
+
+class PresetBank
+{
+public:
+    static constexpr uint32_t kMagic   = 0x42505444; // "DTPB"
+    static constexpr uint32_t kVersion = 1;
+
+    // Writer input: values are in the same order as the paramIds passed to write().
+    struct Preset
+    {
+        juce::String name;
+        juce::StringArray tags;
+        std::vector<float> values;
+    };
+
+    PresetBank() = default;
+
+    bool open (const juce::File& file);
+    void close();
+
+    bool isOpen() const noexcept        { return header != nullptr; }
+    const juce::File& getFile() const noexcept { return bankFile; }
+
+    int getNumPresets() const noexcept  { return header != nullptr ? (int) header->presetCount : 0; }
+    int getNumParams() const noexcept   { return header != nullptr ? (int) header->paramCount : 0; }
+
+    juce::String getParamId (int paramIndex) const;
+    juce::String getName (int presetIndex) const;
+    juce::StringArray getTags (int presetIndex) const;
+
+    // Points into the mapping; getNumParams() values, valid until close().
+    const float* getValues (int presetIndex) const noexcept;
+
+    // Exact (case-insensitive) name lookup via binary search; -1 if absent.
+    int findByName (const juce::String& name) const;
+
+    // Presets whose name contains `text` (case-insensitive) and, if `tag` is
+    // non-empty, that carry that tag. Empty text matches everything.
+    juce::Array<int> search (const juce::String& text, const juce::String& tag = {}) const;
+
+    // Serialises a complete bank; presets are sorted by name on write. Writes to
+    // a temporary file first so readers never see a partial bank.
+    static bool write (const juce::File& file,
+                       const juce::StringArray& paramIds,
+                       std::vector<Preset> presets);
+
+    // Reads every preset back out (for appending/rewriting a bank).
+    std::vector<Preset> readAll() const;
+
+private:
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t presetCount;
+        uint32_t paramCount;
+        uint32_t paramIdsOffset;
+        uint32_t indexOffset;
+        uint32_t recordsOffset;
+        uint32_t stringPoolOffset;
+        uint32_t stringPoolSize;
+    };
+
+    struct StringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct IndexEntry
+    {
+        StringRef name;
+        StringRef tags;   // comma-separated
+    };
+
+    juce::String poolString (const StringRef& ref) const;
+    bool validate (size_t fileSize) const;
+
+    juce::File bankFile;
+    std::unique_ptr<juce::MemoryMappedFile> mapping;
+    const Header*     header     = nullptr;
+    const StringRef*  paramIds   = nullptr;
+    const IndexEntry* index      = nullptr;
+    const float*      records    = nullptr;
+    const char*       stringPool = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (PresetBank)
+};
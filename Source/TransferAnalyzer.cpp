@@ -0,0 +1,465 @@
+#include "TransferAnalyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    using Params  = DisperserEngine::Params;
+    using Complex = std::complex<double>;
+
+    constexpr double kTwoPi = 6.283185307179586;
+
+    // A point deviates when measured and analytic group delay differ by more
+    // than the largest of these and of the estimate's own scatter; the flag
+    // needs a few such points, so one noisy band does not raise it.
+    constexpr float kDeviationFloorMs   = 0.5f;
+    constexpr float kDeviationRatio     = 0.1f;
+    constexpr float kDeviationSigmas    = 3.0f;
+    constexpr int   kMinDeviatingPoints = 3;
+
+    // Segments whose input stays below −80 dBFS RMS carry no information.
+    constexpr double kSilenceMeanSquare = 1.0e-8;
+
+    // The analytic delay used to size the FFT comes from the phase change
+    // across this small step, far below any bin spacing.
+    constexpr double kProbeStepHz = 0.01;
+
+    constexpr double kSegmentsPerDelay = 20.0;
+
+    // Everything computeResponse reads. Transport position and the LFO,
+    // envelope and random settings only move the modulation, which already
+    // makes the model approximate.
+    bool sameResponse (const Params& a, const Params& b) noexcept
+    {
+        if (a.stages != b.stages || a.series != b.series || a.freqHz != b.freqHz || a.shape != b.shape
+            || a.alt != b.alt || a.feedback != b.feedback || a.mod != b.mod || a.stageType != b.stageType
+            || a.midiFreqHz != b.midiFreqHz || a.inputDb != b.inputDb || a.outputDb != b.outputDb
+            || a.mix != b.mix || a.mixMode != b.mixMode || a.dryLevel != b.dryLevel || a.wetLevel != b.wetLevel
+            || a.tiltDb != b.tiltDb || a.pan != b.pan || a.style != b.style
+            || a.hpOn != b.hpOn || a.lpOn != b.lpOn || a.hpFreq != b.hpFreq || a.lpFreq != b.lpFreq
+            || a.hpSlope != b.hpSlope || a.lpSlope != b.lpSlope
+            || a.chaosFilter != b.chaosFilter || a.chaosDelay != b.chaosDelay
+            || a.modeIn != b.modeIn || a.modeOut != b.modeOut || a.sumBus != b.sumBus
+            || a.invPol != b.invPol || a.invStr != b.invStr || a.limMode != b.limMode)
+            return false;
+
+        for (size_t i = 0; i < a.modMatrix.routes.size(); ++i)
+        {
+            const auto& ra = a.modMatrix.routes[i];
+            const auto& rb = b.modMatrix.routes[i];
+            if (ra.source != rb.source || ra.target != rb.target || ra.depth != rb.depth)
+                return false;
+        }
+        return true;
+    }
+
+    // Group delay over bins [k0, k1] from the summed phase steps between
+    // neighbours; weighting by magnitude keeps weak bins from dominating.
+    template <typename Spectrum>
+    double bandDelaySeconds (const Spectrum& at, int k0, int k1, double binHz)
+    {
+        Complex step;
+        for (int k = k0; k < k1; ++k)
+            step += at (k + 1) * std::conj (at (k));
+        return -std::arg (step) / (kTwoPi * binHz);
+    }
+
+    void writeRing (std::vector<float>& ring, uint64_t pos, const float* src, int n) noexcept
+    {
+        const int size  = (int) ring.size();
+        const int start = (int) (pos & (uint64_t) (size - 1));
+        const int first = std::min (n, size - start);
+        std::memcpy (ring.data() + start, src, sizeof (float) * (size_t) first);
+        std::memcpy (ring.data(), src + first, sizeof (float) * (size_t) (n - first));
+    }
+
+    void readRing (const std::vector<float>& ring, uint64_t pos, float* dest, int n) noexcept
+    {
+        const int size  = (int) ring.size();
+        const int start = (int) (pos & (uint64_t) (size - 1));
+        const int first = std::min (n, size - start);
+        std::memcpy (dest, ring.data() + start, sizeof (float) * (size_t) first);
+        std::memcpy (dest + first, ring.data(), sizeof (float) * (size_t) (n - first));
+    }
+}
+
+TransferAnalyzer::TransferAnalyzer()
+    : juce::Thread ("DISP-TR transfer analyzer")
+{
+}
+
+TransferAnalyzer::~TransferAnalyzer()
+{
+    stop();
+}
+
+//==============================================================================
+void TransferAnalyzer::start()
+{
+    stop();
+
+    ringDry.assign ((size_t) kRingSize, 0.0f);
+    ringWet.assign ((size_t) kRingSize, 0.0f);
+    writeIndex.store (0, std::memory_order_relaxed);
+    readIndex.store (0, std::memory_order_relaxed);
+    workerRead = 0;
+    seenDrops  = droppedBlocks.load (std::memory_order_relaxed);
+
+    {
+        // Whatever model was set last is applied afresh.
+        const juce::ScopedLock sl (modelLock);
+        seenGeneration = modelGeneration - 1;
+    }
+    {
+        const juce::ScopedLock sl (resultLock);
+        hasResult = false;
+    }
+
+    captureEnabled.store (true, std::memory_order_seq_cst);
+    startThread (juce::Thread::Priority::low);
+}
+
+void TransferAnalyzer::stop()
+{
+    // Pairs with beginCapture: once the flag is down and the audio thread is
+    // out, it cannot touch the ring again until the next start().
+    captureEnabled.store (false, std::memory_order_seq_cst);
+    while (captureBusy.load (std::memory_order_seq_cst))
+        juce::Thread::yield();
+
+    stopThread (2000);
+
+    ringDry = {};
+    ringWet = {};
+    fft.reset();
+    window = {};
+    histDry = {};
+    histWet = {};
+    fftDry = {};
+    fftWet = {};
+    sxx = {};
+    syy = {};
+    sxy = {};
+    analytic = {};
+    fftOrder = fftSize = filled = averages = 0;
+    workerBytes.store (0, std::memory_order_relaxed);
+}
+
+void TransferAnalyzer::setModel (const DisperserEngine::Params& p, double newSampleRate)
+{
+    if (newSampleRate <= 0.0)   // not prepared yet; nothing is captured either
+        return;
+
+    const juce::ScopedLock sl (modelLock);
+    if (hasModel && newSampleRate == modelSampleRate && sameResponse (p, modelParams))
+        return;
+
+    modelParams     = p;
+    modelSampleRate = newSampleRate;
+    hasModel        = true;
+    ++modelGeneration;
+}
+
+bool TransferAnalyzer::getResult (Result& dest) const
+{
+    const juce::ScopedLock sl (resultLock);
+    if (hasResult)
+        dest = result;
+    return hasResult;
+}
+
+size_t TransferAnalyzer::getMemoryBytes() const noexcept
+{
+    return MemoryReport::getCapacityBytes (ringDry) + MemoryReport::getCapacityBytes (ringWet)
+         + workerBytes.load (std::memory_order_relaxed);
+}
+
+//==============================================================================
+bool TransferAnalyzer::beginCapture (const float* dry, int numSamples) noexcept
+{
+    if (! captureEnabled.load (std::memory_order_acquire))
+        return false;
+
+    // Announce before re-checking, so stop() either sees us busy or we see it.
+    captureBusy.store (true, std::memory_order_seq_cst);
+    if (! captureEnabled.load (std::memory_order_seq_cst))
+    {
+        captureBusy.store (false, std::memory_order_release);
+        return false;
+    }
+
+    const uint64_t w = writeIndex.load (std::memory_order_relaxed);
+    if (numSamples <= 0 || w + (uint64_t) numSamples - readIndex.load (std::memory_order_acquire) > (uint64_t) kRingSize)
+    {
+        droppedBlocks.fetch_add (1, std::memory_order_relaxed);
+        captureBusy.store (false, std::memory_order_release);
+        return false;
+    }
+
+    writeRing (ringDry, w, dry, numSamples);
+    pendingWrite = w;
+    return true;
+}
+
+void TransferAnalyzer::endCapture (const float* wet, int numSamples) noexcept
+{
+    writeRing (ringWet, pendingWrite, wet, numSamples);
+    writeIndex.store (pendingWrite + (uint64_t) numSamples, std::memory_order_release);
+    captureBusy.store (false, std::memory_order_release);
+}
+
+//==============================================================================
+void TransferAnalyzer::run()
+{
+    while (! threadShouldExit())
+    {
+        bool changed = false;
+        {
+            const juce::ScopedLock sl (modelLock);
+            changed = hasModel && modelGeneration != seenGeneration;
+        }
+
+        if (changed)
+            reconfigure();
+        if (fftSize > 0)
+            drainRing();
+
+        wait (20);
+    }
+}
+
+void TransferAnalyzer::reconfigure()
+{
+    Params p;
+    {
+        const juce::ScopedLock sl (modelLock);
+        p = modelParams;
+        sampleRate = juce::jmax (1.0, modelSampleRate);
+        seenGeneration = modelGeneration;
+    }
+
+    // ── Display points, and the analytic delay at each to size the FFT ──
+    const double top  = juce::jmin ((double) kMaxFreqHz, 0.45 * sampleRate);
+    const double span = std::log2 (top / kMinFreqHz);
+    std::array<float, kNumPoints * 2> probeHz;
+    std::array<Complex, kNumPoints * 2> probe;
+    for (int i = 0; i < kNumPoints; ++i)
+    {
+        pointHz[(size_t) i] = (float) (kMinFreqHz * std::exp2 (span * i / (kNumPoints - 1)));
+        probeHz[(size_t) (2 * i)]     = pointHz[(size_t) i] - (float) (0.5 * kProbeStepHz);
+        probeHz[(size_t) (2 * i + 1)] = pointHz[(size_t) i] + (float) (0.5 * kProbeStepHz);
+    }
+    modelExact = DisperserEngine::computeResponse (p, sampleRate, probeHz.data(), kNumPoints * 2, probe.data());
+
+    double peakSeconds = 0.0;
+    for (int i = 0; i < kNumPoints; ++i)
+    {
+        const auto lo = (size_t) (2 * i), hi = lo + 1;
+        const double seconds = -std::arg (probe[hi] * std::conj (probe[lo])) / (kTwoPi * ((double) probeHz[hi] - (double) probeHz[lo]));
+        pointDelayMs[(size_t) i] = (float) (1000.0 * seconds);
+        peakSeconds = juce::jmax (peakSeconds, seconds);
+    }
+
+    // A segment loses the part of the response that spills past its end,
+    // which shows up as coherence of about (1 − delay / length)²: twenty
+    // times the longest delay keeps that near 0.9.
+    const int order = juce::jlimit (kMinFftOrder, kMaxFftOrder, (int) std::ceil (std::log2 (juce::jmax (1.0, kSegmentsPerDelay * peakSeconds * sampleRate))));
+    if (order != fftOrder)
+    {
+        fftOrder = order;
+        fftSize  = 1 << order;
+        fft = std::make_unique<juce::dsp::FFT> (order);
+
+        window.resize ((size_t) fftSize);
+        for (int i = 0; i < fftSize; ++i)
+            window[(size_t) i] = (float) (0.5 - 0.5 * std::cos (kTwoPi * i / fftSize));
+
+        histDry.assign ((size_t) fftSize, 0.0f);
+        histWet.assign ((size_t) fftSize, 0.0f);
+        fftDry.assign ((size_t) fftSize * 2, 0.0f);
+        fftWet.assign ((size_t) fftSize * 2, 0.0f);
+    }
+
+    const int numBins = fftSize / 2 + 1;
+    sxx.assign ((size_t) numBins, 0.0);
+    syy.assign ((size_t) numBins, 0.0);
+    sxy.assign ((size_t) numBins, Complex());
+
+    // The analytic curve goes through the same band estimator as the
+    // measurement, so both are smoothed alike.
+    std::vector<float> binHz ((size_t) numBins);
+    for (int k = 0; k < numBins; ++k)
+        binHz[(size_t) k] = (float) (k * sampleRate / fftSize);
+    analytic.resize ((size_t) numBins);
+    DisperserEngine::computeResponse (p, sampleRate, binHz.data(), numBins, analytic.data());
+
+    workerBytes.store (MemoryReport::getCapacityBytes (window) + MemoryReport::getCapacityBytes (histDry)
+                       + MemoryReport::getCapacityBytes (histWet) + MemoryReport::getCapacityBytes (fftDry)
+                       + MemoryReport::getCapacityBytes (fftWet) + MemoryReport::getCapacityBytes (sxx)
+                       + MemoryReport::getCapacityBytes (syy) + MemoryReport::getCapacityBytes (sxy)
+                       + MemoryReport::getCapacityBytes (analytic),
+                       std::memory_order_relaxed);
+
+    // Blocks already captured ran on the old settings, and the next ones
+    // still carry their tail and the smoothers' glide.
+    filled   = 0;
+    averages = 0;
+    settleRemaining = (int64_t) (juce::jmin (kMaxSettleSeconds, DisperserEngine::estimateTailSeconds (p, sampleRate, -60.0f)) * sampleRate);
+    workerRead = writeIndex.load (std::memory_order_acquire);
+    readIndex.store (workerRead, std::memory_order_release);
+    seenDrops = droppedBlocks.load (std::memory_order_relaxed);
+
+    publishResult();
+}
+
+void TransferAnalyzer::drainRing()
+{
+    // The write index first: a drop counted after it was read lies beyond
+    // everything up to it.
+    const uint64_t w = writeIndex.load (std::memory_order_acquire);
+    const uint32_t drops = droppedBlocks.load (std::memory_order_relaxed);
+    if (drops != seenDrops)
+    {
+        seenDrops  = drops;
+        filled     = 0;
+        workerRead = w;
+        readIndex.store (w, std::memory_order_release);
+        return;
+    }
+
+    const int hop = fftSize / 2;
+    while (workerRead < w && ! threadShouldExit())
+    {
+        if (settleRemaining > 0)
+        {
+            const auto skip = (int64_t) juce::jmin ((uint64_t) settleRemaining, w - workerRead);
+            workerRead += (uint64_t) skip;
+            settleRemaining -= skip;
+        }
+        else
+        {
+            const int take = (int) juce::jmin (w - workerRead, (uint64_t) (fftSize - filled));
+            readRing (ringDry, workerRead, histDry.data() + filled, take);
+            readRing (ringWet, workerRead, histWet.data() + filled, take);
+            filled += take;
+            workerRead += (uint64_t) take;
+
+            if (filled == fftSize)
+            {
+                analyseSegment();
+                std::memmove (histDry.data(), histDry.data() + hop, sizeof (float) * (size_t) (fftSize - hop));
+                std::memmove (histWet.data(), histWet.data() + hop, sizeof (float) * (size_t) (fftSize - hop));
+                filled = fftSize - hop;
+            }
+        }
+
+        readIndex.store (workerRead, std::memory_order_release);
+    }
+}
+
+void TransferAnalyzer::analyseSegment()
+{
+    double energy = 0.0;
+    for (int i = 0; i < fftSize; ++i)
+        energy += (double) histDry[(size_t) i] * histDry[(size_t) i];
+    if (energy < kSilenceMeanSquare * fftSize)
+        return;
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        fftDry[(size_t) i] = histDry[(size_t) i] * window[(size_t) i];
+        fftWet[(size_t) i] = histWet[(size_t) i] * window[(size_t) i];
+    }
+    std::fill (fftDry.begin() + fftSize, fftDry.end(), 0.0f);
+    std::fill (fftWet.begin() + fftSize, fftWet.end(), 0.0f);
+
+    fft->performRealOnlyForwardTransform (fftDry.data(), true);
+    fft->performRealOnlyForwardTransform (fftWet.data(), true);
+
+    // Plain mean over the first kMaxAverages segments, then exponential, so
+    // the estimate keeps following slow changes in the input.
+    ++averages;
+    const double a = 1.0 / juce::jmin (averages, kMaxAverages);
+    for (int k = 0; k <= fftSize / 2; ++k)
+    {
+        const Complex x (fftDry[(size_t) (2 * k)], fftDry[(size_t) (2 * k + 1)]);
+        const Complex y (fftWet[(size_t) (2 * k)], fftWet[(size_t) (2 * k + 1)]);
+        sxx[(size_t) k] += a * (std::norm (x) - sxx[(size_t) k]);
+        syy[(size_t) k] += a * (std::norm (y) - syy[(size_t) k]);
+        sxy[(size_t) k] += a * (std::conj (x) * y - sxy[(size_t) k]);
+    }
+
+    publishResult();
+}
+
+void TransferAnalyzer::publishResult()
+{
+    Result r;
+    r.freqHz       = pointHz;
+    r.fftSize      = fftSize;
+    r.averages     = averages;
+    r.modelExact   = modelExact;
+    r.resolvableMs = (float) (1000.0 * fftSize / (4.0 * sampleRate));
+
+    const double binHz    = sampleRate / fftSize;
+    const double halfStep = std::exp2 (0.5 * std::log2 (r.freqHz[1] / r.freqHz[0]));
+    const int    lastBin  = fftSize / 2;
+
+    auto measured = [this] (int k) { return sxy[(size_t) k]; };
+    auto model    = [this] (int k) { return analytic[(size_t) k]; };
+
+    // Overlapped segments are not independent, and past kMaxAverages the
+    // exponential average remembers about twice that many.
+    const double effectiveAverages = juce::jmax (1, juce::jmin (averages, 2 * kMaxAverages));
+
+    int deviating = 0;
+    for (int i = 0; i < kNumPoints; ++i)
+    {
+        const auto idx = (size_t) i;
+        const int k0 = juce::jlimit (1, lastBin - 1, (int) std::floor (r.freqHz[idx] / halfStep / binHz));
+        const int k1 = juce::jlimit (k0 + 1, lastBin, (int) std::ceil (r.freqHz[idx] * halfStep / binHz));
+
+        // Beyond resolvableMs the band estimate wraps; the curve then shows
+        // the exact value and the point is not compared.
+        r.inRange[idx]    = pointDelayMs[idx] <= r.resolvableMs;
+        r.analyticMs[idx] = r.inRange[idx] ? (float) (1000.0 * bandDelaySeconds (model, k0, k1, binHz)) : pointDelayMs[idx];
+        r.measuredMs[idx] = (float) (1000.0 * bandDelaySeconds (measured, k0, k1, binHz));
+
+        double coherence = 0.0;
+        for (int k = k0; k <= k1; ++k)
+            coherence += std::norm (sxy[(size_t) k]) / (sxx[(size_t) k] * syy[(size_t) k] + 1.0e-30);
+        r.coherence[idx] = (float) (coherence / (k1 - k0 + 1));
+
+        if (! r.isValid (i))
+            continue;
+
+        // Random error of the estimate: per bin the phase scatters by
+        // √((1 − γ²) / (2 γ² n)), and the band averages k1 − k0 steps.
+        const double g2 = juce::jmax (1.0e-6, (double) r.coherence[idx]);
+        const double phaseSd = std::sqrt ((1.0 - juce::jmin (g2, 1.0)) / (2.0 * g2 * effectiveAverages));
+        const double noiseMs = 1000.0 * phaseSd * std::sqrt (2.0) / (kTwoPi * binHz * std::sqrt ((double) (k1 - k0)));
+
+        const float diff = r.measuredMs[idx] - r.analyticMs[idx];
+        const float tolerance = juce::jmax (kDeviationFloorMs, kDeviationRatio * std::abs (r.analyticMs[idx]), (float) (kDeviationSigmas * noiseMs));
+        if (std::abs (diff) > tolerance)
+        {
+            r.deviates[idx] = true;
+            ++deviating;
+        }
+
+        if (std::abs (diff) > std::abs (r.worstDeviationMs))
+        {
+            r.worstDeviationMs = diff;
+            r.worstDeviationHz = r.freqHz[idx];
+        }
+    }
+
+    // An approximate model is expected to miss; only an exact one is flagged.
+    r.deviation = modelExact && deviating >= kMinDeviatingPoints;
+
+    const juce::ScopedLock sl (resultLock);
+    result    = r;
+    hasResult = true;
+}
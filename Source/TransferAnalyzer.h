@@ -0,0 +1,146 @@
+#pragma once
+
+// ============================================================================
+// TransferAnalyzer.h — measured group delay of the running instance
+//
+// DisperserEngine::computeResponse says what the signal path should do; this
+// measures what it did. The audio thread copies each block's left input (dry)
+// and left output (wet) into a ring, and a worker thread estimates the
+// transfer function from them: Hann-windowed segments with 50 % overlap,
+// Welch-averaged auto- and cross-spectra, and group delay from the phase step
+// between neighbouring bins of the averaged cross-spectrum. Each display
+// point also gets the coherence of its band, so bins the input never excited
+// are left out rather than drawn as noise.
+//
+//   analyzer.start();                                        // message thread
+//   analyzer.setModel (params, sampleRate);
+//   if (analyzer.beginCapture (dry, n)) { process; analyzer.endCapture (wet, n); }   // audio thread
+//   analyzer.getResult (result);                             // message thread
+//
+// The audio side is wait-free: two copies and an index store, or nothing at
+// all when the ring is full (that block is dropped and the worker restarts
+// its segment) or the analyzer is stopped. Everything else, buffers included,
+// exists only between start() and stop().
+// ============================================================================
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "MemoryReport.h"
+#include "Engine/DisperserEngine.h"
+
+class TransferAnalyzer : private juce::Thread
+{
+public:
+    static constexpr int   kNumPoints   = 96;      // log-spaced display points
+    static constexpr float kMinFreqHz   = 20.0f;
+    static constexpr float kMaxFreqHz   = 20000.0f;
+    static constexpr int   kMinAverages = 8;       // before anything is compared
+    static constexpr float kMinCoherence = 0.9f;
+
+    struct Result
+    {
+        std::array<float, kNumPoints> freqHz {};
+        std::array<float, kNumPoints> analyticMs {};
+        std::array<float, kNumPoints> measuredMs {};
+        std::array<float, kNumPoints> coherence {};   // mean γ² over the point's band
+        std::array<bool,  kNumPoints> inRange {};    // analytic delay within resolvableMs
+        std::array<bool,  kNumPoints> deviates {};
+
+        int   fftSize  = 0;
+        int   averages = 0;           // Welch segments in the estimate
+        bool  modelExact = true;      // false: the analytic curve is only a guide
+        float resolvableMs = 0.0f;    // group delay the bin spacing can still resolve
+
+        // Raised when several valid points disagree and the model is exact.
+        bool  deviation = false;
+        float worstDeviationMs = 0.0f;
+        float worstDeviationHz = 0.0f;
+
+        bool isValid (int point) const noexcept
+        {
+            return averages >= kMinAverages && inRange[(size_t) point]
+                && coherence[(size_t) point] >= kMinCoherence;
+        }
+    };
+
+    TransferAnalyzer();
+    ~TransferAnalyzer() override;
+
+    // Message thread. start() allocates the ring and launches the worker;
+    // stop() waits for the audio thread to leave the ring, then frees it.
+    void start();
+    void stop();
+    bool isActive() const noexcept { return captureEnabled.load (std::memory_order_relaxed); }
+
+    // The settings the measurement is compared against. A change that alters
+    // the response restarts the average once the engine has had time to
+    // settle into it.
+    void setModel (const DisperserEngine::Params& p, double sampleRate);
+
+    // Latest estimate; false until the worker has finished one segment.
+    bool getResult (Result& dest) const;
+
+    // Audio thread. beginCapture() reserves room for numSamples and copies the
+    // dry block; if it returns true, endCapture() must follow in the same
+    // block with the processed output.
+    bool beginCapture (const float* dry, int numSamples) noexcept;
+    void endCapture (const float* wet, int numSamples) noexcept;
+
+    // Ring and worker buffers while running.
+    size_t getMemoryBytes() const noexcept;
+
+private:
+    static constexpr int kRingSize        = 1 << 15;   // frames; the worker drains it every ~20 ms
+    static constexpr int kMinFftOrder     = 12;
+    static constexpr int kMaxFftOrder     = 16;
+    static constexpr int kMaxAverages     = 32;        // then an exponential average
+    static constexpr double kMaxSettleSeconds = 2.0;
+
+    void run() override;
+
+    // ── Worker ──
+    void reconfigure();
+    void drainRing();
+    void analyseSegment();
+    void publishResult();
+
+    // ── Ring (audio thread writes, worker reads) ──
+    std::vector<float> ringDry, ringWet;
+    std::atomic<uint64_t> writeIndex { 0 }, readIndex { 0 };
+    std::atomic<uint32_t> droppedBlocks { 0 };
+    std::atomic<bool> captureEnabled { false }, captureBusy { false };
+    uint64_t pendingWrite = 0;   // audio thread, between begin and end
+
+    // ── Model (message thread → worker) ──
+    juce::CriticalSection modelLock;
+    DisperserEngine::Params modelParams;
+    double modelSampleRate = 0.0;
+    uint32_t modelGeneration = 0;
+    bool hasModel = false;
+
+    // ── Worker state ──
+    uint32_t seenGeneration = 0, seenDrops = 0;
+    uint64_t workerRead = 0;
+    double   sampleRate = 48000.0;
+    int      fftOrder = 0, fftSize = 0, filled = 0, averages = 0;
+    int64_t  settleRemaining = 0;
+    bool     modelExact = true;
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> window, histDry, histWet, fftDry, fftWet;
+    std::vector<double> sxx, syy;
+    std::vector<std::complex<double>> sxy, analytic;   // per bin
+    std::array<float, kNumPoints> pointHz {}, pointDelayMs {};   // analytic, at the point itself
+    std::atomic<size_t> workerBytes { 0 };
+
+    // ── Result (worker → message thread) ──
+    juce::CriticalSection resultLock;
+    Result result;
+    bool hasResult = false;
+
+    JUCE_DECLARE_NON_COPYABLE (TransferAnalyzer)
+};